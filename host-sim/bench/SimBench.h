@@ -0,0 +1,148 @@
+/**
+ ******************************************************************************
+ * @file    SimBench.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Checks and bus cost measurement shared by the driver benchmarks.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SIM_BENCH_H__
+#define __SIM_BENCH_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mbed.h"
+#include "SimBus.h"
+#include "DevI2C.h"
+#include "DevSPI.h"
+#include "SimCheck.h"
+
+/* Class Declarations --------------------------------------------------------*/
+
+/**
+ * Bus cost of a run of samples read through a DevI2C.
+ *
+ * Prints the transactions, bytes and bus time per sample seen on the wire,
+ * checks that the DevI2C counters agree with the wire, and that the cost
+ * stays within the budget given, so that a driver change reading more than
+ * it needs fails the run. A driver also driving the bus with the raw I2C
+ * calls, which DevI2C does not count, is benchmarked with raw_calls set:
+ * the wire then sees more than the counters, and may see the device not
+ * acknowledging while it is busy.
+ */
+class BenchI2C {
+public:
+    BenchI2C(DevI2C &dev, bool raw_calls = false) : dev(dev), raw_calls(raw_calls) {
+        begin();
+    }
+
+    void begin() {
+        dev.reset_stats();
+        SimI2CBus::instance().reset_stats();
+    }
+
+    void end(const char *what, uint32_t samples, float max_transactions, float max_bytes) {
+        DevI2CStats counted;
+        SimBusStats wire;
+
+        dev.get_stats(&counted);
+        SimI2CBus::instance().get_stats(&wire);
+
+        float transactions = (float)wire.transactions / samples;
+        float bytes = (float)wire.bytes / samples;
+
+        printf("  %-44s %6.2f transactions %7.2f bytes %9.1f us per sample\n", what,
+               transactions, bytes, wire.bus_time / 1000.0 / samples);
+
+        if (raw_calls) {
+            printf("  %-44s %6.2f transactions %7.2f bytes counted by DevI2C\n", "",
+                   (float)counted.transactions / samples, (float)counted.bytes / samples);
+            BENCH_CHECK(counted.transactions <= wire.transactions);
+            BENCH_CHECK(counted.bytes <= wire.bytes);
+            BENCH_CHECK(counted.errors == 0);
+        } else {
+            /* Every transaction of the drivers goes through the counted calls */
+            BENCH_CHECK(counted.transactions == wire.transactions);
+            BENCH_CHECK(counted.bytes == wire.bytes);
+            BENCH_CHECK(counted.bus_time == wire.bus_time);
+            BENCH_CHECK(counted.errors == 0 && wire.nacks == 0);
+        }
+        BENCH_CHECK(transactions <= max_transactions);
+        BENCH_CHECK(bytes <= max_bytes);
+        begin();
+    }
+
+private:
+    DevI2C &dev;
+    bool raw_calls;
+};
+
+/**
+ * Bus cost of a run of samples read through the DevSPI register helpers,
+ * as BenchI2C.
+ */
+class BenchSPI {
+public:
+    BenchSPI() {
+        begin();
+    }
+
+    void begin() {
+        DevSPI::reset_stats();
+        SimSPIBus::instance().reset_stats();
+    }
+
+    void end(const char *what, uint32_t samples, float max_transactions, float max_bytes) {
+        DevSPIStats counted;
+        SimBusStats wire;
+
+        DevSPI::get_stats(&counted);
+        SimSPIBus::instance().get_stats(&wire);
+
+        float transactions = (float)wire.transactions / samples;
+        float bytes = (float)wire.bytes / samples;
+
+        printf("  %-44s %6.2f transactions %7.2f bytes %9.1f us per sample\n", what,
+               transactions, bytes, wire.bus_time / 1000.0 / samples);
+
+        BENCH_CHECK(counted.transactions == wire.transactions);
+        BENCH_CHECK(counted.bytes == wire.bytes);
+        BENCH_CHECK(transactions <= max_transactions);
+        BENCH_CHECK(bytes <= max_bytes);
+        begin();
+    }
+};
+
+#endif // __SIM_BENCH_H__
@@ -0,0 +1,93 @@
+/**
+ ******************************************************************************
+ * @file    SimCheck.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Checks shared by the benchmarks and tests.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SIM_CHECK_H__
+#define __SIM_CHECK_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <math.h>
+
+/* Variables -----------------------------------------------------------------*/
+
+/* Checks failed so far; each benchmark or test is one translation unit */
+static int bench_failures = 0;
+
+/* Macros --------------------------------------------------------------------*/
+
+#define BENCH_CHECK(cond) \
+    bench_check((cond), #cond, __FILE__, __LINE__)
+
+/* Checks that a driver value is within tol of the value the model was set to */
+#define BENCH_NEAR(value, expected, tol) \
+    bench_near((value), (expected), (tol), #value, __FILE__, __LINE__)
+
+/* Functions -----------------------------------------------------------------*/
+
+static inline bool bench_check(bool ok, const char *what, const char *file, int line) {
+    if (!ok) {
+        printf("FAIL %s:%d: %s\n", file, line, what);
+        bench_failures++;
+    }
+    return ok;
+}
+
+static inline bool bench_near(double value, double expected, double tol, const char *what,
+                              const char *file, int line) {
+    if (fabs(value - expected) > tol) {
+        printf("FAIL %s:%d: %s is %g, expected %g +/- %g\n", file, line, what, value, expected, tol);
+        bench_failures++;
+        return false;
+    }
+    return true;
+}
+
+/* Prints the result, to be returned by main() */
+static inline int bench_report(const char *name) {
+    if (bench_failures) {
+        printf("%s: %d check(s) failed\n", name, bench_failures);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+#endif // __SIM_CHECK_H__
@@ -0,0 +1,160 @@
+/**
+ ******************************************************************************
+ * @file    bench_hts221.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   HTS221 driver against the register model: values, calibration
+ *          cache, data ready interrupt and bus cost per sample.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SimBench.h"
+#include "SimHTS221.h"
+#include "HTS221Sensor.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define HTS221_ADDRESS              0xBE
+#define SAMPLES                     100
+
+/* Variables -----------------------------------------------------------------*/
+
+static volatile uint32_t drdy_edges = 0;
+
+/* Functions -----------------------------------------------------------------*/
+
+static void drdy_handler() {
+    drdy_edges++;
+}
+
+static void check_values(HTS221Sensor &sensor, SimHTS221 &model, float rh, float celsius) {
+    float humidity = 0, temperature = 0;
+
+    model.set_humidity(rh);
+    model.set_temperature(celsius);
+    sim_run(200000000);
+
+    BENCH_CHECK(sensor.get_humidity(&humidity) == 0);
+    BENCH_CHECK(sensor.get_temperature(&temperature) == 0);
+    /* The driver works in tenths */
+    BENCH_NEAR(humidity, rh, 0.15);
+    BENCH_NEAR(temperature, celsius, 0.15);
+}
+
+static void bench_i2c() {
+    SimHTS221 model(SIM_PIN_0);
+    DevI2C i2c(I2C_SDA, I2C_SCL);
+    HTS221Sensor sensor(&i2c, HTS221_ADDRESS, SIM_PIN_0);
+    uint8_t id = 0;
+    float value;
+
+    printf("HTS221 over I2C\n");
+    model.attach_i2c(HTS221_ADDRESS);
+
+    BENCH_CHECK(sensor.init(NULL) == 0);
+    BENCH_CHECK(sensor.read_id(&id) == 0 && id == 0xBC);
+    BENCH_CHECK(sensor.set_odr(12.5f) == 0);
+    BENCH_CHECK(sensor.enable() == 0);
+
+    check_values(sensor, model, 45.0f, 22.5f);
+    check_values(sensor, model, 82.3f, -4.7f);
+
+    /* The calibration was read by init(): a sample is one read of each output */
+    BenchI2C bench(i2c);
+    for (int i = 0; i < SAMPLES; i++) {
+        sim_run(80000000);
+        sensor.get_humidity(&value);
+        sensor.get_temperature(&value);
+    }
+    bench.end("get_humidity + get_temperature", SAMPLES, 2, 10);
+
+    /* A reboot reloads the calibration, and so does the driver */
+    BENCH_CHECK(sensor.reset() == 0);
+    check_values(sensor, model, 51.0f, 30.2f);
+
+    /* Data ready at 12.5 Hz, read from the loop as the bindings do */
+    sensor.attach_int_irq(&drdy_handler);
+    sensor.enable_int_irq();
+    BENCH_CHECK(sensor.enable_drdy_irq() == 0);
+
+    uint32_t reads = 0;
+    bench.begin();
+    for (uint64_t end = SimClock::now() + 1000000000; SimClock::now() < end; ) {
+        sim_run(SIM_STEP_NS);
+        if (drdy_edges != reads) {
+            reads = drdy_edges;
+            sensor.get_humidity(&value);
+            sensor.get_temperature(&value);
+        }
+    }
+    BENCH_CHECK(reads >= 12 && reads <= 13);
+    bench.end("get_humidity + get_temperature on DRDY", reads, 2, 10);
+    sensor.disable_int_irq();
+}
+
+static void bench_spi() {
+    SimHTS221 model;
+    SPI spi(SPI_MOSI, NC, SPI_SCK);
+    HTS221Sensor sensor(&spi, SPI_CS);
+    uint8_t id = 0;
+    float value;
+
+    printf("HTS221 over 3-wire SPI\n");
+    model.attach_spi(SPI_CS);
+    SimSPIBus::instance().set_three_wire(true);
+
+    BENCH_CHECK(sensor.init(NULL) == 0);
+    BENCH_CHECK(sensor.read_id(&id) == 0 && id == 0xBC);
+    BENCH_CHECK(sensor.set_odr(12.5f) == 0);
+    BENCH_CHECK(sensor.enable() == 0);
+
+    /* Multiple byte reads, the calibration included, need the MS bit */
+    check_values(sensor, model, 37.5f, 18.0f);
+
+    BenchSPI bench;
+    for (int i = 0; i < SAMPLES; i++) {
+        sim_run(80000000);
+        sensor.get_humidity(&value);
+        sensor.get_temperature(&value);
+    }
+    bench.end("get_humidity + get_temperature", SAMPLES, 2, 6);
+
+    SimSPIBus::instance().set_three_wire(false);
+}
+
+int main() {
+    bench_i2c();
+    bench_spi();
+    return bench_report("bench_hts221");
+}
@@ -0,0 +1,215 @@
+/**
+ ******************************************************************************
+ * @file    bench_lps22hb.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   LPS22HB driver against the register model: values, pressure
+ *          offset, FIFO bursts and bus cost per sample.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SimBench.h"
+#include "SimLPS22HB.h"
+#include "LPS22HBSensor.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define SAMPLES                     100
+
+/* Variables -----------------------------------------------------------------*/
+
+static volatile uint32_t int_edges = 0;
+
+/* Functions -----------------------------------------------------------------*/
+
+static void int_handler() {
+    int_edges++;
+}
+
+static void check_values(LPS22HBSensor &sensor, SimLPS22HB &model, float hpa, float celsius) {
+    float pressure = 0, temperature = 0;
+
+    model.set_pressure(hpa);
+    model.set_temperature(celsius);
+    sim_run(100000000);
+
+    BENCH_CHECK(sensor.get_pressure(&pressure) == 0);
+    BENCH_CHECK(sensor.get_temperature(&temperature) == 0);
+    BENCH_NEAR(pressure, hpa, 0.015);
+    BENCH_NEAR(temperature, celsius, 0.15);
+
+    BENCH_CHECK(sensor.get_pressure_temperature(&pressure, &temperature) == 0);
+    BENCH_NEAR(pressure, hpa, 0.015);
+    BENCH_NEAR(temperature, celsius, 0.15);
+}
+
+static void bench_i2c() {
+    SimLPS22HB model(SIM_PIN_0);
+    DevI2C i2c(I2C_SDA, I2C_SCL);
+    LPS22HBSensor sensor(&i2c, LPS22HB_ADDRESS_HIGH, SIM_PIN_0);
+    float pressure[32], temperature[32];
+    uint8_t id = 0, level = 0, flags = 0;
+
+    printf("LPS22HB over I2C\n");
+    model.attach_i2c(LPS22HB_ADDRESS_HIGH);
+
+    BENCH_CHECK(sensor.init(NULL) == 0);
+    BENCH_CHECK(sensor.read_id(&id) == 0 && id == 0xB1);
+    BENCH_CHECK(sensor.set_odr(25.0f) == 0);
+    BENCH_CHECK(sensor.enable() == 0);
+
+    check_values(sensor, model, 1013.25f, 22.5f);
+    check_values(sensor, model, 871.6f, -12.4f);
+
+    BenchI2C bench(i2c);
+    for (int i = 0; i < SAMPLES; i++) {
+        sim_run(40000000);
+        sensor.get_pressure(pressure);
+        sensor.get_temperature(temperature);
+    }
+    bench.end("get_pressure + get_temperature", SAMPLES, 2, 11);
+
+    for (int i = 0; i < SAMPLES; i++) {
+        sim_run(40000000);
+        sensor.get_pressure_temperature(pressure, temperature);
+    }
+    bench.end("get_pressure_temperature", SAMPLES, 1, 8);
+
+    /* One point calibration: RPDS takes the offset out, in 1/16 hPa */
+    model.set_pressure(1001.5f);
+    model.set_offset(1.5f);
+    sim_run(100000000);
+    sensor.get_pressure(pressure);
+    BENCH_NEAR(pressure[0], 1001.5f + 1.5f, 0.015);
+    BENCH_CHECK(sensor.write_reg(0x18, 24) == 0 && sensor.write_reg(0x19, 0) == 0);
+    check_values(sensor, model, 1001.5f, 20.0f);
+
+    /* Stream mode: a second of samples in one burst */
+    BENCH_CHECK(sensor.enable_fifo(2, 16) == 0);
+    sim_run(1000000000);
+    BENCH_CHECK(sensor.get_fifo_status(&level, &flags) == 0);
+    BENCH_CHECK(level == 25 && flags == 0x80);
+    bench.begin();
+    BENCH_CHECK(sensor.get_fifo_data(pressure, temperature, level) == 0);
+    bench.end("get_fifo_data, 25 samples", level, 0.04f, 5.12f);
+    for (int i = 0; i < 25; i++) {
+        BENCH_NEAR(pressure[i], 1001.5f, 0.001);
+        BENCH_NEAR(temperature[i], 20.0f, 0.01);
+    }
+    /* A new sample may have come in during the burst */
+    BENCH_CHECK(sensor.get_fifo_status(&level, &flags) == 0 && level <= 1 && flags == 0);
+
+    /* Left alone the FIFO fills up and the oldest samples are dropped */
+    sim_run(2000000000);
+    BENCH_CHECK(sensor.get_fifo_status(&level, &flags) == 0);
+    BENCH_CHECK(level == 32 && flags == 0xC0);
+    BENCH_CHECK(sensor.disable_fifo() == 0);
+    BENCH_CHECK(model.get_fifo_level() == 0);
+
+    /* Data ready at 25 Hz, read from the loop as the bindings do */
+    sensor.attach_int_irq(&int_handler);
+    sensor.enable_int_irq();
+    BENCH_CHECK(sensor.enable_drdy_irq() == 0);
+    sensor.get_pressure_temperature(pressure, temperature);
+
+    uint32_t reads = 0;
+    bench.begin();
+    for (uint64_t end = SimClock::now() + 1000000000; SimClock::now() < end; ) {
+        sim_run(SIM_STEP_NS);
+        if (int_edges != reads) {
+            reads = int_edges;
+            sensor.get_pressure_temperature(pressure, temperature);
+        }
+    }
+    BENCH_CHECK(reads >= 24 && reads <= 26);
+    bench.end("get_pressure_temperature on DRDY", reads, 1, 8);
+    sensor.disable_int_irq();
+    BENCH_CHECK(sensor.disable_drdy_irq() == 0);
+
+    /* Stream mode drained on the watermark interrupt: 16 samples a batch */
+    BENCH_CHECK(sensor.enable_fifo(2, 16) == 0);
+    BENCH_CHECK(sensor.enable_fifo_watermark_irq() == 0);
+    sensor.enable_int_irq();
+
+    uint32_t batches = 0, samples = 0;
+    reads = int_edges;
+    bench.begin();
+    for (uint64_t end = SimClock::now() + 2000000000; SimClock::now() < end; ) {
+        sim_run(SIM_STEP_NS);
+        if (int_edges != reads) {
+            reads = int_edges;
+            BENCH_CHECK(sensor.get_fifo_status(&level, &flags) == 0);
+            BENCH_CHECK(level >= 16 && (flags & 0x80));
+            BENCH_CHECK(sensor.get_fifo_data(pressure, temperature, level) == 0);
+            batches++;
+            samples += level;
+        }
+    }
+    BENCH_CHECK(batches == 3 && samples >= 48);
+    bench.end("get_fifo_data on FIFO watermark", samples, 0.13f, 5.5f);
+    sensor.disable_int_irq();
+    BENCH_CHECK(sensor.disable_fifo_watermark_irq() == 0);
+    BENCH_CHECK(sensor.disable_fifo() == 0);
+}
+
+static void bench_spi() {
+    SimLPS22HB model;
+    SPI spi(SPI_MOSI, SPI_MISO, SPI_SCK);
+    LPS22HBSensor sensor(&spi, SPI_CS);
+    float pressure, temperature;
+    uint8_t id = 0;
+
+    printf("LPS22HB over 4-wire SPI\n");
+    model.attach_spi(SPI_CS);
+
+    BENCH_CHECK(sensor.init(NULL) == 0);
+    BENCH_CHECK(sensor.read_id(&id) == 0 && id == 0xB1);
+    BENCH_CHECK(sensor.set_odr(25.0f) == 0);
+    BENCH_CHECK(sensor.enable() == 0);
+
+    check_values(sensor, model, 1024.75f, 31.3f);
+
+    BenchSPI bench;
+    for (int i = 0; i < SAMPLES; i++) {
+        sim_run(40000000);
+        sensor.get_pressure_temperature(&pressure, &temperature);
+    }
+    bench.end("get_pressure_temperature", SAMPLES, 1, 6);
+}
+
+int main() {
+    bench_i2c();
+    bench_spi();
+    return bench_report("bench_lps22hb");
+}
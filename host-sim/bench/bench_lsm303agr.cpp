@@ -0,0 +1,231 @@
+/**
+ ******************************************************************************
+ * @file    bench_lsm303agr.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   LSM303AGR drivers against the register models: values, modes,
+ *          FIFO bursts, hard-iron offset and bus cost per sample.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SimBench.h"
+#include "SimLSM303AGR.h"
+#include "LSM303AGRAccSensor.h"
+#include "LSM303AGRMagSensor.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define SAMPLES                     100
+
+/* Variables -----------------------------------------------------------------*/
+
+static volatile uint32_t int1_edges = 0;
+
+/* Functions -----------------------------------------------------------------*/
+
+static void int1_handler() {
+    int1_edges++;
+}
+
+/* tol is the sensitivity of the mode, in mg */
+static void check_acceleration(LSM303AGRAccSensor &sensor, SimLSM303AGRAcc &model,
+                               float x, float y, float z, float tol) {
+    int32_t axes[3] = { 0, 0, 0 };
+
+    model.set_acceleration(x, y, z);
+    sim_run(20000000);
+
+    BENCH_CHECK(sensor.get_x_axes(axes) == 0);
+    BENCH_NEAR(axes[0], x, tol);
+    BENCH_NEAR(axes[1], y, tol);
+    BENCH_NEAR(axes[2], z, tol);
+}
+
+static void check_field(LSM303AGRMagSensor &sensor, SimLSM303AGRMag &model,
+                        float x, float y, float z, float offset) {
+    int32_t axes[3] = { 0, 0, 0 };
+
+    model.set_field(x, y, z);
+    sim_run(20000000);
+
+    /* Even multiples of the 1.5 mG step come out exactly */
+    BENCH_CHECK(sensor.get_m_axes(axes) == 0);
+    BENCH_NEAR(axes[0], x - offset, 0);
+    BENCH_NEAR(axes[1], y - offset, 0);
+    BENCH_NEAR(axes[2], z - offset, 0);
+}
+
+static void bench_acc_i2c(DevI2C &i2c) {
+    SimLSM303AGRAcc model(SIM_PIN_0);
+    LSM303AGRAccSensor sensor(&i2c, LSM303AGR_ACC_I2C_ADDRESS, SIM_PIN_0);
+    int32_t axes[3 * 32];
+    uint8_t id = 0, level = 0, flags = 0;
+
+    printf("LSM303AGR accelerometer over I2C\n");
+    model.attach_i2c(LSM303AGR_ACC_I2C_ADDRESS);
+
+    BENCH_CHECK(sensor.init(NULL) == 0);
+    BENCH_CHECK(sensor.read_id(&id) == 0 && id == 0x33);
+    BENCH_CHECK(sensor.set_x_odr(100.0f) == 0);
+    BENCH_CHECK(sensor.enable() == 0);
+
+    /* Normal mode, 10 bits */
+    check_acceleration(sensor, model, 0.0f, 0.0f, 1000.0f, 3.9f);
+    check_acceleration(sensor, model, -523.0f, 1240.0f, -87.0f, 3.9f);
+    /* Beyond 2 g the outputs saturate, 4 g fits */
+    BENCH_CHECK(sensor.set_x_fs(4.0f) == 0);
+    check_acceleration(sensor, model, 3100.0f, -2750.0f, 12.0f, 7.82f);
+    BENCH_CHECK(sensor.set_x_fs(2.0f) == 0);
+    model.set_acceleration(-523.0f, 1240.0f, -87.0f);
+
+    /* The first read after a full scale change reloads the scale */
+    sensor.get_x_axes(axes);
+
+    BenchI2C bench(i2c);
+    for (int i = 0; i < SAMPLES; i++) {
+        sim_run(10000000);
+        sensor.get_x_axes(axes);
+    }
+    bench.end("get_x_axes", SAMPLES, 1, 9);
+
+    /* Stream mode: a quarter of a second at 100 Hz in one burst */
+    BENCH_CHECK(sensor.set_fifo_watermark_level(16) == 0);
+    BENCH_CHECK(sensor.set_fifo_mode(2) == 0);
+    sim_run(250000000);
+    BENCH_CHECK(sensor.get_fifo_status(&level, &flags) == 0);
+    BENCH_CHECK(level == 25 && flags == 0x80);
+    bench.begin();
+    BENCH_CHECK(sensor.get_fifo_data(axes, level) == 0);
+    bench.end("get_fifo_data, 25 samples", level, 0.04f, 6.12f);
+    for (int i = 0; i < 25; i++) {
+        BENCH_NEAR(axes[3 * i], -523.0f, 3.9f);
+        BENCH_NEAR(axes[3 * i + 1], 1240.0f, 3.9f);
+        BENCH_NEAR(axes[3 * i + 2], -87.0f, 3.9f);
+    }
+
+    /* Left alone it fills up: FSS stops at 31, the overrun flag tells 32 */
+    sim_run(1000000000);
+    BENCH_CHECK(sensor.get_fifo_status(&level, &flags) == 0);
+    BENCH_CHECK(level == 32 && (flags & 0x40));
+    BENCH_CHECK(sensor.set_fifo_mode(0) == 0);
+    BENCH_CHECK(model.get_fifo_level() == 0);
+
+    /* Data ready at 100 Hz, read from the loop as the bindings do */
+    sensor.attach_int1_irq(&int1_handler);
+    sensor.enable_int1_irq();
+    BENCH_CHECK(sensor.set_int1_drdy(1) == 0);
+    sensor.get_x_axes(axes);
+
+    uint32_t reads = 0;
+    bench.begin();
+    for (uint64_t end = SimClock::now() + 1000000000; SimClock::now() < end; ) {
+        sim_run(SIM_STEP_NS);
+        if (int1_edges != reads) {
+            reads = int1_edges;
+            sensor.get_x_axes(axes);
+        }
+    }
+    BENCH_CHECK(reads >= 99 && reads <= 101);
+    bench.end("get_x_axes on INT1 data ready", reads, 1, 9);
+    sensor.set_int1_drdy(0);
+    sensor.disable_int1_irq();
+}
+
+static void bench_mag_i2c(DevI2C &i2c) {
+    SimLSM303AGRMag model;
+    LSM303AGRMagSensor sensor(&i2c, LSM303AGR_MAG_I2C_ADDRESS);
+    int32_t axes[3];
+    uint8_t id = 0;
+
+    printf("LSM303AGR magnetometer over I2C\n");
+    model.attach_i2c(LSM303AGR_MAG_I2C_ADDRESS);
+
+    BENCH_CHECK(sensor.init(NULL) == 0);
+    BENCH_CHECK(sensor.read_id(&id) == 0 && id == 0x40);
+    BENCH_CHECK(sensor.enable() == 0);
+
+    check_field(sensor, model, 300.0f, -150.0f, 450.0f, 0.0f);
+
+    /* Hard-iron offset of 100 LSB on each axis, subtracted by the part */
+    for (uint8_t reg = 0x45; reg <= 0x4A; reg += 2) {
+        BENCH_CHECK(sensor.write_reg(reg, 100) == 0 && sensor.write_reg(reg + 1, 0) == 0);
+    }
+    check_field(sensor, model, 300.0f, -150.0f, 450.0f, 150.0f);
+
+    BenchI2C bench(i2c);
+    for (int i = 0; i < SAMPLES; i++) {
+        sim_run(10000000);
+        sensor.get_m_axes(axes);
+    }
+    bench.end("get_m_axes", SAMPLES, 1, 9);
+}
+
+static void bench_acc_spi() {
+    SimLSM303AGRAcc model;
+    SPI spi(SPI_MOSI, NC, SPI_SCK);
+    int32_t axes[3];
+    uint8_t id = 0;
+
+    printf("LSM303AGR accelerometer over 3-wire SPI\n");
+    model.attach_spi(SPI_CS);
+    SimSPIBus::instance().set_three_wire(true);
+
+    LSM303AGRAccSensor sensor(&spi, SPI_CS);
+    BENCH_CHECK(sensor.init(NULL) == 0);
+    BENCH_CHECK(sensor.read_id(&id) == 0 && id == 0x33);
+    BENCH_CHECK(sensor.set_x_odr(100.0f) == 0);
+    BENCH_CHECK(sensor.enable() == 0);
+
+    check_acceleration(sensor, model, 12.0f, -980.0f, 140.0f, 3.9f);
+
+    BenchSPI bench;
+    for (int i = 0; i < SAMPLES; i++) {
+        sim_run(10000000);
+        sensor.get_x_axes(axes);
+    }
+    bench.end("get_x_axes", SAMPLES, 1, 7);
+
+    SimSPIBus::instance().set_three_wire(false);
+}
+
+int main() {
+    DevI2C i2c(I2C_SDA, I2C_SCL);
+
+    /* 400 kHz, as on the X-NUCLEO-IKS01A2 examples */
+    i2c.frequency(400000);
+    bench_acc_i2c(i2c);
+    bench_mag_i2c(i2c);
+    bench_acc_spi();
+    return bench_report("bench_lsm303agr");
+}
@@ -0,0 +1,245 @@
+/**
+ ******************************************************************************
+ * @file    bench_lsm6dsl.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   LSM6DSL driver and FIFO stream against the register model: values,
+ *          user offsets, FIFO pattern, streaming and bus cost per sample.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SimBench.h"
+#include "SimLSM6DSL.h"
+#include "LSM6DSLSensor.h"
+#include "LSM6DSLStream.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define SAMPLES                     100
+#define STREAM_ODR                  104.0f
+#define STREAM_BLOCK                13
+
+/* Variables -----------------------------------------------------------------*/
+
+static volatile uint32_t int1_edges = 0;
+static volatile bool stream_ready = false;
+
+/* Functions -----------------------------------------------------------------*/
+
+static void int1_handler() {
+    int1_edges++;
+}
+
+static void ready_handler() {
+    stream_ready = true;
+}
+
+static void check_motion(LSM6DSLSensor &sensor, SimLSM6DSL &model, float ax, float ay, float az,
+                         float gx, float gy, float gz) {
+    int32_t acc[3] = { 0, 0, 0 }, gyro[3] = { 0, 0, 0 };
+
+    model.set_acceleration(ax, ay, az);
+    model.set_angular_rate(gx, gy, gz);
+    sim_run(20000000);
+
+    /* One LSB at 2 g and 2000 dps, and the driver truncating to units */
+    BENCH_CHECK(sensor.get_x_g_axes(acc, gyro) == 0);
+    BENCH_NEAR(acc[0], ax, 1.061f);
+    BENCH_NEAR(acc[1], ay, 1.061f);
+    BENCH_NEAR(acc[2], az, 1.061f);
+    BENCH_NEAR(gyro[0], gx, 71.0f);
+    BENCH_NEAR(gyro[1], gy, 71.0f);
+    BENCH_NEAR(gyro[2], gz, 71.0f);
+}
+
+/* Streams for a second and checks that every data set arrives once, in order */
+static void check_stream(LSM6DSLSensor &sensor, SimLSM6DSL &model, BenchI2C &bench, bool use_int1,
+                         const char *what, float max_transactions, float max_bytes) {
+    LSM6DSLStream stream(&sensor, use_int1);
+    int16_t samples[STREAM_BLOCK * 4][LSM6DSL_STREAM_AXES];
+    uint32_t received = 0;
+    bool in_order = true;
+
+    model.set_counting(true);
+    stream_ready = false;
+    BENCH_CHECK(stream.start(STREAM_ODR, 1, STREAM_BLOCK, callback(&ready_handler)) == 0);
+
+    bench.begin();
+    for (uint64_t end = SimClock::now() + 1000000000; SimClock::now() < end; ) {
+        sim_run(SIM_STEP_NS);
+        if (!stream_ready) {
+            continue;
+        }
+        stream.acknowledge();
+        stream_ready = false;
+
+        size_t n = stream.read(&samples[0][0], STREAM_BLOCK * 4);
+        for (size_t i = 0; i < n; i++, received++) {
+            /* Accelerometer then gyroscope, each counting data sets */
+            if (samples[i][0] != (int16_t)received || samples[i][3] != (int16_t)received) {
+                in_order = false;
+            }
+        }
+    }
+    bench.end(what, received, max_transactions, max_bytes);
+    BENCH_CHECK(in_order);
+    BENCH_CHECK(stream.get_lost() == 0 && stream.get_overruns() == 0);
+    /* 104 samples, less those of the last block still in the FIFO */
+    BENCH_CHECK(received >= 104 - 2 * STREAM_BLOCK && received <= 104);
+    BENCH_CHECK(stream.stop() == 0);
+    model.set_counting(false);
+}
+
+static void bench_i2c(DevI2C &i2c) {
+    SimLSM6DSL model(SIM_PIN_0);
+    LSM6DSLSensor sensor(&i2c, LSM6DSL_ACC_GYRO_I2C_ADDRESS_HIGH, SIM_PIN_0);
+    int32_t acc[3], gyro[3];
+    int16_t words[6];
+    uint16_t level = 0, pattern = 0;
+    uint8_t id = 0, flags = 0;
+
+    printf("LSM6DSL over I2C\n");
+    model.attach_i2c(LSM6DSL_ACC_GYRO_I2C_ADDRESS_HIGH);
+
+    BENCH_CHECK(sensor.init(NULL) == 0);
+    BENCH_CHECK(sensor.read_id(&id) == 0 && id == 0x6A);
+    BENCH_CHECK(sensor.set_x_odr(104.0f) == 0 && sensor.set_g_odr(104.0f) == 0);
+    BENCH_CHECK(sensor.enable_x() == 0 && sensor.enable_g() == 0);
+
+    check_motion(sensor, model, 0.0f, 0.0f, 1000.0f, 0.0f, 0.0f, 0.0f);
+    check_motion(sensor, model, -412.0f, 733.0f, 180.0f, 35000.0f, -7000.0f, 1400.0f);
+
+    BenchI2C bench(i2c);
+    for (int i = 0; i < SAMPLES; i++) {
+        sim_run(10000000);
+        sensor.get_x_axes(acc);
+        sensor.get_g_axes(gyro);
+    }
+    bench.end("get_x_axes + get_g_axes", SAMPLES, 2, 18);
+    for (int i = 0; i < SAMPLES; i++) {
+        sim_run(10000000);
+        sensor.get_x_g_axes(acc, gyro);
+    }
+    bench.end("get_x_g_axes", SAMPLES, 1, 15);
+
+    /* User offset of 20 x 2^-10 g on x, subtracted by the part */
+    BENCH_CHECK(sensor.write_reg(0x73, 20) == 0);
+    sim_run(20000000);
+    BENCH_CHECK(sensor.get_x_axes(acc) == 0);
+    BENCH_NEAR(acc[0], -412.0f - 20 * 1000.0f / 1024, 1.061f);
+    BENCH_CHECK(sensor.write_reg(0x73, 0) == 0);
+
+    /* FIFO at 104 Hz: a data set is the gyroscope then the accelerometer,
+       and the pattern tells where in it the next word read is */
+    BENCH_CHECK(sensor.set_fifo_x_decimation(1) == 0 && sensor.set_fifo_g_decimation(1) == 0);
+    BENCH_CHECK(sensor.set_fifo_odr(104.0f) == 0);
+    BENCH_CHECK(sensor.set_fifo_watermark_level(60) == 0);
+    BENCH_CHECK(sensor.set_fifo_mode(LSM6DSL_ACC_GYRO_FIFO_MODE_FIFO) == 0);
+    sim_run(100000000);
+    BENCH_CHECK(sensor.get_fifo_status(&level, &pattern, &flags) == 0);
+    BENCH_CHECK(level == 60 && pattern == 0 && flags == LSM6DSL_ACC_GYRO_WTM_MASK);
+    BENCH_CHECK(sensor.get_fifo_data(words, 2) == 0);
+    BENCH_CHECK(sensor.get_fifo_status(&level, &pattern, &flags) == 0);
+    BENCH_CHECK(level == 58 && pattern == 2 && flags == 0);
+    BENCH_CHECK(sensor.get_fifo_data(words, 6) == 0);
+    BENCH_NEAR(words[2] * 0.061f, 733.0f, 0.061f);
+
+    /* FIFO mode stops when the next data set does not fit */
+    sim_run(4000000000ULL);
+    BENCH_CHECK(sensor.get_fifo_status(&level, &pattern, &flags) == 0);
+    BENCH_CHECK(level > 2048 - 6 && (flags & LSM6DSL_ACC_GYRO_FIFO_FULL_MASK));
+    BENCH_CHECK(sensor.set_fifo_mode(LSM6DSL_ACC_GYRO_FIFO_MODE_BYPASS) == 0);
+    BENCH_CHECK(model.get_fifo_level() == 0);
+
+    /* Pulsed data ready at 104 Hz, read from the loop as the bindings do */
+    sensor.attach_int1_irq(&int1_handler);
+    sensor.enable_int1_irq();
+    BENCH_CHECK(sensor.set_int1_drdy(1) == 0);
+
+    /* The first read after a register write reloads the sensitivity */
+    sensor.get_x_axes(acc);
+
+    uint32_t reads = 0;
+    bench.begin();
+    for (uint64_t end = SimClock::now() + 1000000000; SimClock::now() < end; ) {
+        sim_run(SIM_STEP_NS);
+        if (int1_edges != reads) {
+            reads = int1_edges;
+            sensor.get_x_axes(acc);
+        }
+    }
+    BENCH_CHECK(reads >= 103 && reads <= 105);
+    bench.end("get_x_axes on INT1 data ready", reads, 1, 9);
+    BENCH_CHECK(sensor.set_int1_drdy(0) == 0);
+    sensor.disable_int1_irq();
+
+    /* Streams, on the watermark interrupt then polled */
+    check_stream(sensor, model, bench, true, "LSM6DSLStream on INT1", 0.25f, 13.5f);
+    check_stream(sensor, model, bench, false, "LSM6DSLStream polled", 0.5f, 16.0f);
+}
+
+static void bench_spi() {
+    SimLSM6DSL model;
+    SPI spi(SPI_MOSI, SPI_MISO, SPI_SCK);
+    int32_t acc[3], gyro[3];
+    uint8_t id = 0;
+
+    printf("LSM6DSL over 4-wire SPI\n");
+    model.attach_spi(SPI_CS);
+
+    LSM6DSLSensor sensor(&spi, SPI_CS);
+    BENCH_CHECK(sensor.init(NULL) == 0);
+    BENCH_CHECK(sensor.read_id(&id) == 0 && id == 0x6A);
+    BENCH_CHECK(sensor.set_x_odr(104.0f) == 0 && sensor.set_g_odr(104.0f) == 0);
+    BENCH_CHECK(sensor.enable_x() == 0 && sensor.enable_g() == 0);
+
+    check_motion(sensor, model, 250.0f, -950.0f, 60.0f, -2100.0f, 700.0f, 0.0f);
+
+    BenchSPI bench;
+    for (int i = 0; i < SAMPLES; i++) {
+        sim_run(10000000);
+        sensor.get_x_g_axes(acc, gyro);
+    }
+    bench.end("get_x_g_axes", SAMPLES, 1, 13);
+}
+
+int main() {
+    DevI2C i2c(I2C_SDA, I2C_SCL);
+
+    /* 400 kHz, as on the X-NUCLEO-IKS01A2 examples */
+    i2c.frequency(400000);
+    bench_i2c(i2c);
+    bench_spi();
+    return bench_report("bench_lsm6dsl");
+}
@@ -0,0 +1,151 @@
+/**
+ ******************************************************************************
+ * @file    bench_m24lr.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   M24LR driver and NDEF tag against the EEPROM model: row writes,
+ *          write cycle polling, system registers and bus cost per byte.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <string.h>
+#include "SimBench.h"
+#include "SimM24LR.h"
+#include "M24LR.h"
+#include "Message.h"
+#include "RecordType/RecordURI.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define BLOCK_SIZE                  64
+#define BLOCK_OFFSET                0x0102
+#define READ_SIZE                   256
+
+/* Functions -----------------------------------------------------------------*/
+
+static void check_system(M24LR &tag, SimM24LR &model) {
+    M24LR_Mem_Size size;
+    M24LR_UID uid;
+    uint8_t id = 0;
+
+    BENCH_CHECK(tag.read_id(&id) == 0 && id == I_AM_M24LR64);
+    BENCH_CHECK(tag.i2c_read_mem_size(&size) == NFCTAG_OK);
+    BENCH_CHECK(size.Mem_Size == 0x07FF && size.BlockSize == 3);
+    BENCH_CHECK(tag.i2c_read_UID(&uid) == NFCTAG_OK);
+    BENCH_CHECK(uid.MSB_UID == 0xE0022C00);
+
+    /* Energy harvesting: three system register writes, each a write cycle */
+    uint32_t cycles = model.get_write_cycles();
+    M24LR_EH_STATUS eh = M24LR_EH_DISABLE;
+    tag.enable_energy_harvesting();
+    BENCH_CHECK(model.get_write_cycles() == cycles + 3);
+    BENCH_CHECK(tag.i2c_get_EH(&eh) == NFCTAG_OK && eh == M24LR_EH_ENABLE);
+}
+
+static void bench_memory(DevI2C &i2c, M24LR &tag, SimM24LR &model) {
+    uint8_t block[BLOCK_SIZE], readback[READ_SIZE];
+
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        block[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    /* Unaligned: 2 bytes to the end of the first row, 15 rows, then 2 bytes */
+    BenchI2C bench(i2c, true);
+    uint32_t cycles = model.get_write_cycles();
+    uint64_t start = SimClock::now();
+    BENCH_CHECK(tag.i2c_write_data(block, BLOCK_OFFSET, BLOCK_SIZE) == NFCTAG_OK);
+    BENCH_CHECK(model.get_write_cycles() == cycles + 17);
+    BENCH_CHECK(SimClock::now() - start >= 17ULL * SIM_M24LR_WRITE_TIME_NS);
+    printf("  i2c_write_data, %d bytes                     %9.1f ms\n", BLOCK_SIZE,
+           (SimClock::now() - start) / 1e6);
+    /* The driver polls the busy part without waiting: the unacknowledged
+       polls of the 17 write cycles dominate */
+    bench.end("i2c_write_data, per byte", BLOCK_SIZE, 50.0f, 52.0f);
+
+    BENCH_CHECK(model.peek(BLOCK_OFFSET - 1) == 0xFF);
+    BENCH_CHECK(model.peek(BLOCK_OFFSET + BLOCK_SIZE) == 0xFF);
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        BENCH_CHECK(model.peek(BLOCK_OFFSET + i) == block[i]);
+    }
+
+    /* One register read, after the readiness poll */
+    BENCH_CHECK(tag.i2c_read_data(readback, BLOCK_OFFSET, READ_SIZE) == NFCTAG_OK);
+    bench.end("i2c_read_data, per byte", READ_SIZE, 0.01f, 1.03f);
+    BENCH_CHECK(memcmp(readback, block, BLOCK_SIZE) == 0);
+}
+
+static void bench_ndef(DevI2C &i2c, M24LR &tag) {
+    NDefLib::NDefNfcTag &ndef = tag.get_NDef_tag();
+    const std::string content = "st.com/en/nfc/m24lr64e-r.html";
+
+    BENCH_CHECK(ndef.open_session());
+
+    BenchI2C bench(i2c, true);
+    NDefLib::Message msg;
+    NDefLib::RecordURI uri(NDefLib::RecordURI::HTTP_WWW, content);
+    msg.add_record(&uri);
+    uint16_t length = msg.get_byte_length();
+    BENCH_CHECK(ndef.write(msg));
+    bench.end("NDEF URI write, per message byte", length, 62.0f, 65.0f);
+
+    NDefLib::Message read;
+    BENCH_CHECK(ndef.read(&read));
+    bench.end("NDEF URI read, per message byte", length, 0.4f, 3.0f);
+    BENCH_CHECK(read.get_N_records() == 1);
+    if (read.get_N_records() == 1) {
+        NDefLib::RecordURI *record = (NDefLib::RecordURI *)read[0];
+        BENCH_CHECK(record->get_uri_id() == NDefLib::RecordURI::HTTP_WWW);
+        BENCH_CHECK(record->get_content() == content);
+        delete record;
+    }
+
+    BENCH_CHECK(ndef.close_session());
+}
+
+int main() {
+    DevI2C i2c(I2C_SDA, I2C_SCL);
+    SimM24LR model;
+    M24LR tag(M24LR_ADDR_SYST_I2C, M24LR_ADDR_DATA_I2C, i2c);
+
+    /* 400 kHz, as on the X-NUCLEO-NFC02A1 examples */
+    i2c.frequency(400000);
+    model.attach_i2c(M24LR_ADDR_DATA_I2C, M24LR_ADDR_SYST_I2C);
+
+    printf("M24LR64 over I2C\n");
+    BENCH_CHECK(tag.initialization() == NFCTAG_OK);
+    check_system(tag, model);
+    bench_memory(i2c, tag, model);
+    bench_ndef(i2c, tag);
+    return bench_report("bench_m24lr");
+}
@@ -0,0 +1,377 @@
+/**
+ ******************************************************************************
+ * @file    mbed.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Host stand-in for the parts of the Mbed OS API used by the drivers,
+ *          backed by the simulated buses.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __HOST_SIM_MBED_H__
+#define __HOST_SIM_MBED_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <arpa/inet.h>
+#include <functional>
+#include <vector>
+
+/* Defines -------------------------------------------------------------------*/
+
+/** The simulated I2C bus completes every transaction synchronously. */
+#define DEVICE_I2C_ASYNCH           0
+
+/** Size of one event, for sizing an EventQueue. */
+#define EVENTS_EVENT_SIZE           64
+
+/** Memory barrier; the simulation runs on one thread. */
+#define __DMB()                     do { } while (0)
+
+/* Types ---------------------------------------------------------------------*/
+
+/** Pins of the Arduino connector, as on the Nucleo boards. */
+typedef enum {
+    D0 = 0, D1, D2, D3, D4, D5, D6, D7,
+    D8, D9, D10, D11, D12, D13, D14, D15,
+    A0, A1, A2, A3, A4, A5,
+
+    /* Chip selects and interrupt lines of the simulated devices. */
+    SIM_PIN_0, SIM_PIN_1, SIM_PIN_2, SIM_PIN_3,
+    SIM_PIN_4, SIM_PIN_5, SIM_PIN_6, SIM_PIN_7,
+    SIM_PIN_COUNT,
+
+    I2C_SDA = D14,
+    I2C_SCL = D15,
+    SPI_MOSI = D11,
+    SPI_MISO = D12,
+    SPI_SCK = D13,
+    SPI_CS = D10,
+
+    NC = -1
+} PinName;
+
+typedef enum {
+    PullNone = 0,
+    PullUp,
+    PullDown
+} PinMode;
+
+typedef enum {
+    osOK = 0,
+    osErrorResource = -3
+} osStatus;
+
+typedef enum {
+    osPriorityNormal = 24,
+    osPriorityAboveNormal = 32,
+    osPriorityHigh = 40
+} osPriority;
+
+/* Critical sections ---------------------------------------------------------*/
+
+/* Interrupt handlers run from the simulation loop, between bus transactions */
+inline void core_util_critical_section_enter(void) {}
+inline void core_util_critical_section_exit(void) {}
+
+/* Callback ------------------------------------------------------------------*/
+
+template <typename F>
+class Callback;
+
+/** Callable reference to a function or a member function of an object. */
+template <typename R, typename... Args>
+class Callback<R(Args...)> {
+public:
+    Callback() {}
+
+    Callback(R (*func)(Args...)) {
+        if (func) {
+            fn = func;
+        }
+    }
+
+    template <typename T, typename U>
+    Callback(U *obj, R (T::*method)(Args...)) {
+        fn = [obj, method](Args... args) -> R { return (obj->*method)(args...); };
+    }
+
+    template <typename T, typename U>
+    Callback(const U *obj, R (T::*method)(Args...) const) {
+        fn = [obj, method](Args... args) -> R { return (obj->*method)(args...); };
+    }
+
+    R call(Args... args) const {
+        return fn(args...);
+    }
+
+    R operator()(Args... args) const {
+        return fn(args...);
+    }
+
+    operator bool() const {
+        return (bool)fn;
+    }
+
+private:
+    std::function<R(Args...)> fn;
+};
+
+template <typename R, typename... Args>
+Callback<R(Args...)> callback(R (*func)(Args...)) {
+    return Callback<R(Args...)>(func);
+}
+
+template <typename T, typename U, typename R, typename... Args>
+Callback<R(Args...)> callback(U *obj, R (T::*method)(Args...)) {
+    return Callback<R(Args...)>(obj, method);
+}
+
+namespace mbed {
+    using ::Callback;
+    using ::callback;
+}
+
+/* Time ----------------------------------------------------------------------*/
+
+/* Waiting moves the simulated time forward; it runs no interrupt handler */
+void wait(float s);
+void wait_ms(int ms);
+void wait_us(int us);
+
+/* Digital I/O ---------------------------------------------------------------*/
+
+/** Output pin; chip selects of simulated SPI devices are driven through it. */
+class DigitalOut {
+public:
+    DigitalOut(PinName pin);
+    DigitalOut(PinName pin, int value);
+
+    void write(int value);
+    int read();
+
+    DigitalOut &operator=(int value) {
+        write(value);
+        return *this;
+    }
+
+    operator int() {
+        return read();
+    }
+
+private:
+    PinName pin;
+    int value;
+};
+
+/** Input pin raising interrupts on the edges a simulated device drives. */
+class InterruptIn {
+public:
+    InterruptIn(PinName pin);
+    ~InterruptIn();
+
+    int read();
+    void rise(Callback<void()> func);
+    void fall(Callback<void()> func);
+    void mode(PinMode pull) {}
+    void enable_irq();
+    void disable_irq();
+
+    operator int() {
+        return read();
+    }
+
+    /* Called by the simulation on an edge of the pin. */
+    void edge(int level);
+
+private:
+    PinName pin;
+    bool enabled;
+    Callback<void()> on_rise;
+    Callback<void()> on_fall;
+};
+
+/* Buses ---------------------------------------------------------------------*/
+
+class SimI2CBus;
+class SimSPIBus;
+
+/** I2C master on the simulated I2C bus. */
+class I2C {
+public:
+    enum Acknowledge {
+        NoACK = 0,
+        ACK = 1
+    };
+
+    I2C(PinName sda, PinName scl);
+    virtual ~I2C() {}
+
+    void frequency(int hz);
+    int read(int address, char *data, int length, bool repeated = false);
+    int read(int ack);
+    int write(int address, const char *data, int length, bool repeated = false);
+    int write(int data);
+    void start(void);
+    void stop(void);
+    virtual void lock(void) {}
+    virtual void unlock(void) {}
+
+protected:
+    SimI2CBus *bus;
+    int hz;
+};
+
+/** SPI master on the simulated SPI bus. */
+class SPI {
+public:
+    SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel = NC);
+    virtual ~SPI() {}
+
+    void format(int bits, int mode = 0);
+    void frequency(int hz = 1000000);
+    virtual int write(int value);
+    virtual int write(const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length);
+    virtual void lock(void) {}
+    virtual void unlock(void) {}
+
+protected:
+    SimSPIBus *bus;
+    int _bits;
+    int _mode;
+    int _hz;
+};
+
+/* Flash ---------------------------------------------------------------------*/
+
+/* Start of the application area in flash, set by the bootloader configuration
+   on the target; here the middle of the simulated flash, see SimFlash.h */
+#ifndef POST_APPLICATION_ADDR
+#define POST_APPLICATION_ADDR       0x08040000
+#endif
+
+/** In-application programming of the simulated flash; see SimFlash. */
+class FlashIAP {
+public:
+    FlashIAP();
+
+    int init();
+    int deinit();
+
+    int read(void *buffer, uint32_t addr, uint32_t size);
+    int program(const void *buffer, uint32_t addr, uint32_t size);
+    int erase(uint32_t addr, uint32_t size);
+
+    uint32_t get_page_size() const;
+    uint32_t get_sector_size(uint32_t addr) const;
+    uint32_t get_flash_start() const;
+    uint32_t get_flash_size() const;
+};
+
+/* RTOS ----------------------------------------------------------------------*/
+
+/**
+ * Event queue run by the simulation loop.
+ *
+ * Calls are queued, then run by sim_run() after the interrupts of the same
+ * step, as the thread dispatching the queue would run them on the target.
+ */
+class EventQueue {
+public:
+    EventQueue(unsigned size = 32 * EVENTS_EVENT_SIZE);
+    ~EventQueue();
+
+    template <typename T, typename U, typename... Args, typename... BoundArgs>
+    int call(U *obj, void (T::*method)(Args...), BoundArgs... args) {
+        pending.push_back([obj, method, args...]() { (obj->*method)(args...); });
+        return (int)pending.size();
+    }
+
+    template <typename... Args, typename... BoundArgs>
+    int call(void (*func)(Args...), BoundArgs... args) {
+        pending.push_back([func, args...]() { func(args...); });
+        return (int)pending.size();
+    }
+
+    void dispatch(int ms = -1);
+    void dispatch_forever() {}
+    void break_dispatch() {}
+
+    /* Runs all the queued calls, including those they queue; false if none. */
+    bool run_pending();
+
+private:
+    std::vector<std::function<void()> > pending;
+};
+
+/** Thread whose work the simulation runs in its loop; see EventQueue. */
+class Thread {
+public:
+    Thread(osPriority priority = osPriorityNormal, uint32_t stack_size = 0) {}
+
+    osStatus start(Callback<void()> task) {
+        return osOK;
+    }
+
+    osStatus join() {
+        return osOK;
+    }
+};
+
+/** Periodic interrupt on the simulated time. */
+class Ticker {
+public:
+    Ticker();
+    ~Ticker();
+
+    void attach(Callback<void()> func, float t);
+    void attach_us(Callback<void()> func, uint32_t t);
+    void detach();
+
+    /* Called by the simulation loop; fires the handler once if it is due. */
+    bool poll(uint64_t now);
+
+private:
+    Callback<void()> handler;
+    uint64_t period;
+    uint64_t next;
+};
+
+#endif // __HOST_SIM_MBED_H__
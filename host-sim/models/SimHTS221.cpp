@@ -0,0 +1,211 @@
+/**
+ ******************************************************************************
+ * @file    SimHTS221.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Register level model of the HTS221 humidity and temperature sensor.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SimHTS221.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define WHO_AM_I                    0x0F
+#define AV_CONF                     0x10
+#define CTRL_REG1                   0x20
+#define CTRL_REG2                   0x21
+#define CTRL_REG3                   0x22
+#define STATUS_REG                  0x27
+#define HUMIDITY_OUT_L              0x28
+#define HUMIDITY_OUT_H              0x29
+#define TEMP_OUT_L                  0x2A
+#define TEMP_OUT_H                  0x2B
+#define CALIB_0                     0x30
+
+#define CTRL_REG1_PD                0x80
+#define CTRL_REG1_ODR               0x03
+#define CTRL_REG2_BOOT              0x80
+#define CTRL_REG2_ONE_SHOT          0x01
+#define CTRL_REG3_DRDY_H_L          0x80
+#define CTRL_REG3_DRDY              0x04
+#define STATUS_T_DA                 0x01
+#define STATUS_H_DA                 0x02
+
+/* Factory calibration of the simulated part: rH in %, T in degrees C */
+#define CAL_H0_RH                   30
+#define CAL_H1_RH                   70
+#define CAL_H0_T0_OUT               -2180
+#define CAL_H1_T0_OUT               9460
+#define CAL_T0_DEGC                 10
+#define CAL_T1_DEGC                 35
+#define CAL_T0_OUT                  -310
+#define CAL_T1_OUT                  1290
+
+/* Variables -----------------------------------------------------------------*/
+
+/* Output data rate for each CTRL_REG1 ODR setting, 0 for one-shot */
+static const float odr_hz[4] = { 0.0f, 1.0f, 7.0f, 12.5f };
+
+/* Class Implementation ------------------------------------------------------*/
+
+SimHTS221::SimHTS221(PinName drdy) : drdy(drdy), humidity(45.0f), temperature(22.5f),
+        last(0), samples(0) {
+    regs[WHO_AM_I] = 0xBC;
+    regs[AV_CONF] = 0x1B;
+    load_calibration();
+    drive_drdy();
+}
+
+void SimHTS221::set_humidity(float rh) {
+    humidity = rh;
+}
+
+void SimHTS221::set_temperature(float celsius) {
+    temperature = celsius;
+}
+
+uint32_t SimHTS221::get_samples() {
+    return samples;
+}
+
+void SimHTS221::update(uint64_t now) {
+    uint8_t odr = regs[CTRL_REG1] & CTRL_REG1_ODR;
+
+    if (!(regs[CTRL_REG1] & CTRL_REG1_PD) || !odr) {
+        last = now;
+        return;
+    }
+
+    if (samples_due(now, odr_hz[odr], &last)) {
+        sample();
+    }
+}
+
+uint8_t SimHTS221::first_address(uint8_t data, bool spi) {
+    return data & (spi ? 0x3F : 0x7F);
+}
+
+bool SimHTS221::increments(uint8_t data, bool spi) {
+    return data & (spi ? 0x40 : 0x80);
+}
+
+uint8_t SimHTS221::read_register(uint8_t reg) {
+    uint8_t value = regs[reg];
+
+    if (reg == HUMIDITY_OUT_H) {
+        regs[STATUS_REG] &= ~STATUS_H_DA;
+        drive_drdy();
+    } else if (reg == TEMP_OUT_H) {
+        regs[STATUS_REG] &= ~STATUS_T_DA;
+        drive_drdy();
+    }
+    return value;
+}
+
+void SimHTS221::write_register(uint8_t reg, uint8_t value) {
+    switch (reg) {
+    case CTRL_REG1:
+        /* The rate restarts from now */
+        last = SimClock::now();
+        regs[reg] = value;
+        break;
+
+    case CTRL_REG2:
+        if (value & CTRL_REG2_BOOT) {
+            load_calibration();
+        }
+        if ((value & CTRL_REG2_ONE_SHOT) && (regs[CTRL_REG1] & CTRL_REG1_PD)) {
+            sample();
+        }
+        /* Both bits clear themselves once done */
+        regs[reg] = value & ~(CTRL_REG2_BOOT | CTRL_REG2_ONE_SHOT);
+        break;
+
+    case CTRL_REG3:
+        regs[reg] = value;
+        drive_drdy();
+        break;
+
+    case AV_CONF:
+        regs[reg] = value;
+        break;
+
+    default:
+        /* Read only registers, calibration included */
+        break;
+    }
+}
+
+void SimHTS221::load_calibration() {
+    uint16_t t0 = CAL_T0_DEGC * 8;
+    uint16_t t1 = CAL_T1_DEGC * 8;
+
+    regs[CALIB_0 + 0x0] = CAL_H0_RH * 2;
+    regs[CALIB_0 + 0x1] = CAL_H1_RH * 2;
+    regs[CALIB_0 + 0x2] = t0 & 0xFF;
+    regs[CALIB_0 + 0x3] = t1 & 0xFF;
+    regs[CALIB_0 + 0x5] = ((t0 >> 8) & 0x03) | (((t1 >> 8) & 0x03) << 2);
+    regs[CALIB_0 + 0x6] = (uint16_t)CAL_H0_T0_OUT & 0xFF;
+    regs[CALIB_0 + 0x7] = (uint16_t)CAL_H0_T0_OUT >> 8;
+    regs[CALIB_0 + 0xA] = (uint16_t)CAL_H1_T0_OUT & 0xFF;
+    regs[CALIB_0 + 0xB] = (uint16_t)CAL_H1_T0_OUT >> 8;
+    regs[CALIB_0 + 0xC] = (uint16_t)CAL_T0_OUT & 0xFF;
+    regs[CALIB_0 + 0xD] = (uint16_t)CAL_T0_OUT >> 8;
+    regs[CALIB_0 + 0xE] = (uint16_t)CAL_T1_OUT & 0xFF;
+    regs[CALIB_0 + 0xF] = (uint16_t)CAL_T1_OUT >> 8;
+}
+
+void SimHTS221::sample() {
+    /* The raw outputs sit on the calibration line of the part */
+    float h = CAL_H0_T0_OUT + (humidity - CAL_H0_RH) * (CAL_H1_T0_OUT - CAL_H0_T0_OUT) / (CAL_H1_RH - CAL_H0_RH);
+    float t = CAL_T0_OUT + (temperature - CAL_T0_DEGC) * (CAL_T1_OUT - CAL_T0_OUT) / (CAL_T1_DEGC - CAL_T0_DEGC);
+    int16_t raw_h = (int16_t)lroundf(h);
+    int16_t raw_t = (int16_t)lroundf(t);
+
+    regs[HUMIDITY_OUT_L] = (uint16_t)raw_h & 0xFF;
+    regs[HUMIDITY_OUT_H] = (uint16_t)raw_h >> 8;
+    regs[TEMP_OUT_L] = (uint16_t)raw_t & 0xFF;
+    regs[TEMP_OUT_H] = (uint16_t)raw_t >> 8;
+    regs[STATUS_REG] |= STATUS_H_DA | STATUS_T_DA;
+    samples++;
+    drive_drdy();
+}
+
+void SimHTS221::drive_drdy() {
+    bool ready = (regs[CTRL_REG3] & CTRL_REG3_DRDY) && (regs[STATUS_REG] & (STATUS_H_DA | STATUS_T_DA));
+    bool active_low = regs[CTRL_REG3] & CTRL_REG3_DRDY_H_L;
+
+    SimPins::drive(drdy, ready != active_low);
+}
@@ -0,0 +1,92 @@
+/**
+ ******************************************************************************
+ * @file    SimHTS221.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Register level model of the HTS221 humidity and temperature sensor.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SIM_HTS221_H__
+#define __SIM_HTS221_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SimRegisterDevice.h"
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * HTS221 model.
+ *
+ *  - Over I2C bit 7 of the register address, over SPI bit 6, makes a
+ *    multiple byte access move on to the next register.
+ *  - Samples at the rate set in CTRL_REG1 while active, or once on
+ *    ONE_SHOT; STATUS_REG flags are cleared by reading the high bytes.
+ *  - The calibration registers 0x30 to 0x3F hold a factory line for each
+ *    value, different from one part to the next, and the outputs follow
+ *    it; BOOT reloads them.
+ *  - DRDY is driven while data is ready if enabled in CTRL_REG3.
+ */
+class SimHTS221 : public SimRegisterDevice {
+public:
+    SimHTS221(PinName drdy = NC);
+
+    /* Environment seen by the part. */
+    void set_humidity(float rh);
+    void set_temperature(float celsius);
+
+    uint32_t get_samples();
+
+    virtual void update(uint64_t now);
+
+protected:
+    virtual uint8_t first_address(uint8_t data, bool spi);
+    virtual bool increments(uint8_t data, bool spi);
+    virtual uint8_t read_register(uint8_t reg);
+    virtual void write_register(uint8_t reg, uint8_t value);
+
+private:
+    void load_calibration();
+    void sample();
+    void drive_drdy();
+
+    PinName drdy;
+    float humidity;
+    float temperature;
+    uint64_t last;
+    uint32_t samples;
+};
+
+#endif // __SIM_HTS221_H__
@@ -0,0 +1,286 @@
+/**
+ ******************************************************************************
+ * @file    SimLPS22HB.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Register level model of the LPS22HB pressure sensor.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SimLPS22HB.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define WHO_AM_I                    0x0F
+#define CTRL_REG1                   0x10
+#define CTRL_REG2                   0x11
+#define CTRL_REG3                   0x12
+#define FIFO_CTRL                   0x14
+#define RPDS_L                      0x18
+#define RPDS_H                      0x19
+#define FIFO_STATUS                 0x26
+#define STATUS                      0x27
+#define PRESS_OUT_XL                0x28
+#define PRESS_OUT_H                 0x2A
+#define TEMP_OUT_L                  0x2B
+#define TEMP_OUT_H                  0x2C
+
+#define CTRL_REG1_ODR               0x70
+#define CTRL_REG2_BOOT              0x80
+#define CTRL_REG2_FIFO_EN           0x40
+#define CTRL_REG2_STOP_ON_FTH       0x20
+#define CTRL_REG2_IF_ADD_INC        0x10
+#define CTRL_REG2_SWRESET           0x04
+#define CTRL_REG2_ONE_SHOT          0x01
+#define CTRL_REG3_INT_H_L           0x80
+#define CTRL_REG3_F_FSS5            0x20
+#define CTRL_REG3_F_FTH             0x10
+#define CTRL_REG3_F_OVR             0x08
+#define CTRL_REG3_DRDY              0x04
+#define FIFO_CTRL_MODE              0xE0
+#define FIFO_CTRL_WTM               0x1F
+#define FIFO_MODE_BYPASS            0x00
+#define FIFO_MODE_FIFO              0x20
+#define FIFO_MODE_BYPASS_TO_FIFO    0xE0
+#define FIFO_STATUS_FTH             0x80
+#define FIFO_STATUS_OVR             0x40
+#define STATUS_P_DA                 0x01
+#define STATUS_T_DA                 0x02
+
+#define FIFO_SLOTS                  32
+
+/* Variables -----------------------------------------------------------------*/
+
+/* Output data rate for each CTRL_REG1 ODR setting, 0 for one-shot */
+static const float odr_hz[8] = { 0.0f, 1.0f, 10.0f, 25.0f, 50.0f, 75.0f, 75.0f, 75.0f };
+
+/* Class Implementation ------------------------------------------------------*/
+
+SimLPS22HB::SimLPS22HB(PinName int_drdy) : int_drdy(int_drdy), pressure(1013.25f),
+        temperature(22.5f), offset(0.0f), last(0), samples(0), overrun(false) {
+    reset_registers();
+}
+
+void SimLPS22HB::set_pressure(float hpa) {
+    pressure = hpa;
+}
+
+void SimLPS22HB::set_temperature(float celsius) {
+    temperature = celsius;
+}
+
+void SimLPS22HB::set_offset(float hpa) {
+    offset = hpa;
+}
+
+uint32_t SimLPS22HB::get_samples() {
+    return samples;
+}
+
+uint32_t SimLPS22HB::get_fifo_level() {
+    return fifo.size();
+}
+
+void SimLPS22HB::update(uint64_t now) {
+    float rate = odr_hz[(regs[CTRL_REG1] & CTRL_REG1_ODR) >> 4];
+
+    for (uint32_t due = samples_due(now, rate, &last); due; due--) {
+        sample();
+    }
+}
+
+bool SimLPS22HB::increments(uint8_t data, bool spi) {
+    return regs[CTRL_REG2] & CTRL_REG2_IF_ADD_INC;
+}
+
+uint8_t SimLPS22HB::next_address(uint8_t reg) {
+    if (reg == TEMP_OUT_H && fifo_active()) {
+        /* The slot has been read: take it off and read the next one */
+        if (!fifo.empty()) {
+            fifo.pop_front();
+            overrun = false;
+            update_fifo_status();
+        }
+        return PRESS_OUT_XL;
+    }
+    return reg + 1;
+}
+
+uint8_t SimLPS22HB::read_register(uint8_t reg) {
+    if (reg >= PRESS_OUT_XL && reg <= TEMP_OUT_H) {
+        if (reg == PRESS_OUT_H) {
+            regs[STATUS] &= ~STATUS_P_DA;
+            drive_int();
+        } else if (reg == TEMP_OUT_H) {
+            regs[STATUS] &= ~STATUS_T_DA;
+            drive_int();
+        }
+        if (fifo_active() && !fifo.empty()) {
+            return fifo.front().data[reg - PRESS_OUT_XL];
+        }
+    }
+    return regs[reg];
+}
+
+void SimLPS22HB::write_register(uint8_t reg, uint8_t value) {
+    switch (reg) {
+    case CTRL_REG1:
+        last = SimClock::now();
+        regs[reg] = value;
+        break;
+
+    case CTRL_REG2:
+        if (value & CTRL_REG2_SWRESET) {
+            reset_registers();
+            break;
+        }
+        regs[reg] = value & ~(CTRL_REG2_BOOT | CTRL_REG2_ONE_SHOT);
+        if ((value & CTRL_REG2_ONE_SHOT) && !(regs[CTRL_REG1] & CTRL_REG1_ODR)) {
+            sample();
+        }
+        if (!fifo_active()) {
+            fifo.clear();
+            overrun = false;
+        }
+        update_fifo_status();
+        break;
+
+    case FIFO_CTRL:
+        regs[reg] = value;
+        if ((value & FIFO_CTRL_MODE) == FIFO_MODE_BYPASS) {
+            /* Bypass empties the FIFO, to restart it */
+            fifo.clear();
+            overrun = false;
+        }
+        update_fifo_status();
+        break;
+
+    case CTRL_REG3:
+        regs[reg] = value;
+        drive_int();
+        break;
+
+    case WHO_AM_I:
+    case FIFO_STATUS:
+    case STATUS:
+        break;
+
+    default:
+        if (reg < PRESS_OUT_XL || reg > TEMP_OUT_H) {
+            regs[reg] = value;
+        }
+        break;
+    }
+}
+
+void SimLPS22HB::reset_registers() {
+    memset(regs, 0, sizeof(regs));
+    regs[WHO_AM_I] = 0xB1;
+    regs[CTRL_REG2] = CTRL_REG2_IF_ADD_INC;
+    fifo.clear();
+    overrun = false;
+    last = SimClock::now();
+    update_fifo_status();
+}
+
+void SimLPS22HB::sample() {
+    int16_t rpds = (int16_t)(regs[RPDS_L] | (regs[RPDS_H] << 8));
+    int32_t raw_p = (int32_t)lroundf((pressure + offset) * 4096.0f) - rpds * 256;
+    int16_t raw_t = (int16_t)lroundf(temperature * 100.0f);
+    Slot slot;
+
+    slot.data[0] = raw_p & 0xFF;
+    slot.data[1] = (raw_p >> 8) & 0xFF;
+    slot.data[2] = (raw_p >> 16) & 0xFF;
+    slot.data[3] = (uint16_t)raw_t & 0xFF;
+    slot.data[4] = (uint16_t)raw_t >> 8;
+    memcpy(&regs[PRESS_OUT_XL], slot.data, sizeof(slot.data));
+    regs[STATUS] |= STATUS_P_DA | STATUS_T_DA;
+    samples++;
+
+    if (fifo_active()) {
+        if (fifo.size() < fifo_depth()) {
+            fifo.push_back(slot);
+        } else if ((regs[FIFO_CTRL] & FIFO_CTRL_MODE) != FIFO_MODE_FIFO &&
+                   (regs[FIFO_CTRL] & FIFO_CTRL_MODE) != FIFO_MODE_BYPASS_TO_FIFO) {
+            fifo.pop_front();
+            fifo.push_back(slot);
+            overrun = true;
+        }
+    }
+    update_fifo_status();
+}
+
+bool SimLPS22HB::fifo_active() {
+    return (regs[CTRL_REG2] & CTRL_REG2_FIFO_EN) && (regs[FIFO_CTRL] & FIFO_CTRL_MODE) != FIFO_MODE_BYPASS;
+}
+
+uint32_t SimLPS22HB::fifo_depth() {
+    uint32_t wtm = regs[FIFO_CTRL] & FIFO_CTRL_WTM;
+
+    return (regs[CTRL_REG2] & CTRL_REG2_STOP_ON_FTH) && wtm ? wtm : FIFO_SLOTS;
+}
+
+void SimLPS22HB::update_fifo_status() {
+    uint32_t wtm = regs[FIFO_CTRL] & FIFO_CTRL_WTM;
+    uint8_t status = fifo.size();
+
+    if (wtm && fifo.size() >= wtm) {
+        status |= FIFO_STATUS_FTH;
+    }
+    if (overrun) {
+        status |= FIFO_STATUS_OVR;
+    }
+    regs[FIFO_STATUS] = status;
+    drive_int();
+}
+
+void SimLPS22HB::drive_int() {
+    uint8_t ctrl = regs[CTRL_REG3];
+    bool active = false;
+
+    if ((ctrl & CTRL_REG3_DRDY) && (regs[STATUS] & STATUS_P_DA)) {
+        active = true;
+    }
+    if ((ctrl & CTRL_REG3_F_FTH) && (regs[FIFO_STATUS] & FIFO_STATUS_FTH)) {
+        active = true;
+    }
+    if ((ctrl & CTRL_REG3_F_OVR) && (regs[FIFO_STATUS] & FIFO_STATUS_OVR)) {
+        active = true;
+    }
+    if ((ctrl & CTRL_REG3_F_FSS5) && fifo.size() >= FIFO_SLOTS) {
+        active = true;
+    }
+    SimPins::drive(int_drdy, active != (bool)(ctrl & CTRL_REG3_INT_H_L));
+}
@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file    SimLPS22HB.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Register level model of the LPS22HB pressure sensor.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SIM_LPS22HB_H__
+#define __SIM_LPS22HB_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <deque>
+#include "SimRegisterDevice.h"
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * LPS22HB model.
+ *
+ *  - Multiple byte accesses move on to the next register while IF_ADD_INC
+ *    is set in CTRL_REG2, as it is after reset, on either bus.
+ *  - Samples at the rate set in CTRL_REG1, or once on ONE_SHOT.
+ *  - With FIFO_EN set and a FIFO mode other than bypass, samples go to the
+ *    32 slot FIFO; the output registers show the oldest slot, and a read
+ *    going past TEMP_OUT_H rolls back to PRESS_OUT_XL and takes the slot
+ *    off, so that one burst empties several slots. FIFO mode stops when
+ *    full, the stream modes drop the oldest slot and flag an overrun.
+ *  - RPDS is subtracted from the output, in steps of 256 LSB (1/16 hPa), to
+ *    take out the offset set with set_offset().
+ *  - INT_DRDY is driven as routed by CTRL_REG3.
+ */
+class SimLPS22HB : public SimRegisterDevice {
+public:
+    SimLPS22HB(PinName int_drdy = NC);
+
+    /* Environment seen by the part, and its offset after soldering. */
+    void set_pressure(float hpa);
+    void set_temperature(float celsius);
+    void set_offset(float hpa);
+
+    uint32_t get_samples();
+    uint32_t get_fifo_level();
+
+    virtual void update(uint64_t now);
+
+protected:
+    virtual bool increments(uint8_t data, bool spi);
+    virtual uint8_t next_address(uint8_t reg);
+    virtual uint8_t read_register(uint8_t reg);
+    virtual void write_register(uint8_t reg, uint8_t value);
+
+private:
+    struct Slot {
+        uint8_t data[5];
+    };
+
+    void reset_registers();
+    void sample();
+    bool fifo_active();
+    uint32_t fifo_depth();
+    void update_fifo_status();
+    void drive_int();
+
+    PinName int_drdy;
+    float pressure;
+    float temperature;
+    float offset;
+    uint64_t last;
+    uint32_t samples;
+    bool overrun;
+    std::deque<Slot> fifo;
+};
+
+#endif // __SIM_LPS22HB_H__
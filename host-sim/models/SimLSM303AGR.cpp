@@ -0,0 +1,429 @@
+/**
+ ******************************************************************************
+ * @file    SimLSM303AGR.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Register level models of the LSM303AGR accelerometer and
+ *          magnetometer.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SimLSM303AGR.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/* Accelerometer */
+#define ACC_WHO_AM_I                0x0F
+#define ACC_CTRL_REG1               0x20
+#define ACC_CTRL_REG3               0x22
+#define ACC_CTRL_REG4               0x23
+#define ACC_CTRL_REG5               0x24
+#define ACC_CTRL_REG6               0x25
+#define ACC_STATUS                  0x27
+#define ACC_OUT_X_L                 0x28
+#define ACC_OUT_Z_H                 0x2D
+#define ACC_FIFO_CTRL               0x2E
+#define ACC_FIFO_SRC                0x2F
+
+#define ACC_CTRL_REG1_ODR           0xF0
+#define ACC_CTRL_REG1_LPEN          0x08
+#define ACC_CTRL_REG3_I1_DRDY1      0x10
+#define ACC_CTRL_REG3_I1_WTM        0x04
+#define ACC_CTRL_REG3_I1_OVERRUN    0x02
+#define ACC_CTRL_REG4_FS            0x30
+#define ACC_CTRL_REG4_HR            0x08
+#define ACC_CTRL_REG5_BOOT          0x80
+#define ACC_CTRL_REG5_FIFO_EN       0x40
+#define ACC_CTRL_REG6_H_LACTIVE     0x02
+#define ACC_STATUS_ZYXDA            0x08
+#define ACC_STATUS_ZYXOR            0x80
+#define ACC_FIFO_CTRL_FM            0xC0
+#define ACC_FIFO_CTRL_FTH           0x1F
+#define ACC_FIFO_MODE_BYPASS        0x00
+#define ACC_FIFO_MODE_FIFO          0x40
+#define ACC_FIFO_SRC_WTM            0x80
+#define ACC_FIFO_SRC_OVRN           0x40
+#define ACC_FIFO_SRC_EMPTY          0x20
+#define ACC_FIFO_SLOTS              32
+
+/* Magnetometer */
+#define MAG_OFFSET_X_L              0x45
+#define MAG_WHO_AM_I                0x4F
+#define MAG_CFG_REG_A               0x60
+#define MAG_CFG_REG_C               0x62
+#define MAG_STATUS                  0x67
+#define MAG_OUTX_L                  0x68
+#define MAG_OUTZ_H                  0x6D
+
+#define MAG_CFG_REG_A_REBOOT        0x40
+#define MAG_CFG_REG_A_SOFT_RST      0x20
+#define MAG_CFG_REG_A_ODR           0x0C
+#define MAG_CFG_REG_A_MD            0x03
+#define MAG_MD_CONTINUOUS           0x00
+#define MAG_MD_SINGLE               0x01
+#define MAG_MD_IDLE                 0x03
+#define MAG_CFG_REG_C_INT_MAG       0x01
+#define MAG_STATUS_ZYXDA            0x08
+#define MAG_STATUS_ZYXOR            0x80
+#define MAG_SENSITIVITY             1.5f
+
+/* Variables -----------------------------------------------------------------*/
+
+/* Accelerometer output data rate for each CTRL_REG1 ODR setting */
+static const float acc_odr_hz[16] = {
+    0.0f, 1.0f, 10.0f, 25.0f, 50.0f, 100.0f, 200.0f, 400.0f,
+    1620.0f, 1344.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f
+};
+
+/* Sensitivity in ug/digit by mode (high resolution, normal, low power) and full scale */
+static const int acc_sensitivity[3][4] = {
+    {   980,  1950,  3900,  11720 },
+    {  3900,  7820, 15630,  46900 },
+    { 15630, 31260, 62520, 187580 }
+};
+
+/* Magnetometer output data rate for each CFG_REG_A ODR setting */
+static const float mag_odr_hz[4] = { 10.0f, 20.0f, 50.0f, 100.0f };
+
+/* Functions -----------------------------------------------------------------*/
+
+static int16_t saturate(long value, int bits) {
+    long max = (1L << (bits - 1)) - 1;
+
+    return (int16_t)(value > max ? max : value < -max - 1 ? -max - 1 : value);
+}
+
+/* SimLSM303AGRAcc -----------------------------------------------------------*/
+
+SimLSM303AGRAcc::SimLSM303AGRAcc(PinName int1) : int1(int1), last(0), samples(0) {
+    acceleration[0] = 0.0f;
+    acceleration[1] = 0.0f;
+    acceleration[2] = 1000.0f;
+    reset_registers();
+}
+
+void SimLSM303AGRAcc::set_acceleration(float x, float y, float z) {
+    acceleration[0] = x;
+    acceleration[1] = y;
+    acceleration[2] = z;
+}
+
+uint32_t SimLSM303AGRAcc::get_samples() {
+    return samples;
+}
+
+uint32_t SimLSM303AGRAcc::get_fifo_level() {
+    return fifo.size();
+}
+
+void SimLSM303AGRAcc::update(uint64_t now) {
+    float rate = acc_odr_hz[regs[ACC_CTRL_REG1] >> 4];
+
+    for (uint32_t due = samples_due(now, rate, &last); due; due--) {
+        sample();
+    }
+}
+
+uint8_t SimLSM303AGRAcc::first_address(uint8_t data, bool spi) {
+    return data & (spi ? 0x3F : 0x7F);
+}
+
+bool SimLSM303AGRAcc::increments(uint8_t data, bool spi) {
+    return data & (spi ? 0x40 : 0x80);
+}
+
+uint8_t SimLSM303AGRAcc::next_address(uint8_t reg) {
+    if (reg == ACC_OUT_Z_H && fifo_active()) {
+        /* The slot has been read: take it off and read the next one */
+        if (!fifo.empty()) {
+            fifo.pop_front();
+            update_fifo_status();
+        }
+        return ACC_OUT_X_L;
+    }
+    return reg + 1;
+}
+
+uint8_t SimLSM303AGRAcc::read_register(uint8_t reg) {
+    if (reg >= ACC_OUT_X_L && reg <= ACC_OUT_Z_H) {
+        if (reg == ACC_OUT_Z_H) {
+            regs[ACC_STATUS] &= ~(ACC_STATUS_ZYXDA | ACC_STATUS_ZYXOR);
+            drive_int1();
+        }
+        if (fifo_active() && !fifo.empty()) {
+            return fifo.front().data[reg - ACC_OUT_X_L];
+        }
+    }
+    return regs[reg];
+}
+
+void SimLSM303AGRAcc::write_register(uint8_t reg, uint8_t value) {
+    switch (reg) {
+    case ACC_CTRL_REG1:
+        last = SimClock::now();
+        regs[reg] = value;
+        break;
+
+    case ACC_CTRL_REG5:
+        if (value & ACC_CTRL_REG5_BOOT) {
+            reset_registers();
+            break;
+        }
+        regs[reg] = value;
+        if (!fifo_active()) {
+            fifo.clear();
+        }
+        update_fifo_status();
+        break;
+
+    case ACC_FIFO_CTRL:
+        regs[reg] = value;
+        if ((value & ACC_FIFO_CTRL_FM) == ACC_FIFO_MODE_BYPASS) {
+            /* Bypass empties the FIFO, to restart it */
+            fifo.clear();
+        }
+        update_fifo_status();
+        break;
+
+    case ACC_CTRL_REG3:
+    case ACC_CTRL_REG6:
+        regs[reg] = value;
+        drive_int1();
+        break;
+
+    case ACC_WHO_AM_I:
+    case ACC_STATUS:
+    case ACC_FIFO_SRC:
+        break;
+
+    default:
+        if (reg < ACC_OUT_X_L || reg > ACC_OUT_Z_H) {
+            regs[reg] = value;
+        }
+        break;
+    }
+}
+
+void SimLSM303AGRAcc::reset_registers() {
+    memset(regs, 0, sizeof(regs));
+    regs[ACC_WHO_AM_I] = 0x33;
+    regs[ACC_CTRL_REG1] = 0x07;
+    fifo.clear();
+    last = SimClock::now();
+    update_fifo_status();
+}
+
+void SimLSM303AGRAcc::sample() {
+    int mode = (regs[ACC_CTRL_REG4] & ACC_CTRL_REG4_HR) ? 0 : (regs[ACC_CTRL_REG1] & ACC_CTRL_REG1_LPEN) ? 2 : 1;
+    int bits = 12 - 2 * mode;
+    int fs = (regs[ACC_CTRL_REG4] & ACC_CTRL_REG4_FS) >> 4;
+    Slot slot;
+
+    for (int i = 0; i < 3; i++) {
+        /* Digits of the mode, left-justified in 16 bits */
+        int16_t digits = saturate(lroundf(acceleration[i] * 1000.0f / acc_sensitivity[mode][fs]), bits);
+        uint16_t raw = (uint16_t)digits << (16 - bits);
+
+        slot.data[2 * i] = raw & 0xFF;
+        slot.data[2 * i + 1] = raw >> 8;
+    }
+
+    if (regs[ACC_STATUS] & ACC_STATUS_ZYXDA) {
+        regs[ACC_STATUS] |= ACC_STATUS_ZYXOR;
+    }
+    memcpy(&regs[ACC_OUT_X_L], slot.data, sizeof(slot.data));
+    regs[ACC_STATUS] |= ACC_STATUS_ZYXDA;
+    samples++;
+
+    if (fifo_active()) {
+        if (fifo.size() < ACC_FIFO_SLOTS) {
+            fifo.push_back(slot);
+        } else if ((regs[ACC_FIFO_CTRL] & ACC_FIFO_CTRL_FM) != ACC_FIFO_MODE_FIFO) {
+            fifo.pop_front();
+            fifo.push_back(slot);
+        }
+    }
+    update_fifo_status();
+}
+
+bool SimLSM303AGRAcc::fifo_active() {
+    return (regs[ACC_CTRL_REG5] & ACC_CTRL_REG5_FIFO_EN) &&
+           (regs[ACC_FIFO_CTRL] & ACC_FIFO_CTRL_FM) != ACC_FIFO_MODE_BYPASS;
+}
+
+void SimLSM303AGRAcc::update_fifo_status() {
+    uint32_t fth = regs[ACC_FIFO_CTRL] & ACC_FIFO_CTRL_FTH;
+    uint8_t status;
+
+    /* FSS counts to 31: a full FIFO shows as an overrun */
+    if (fifo.size() >= ACC_FIFO_SLOTS) {
+        status = ACC_FIFO_SRC_OVRN | (ACC_FIFO_SLOTS - 1);
+    } else {
+        status = fifo.size();
+    }
+    if (fifo.empty()) {
+        status |= ACC_FIFO_SRC_EMPTY;
+    }
+    if (fth && fifo.size() >= fth) {
+        status |= ACC_FIFO_SRC_WTM;
+    }
+    regs[ACC_FIFO_SRC] = status;
+    drive_int1();
+}
+
+void SimLSM303AGRAcc::drive_int1() {
+    uint8_t ctrl = regs[ACC_CTRL_REG3];
+    bool active = false;
+
+    if ((ctrl & ACC_CTRL_REG3_I1_DRDY1) && (regs[ACC_STATUS] & ACC_STATUS_ZYXDA)) {
+        active = true;
+    }
+    if ((ctrl & ACC_CTRL_REG3_I1_WTM) && (regs[ACC_FIFO_SRC] & ACC_FIFO_SRC_WTM)) {
+        active = true;
+    }
+    if ((ctrl & ACC_CTRL_REG3_I1_OVERRUN) && (regs[ACC_FIFO_SRC] & ACC_FIFO_SRC_OVRN)) {
+        active = true;
+    }
+    SimPins::drive(int1, active != (bool)(regs[ACC_CTRL_REG6] & ACC_CTRL_REG6_H_LACTIVE));
+}
+
+/* SimLSM303AGRMag -----------------------------------------------------------*/
+
+SimLSM303AGRMag::SimLSM303AGRMag(PinName int_mag) : int_mag(int_mag), last(0), samples(0) {
+    field[0] = 200.0f;
+    field[1] = 0.0f;
+    field[2] = -400.0f;
+    reset_registers();
+}
+
+void SimLSM303AGRMag::set_field(float x, float y, float z) {
+    field[0] = x;
+    field[1] = y;
+    field[2] = z;
+}
+
+uint32_t SimLSM303AGRMag::get_samples() {
+    return samples;
+}
+
+void SimLSM303AGRMag::update(uint64_t now) {
+    if ((regs[MAG_CFG_REG_A] & MAG_CFG_REG_A_MD) != MAG_MD_CONTINUOUS) {
+        last = now;
+        return;
+    }
+
+    float rate = mag_odr_hz[(regs[MAG_CFG_REG_A] & MAG_CFG_REG_A_ODR) >> 2];
+
+    for (uint32_t due = samples_due(now, rate, &last); due; due--) {
+        sample();
+    }
+}
+
+uint8_t SimLSM303AGRMag::first_address(uint8_t data, bool spi) {
+    return data & (spi ? 0x3F : 0x7F);
+}
+
+bool SimLSM303AGRMag::increments(uint8_t data, bool spi) {
+    return true;
+}
+
+uint8_t SimLSM303AGRMag::read_register(uint8_t reg) {
+    if (reg == MAG_OUTZ_H) {
+        regs[MAG_STATUS] &= ~(MAG_STATUS_ZYXDA | MAG_STATUS_ZYXOR);
+        drive_int();
+    }
+    return regs[reg];
+}
+
+void SimLSM303AGRMag::write_register(uint8_t reg, uint8_t value) {
+    switch (reg) {
+    case MAG_CFG_REG_A:
+        if (value & MAG_CFG_REG_A_SOFT_RST) {
+            reset_registers();
+            break;
+        }
+        last = SimClock::now();
+        regs[reg] = value & ~MAG_CFG_REG_A_REBOOT;
+        if ((value & MAG_CFG_REG_A_MD) == MAG_MD_SINGLE) {
+            /* One measurement, then back to idle */
+            sample();
+            regs[reg] = (regs[reg] & ~MAG_CFG_REG_A_MD) | MAG_MD_IDLE;
+        }
+        break;
+
+    case MAG_CFG_REG_C:
+        regs[reg] = value;
+        drive_int();
+        break;
+
+    case MAG_WHO_AM_I:
+    case MAG_STATUS:
+        break;
+
+    default:
+        if (reg < MAG_OUTX_L || reg > MAG_OUTZ_H) {
+            regs[reg] = value;
+        }
+        break;
+    }
+}
+
+void SimLSM303AGRMag::reset_registers() {
+    memset(regs, 0, sizeof(regs));
+    regs[MAG_WHO_AM_I] = 0x40;
+    regs[MAG_CFG_REG_A] = MAG_MD_IDLE;
+    last = SimClock::now();
+    drive_int();
+}
+
+void SimLSM303AGRMag::sample() {
+    for (int i = 0; i < 3; i++) {
+        int16_t offset = (int16_t)(regs[MAG_OFFSET_X_L + 2 * i] | (regs[MAG_OFFSET_X_L + 2 * i + 1] << 8));
+        int16_t raw = saturate(lroundf(field[i] / MAG_SENSITIVITY) - offset, 16);
+
+        regs[MAG_OUTX_L + 2 * i] = (uint16_t)raw & 0xFF;
+        regs[MAG_OUTX_L + 2 * i + 1] = (uint16_t)raw >> 8;
+    }
+
+    if (regs[MAG_STATUS] & MAG_STATUS_ZYXDA) {
+        regs[MAG_STATUS] |= MAG_STATUS_ZYXOR;
+    }
+    regs[MAG_STATUS] |= MAG_STATUS_ZYXDA;
+    samples++;
+    drive_int();
+}
+
+void SimLSM303AGRMag::drive_int() {
+    SimPins::drive(int_mag, (regs[MAG_CFG_REG_C] & MAG_CFG_REG_C_INT_MAG) && (regs[MAG_STATUS] & MAG_STATUS_ZYXDA));
+}
@@ -0,0 +1,140 @@
+/**
+ ******************************************************************************
+ * @file    SimLSM303AGR.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Register level models of the LSM303AGR accelerometer and
+ *          magnetometer.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SIM_LSM303AGR_H__
+#define __SIM_LSM303AGR_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <deque>
+#include "SimRegisterDevice.h"
+
+/* Class Declarations --------------------------------------------------------*/
+
+/**
+ * LSM303AGR accelerometer model.
+ *
+ *  - Over I2C bit 7 of the register address, over SPI bit 6, makes a
+ *    multiple byte access move on to the next register.
+ *  - Samples at the rate set in CTRL_REG1, left-justified in the output
+ *    registers with the resolution of the mode: 8 bits in low power, 10 in
+ *    normal and 12 in high resolution mode.
+ *  - With FIFO_EN set in CTRL_REG5 and a FIFO mode other than bypass,
+ *    samples go to the 32 slot FIFO; the output registers show the oldest
+ *    slot, and a read going past OUT_Z_H rolls back to OUT_X_L and takes
+ *    the slot off. FIFO mode stops when full, stream drops the oldest.
+ *  - INT1 is driven as routed by CTRL_REG3.
+ */
+class SimLSM303AGRAcc : public SimRegisterDevice {
+public:
+    SimLSM303AGRAcc(PinName int1 = NC);
+
+    /* Acceleration seen by the part, in mg. */
+    void set_acceleration(float x, float y, float z);
+
+    uint32_t get_samples();
+    uint32_t get_fifo_level();
+
+    virtual void update(uint64_t now);
+
+protected:
+    virtual uint8_t first_address(uint8_t data, bool spi);
+    virtual bool increments(uint8_t data, bool spi);
+    virtual uint8_t next_address(uint8_t reg);
+    virtual uint8_t read_register(uint8_t reg);
+    virtual void write_register(uint8_t reg, uint8_t value);
+
+private:
+    struct Slot {
+        uint8_t data[6];
+    };
+
+    void reset_registers();
+    void sample();
+    bool fifo_active();
+    void update_fifo_status();
+    void drive_int1();
+
+    PinName int1;
+    float acceleration[3];
+    uint64_t last;
+    uint32_t samples;
+    std::deque<Slot> fifo;
+};
+
+/**
+ * LSM303AGR magnetometer model.
+ *
+ *  - Multiple byte accesses always move on to the next register.
+ *  - Samples at the rate set in CFG_REG_A in continuous mode, or once in
+ *    single mode, at 1.5 mG/LSB; the hard-iron offset in OFFSET_X/Y/Z is
+ *    subtracted from the outputs.
+ *  - INT_MAG is driven while data is ready if enabled in CFG_REG_C.
+ */
+class SimLSM303AGRMag : public SimRegisterDevice {
+public:
+    SimLSM303AGRMag(PinName int_mag = NC);
+
+    /* Field seen by the part, in mG. */
+    void set_field(float x, float y, float z);
+
+    uint32_t get_samples();
+
+    virtual void update(uint64_t now);
+
+protected:
+    virtual uint8_t first_address(uint8_t data, bool spi);
+    virtual bool increments(uint8_t data, bool spi);
+    virtual uint8_t read_register(uint8_t reg);
+    virtual void write_register(uint8_t reg, uint8_t value);
+
+private:
+    void reset_registers();
+    void sample();
+    void drive_int();
+
+    PinName int_mag;
+    float field[3];
+    uint64_t last;
+    uint32_t samples;
+};
+
+#endif // __SIM_LSM303AGR_H__
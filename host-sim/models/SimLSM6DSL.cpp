@@ -0,0 +1,458 @@
+/**
+ ******************************************************************************
+ * @file    SimLSM6DSL.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Register level model of the LSM6DSL accelerometer and gyroscope.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SimLSM6DSL.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define FIFO_CTRL1                  0x06
+#define FIFO_CTRL2                  0x07
+#define FIFO_CTRL3                  0x08
+#define FIFO_CTRL5                  0x0A
+#define DRDY_PULSE_CFG_G            0x0B
+#define INT1_CTRL                   0x0D
+#define WHO_AM_I                    0x0F
+#define CTRL1_XL                    0x10
+#define CTRL2_G                     0x11
+#define CTRL3_C                     0x12
+#define CTRL6_C                     0x15
+#define STATUS_REG                  0x1E
+#define OUT_TEMP_L                  0x20
+#define OUT_TEMP_H                  0x21
+#define OUTX_L_G                    0x22
+#define OUTZ_H_G                    0x27
+#define OUTX_L_XL                   0x28
+#define OUTZ_H_XL                   0x2D
+#define FIFO_STATUS1                0x3A
+#define FIFO_STATUS2                0x3B
+#define FIFO_STATUS3                0x3C
+#define FIFO_STATUS4                0x3D
+#define FIFO_DATA_OUT_L             0x3E
+#define FIFO_DATA_OUT_H             0x3F
+#define X_OFS_USR                   0x73
+
+#define FIFO_CTRL2_FTH_H            0x07
+#define FIFO_CTRL3_DEC_G            0x38
+#define FIFO_CTRL3_DEC_XL           0x07
+#define FIFO_CTRL5_ODR              0x78
+#define FIFO_CTRL5_MODE             0x07
+#define FIFO_MODE_BYPASS            0x00
+#define FIFO_MODE_FIFO              0x01
+#define DRDY_PULSED                 0x80
+#define INT1_FULL_FLAG              0x20
+#define INT1_FIFO_OVR               0x10
+#define INT1_FTH                    0x08
+#define INT1_DRDY_G                 0x02
+#define INT1_DRDY_XL                0x01
+#define CTRL_FS                     0x0C
+#define CTRL2_G_FS_125              0x02
+#define CTRL3_C_BOOT                0x80
+#define CTRL3_C_IF_INC              0x04
+#define CTRL3_C_SW_RESET            0x01
+#define CTRL6_C_USR_OFF_W           0x08
+#define STATUS_TDA                  0x04
+#define STATUS_GDA                  0x02
+#define STATUS_XLDA                 0x01
+#define FIFO_STATUS2_WTM            0x80
+#define FIFO_STATUS2_OVER_RUN       0x40
+#define FIFO_STATUS2_FULL_SMART     0x20
+#define FIFO_STATUS2_EMPTY          0x10
+
+#define FIFO_WORDS                  2048
+
+/* Variables -----------------------------------------------------------------*/
+
+/* Output data rate for each ODR setting of CTRL1_XL, CTRL2_G and FIFO_CTRL5 */
+static const float odr_hz[16] = {
+    0.0f, 12.5f, 26.0f, 52.0f, 104.0f, 208.0f, 416.0f, 833.0f,
+    1660.0f, 3330.0f, 6660.0f, 1.6f, 0.0f, 0.0f, 0.0f, 0.0f
+};
+
+/* Sensitivity for each FS_XL setting, in mg/LSB */
+static const float xl_sensitivity[4] = { 0.061f, 0.488f, 0.122f, 0.244f };
+
+/* Sensitivity for each FS_G setting, in mdps/LSB */
+static const float g_sensitivity[4] = { 8.75f, 17.5f, 35.0f, 70.0f };
+
+/* Decimation for each DEC_FIFO setting, 0 when not in the FIFO */
+static const uint32_t decimation[8] = { 0, 1, 2, 3, 4, 8, 16, 32 };
+
+/* Functions -----------------------------------------------------------------*/
+
+static int16_t saturate(long value) {
+    return (int16_t)(value > 32767 ? 32767 : value < -32768 ? -32768 : value);
+}
+
+/* Class Implementation ------------------------------------------------------*/
+
+SimLSM6DSL::SimLSM6DSL(PinName int1) : int1(int1), temperature(25.0f), counting(false),
+        xl_count(0), g_count(0), xl_last(0), g_last(0), fifo_last(0), fifo_ticks(0),
+        pattern(0), overrun(false) {
+    acceleration[0] = 0.0f;
+    acceleration[1] = 0.0f;
+    acceleration[2] = 1000.0f;
+    angular_rate[0] = 0.0f;
+    angular_rate[1] = 0.0f;
+    angular_rate[2] = 0.0f;
+    reset_registers();
+}
+
+void SimLSM6DSL::set_acceleration(float x, float y, float z) {
+    acceleration[0] = x;
+    acceleration[1] = y;
+    acceleration[2] = z;
+}
+
+void SimLSM6DSL::set_angular_rate(float x, float y, float z) {
+    angular_rate[0] = x;
+    angular_rate[1] = y;
+    angular_rate[2] = z;
+}
+
+void SimLSM6DSL::set_temperature(float celsius) {
+    temperature = celsius;
+}
+
+void SimLSM6DSL::set_counting(bool counting) {
+    this->counting = counting;
+    xl_count = 0;
+    g_count = 0;
+}
+
+uint32_t SimLSM6DSL::get_fifo_level() {
+    return fifo.size();
+}
+
+void SimLSM6DSL::update(uint64_t now) {
+    uint32_t due;
+
+    for (due = samples_due(now, odr_hz[regs[CTRL1_XL] >> 4], &xl_last); due; due--) {
+        output_xl();
+    }
+    for (due = samples_due(now, odr_hz[regs[CTRL2_G] >> 4], &g_last); due; due--) {
+        output_g();
+    }
+
+    float fifo_rate = odr_hz[(regs[FIFO_CTRL5] & FIFO_CTRL5_ODR) >> 3];
+    if ((regs[FIFO_CTRL5] & FIFO_CTRL5_MODE) == FIFO_MODE_BYPASS) {
+        fifo_rate = 0.0f;
+    }
+    for (due = samples_due(now, fifo_rate, &fifo_last); due; due--) {
+        fifo_tick();
+    }
+}
+
+bool SimLSM6DSL::increments(uint8_t data, bool spi) {
+    return regs[CTRL3_C] & CTRL3_C_IF_INC;
+}
+
+uint8_t SimLSM6DSL::next_address(uint8_t reg) {
+    /* The FIFO output register pair is read over and over */
+    return reg == FIFO_DATA_OUT_H ? FIFO_DATA_OUT_L : reg + 1;
+}
+
+uint8_t SimLSM6DSL::read_register(uint8_t reg) {
+    uint8_t value = regs[reg];
+
+    switch (reg) {
+    case OUT_TEMP_H:
+        regs[STATUS_REG] &= ~STATUS_TDA;
+        break;
+
+    case OUTZ_H_G:
+        regs[STATUS_REG] &= ~STATUS_GDA;
+        drive_int1();
+        break;
+
+    case OUTZ_H_XL:
+        regs[STATUS_REG] &= ~STATUS_XLDA;
+        drive_int1();
+        break;
+
+    case FIFO_DATA_OUT_L:
+        value = fifo.empty() ? 0 : fifo.front() & 0xFF;
+        break;
+
+    case FIFO_DATA_OUT_H:
+        if (fifo.empty()) {
+            value = 0;
+            break;
+        }
+        value = fifo.front() >> 8;
+        fifo.pop_front();
+        pattern++;
+        overrun = false;
+        update_fifo_status();
+        break;
+
+    default:
+        break;
+    }
+    return value;
+}
+
+void SimLSM6DSL::write_register(uint8_t reg, uint8_t value) {
+    switch (reg) {
+    case CTRL1_XL:
+        xl_last = SimClock::now();
+        regs[reg] = value;
+        break;
+
+    case CTRL2_G:
+        g_last = SimClock::now();
+        regs[reg] = value;
+        break;
+
+    case CTRL3_C:
+        if (value & CTRL3_C_SW_RESET) {
+            reset_registers();
+            break;
+        }
+        regs[reg] = value & ~CTRL3_C_BOOT;
+        break;
+
+    case FIFO_CTRL5:
+        if (value != regs[reg]) {
+            fifo_last = SimClock::now();
+        }
+        regs[reg] = value;
+        if ((value & FIFO_CTRL5_MODE) == FIFO_MODE_BYPASS) {
+            /* Bypass empties the FIFO, to restart it */
+            fifo.clear();
+            overrun = false;
+            fifo_ticks = 0;
+            pattern = 0;
+        }
+        update_fifo_status();
+        break;
+
+    case FIFO_CTRL1:
+    case FIFO_CTRL2:
+    case FIFO_CTRL3:
+        regs[reg] = value;
+        update_fifo_status();
+        break;
+
+    case INT1_CTRL:
+    case DRDY_PULSE_CFG_G:
+        regs[reg] = value;
+        drive_int1();
+        break;
+
+    case WHO_AM_I:
+    case STATUS_REG:
+        break;
+
+    default:
+        if (reg < OUT_TEMP_L || (reg > OUTZ_H_XL && reg < FIFO_STATUS1) || reg > FIFO_DATA_OUT_H) {
+            regs[reg] = value;
+        }
+        break;
+    }
+}
+
+void SimLSM6DSL::reset_registers() {
+    memset(regs, 0, sizeof(regs));
+    regs[WHO_AM_I] = 0x6A;
+    regs[CTRL3_C] = CTRL3_C_IF_INC;
+    fifo.clear();
+    overrun = false;
+    pattern = 0;
+    xl_last = g_last = fifo_last = SimClock::now();
+    update_fifo_status();
+}
+
+void SimLSM6DSL::sample_xl(int16_t *raw) {
+    float sensitivity = xl_sensitivity[(regs[CTRL1_XL] & CTRL_FS) >> 2];
+    float weight = (regs[CTRL6_C] & CTRL6_C_USR_OFF_W) ? 1000.0f / 64 : 1000.0f / 1024;
+
+    for (int i = 0; i < 3; i++) {
+        float offset = (int8_t)regs[X_OFS_USR + i] * weight;
+
+        raw[i] = saturate(lroundf((acceleration[i] - offset) / sensitivity));
+    }
+}
+
+void SimLSM6DSL::sample_g(int16_t *raw) {
+    float sensitivity = (regs[CTRL2_G] & CTRL2_G_FS_125) ? 4.375f : g_sensitivity[(regs[CTRL2_G] & CTRL_FS) >> 2];
+
+    for (int i = 0; i < 3; i++) {
+        raw[i] = saturate(lroundf(angular_rate[i] / sensitivity));
+    }
+}
+
+void SimLSM6DSL::count_sample(int16_t *raw, uint32_t *count) {
+    if (counting) {
+        raw[0] = (int16_t)*count;
+    }
+    (*count)++;
+}
+
+void SimLSM6DSL::output_xl() {
+    int16_t raw[3];
+    int16_t temp = saturate(lroundf((temperature - 25.0f) * 256.0f));
+
+    sample_xl(raw);
+    for (int i = 0; i < 3; i++) {
+        regs[OUTX_L_XL + 2 * i] = (uint16_t)raw[i] & 0xFF;
+        regs[OUTX_L_XL + 2 * i + 1] = (uint16_t)raw[i] >> 8;
+    }
+    regs[OUT_TEMP_L] = (uint16_t)temp & 0xFF;
+    regs[OUT_TEMP_H] = (uint16_t)temp >> 8;
+    regs[STATUS_REG] |= STATUS_XLDA | STATUS_TDA;
+
+    if ((regs[DRDY_PULSE_CFG_G] & DRDY_PULSED) && (regs[INT1_CTRL] & INT1_DRDY_XL)) {
+        SimPins::pulse(int1);
+    }
+    drive_int1();
+}
+
+void SimLSM6DSL::output_g() {
+    int16_t raw[3];
+
+    sample_g(raw);
+    for (int i = 0; i < 3; i++) {
+        regs[OUTX_L_G + 2 * i] = (uint16_t)raw[i] & 0xFF;
+        regs[OUTX_L_G + 2 * i + 1] = (uint16_t)raw[i] >> 8;
+    }
+    regs[STATUS_REG] |= STATUS_GDA;
+
+    if ((regs[DRDY_PULSE_CFG_G] & DRDY_PULSED) && (regs[INT1_CTRL] & INT1_DRDY_G)) {
+        SimPins::pulse(int1);
+    }
+    drive_int1();
+}
+
+void SimLSM6DSL::fifo_tick() {
+    uint32_t dec_g = decimation[(regs[FIFO_CTRL3] & FIFO_CTRL3_DEC_G) >> 3];
+    uint32_t dec_xl = decimation[regs[FIFO_CTRL3] & FIFO_CTRL3_DEC_XL];
+    std::vector<uint16_t> set;
+    int16_t raw[3];
+
+    /* A data set holds the gyroscope, then the accelerometer */
+    if (dec_g && fifo_ticks % dec_g == 0) {
+        sample_g(raw);
+        count_sample(raw, &g_count);
+        set.insert(set.end(), (uint16_t *)raw, (uint16_t *)raw + 3);
+    }
+    if (dec_xl && fifo_ticks % dec_xl == 0) {
+        sample_xl(raw);
+        count_sample(raw, &xl_count);
+        set.insert(set.end(), (uint16_t *)raw, (uint16_t *)raw + 3);
+    }
+    fifo_ticks++;
+
+    if (set.empty()) {
+        return;
+    }
+    if (fifo.size() + set.size() > FIFO_WORDS) {
+        if (fifo_stops_when_full()) {
+            return;
+        }
+        /* The oldest data set goes, the next word read is still its start */
+        fifo.erase(fifo.begin(), fifo.begin() + set.size());
+        overrun = true;
+    }
+    fifo.insert(fifo.end(), set.begin(), set.end());
+    update_fifo_status();
+}
+
+bool SimLSM6DSL::fifo_stops_when_full() {
+    return (regs[FIFO_CTRL5] & FIFO_CTRL5_MODE) == FIFO_MODE_FIFO;
+}
+
+void SimLSM6DSL::update_fifo_status() {
+    uint32_t fth = regs[FIFO_CTRL1] | ((regs[FIFO_CTRL2] & FIFO_CTRL2_FTH_H) << 8);
+    uint32_t dec_g = decimation[(regs[FIFO_CTRL3] & FIFO_CTRL3_DEC_G) >> 3];
+    uint32_t dec_xl = decimation[regs[FIFO_CTRL3] & FIFO_CTRL3_DEC_XL];
+    uint32_t set_size = (dec_g ? 3 : 0) + (dec_xl ? 3 : 0);
+    uint32_t level = fifo.size();
+    uint8_t status2 = (level >> 8) & 0x0F;
+
+    if (set_size) {
+        pattern %= set_size;
+    } else {
+        pattern = 0;
+    }
+
+    if (fth && level >= fth) {
+        status2 |= FIFO_STATUS2_WTM;
+    }
+    if (overrun) {
+        status2 |= FIFO_STATUS2_OVER_RUN;
+    }
+    if (set_size && level + set_size > FIFO_WORDS) {
+        status2 |= FIFO_STATUS2_FULL_SMART;
+    }
+    if (!level) {
+        status2 |= FIFO_STATUS2_EMPTY;
+    }
+
+    regs[FIFO_STATUS1] = level & 0xFF;
+    regs[FIFO_STATUS2] = status2;
+    regs[FIFO_STATUS3] = pattern & 0xFF;
+    regs[FIFO_STATUS4] = (pattern >> 8) & 0x03;
+    drive_int1();
+}
+
+void SimLSM6DSL::drive_int1() {
+    uint8_t ctrl = regs[INT1_CTRL];
+    bool active = false;
+
+    /* Pulsed data ready signals are sent by SimPins::pulse() */
+    if (!(regs[DRDY_PULSE_CFG_G] & DRDY_PULSED)) {
+        if ((ctrl & INT1_DRDY_XL) && (regs[STATUS_REG] & STATUS_XLDA)) {
+            active = true;
+        }
+        if ((ctrl & INT1_DRDY_G) && (regs[STATUS_REG] & STATUS_GDA)) {
+            active = true;
+        }
+    }
+    if ((ctrl & INT1_FTH) && (regs[FIFO_STATUS2] & FIFO_STATUS2_WTM)) {
+        active = true;
+    }
+    if ((ctrl & INT1_FIFO_OVR) && (regs[FIFO_STATUS2] & FIFO_STATUS2_OVER_RUN)) {
+        active = true;
+    }
+    if ((ctrl & INT1_FULL_FLAG) && (regs[FIFO_STATUS2] & FIFO_STATUS2_FULL_SMART)) {
+        active = true;
+    }
+    SimPins::drive(int1, active);
+}
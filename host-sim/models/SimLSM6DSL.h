@@ -0,0 +1,120 @@
+/**
+ ******************************************************************************
+ * @file    SimLSM6DSL.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Register level model of the LSM6DSL accelerometer and gyroscope.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SIM_LSM6DSL_H__
+#define __SIM_LSM6DSL_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <deque>
+#include "SimRegisterDevice.h"
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * LSM6DSL model.
+ *
+ *  - Multiple byte accesses move on to the next register while IF_INC is
+ *    set in CTRL3_C, as it is after reset, on either bus.
+ *  - The accelerometer and the gyroscope sample at the rates set in
+ *    CTRL1_XL and CTRL2_G, with the full scale set there; the user offsets
+ *    X/Y/Z_OFS_USR are subtracted from the accelerometer, weighted as set by
+ *    USR_OFF_W in CTRL6_C.
+ *  - At the FIFO rate, data sets of the gyroscope then the accelerometer,
+ *    each decimated as set in FIFO_CTRL3, go to the 2048 word FIFO. Reading
+ *    FIFO_DATA_OUT_H takes the word off and goes back to FIFO_DATA_OUT_L,
+ *    so that one burst reads many words. FIFO mode stops when full, the
+ *    continuous modes drop the oldest data set and flag an overrun.
+ *  - INT1 carries the data ready signals, latched or pulsed as set in
+ *    DRDY_PULSE_CFG_G, and the FIFO flags routed by INT1_CTRL. The embedded
+ *    functions are not modelled: their registers only hold what is written.
+ */
+class SimLSM6DSL : public SimRegisterDevice {
+public:
+    SimLSM6DSL(PinName int1 = NC);
+
+    /* Motion seen by the part, in mg and mdps, and its temperature. */
+    void set_acceleration(float x, float y, float z);
+    void set_angular_rate(float x, float y, float z);
+    void set_temperature(float celsius);
+
+    /* Makes the x axis of both sensors count the data sets going to the
+       FIFO, in LSB, so that a test can check that none is lost or reordered. */
+    void set_counting(bool counting);
+
+    uint32_t get_fifo_level();
+
+    virtual void update(uint64_t now);
+
+protected:
+    virtual bool increments(uint8_t data, bool spi);
+    virtual uint8_t next_address(uint8_t reg);
+    virtual uint8_t read_register(uint8_t reg);
+    virtual void write_register(uint8_t reg, uint8_t value);
+
+private:
+    void reset_registers();
+    void sample_xl(int16_t *raw);
+    void sample_g(int16_t *raw);
+    void count_sample(int16_t *raw, uint32_t *count);
+    void output_xl();
+    void output_g();
+    void fifo_tick();
+    bool fifo_stops_when_full();
+    void update_fifo_status();
+    void drive_int1();
+
+    PinName int1;
+    float acceleration[3];
+    float angular_rate[3];
+    float temperature;
+    bool counting;
+    uint32_t xl_count;
+    uint32_t g_count;
+    uint64_t xl_last;
+    uint64_t g_last;
+    uint64_t fifo_last;
+    uint32_t fifo_ticks;
+    uint32_t pattern;
+    bool overrun;
+    std::deque<uint16_t> fifo;
+};
+
+#endif // __SIM_LSM6DSL_H__
@@ -0,0 +1,170 @@
+/**
+ ******************************************************************************
+ * @file    SimM24LR.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Model of the M24LR64 dynamic NFC tag EEPROM on its I2C side.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <string.h>
+#include "SimM24LR.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define LOCK_REG                    0x0800
+#define UID_REG                     0x0914
+#define ICREF_REG                   0x091C
+#define MEMSIZE_REG                 0x091D
+#define CTRL_REG                    0x0920
+
+#define ICREF_M24LR64               0x5E
+#define CTRL_FIELD                  0x02
+#define CTRL_T_PROG                 0x80
+
+/* Variables -----------------------------------------------------------------*/
+
+static const uint8_t uid[8] = { 0x4E, 0x61, 0x2C, 0x10, 0x00, 0x2C, 0x02, 0xE0 };
+
+/* Class Implementation ------------------------------------------------------*/
+
+SimM24LR::SimM24LR() : data_address(0xA6), system_selected(false), address_bytes(0), pointer(0),
+        row_written(0), row_start(0), bytes_written(0), busy_until(0), write_cycles(0) {
+    /* Delivered erased */
+    memset(memory, 0xFF, sizeof(memory));
+    memset(system, 0x00, sizeof(system));
+    memcpy(system + UID_REG, uid, sizeof(uid));
+    system[ICREF_REG] = ICREF_M24LR64;
+    /* 2048 blocks of 4 bytes, each stored minus one */
+    system[MEMSIZE_REG] = 0xFF;
+    system[MEMSIZE_REG + 1] = 0x07;
+    system[MEMSIZE_REG + 2] = SIM_M24LR_ROW_SIZE - 1;
+}
+
+SimM24LR::~SimM24LR() {
+    SimI2CBus::instance().detach(this);
+}
+
+void SimM24LR::attach_i2c(uint8_t data_address, uint8_t system_address) {
+    this->data_address = data_address;
+    SimI2CBus::instance().attach(data_address, this);
+    SimI2CBus::instance().attach(system_address, this);
+}
+
+uint8_t SimM24LR::peek(uint16_t address) {
+    return memory[address % SIM_M24LR_MEMORY_SIZE];
+}
+
+void SimM24LR::poke(uint16_t address, uint8_t value) {
+    memory[address % SIM_M24LR_MEMORY_SIZE] = value;
+}
+
+uint32_t SimM24LR::get_write_cycles() {
+    return write_cycles;
+}
+
+bool SimM24LR::i2c_address(uint8_t address, bool read) {
+    /* Busy programming: no acknowledge, on either address */
+    if (SimClock::now() < busy_until) {
+        return false;
+    }
+
+    system_selected = address != data_address;
+    if (!read) {
+        address_bytes = 0;
+        row_written = 0;
+        bytes_written = 0;
+    }
+    return true;
+}
+
+bool SimM24LR::i2c_write(uint8_t data) {
+    if (address_bytes < 2) {
+        pointer = (pointer << 8) | data;
+        if (++address_bytes == 2) {
+            pointer %= area_size();
+            row_start = pointer - pointer % SIM_M24LR_ROW_SIZE;
+            memcpy(row, area() + row_start, SIM_M24LR_ROW_SIZE);
+        }
+        return true;
+    }
+
+    /* The row latches take the data, the bytes past its end wrap around */
+    uint8_t column = (pointer + bytes_written) % SIM_M24LR_ROW_SIZE;
+    row[column] = data;
+    row_written |= 1 << column;
+    bytes_written++;
+    return true;
+}
+
+uint8_t SimM24LR::i2c_read(bool ack) {
+    uint8_t value = area()[pointer];
+
+    if (system_selected && pointer == CTRL_REG) {
+        /* No RF field, no programming from the RF side */
+        value &= ~(CTRL_FIELD | CTRL_T_PROG);
+    }
+    pointer = (pointer + 1) % area_size();
+    return value;
+}
+
+void SimM24LR::i2c_stop() {
+    if (!row_written) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < SIM_M24LR_ROW_SIZE; i++) {
+        if ((row_written & (1 << i)) && writable(row_start + i)) {
+            area()[row_start + i] = row[i];
+        }
+    }
+    row_written = 0;
+    busy_until = SimClock::now() + SIM_M24LR_WRITE_TIME_NS;
+    write_cycles++;
+}
+
+uint8_t *SimM24LR::area() {
+    return system_selected ? system : memory;
+}
+
+uint32_t SimM24LR::area_size() {
+    return system_selected ? SIM_M24LR_SYSTEM_SIZE : SIM_M24LR_MEMORY_SIZE;
+}
+
+bool SimM24LR::writable(uint16_t address) {
+    if (!system_selected) {
+        return true;
+    }
+    return address < UID_REG || address >= CTRL_REG;
+}
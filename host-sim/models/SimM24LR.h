@@ -0,0 +1,122 @@
+/**
+ ******************************************************************************
+ * @file    SimM24LR.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Model of the M24LR64 dynamic NFC tag EEPROM on its I2C side.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SIM_M24LR_H__
+#define __SIM_M24LR_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "SimBus.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** User memory of the M24LR64, in bytes. */
+#define SIM_M24LR_MEMORY_SIZE       8192
+
+/** System area, from the sector security bytes up to the control register. */
+#define SIM_M24LR_SYSTEM_SIZE       0x0921
+
+/** Bytes programmed in one write cycle: a row of the memory array. */
+#define SIM_M24LR_ROW_SIZE          4
+
+/** Time of a write cycle, in ns. */
+#ifndef SIM_M24LR_WRITE_TIME_NS
+#define SIM_M24LR_WRITE_TIME_NS     5000000
+#endif
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * M24LR64 model.
+ *
+ * The user memory answers at the data address (0xA6) and the system area
+ * (sector security, lock bits, configuration, UID, IC reference, memory
+ * size and control) at the system address (0xAE), both with a 16-bit
+ * address sent MSB first. Reads run on to the following bytes. A write
+ * programs the bytes sent in the row of the first one, wrapping inside the
+ * row, when the stop condition comes; the device then does not acknowledge
+ * its addresses until the write cycle is over, which is what the driver
+ * polls for. The UID, IC reference and memory size are read only, and the
+ * RF side and the password protection are not modelled.
+ */
+class SimM24LR : public SimI2CDevice {
+public:
+    SimM24LR();
+    virtual ~SimM24LR();
+
+    /* Connects the device to the bus, at the data and system addresses. */
+    void attach_i2c(uint8_t data_address = 0xA6, uint8_t system_address = 0xAE);
+
+    /* Memory access for tests, without write cycles. */
+    uint8_t peek(uint16_t address);
+    void poke(uint16_t address, uint8_t value);
+
+    /* Write cycles completed since the model was created. */
+    uint32_t get_write_cycles();
+
+    /* SimI2CDevice */
+    virtual bool i2c_address(uint8_t address, bool read);
+    virtual bool i2c_write(uint8_t data);
+    virtual uint8_t i2c_read(bool ack);
+    virtual void i2c_stop();
+
+private:
+    uint8_t *area();
+    uint32_t area_size();
+    bool writable(uint16_t address);
+
+    uint8_t memory[SIM_M24LR_MEMORY_SIZE];
+    uint8_t system[SIM_M24LR_SYSTEM_SIZE];
+    uint8_t data_address;
+    bool system_selected;
+
+    uint32_t address_bytes;
+    uint16_t pointer;
+    uint8_t row[SIM_M24LR_ROW_SIZE];
+    uint8_t row_written;
+    uint16_t row_start;
+    uint32_t bytes_written;
+
+    uint64_t busy_until;
+    uint32_t write_cycles;
+};
+
+#endif // __SIM_M24LR_H__
@@ -0,0 +1,400 @@
+/**
+ ******************************************************************************
+ * @file    SimBus.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Simulated time, I2C and SPI buses and interrupt lines.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <algorithm>
+#include "SimBus.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define NS_PER_SECOND               1000000000ULL
+
+/* Variables -----------------------------------------------------------------*/
+
+static uint64_t sim_now = 0;
+
+/* Registered parts of the simulation; function statics so that objects
+   created during static initialization find them */
+static std::vector<SimDevice *> &sim_devices() {
+    static std::vector<SimDevice *> devices;
+    return devices;
+}
+
+static std::vector<EventQueue *> &sim_queues() {
+    static std::vector<EventQueue *> queues;
+    return queues;
+}
+
+static std::vector<Ticker *> &sim_tickers() {
+    static std::vector<Ticker *> tickers;
+    return tickers;
+}
+
+template <typename T>
+static void sim_remove(std::vector<T *> &list, T *item) {
+    list.erase(std::remove(list.begin(), list.end(), item), list.end());
+}
+
+/* SimClock ------------------------------------------------------------------*/
+
+uint64_t SimClock::now() {
+    return sim_now;
+}
+
+void SimClock::advance(uint64_t ns) {
+    sim_now += ns;
+}
+
+void SimClock::reset() {
+    sim_now = 0;
+}
+
+/* SimDevice -----------------------------------------------------------------*/
+
+SimDevice::SimDevice() {
+    SimScheduler::add(this);
+}
+
+SimDevice::~SimDevice() {
+    SimScheduler::remove(this);
+}
+
+/* SimI2CBus -----------------------------------------------------------------*/
+
+SimI2CBus &SimI2CBus::instance() {
+    static SimI2CBus bus;
+    return bus;
+}
+
+SimI2CBus::SimI2CBus() : current(NULL), addressing(false), active(false),
+        bit_time(NS_PER_SECOND / 100000) {
+    memset(devices, 0, sizeof(devices));
+    reset_stats();
+}
+
+void SimI2CBus::attach(uint8_t address, SimI2CDevice *device) {
+    devices[address >> 1] = device;
+}
+
+void SimI2CBus::detach(SimI2CDevice *device) {
+    for (int i = 0; i < 128; i++) {
+        if (devices[i] == device) {
+            devices[i] = NULL;
+        }
+    }
+}
+
+void SimI2CBus::frequency(int hz) {
+    bit_time = NS_PER_SECOND / hz;
+}
+
+void SimI2CBus::clock(uint32_t bits) {
+    stats.bus_time += bits * bit_time;
+    SimClock::advance(bits * bit_time);
+}
+
+void SimI2CBus::start() {
+    stats.starts++;
+    clock(1);
+    addressing = true;
+    active = true;
+}
+
+bool SimI2CBus::write(uint8_t data) {
+    bool ack;
+
+    stats.bytes++;
+    clock(9);
+
+    if (addressing) {
+        addressing = false;
+        current = devices[data >> 1];
+        ack = current && current->i2c_address(data & 0xFE, data & 1);
+        if (!ack) {
+            current = NULL;
+        }
+    } else {
+        ack = current && current->i2c_write(data);
+    }
+
+    if (!ack) {
+        stats.nacks++;
+    }
+    return ack;
+}
+
+uint8_t SimI2CBus::read(bool ack) {
+    stats.bytes++;
+    clock(9);
+
+    /* Nobody drives the line: it reads high */
+    return current ? current->i2c_read(ack) : 0xFF;
+}
+
+void SimI2CBus::stop() {
+    if (current) {
+        current->i2c_stop();
+        current = NULL;
+    }
+    if (active) {
+        stats.transactions++;
+        active = false;
+    }
+    clock(1);
+}
+
+void SimI2CBus::get_stats(SimBusStats *stats) {
+    *stats = this->stats;
+}
+
+void SimI2CBus::reset_stats() {
+    memset(&stats, 0, sizeof(stats));
+}
+
+/* SimSPIBus -----------------------------------------------------------------*/
+
+SimSPIBus &SimSPIBus::instance() {
+    static SimSPIBus bus;
+    return bus;
+}
+
+SimSPIBus::SimSPIBus() : current(NULL), three_wire(false), bit_time(NS_PER_SECOND / 1000000) {
+    memset(devices, 0, sizeof(devices));
+    reset_stats();
+}
+
+void SimSPIBus::attach(PinName cs, SimSPIDevice *device) {
+    if (cs >= 0 && cs < SIM_PIN_COUNT) {
+        devices[cs] = device;
+    }
+}
+
+void SimSPIBus::detach(SimSPIDevice *device) {
+    for (int i = 0; i < SIM_PIN_COUNT; i++) {
+        if (devices[i] == device) {
+            devices[i] = NULL;
+        }
+    }
+}
+
+void SimSPIBus::set_three_wire(bool three_wire) {
+    this->three_wire = three_wire;
+}
+
+void SimSPIBus::frequency(int hz) {
+    bit_time = NS_PER_SECOND / hz;
+}
+
+void SimSPIBus::chip_select(PinName pin, int level) {
+    if (pin < 0 || pin >= SIM_PIN_COUNT || !devices[pin]) {
+        return;
+    }
+
+    if (!level && current != devices[pin]) {
+        current = devices[pin];
+        current->spi_select();
+    } else if (level && current == devices[pin]) {
+        current->spi_deselect();
+        current = NULL;
+        stats.transactions++;
+    }
+}
+
+uint8_t SimSPIBus::transfer(uint8_t data) {
+    stats.bytes++;
+    stats.bus_time += 8 * bit_time;
+    SimClock::advance(8 * bit_time);
+
+    /* Nobody drives MISO: it reads high */
+    return current ? current->spi_transfer(data) : 0xFF;
+}
+
+int SimSPIBus::transfer(const char *tx, int tx_length, char *rx, int rx_length) {
+    if (three_wire) {
+        for (int i = 0; i < tx_length; i++) {
+            transfer((uint8_t)tx[i]);
+        }
+        for (int i = 0; i < rx_length; i++) {
+            rx[i] = (char)transfer(0xFF);
+        }
+        return tx_length + rx_length;
+    }
+
+    int total = tx_length > rx_length ? tx_length : rx_length;
+
+    for (int i = 0; i < total; i++) {
+        uint8_t in = transfer(i < tx_length ? (uint8_t)tx[i] : 0xFF);
+        if (i < rx_length) {
+            rx[i] = (char)in;
+        }
+    }
+    return total;
+}
+
+void SimSPIBus::get_stats(SimBusStats *stats) {
+    *stats = this->stats;
+}
+
+void SimSPIBus::reset_stats() {
+    memset(&stats, 0, sizeof(stats));
+}
+
+/* SimPins -------------------------------------------------------------------*/
+
+static int pin_level[SIM_PIN_COUNT];
+static int pin_seen[SIM_PIN_COUNT];
+static InterruptIn *pin_irq[SIM_PIN_COUNT];
+static uint32_t pin_pulses[SIM_PIN_COUNT];
+
+void SimPins::drive(PinName pin, int level) {
+    if (pin >= 0 && pin < SIM_PIN_COUNT) {
+        pin_level[pin] = level ? 1 : 0;
+    }
+}
+
+int SimPins::level(PinName pin) {
+    return (pin >= 0 && pin < SIM_PIN_COUNT) ? pin_level[pin] : 0;
+}
+
+void SimPins::pulse(PinName pin) {
+    if (pin >= 0 && pin < SIM_PIN_COUNT) {
+        pin_pulses[pin]++;
+    }
+}
+
+void SimPins::attach(PinName pin, InterruptIn *in) {
+    if (pin >= 0 && pin < SIM_PIN_COUNT) {
+        pin_irq[pin] = in;
+        pin_seen[pin] = pin_level[pin];
+    }
+}
+
+void SimPins::detach(InterruptIn *in) {
+    for (int i = 0; i < SIM_PIN_COUNT; i++) {
+        if (pin_irq[i] == in) {
+            pin_irq[i] = NULL;
+        }
+    }
+}
+
+bool SimPins::deliver() {
+    bool any = false;
+
+    for (int i = 0; i < SIM_PIN_COUNT; i++) {
+        if (pin_level[i] != pin_seen[i]) {
+            pin_seen[i] = pin_level[i];
+            if (pin_irq[i]) {
+                pin_irq[i]->edge(pin_level[i]);
+                any = true;
+            }
+        } else if (pin_pulses[i] && !pin_irq[i]) {
+            pin_pulses[i] = 0;
+        } else if (pin_pulses[i] && !pin_level[i]) {
+            /* One pulse per call, so that each handler run is seen */
+            pin_pulses[i]--;
+            pin_irq[i]->edge(1);
+            pin_irq[i]->edge(0);
+            any = true;
+        }
+    }
+    return any;
+}
+
+/* SimScheduler --------------------------------------------------------------*/
+
+void SimScheduler::add(SimDevice *device) {
+    sim_devices().push_back(device);
+}
+
+void SimScheduler::remove(SimDevice *device) {
+    sim_remove(sim_devices(), device);
+}
+
+void SimScheduler::add(EventQueue *queue) {
+    sim_queues().push_back(queue);
+}
+
+void SimScheduler::remove(EventQueue *queue) {
+    sim_remove(sim_queues(), queue);
+}
+
+void SimScheduler::add(Ticker *ticker) {
+    sim_tickers().push_back(ticker);
+}
+
+void SimScheduler::remove(Ticker *ticker) {
+    sim_remove(sim_tickers(), ticker);
+}
+
+void SimScheduler::step() {
+    bool busy = true;
+
+    /* Handlers and events move the clock and the devices on; go round until
+       everything has settled */
+    while (busy) {
+        busy = false;
+
+        for (size_t i = 0; i < sim_devices().size(); i++) {
+            sim_devices()[i]->update(SimClock::now());
+        }
+
+        busy |= SimPins::deliver();
+
+        std::vector<Ticker *> tickers = sim_tickers();
+        for (size_t i = 0; i < tickers.size(); i++) {
+            busy |= tickers[i]->poll(SimClock::now());
+        }
+
+        std::vector<EventQueue *> queues = sim_queues();
+        for (size_t i = 0; i < queues.size(); i++) {
+            busy |= queues[i]->run_pending();
+        }
+    }
+}
+
+void SimScheduler::run(uint64_t ns, uint64_t step_ns) {
+    uint64_t end = SimClock::now() + ns;
+
+    step();
+    while (SimClock::now() < end) {
+        uint64_t left = end - SimClock::now();
+        SimClock::advance(left < step_ns ? left : step_ns);
+        step();
+    }
+}
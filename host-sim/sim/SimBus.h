@@ -0,0 +1,235 @@
+/**
+ ******************************************************************************
+ * @file    SimBus.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Simulated time, I2C and SPI buses and interrupt lines for running
+ *          the sensor drivers on a host.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SIM_BUS_H__
+#define __SIM_BUS_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <vector>
+#include "mbed.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Default step of sim_run(), in ns: interrupts are seen within a step. */
+#ifndef SIM_STEP_NS
+#define SIM_STEP_NS                 100000
+#endif
+
+/* Types ---------------------------------------------------------------------*/
+
+/** Traffic seen on a simulated bus. */
+typedef struct {
+    uint32_t transactions;      /*!< I2C stop conditions, or SPI chip select cycles */
+    uint32_t bytes;             /*!< I2C address and data bytes, or SPI bytes clocked */
+    uint32_t starts;            /*!< I2C start and repeated start conditions */
+    uint32_t nacks;             /*!< I2C bytes not acknowledged */
+    uint64_t bus_time;          /*!< Time the bus was clocked, in ns */
+} SimBusStats;
+
+/* Class Declarations --------------------------------------------------------*/
+
+/**
+ * Simulated time, in ns.
+ *
+ * It only moves forward when the bus is clocked, when a driver waits and
+ * when the test runs the simulation with sim_run().
+ */
+class SimClock {
+public:
+    static uint64_t now();
+    static void advance(uint64_t ns);
+    static void reset();
+};
+
+/**
+ * Part of the simulation whose state moves with the time, such as a sensor
+ * sampling at its output data rate. Registered while it exists.
+ */
+class SimDevice {
+public:
+    SimDevice();
+    virtual ~SimDevice();
+
+    /* Brings the state up to the current time, called on every step. */
+    virtual void update(uint64_t now) {}
+};
+
+/** Device on the simulated I2C bus. */
+class SimI2CDevice {
+public:
+    virtual ~SimI2CDevice() {}
+
+    /* Start or repeated start addressed to the device; false to not acknowledge. */
+    virtual bool i2c_address(uint8_t address, bool read) = 0;
+    /* Byte written by the master; false to not acknowledge. */
+    virtual bool i2c_write(uint8_t data) = 0;
+    /* Byte read by the master, ack tells whether another one follows. */
+    virtual uint8_t i2c_read(bool ack) = 0;
+    /* Stop condition ending a transaction with the device. */
+    virtual void i2c_stop() = 0;
+};
+
+/** Device on the simulated SPI bus. */
+class SimSPIDevice {
+public:
+    virtual ~SimSPIDevice() {}
+
+    virtual void spi_select() = 0;
+    /* Byte clocked out by the master; returns the byte clocked in. */
+    virtual uint8_t spi_transfer(uint8_t data) = 0;
+    virtual void spi_deselect() = 0;
+};
+
+/**
+ * The simulated I2C bus every I2C object drives.
+ *
+ * Each byte takes 9 clocks and each start or stop condition one more, at
+ * the frequency set by the master; the clock moves forward accordingly.
+ */
+class SimI2CBus {
+public:
+    static SimI2CBus &instance();
+
+    /* Devices answer to their 8-bit address, read bit clear. */
+    void attach(uint8_t address, SimI2CDevice *device);
+    void detach(SimI2CDevice *device);
+
+    void frequency(int hz);
+    void start();
+    bool write(uint8_t data);
+    uint8_t read(bool ack);
+    void stop();
+
+    void get_stats(SimBusStats *stats);
+    void reset_stats();
+
+private:
+    SimI2CBus();
+    void clock(uint32_t bits);
+
+    SimI2CDevice *devices[128];
+    SimI2CDevice *current;
+    bool addressing;
+    bool active;
+    uint64_t bit_time;
+    SimBusStats stats;
+};
+
+/**
+ * The simulated SPI bus every SPI object drives.
+ *
+ * A device is selected while its chip select pin, driven with a DigitalOut,
+ * is low. Block transfers are full duplex, as SPI::write() documents; in
+ * 3-wire mode the bytes read follow the bytes written on the shared line.
+ */
+class SimSPIBus {
+public:
+    static SimSPIBus &instance();
+
+    void attach(PinName cs, SimSPIDevice *device);
+    void detach(SimSPIDevice *device);
+    void set_three_wire(bool three_wire);
+
+    void frequency(int hz);
+    void chip_select(PinName pin, int level);
+    uint8_t transfer(uint8_t data);
+    int transfer(const char *tx, int tx_length, char *rx, int rx_length);
+
+    void get_stats(SimBusStats *stats);
+    void reset_stats();
+
+private:
+    SimSPIBus();
+
+    SimSPIDevice *devices[SIM_PIN_COUNT];
+    SimSPIDevice *current;
+    bool three_wire;
+    uint64_t bit_time;
+    SimBusStats stats;
+};
+
+/**
+ * Levels of the pins the simulated devices drive, such as interrupt lines.
+ *
+ * Edges are delivered to the InterruptIn on the pin from the simulation
+ * loop, never from inside a bus transaction.
+ */
+class SimPins {
+public:
+    static void drive(PinName pin, int level);
+    static int level(PinName pin);
+    /* Short high pulse, such as a pulsed data ready signal: delivered as a
+       rising then a falling edge even if it is over within a step. */
+    static void pulse(PinName pin);
+
+    static void attach(PinName pin, InterruptIn *in);
+    static void detach(InterruptIn *in);
+
+    /* Delivers the edges seen since the last call; false if there were none. */
+    static bool deliver();
+};
+
+/**
+ * The simulation loop: moves the time forward in steps; on each step the
+ * devices are updated, then interrupt handlers, tickers and queued events
+ * run, as the interrupts and threads would on the target.
+ */
+class SimScheduler {
+public:
+    static void add(SimDevice *device);
+    static void remove(SimDevice *device);
+    static void add(EventQueue *queue);
+    static void remove(EventQueue *queue);
+    static void add(Ticker *ticker);
+    static void remove(Ticker *ticker);
+
+    static void step();
+    static void run(uint64_t ns, uint64_t step_ns = SIM_STEP_NS);
+};
+
+/** Runs the simulation for ns nanoseconds. */
+inline void sim_run(uint64_t ns) {
+    SimScheduler::run(ns);
+}
+
+#endif // __SIM_BUS_H__
@@ -0,0 +1,178 @@
+/**
+ ******************************************************************************
+ * @file    SimFlash.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Simulated internal flash and FlashIAP stand-in.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <sys/mman.h>
+#include "SimFlash.h"
+
+/* SimFlash ------------------------------------------------------------------*/
+
+SimFlash &SimFlash::instance() {
+    static SimFlash flash;
+    return flash;
+}
+
+SimFlash::SimFlash() : users(0), fault(false) {
+    // Map the memory where the part has its flash, so that flash addresses
+    // are valid pointers as on the target
+    void *addr = mmap((void *)(uintptr_t)SIM_FLASH_START, SIM_FLASH_SIZE, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr != (void *)(uintptr_t)SIM_FLASH_START) {
+        fprintf(stderr, "SimFlash: cannot map the flash at 0x%08X\n", SIM_FLASH_START);
+        abort();
+    }
+    memory = (uint8_t *)addr;
+    reset();
+}
+
+void SimFlash::reset() {
+    memset(memory, 0xFF, SIM_FLASH_SIZE);
+    users = 0;
+    fault = false;
+    clear_log();
+}
+
+uint8_t *SimFlash::data(uint32_t addr) {
+    return memory + (addr - SIM_FLASH_START);
+}
+
+void SimFlash::fail_next_program() {
+    fault = true;
+}
+
+void SimFlash::clear_log() {
+    programs.clear();
+    erases.clear();
+}
+
+bool SimFlash::init() {
+    users++;
+    return true;
+}
+
+bool SimFlash::deinit() {
+    if (users == 0) {
+        return false;
+    }
+    users--;
+    return true;
+}
+
+int SimFlash::program(const uint8_t *buffer, uint32_t addr, uint32_t size) {
+    if (users == 0 || addr < SIM_FLASH_START || size > SIM_FLASH_START + SIM_FLASH_SIZE - addr ||
+        addr % SIM_FLASH_PAGE_SIZE || size % SIM_FLASH_PAGE_SIZE) {
+        return -1;
+    }
+
+    uint8_t *dst = data(addr);
+    for (uint32_t i = 0; i < size; i++) {
+        if (dst[i] != 0xFF) {
+            return -1; // Programming over data that was not erased
+        }
+    }
+
+    memcpy(dst, buffer, size);
+    if (fault) {
+        dst[size / 2] ^= 0x01;
+        fault = false;
+    }
+    programs.push_back(addr);
+    return 0;
+}
+
+int SimFlash::erase(uint32_t addr, uint32_t size) {
+    if (users == 0 || addr < SIM_FLASH_START || size > SIM_FLASH_START + SIM_FLASH_SIZE - addr ||
+        addr % SIM_FLASH_SECTOR_SIZE || size % SIM_FLASH_SECTOR_SIZE) {
+        return -1;
+    }
+
+    memset(data(addr), 0xFF, size);
+    erases.push_back(addr);
+    return 0;
+}
+
+/* FlashIAP ------------------------------------------------------------------*/
+
+FlashIAP::FlashIAP() {
+    // Maps the flash before anything reads it through a pointer
+    SimFlash::instance();
+}
+
+int FlashIAP::init() {
+    return SimFlash::instance().init() ? 0 : -1;
+}
+
+int FlashIAP::deinit() {
+    return SimFlash::instance().deinit() ? 0 : -1;
+}
+
+int FlashIAP::read(void *buffer, uint32_t addr, uint32_t size) {
+    if (addr < SIM_FLASH_START || size > SIM_FLASH_START + SIM_FLASH_SIZE - addr) {
+        return -1;
+    }
+    memcpy(buffer, SimFlash::instance().data(addr), size);
+    return 0;
+}
+
+int FlashIAP::program(const void *buffer, uint32_t addr, uint32_t size) {
+    return SimFlash::instance().program((const uint8_t *)buffer, addr, size);
+}
+
+int FlashIAP::erase(uint32_t addr, uint32_t size) {
+    return SimFlash::instance().erase(addr, size);
+}
+
+uint32_t FlashIAP::get_page_size() const {
+    return SIM_FLASH_PAGE_SIZE;
+}
+
+uint32_t FlashIAP::get_sector_size(uint32_t addr) const {
+    if (addr < SIM_FLASH_START || addr >= SIM_FLASH_START + SIM_FLASH_SIZE) {
+        return 0;
+    }
+    return SIM_FLASH_SECTOR_SIZE;
+}
+
+uint32_t FlashIAP::get_flash_start() const {
+    return SIM_FLASH_START;
+}
+
+uint32_t FlashIAP::get_flash_size() const {
+    return SIM_FLASH_SIZE;
+}
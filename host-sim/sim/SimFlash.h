@@ -0,0 +1,104 @@
+/**
+ ******************************************************************************
+ * @file    SimFlash.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Simulated internal flash behind the FlashIAP stand-in.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SIM_FLASH_H__
+#define __SIM_FLASH_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <vector>
+#include "mbed.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Flash layout of an STM32L4 with 512 KB: 2 KB sectors, 8 byte pages. */
+#define SIM_FLASH_START             0x08000000
+#define SIM_FLASH_SIZE              0x80000
+#define SIM_FLASH_SECTOR_SIZE       0x800
+#define SIM_FLASH_PAGE_SIZE         8
+
+/* Class Declarations --------------------------------------------------------*/
+
+/**
+ * The simulated internal flash.
+ *
+ * The memory is mapped at SIM_FLASH_START, as on the target, so the code
+ * reading flash through pointers sees what FlashIAP programmed. Erasing sets
+ * whole sectors to 0xFF and programming only succeeds on erased, page aligned
+ * memory, as on the part. Every program and erase is logged so a test can
+ * check their order, and a fault can be injected in the next program.
+ */
+class SimFlash {
+public:
+    static SimFlash &instance();
+
+    /* Erases the whole flash and clears the log and the fault. */
+    void reset();
+
+    /* Contents at a flash address, for a test to check or corrupt. */
+    uint8_t *data(uint32_t addr);
+
+    /* Clears one bit of the next program, as a cell failing to program
+       does; the program still reports success. */
+    void fail_next_program();
+
+    /* Addresses of the programs and erases since the last clear_log(). */
+    const std::vector<uint32_t> &get_programs() const { return programs; }
+    const std::vector<uint32_t> &get_erases() const { return erases; }
+    void clear_log();
+
+    /* Called by FlashIAP. */
+    bool init();
+    bool deinit();
+    int program(const uint8_t *buffer, uint32_t addr, uint32_t size);
+    int erase(uint32_t addr, uint32_t size);
+
+private:
+    SimFlash();
+
+    uint8_t *memory;
+    int users;
+    bool fault;
+    std::vector<uint32_t> programs;
+    std::vector<uint32_t> erases;
+};
+
+#endif // __SIM_FLASH_H__
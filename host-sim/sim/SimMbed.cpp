@@ -0,0 +1,275 @@
+/**
+ ******************************************************************************
+ * @file    SimMbed.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Host implementation of the Mbed OS stand-in, on the simulated buses.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mbed.h"
+#include "SimBus.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define NS_PER_US                   1000ULL
+
+/* Time ----------------------------------------------------------------------*/
+
+void wait(float s) {
+    SimClock::advance((uint64_t)(s * 1e9f));
+}
+
+void wait_ms(int ms) {
+    SimClock::advance((uint64_t)ms * 1000 * NS_PER_US);
+}
+
+void wait_us(int us) {
+    SimClock::advance((uint64_t)us * NS_PER_US);
+}
+
+/* DigitalOut ----------------------------------------------------------------*/
+
+DigitalOut::DigitalOut(PinName pin) : pin(pin), value(0) {
+}
+
+DigitalOut::DigitalOut(PinName pin, int value) : pin(pin), value(0) {
+    write(value);
+}
+
+void DigitalOut::write(int value) {
+    this->value = value ? 1 : 0;
+    SimSPIBus::instance().chip_select(pin, this->value);
+}
+
+int DigitalOut::read() {
+    return value;
+}
+
+/* InterruptIn ---------------------------------------------------------------*/
+
+InterruptIn::InterruptIn(PinName pin) : pin(pin), enabled(true) {
+    if (pin != NC) {
+        SimPins::attach(pin, this);
+    }
+}
+
+InterruptIn::~InterruptIn() {
+    SimPins::detach(this);
+}
+
+int InterruptIn::read() {
+    return SimPins::level(pin);
+}
+
+void InterruptIn::rise(Callback<void()> func) {
+    on_rise = func;
+}
+
+void InterruptIn::fall(Callback<void()> func) {
+    on_fall = func;
+}
+
+void InterruptIn::enable_irq() {
+    enabled = true;
+}
+
+void InterruptIn::disable_irq() {
+    enabled = false;
+}
+
+void InterruptIn::edge(int level) {
+    if (!enabled) {
+        return;
+    }
+    if (level && on_rise) {
+        on_rise();
+    } else if (!level && on_fall) {
+        on_fall();
+    }
+}
+
+/* I2C -----------------------------------------------------------------------*/
+
+I2C::I2C(PinName sda, PinName scl) : bus(&SimI2CBus::instance()), hz(100000) {
+    bus->frequency(hz);
+}
+
+void I2C::frequency(int hz) {
+    this->hz = hz;
+    bus->frequency(hz);
+}
+
+int I2C::read(int address, char *data, int length, bool repeated) {
+    bus->frequency(hz);
+    bus->start();
+    if (!bus->write((uint8_t)(address | 1))) {
+        bus->stop();
+        return -1;
+    }
+    for (int i = 0; i < length; i++) {
+        data[i] = (char)bus->read(i < length - 1);
+    }
+    if (!repeated) {
+        bus->stop();
+    }
+    return 0;
+}
+
+int I2C::read(int ack) {
+    return bus->read(ack != 0);
+}
+
+int I2C::write(int address, const char *data, int length, bool repeated) {
+    bus->frequency(hz);
+    bus->start();
+    if (!bus->write((uint8_t)(address & 0xFE))) {
+        bus->stop();
+        return -1;
+    }
+    for (int i = 0; i < length; i++) {
+        if (!bus->write((uint8_t)data[i])) {
+            bus->stop();
+            return -1;
+        }
+    }
+    if (!repeated) {
+        bus->stop();
+    }
+    return 0;
+}
+
+int I2C::write(int data) {
+    return bus->write((uint8_t)data) ? 1 : 0;
+}
+
+void I2C::start(void) {
+    bus->frequency(hz);
+    bus->start();
+}
+
+void I2C::stop(void) {
+    bus->stop();
+}
+
+/* SPI -----------------------------------------------------------------------*/
+
+SPI::SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel) :
+        bus(&SimSPIBus::instance()), _bits(8), _mode(0), _hz(1000000) {
+}
+
+void SPI::format(int bits, int mode) {
+    _bits = bits;
+    _mode = mode;
+}
+
+void SPI::frequency(int hz) {
+    _hz = hz;
+    bus->frequency(hz);
+}
+
+int SPI::write(int value) {
+    bus->frequency(_hz);
+    return bus->transfer((uint8_t)value);
+}
+
+int SPI::write(const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length) {
+    bus->frequency(_hz);
+    return bus->transfer(tx_buffer, tx_length, rx_buffer, rx_length);
+}
+
+/* EventQueue ----------------------------------------------------------------*/
+
+EventQueue::EventQueue(unsigned size) {
+    SimScheduler::add(this);
+}
+
+EventQueue::~EventQueue() {
+    SimScheduler::remove(this);
+}
+
+void EventQueue::dispatch(int ms) {
+    run_pending();
+    if (ms > 0) {
+        wait_ms(ms);
+    }
+}
+
+bool EventQueue::run_pending() {
+    bool ran = false;
+
+    while (!pending.empty()) {
+        std::vector<std::function<void()> > calls;
+        calls.swap(pending);
+        for (size_t i = 0; i < calls.size(); i++) {
+            calls[i]();
+        }
+        ran = true;
+    }
+    return ran;
+}
+
+/* Ticker --------------------------------------------------------------------*/
+
+Ticker::Ticker() : period(0), next(0) {
+    SimScheduler::add(this);
+}
+
+Ticker::~Ticker() {
+    SimScheduler::remove(this);
+}
+
+void Ticker::attach(Callback<void()> func, float t) {
+    attach_us(func, (uint32_t)(t * 1e6f));
+}
+
+void Ticker::attach_us(Callback<void()> func, uint32_t t) {
+    handler = func;
+    period = (uint64_t)t * NS_PER_US;
+    next = SimClock::now() + period;
+}
+
+void Ticker::detach() {
+    handler = Callback<void()>();
+    period = 0;
+}
+
+bool Ticker::poll(uint64_t now) {
+    if (!period || !handler || now < next) {
+        return false;
+    }
+    next += period;
+    handler();
+    return true;
+}
@@ -0,0 +1,162 @@
+/**
+ ******************************************************************************
+ * @file    SimRegisterDevice.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Register map of a simulated sensor, reached over I2C or SPI.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SimRegisterDevice.h"
+
+/* Class Implementation ------------------------------------------------------*/
+
+SimRegisterDevice::SimRegisterDevice() : phase(IDLE), pointer(0), incrementing(false), cs(NC) {
+    memset(regs, 0, sizeof(regs));
+}
+
+SimRegisterDevice::~SimRegisterDevice() {
+    SimI2CBus::instance().detach(this);
+    SimSPIBus::instance().detach(this);
+}
+
+void SimRegisterDevice::attach_i2c(uint8_t address) {
+    SimI2CBus::instance().attach(address, this);
+}
+
+void SimRegisterDevice::attach_spi(PinName cs) {
+    this->cs = cs;
+    SimSPIBus::instance().attach(cs, this);
+}
+
+uint8_t SimRegisterDevice::peek(uint8_t reg) {
+    return regs[reg];
+}
+
+void SimRegisterDevice::poke(uint8_t reg, uint8_t value) {
+    regs[reg] = value;
+}
+
+bool SimRegisterDevice::i2c_address(uint8_t address, bool read) {
+    update(SimClock::now());
+    phase = read ? READ : ADDRESS;
+    return true;
+}
+
+bool SimRegisterDevice::i2c_write(uint8_t data) {
+    if (phase == ADDRESS) {
+        pointer = first_address(data, false);
+        incrementing = increments(data, false);
+        phase = WRITE;
+    } else if (phase == WRITE) {
+        write_register(pointer, data);
+        advance();
+    } else {
+        return false;
+    }
+    return true;
+}
+
+uint8_t SimRegisterDevice::i2c_read(bool ack) {
+    uint8_t value = read_register(pointer);
+    advance();
+    return value;
+}
+
+void SimRegisterDevice::i2c_stop() {
+    phase = IDLE;
+    end_access();
+}
+
+void SimRegisterDevice::spi_select() {
+    update(SimClock::now());
+    phase = ADDRESS;
+}
+
+uint8_t SimRegisterDevice::spi_transfer(uint8_t data) {
+    uint8_t value = 0xFF;
+
+    if (phase == ADDRESS) {
+        pointer = first_address(data, true);
+        incrementing = increments(data, true);
+        phase = (data & 0x80) ? READ : WRITE;
+    } else if (phase == READ) {
+        value = read_register(pointer);
+        advance();
+    } else if (phase == WRITE) {
+        write_register(pointer, data);
+        advance();
+    }
+    return value;
+}
+
+void SimRegisterDevice::spi_deselect() {
+    phase = IDLE;
+    end_access();
+}
+
+uint8_t SimRegisterDevice::first_address(uint8_t data, bool spi) {
+    return data & 0x7F;
+}
+
+uint8_t SimRegisterDevice::next_address(uint8_t reg) {
+    return reg + 1;
+}
+
+uint8_t SimRegisterDevice::read_register(uint8_t reg) {
+    return regs[reg];
+}
+
+void SimRegisterDevice::write_register(uint8_t reg, uint8_t value) {
+    regs[reg] = value;
+}
+
+uint32_t SimRegisterDevice::samples_due(uint64_t now, float rate, uint64_t *last) {
+    if (rate <= 0.0f) {
+        *last = now;
+        return 0;
+    }
+
+    uint64_t period = (uint64_t)(1e9f / rate);
+    uint32_t due = (uint32_t)((now - *last) / period);
+
+    *last += (uint64_t)due * period;
+    return due;
+}
+
+void SimRegisterDevice::advance() {
+    if (incrementing) {
+        pointer = next_address(pointer);
+    }
+}
@@ -0,0 +1,117 @@
+/**
+ ******************************************************************************
+ * @file    SimRegisterDevice.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Register map of a simulated sensor, reached over I2C or SPI.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SIM_REGISTER_DEVICE_H__
+#define __SIM_REGISTER_DEVICE_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "SimBus.h"
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Register map of an ST sensor with the usual serial protocol.
+ *
+ * Over I2C the first byte written is the register address, then data bytes
+ * are written or, after a repeated start, read. Over SPI the first byte is
+ * the register address with the read bit (bit 7) set for a read. Parts
+ * decide whether the address moves on after each byte and where it goes,
+ * and give registers side effects, by overriding the hooks below.
+ */
+class SimRegisterDevice : public SimDevice, public SimI2CDevice, public SimSPIDevice {
+public:
+    SimRegisterDevice();
+    virtual ~SimRegisterDevice();
+
+    /* Connects the device to a bus. */
+    void attach_i2c(uint8_t address);
+    void attach_spi(PinName cs);
+
+    /* Register access for tests, without side effects. */
+    uint8_t peek(uint8_t reg);
+    void poke(uint8_t reg, uint8_t value);
+
+    /* SimI2CDevice */
+    virtual bool i2c_address(uint8_t address, bool read);
+    virtual bool i2c_write(uint8_t data);
+    virtual uint8_t i2c_read(bool ack);
+    virtual void i2c_stop();
+
+    /* SimSPIDevice */
+    virtual void spi_select();
+    virtual uint8_t spi_transfer(uint8_t data);
+    virtual void spi_deselect();
+
+protected:
+    /* Register addressed by the first byte of an access. */
+    virtual uint8_t first_address(uint8_t data, bool spi);
+    /* Whether the address moves on after each byte of this access. */
+    virtual bool increments(uint8_t data, bool spi) = 0;
+    /* Register following reg in a multiple byte access. */
+    virtual uint8_t next_address(uint8_t reg);
+    /* Register accesses by the master, with their side effects. */
+    virtual uint8_t read_register(uint8_t reg);
+    virtual void write_register(uint8_t reg, uint8_t value);
+    /* End of a transaction with the device. */
+    virtual void end_access() {}
+
+    /* Samples due at rate Hz between *last and now; moves *last on to the
+       time of the last one counted. */
+    static uint32_t samples_due(uint64_t now, float rate, uint64_t *last);
+
+    uint8_t regs[256];
+
+private:
+    void advance();
+
+    enum {
+        IDLE,
+        ADDRESS,
+        WRITE,
+        READ
+    } phase;
+    uint8_t pointer;
+    bool incrementing;
+    PinName cs;
+};
+
+#endif // __SIM_REGISTER_DEVICE_H__
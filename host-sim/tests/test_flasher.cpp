@@ -0,0 +1,277 @@
+/**
+ ******************************************************************************
+ * @file    test_flasher.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Test of the script banks of Flasher on the simulated flash.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <string.h>
+#include "SimCheck.h"
+#include "SimFlash.h"
+#include "Flasher.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/* Spans five sectors, with the header */
+#define SCRIPT_SIZE                 10000
+
+/* Variables -----------------------------------------------------------------*/
+
+static char script[SCRIPT_SIZE];
+
+/* Chunk sizes of a streamed write: not page multiples, and some over a sector */
+static const uint32_t chunk_sizes[] = { 1, 7, 100, 333, 2048, 5000, 13 };
+
+/* Functions -----------------------------------------------------------------*/
+
+static void make_script(uint32_t seed) {
+    for (int i = 0; i < SCRIPT_SIZE; i++) {
+        seed = seed * 1103515245 + 12345;
+        script[i] = (char)(seed >> 16);
+    }
+}
+
+/* Streams the script in chunks of uneven sizes; stops before end_write() */
+static int stream_script(uint32_t length) {
+    int ret = Flasher::begin_write(length);
+    uint32_t offset = 0;
+    for (int i = 0; ret == 0 && offset < SCRIPT_SIZE; i = (i + 1) % 7) {
+        uint32_t size = chunk_sizes[i];
+        if (size > SCRIPT_SIZE - offset) {
+            size = SCRIPT_SIZE - offset;
+        }
+        ret = Flasher::write_chunk(script + offset, size);
+        offset += size;
+    }
+    return ret;
+}
+
+static bool holds_script(int bank) {
+    uint32_t length = 0;
+    const char *data = Flasher::read_from_flash(bank, &length);
+    return data != 0 && length == SCRIPT_SIZE && memcmp(data, script, SCRIPT_SIZE) == 0 &&
+           Flasher::verify_flash(bank) == 0;
+}
+
+static void test_layout() {
+    BENCH_CHECK(Flasher::get_flash_address() == POST_APPLICATION_ADDR);
+    BENCH_CHECK(Flasher::get_bank_address(0) == 0x08040000);
+    BENCH_CHECK(Flasher::get_bank_address(1) == 0x08060000);
+    BENCH_CHECK(Flasher::get_bank_size(0) == 0x20000 && Flasher::get_bank_size(1) == 0x20000);
+    BENCH_CHECK(Flasher::header_size() == 24);
+    BENCH_CHECK(Flasher::get_active_bank() == -1);
+    BENCH_CHECK(Flasher::read_from_flash() == 0);
+}
+
+/* A script spanning several sectors, streamed, then written in one go */
+static void test_multi_sector() {
+    SimFlash &flash = SimFlash::instance();
+    uint32_t bank = Flasher::get_bank_address(0);
+
+    make_script(1);
+    flash.clear_log();
+    BENCH_CHECK(stream_script(SCRIPT_SIZE) == 0);
+    BENCH_CHECK(Flasher::end_write() == 0);
+    BENCH_CHECK(Flasher::get_active_bank() == 0);
+    BENCH_CHECK(Flasher::get_header(0)->version == 1);
+    BENCH_CHECK(holds_script(0));
+
+    /* Only the sectors the image covers are erased, each one once */
+    uint32_t sectors = (Flasher::header_size() + SCRIPT_SIZE + SIM_FLASH_SECTOR_SIZE - 1) /
+                       SIM_FLASH_SECTOR_SIZE;
+    BENCH_CHECK(flash.get_erases().size() == sectors);
+    for (uint32_t i = 0; i < flash.get_erases().size(); i++) {
+        BENCH_CHECK(flash.get_erases()[i] == bank + i * SIM_FLASH_SECTOR_SIZE);
+    }
+
+    /* A length not given up front */
+    make_script(2);
+    BENCH_CHECK(stream_script(FLASHER_LENGTH_UNKNOWN) == 0);
+    BENCH_CHECK(Flasher::end_write() == 0);
+    BENCH_CHECK(Flasher::get_active_bank() == 1);
+    BENCH_CHECK(Flasher::get_header(1)->version == 2);
+    BENCH_CHECK(holds_script(1));
+
+    /* The next write goes back to bank 0 */
+    make_script(3);
+    BENCH_CHECK(Flasher::write_to_flash(script, SCRIPT_SIZE) == 0);
+    BENCH_CHECK(Flasher::get_active_bank() == 0);
+    BENCH_CHECK(Flasher::get_header(0)->version == 3);
+    BENCH_CHECK(holds_script(0));
+
+    /* Too large for a bank */
+    BENCH_CHECK(Flasher::begin_write(Flasher::get_bank_size(1)) == 3);
+    BENCH_CHECK(Flasher::get_active_bank() == 0);
+}
+
+/* The header goes in last, so the previous script stays active until then */
+static void test_header_last() {
+    SimFlash &flash = SimFlash::instance();
+    int active = Flasher::get_active_bank();
+    int target = Flasher::get_inactive_bank();
+    uint32_t version = Flasher::get_header(active)->version;
+    uint32_t bank = Flasher::get_bank_address(target);
+
+    make_script(4);
+    flash.clear_log();
+    BENCH_CHECK(stream_script(SCRIPT_SIZE) == 0);
+    BENCH_CHECK(Flasher::flush_write() == 0);
+
+    /* Payload programmed and verified, header not yet */
+    BENCH_CHECK(Flasher::get_header(target) == 0);
+    BENCH_CHECK(Flasher::get_active_bank() == active);
+    uint32_t length = 0;
+    const char *data = Flasher::get_write_data(&length);
+    BENCH_CHECK(data != 0 && length == SCRIPT_SIZE && memcmp(data, script, SCRIPT_SIZE) == 0);
+
+    /* Pages in order, then the header, the page with the magic last */
+    BENCH_CHECK(Flasher::end_write() == 0);
+    const std::vector<uint32_t> &programs = flash.get_programs();
+    BENCH_CHECK(programs.size() > 2 && programs.back() == bank);
+    BENCH_CHECK(programs[programs.size() - 2] == bank + SIM_FLASH_PAGE_SIZE);
+    for (uint32_t i = 0; i + 2 < programs.size(); i++) {
+        BENCH_CHECK(programs[i] >= bank + Flasher::header_size());
+        BENCH_CHECK(i == 0 || programs[i] > programs[i - 1]);
+    }
+    BENCH_CHECK(Flasher::get_active_bank() == target);
+    BENCH_CHECK(Flasher::get_header(target)->version == version + 1);
+
+    /* A write dropped after the payload leaves the script just written active */
+    active = target;
+    target = Flasher::get_inactive_bank();
+    make_script(5);
+    BENCH_CHECK(stream_script(SCRIPT_SIZE) == 0);
+    BENCH_CHECK(Flasher::flush_write() == 0);
+    Flasher::abort_write();
+    BENCH_CHECK(Flasher::get_header(target) == 0);
+    BENCH_CHECK(Flasher::get_active_bank() == active);
+    make_script(4);
+    BENCH_CHECK(holds_script(active));
+
+    /* Invalidating the active bank rolls back to the other one, if valid */
+    BENCH_CHECK(Flasher::invalidate_bank(active) == 0);
+    BENCH_CHECK(Flasher::get_active_bank() == -1);
+}
+
+/* A page failing to program is caught before the header goes in */
+static void test_crc_mismatch() {
+    SimFlash &flash = SimFlash::instance();
+
+    make_script(6);
+    BENCH_CHECK(Flasher::write_to_flash(script, SCRIPT_SIZE) == 0);
+    int active = Flasher::get_active_bank();
+    int target = Flasher::get_inactive_bank();
+    uint32_t bank = Flasher::get_bank_address(target);
+
+    make_script(7);
+    flash.clear_log();
+    BENCH_CHECK(Flasher::begin_write(SCRIPT_SIZE) == 0);
+    flash.fail_next_program();
+    BENCH_CHECK(Flasher::write_chunk(script, SCRIPT_SIZE) == 0);
+    BENCH_CHECK(Flasher::end_write() == 4);
+
+    /* No header programmed, the previous script still active */
+    for (uint32_t i = 0; i < flash.get_programs().size(); i++) {
+        BENCH_CHECK(flash.get_programs()[i] != bank);
+    }
+    BENCH_CHECK(Flasher::get_header(target) == 0);
+    BENCH_CHECK(Flasher::get_active_bank() == active);
+    make_script(6);
+    BENCH_CHECK(holds_script(active));
+
+    /* A stored payload gone bad is reported by verify_flash() */
+    uint32_t length = 0;
+    const char *data = Flasher::read_from_flash(active, &length);
+    flash.data((uint32_t)(uintptr_t)data)[length / 3] ^= 0x10;
+    BENCH_CHECK(Flasher::verify_flash(active) == 4);
+}
+
+/* Headers cut short by a power loss never make their bank active */
+static void test_torn_header() {
+    SimFlash &flash = SimFlash::instance();
+
+    make_script(8);
+    BENCH_CHECK(Flasher::write_to_flash(script, SCRIPT_SIZE) == 0);
+    int active = Flasher::get_active_bank();
+    int target = Flasher::get_inactive_bank();
+    flasher_header_t header = *Flasher::get_header(active);
+    uint8_t *torn = flash.data(Flasher::get_bank_address(target));
+
+    /* The payload of a newer script, then only part of its header */
+    make_script(9);
+    BENCH_CHECK(stream_script(SCRIPT_SIZE) == 0);
+    BENCH_CHECK(Flasher::flush_write() == 0);
+    Flasher::abort_write();
+    header.version++;
+    header.crc = Flasher::crc32(script, SCRIPT_SIZE);
+
+    /* Magic and format in, version and length still erased */
+    memcpy(torn, &header, 8);
+    BENCH_CHECK(Flasher::get_header(target) == 0);
+    BENCH_CHECK(Flasher::get_active_bank() == active);
+    uint32_t length = 0;
+    BENCH_CHECK(Flasher::read_from_flash(&length) != 0 && length == SCRIPT_SIZE);
+
+    /* Version and length in, CRC32 still erased */
+    memcpy(torn + 8, &header.version, 8);
+    BENCH_CHECK(Flasher::get_header(target) == 0);
+    BENCH_CHECK(Flasher::get_active_bank() == active);
+
+    /* Whole header: the newer script wins */
+    memcpy(torn + 16, &header.crc, 4);
+    BENCH_CHECK(Flasher::get_active_bank() == target);
+    BENCH_CHECK(holds_script(target));
+
+    /* A length past the end of the bank */
+    header.length = Flasher::get_bank_size(target);
+    memcpy(torn + 12, &header.length, 4);
+    BENCH_CHECK(Flasher::get_header(target) == 0);
+    BENCH_CHECK(Flasher::get_active_bank() == active);
+    make_script(8);
+    BENCH_CHECK(holds_script(active));
+}
+
+int main() {
+    SimFlash::instance().reset();
+
+    test_layout();
+    test_multi_sector();
+    test_header_last();
+    test_crc_mismatch();
+    test_torn_header();
+
+    return bench_report("test_flasher");
+}
@@ -0,0 +1,186 @@
+/**
+ ******************************************************************************
+ * @file    test_script_update.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Test of the update decoder of ScriptUpdate on the simulated flash.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <string.h>
+#include "SimCheck.h"
+#include "SimFlash.h"
+#include "ScriptUpdate.h"
+
+/* Variables -----------------------------------------------------------------*/
+
+static const char base_script[] = "var led = DigitalOut(LED1);\nsetInterval(function() { led.write(!led.read()); }, 500);\n";
+static const char new_script[]  = "var led = DigitalOut(LED1);\nsetInterval(function() { led.write(!led.read()); }, 100);\n";
+
+static char update[256];
+static uint32_t update_size;
+
+/* Functions -----------------------------------------------------------------*/
+
+static void put_u32(char *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (char)(value >> (8 * i));
+    }
+}
+
+static void put_header(uint8_t type, const char *script, uint32_t length, uint32_t base_crc) {
+    memset(update, 0, SCRIPT_UPDATE_HEADER_SIZE);
+    put_u32(update, SCRIPT_UPDATE_MAGIC);
+    update[4] = (char)type;
+    put_u32(update + 8, length);
+    put_u32(update + 12, Flasher::crc32(script, length));
+    put_u32(update + 16, base_crc);
+    update_size = SCRIPT_UPDATE_HEADER_SIZE;
+}
+
+static void put_bytes(const char *data, uint32_t size) {
+    memcpy(update + update_size, data, size);
+    update_size += size;
+}
+
+static void put_byte(uint8_t byte) {
+    update[update_size++] = (char)byte;
+}
+
+/* Decodes the update one byte at a time, returns the first error */
+static int decode(UpdateDecoder &decoder) {
+    decoder.reset();
+    for (uint32_t i = 0; i < update_size; i++) {
+        int ret = decoder.write(update + i, 1);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+    return decoder.finish();
+}
+
+static bool holds(const char *script, uint32_t length) {
+    uint32_t stored = 0;
+    const char *data = Flasher::read_from_flash(&stored);
+    return data != 0 && stored == length && memcmp(data, script, length) == 0;
+}
+
+/* Literals and copies back in the script written so far */
+static void test_compressed() {
+    UpdateDecoder decoder;
+    char script[60];
+    for (int i = 0; i < 60; i++) {
+        script[i] = "abc"[i % 3];
+    }
+
+    put_header(SCRIPT_UPDATE_COMPRESSED, script, 60, 0);
+    put_byte(SCRIPT_UPDATE_OP_LITERAL);
+    put_byte(3);
+    put_bytes(script, 3);
+    put_byte(SCRIPT_UPDATE_OP_COPY);
+    put_byte(57);
+    put_byte(3);
+    BENCH_CHECK(decode(decoder) == 0);
+    BENCH_CHECK(Flasher::end_write() == 0);
+    BENCH_CHECK(holds(script, 60));
+}
+
+/* Copies from the installed script, which must be the base */
+static void test_delta() {
+    UpdateDecoder decoder;
+    uint32_t length = sizeof(base_script) - 1;
+    uint32_t tail = length - 8;
+
+    BENCH_CHECK(Flasher::write_to_flash(base_script, length) == 0);
+    uint32_t base_crc = Flasher::get_header(Flasher::get_active_bank())->crc;
+
+    /* Same as the base up to the interval, then a new tail */
+    put_header(SCRIPT_UPDATE_DELTA, new_script, length, base_crc);
+    put_byte(SCRIPT_UPDATE_OP_BASE);
+    put_byte(tail);
+    put_byte(0);
+    put_byte(SCRIPT_UPDATE_OP_LITERAL);
+    put_byte(8);
+    put_bytes(new_script + tail, 8);
+    BENCH_CHECK(decode(decoder) == 0);
+    BENCH_CHECK(Flasher::end_write() == 0);
+    BENCH_CHECK(holds(new_script, length));
+
+    /* Built against the script it replaced */
+    put_u32(update + 16, base_crc);
+    BENCH_CHECK(decode(decoder) == 7);
+    BENCH_CHECK(holds(new_script, length));
+
+    /* The installed program is a snapshot, not the source of the base */
+    BENCH_CHECK(Flasher::write_to_flash(base_script, length, FLASHER_FLAG_SNAPSHOT) == 0);
+    put_u32(update + 16, Flasher::get_header(Flasher::get_active_bank())->crc);
+    BENCH_CHECK(decode(decoder) == 8);
+    BENCH_CHECK(holds(base_script, length));
+}
+
+/* A varint carries at most 32 bits: 4 in its fifth byte */
+static void test_varint() {
+    UpdateDecoder decoder;
+    const char *script = "abcd";
+
+    /* 2^32, read as a zero length literal if the high bits were dropped */
+    put_header(SCRIPT_UPDATE_COMPRESSED, script, 4, 0);
+    put_byte(SCRIPT_UPDATE_OP_LITERAL);
+    put_bytes("\x80\x80\x80\x80\x10", 5);
+    put_byte(SCRIPT_UPDATE_OP_LITERAL);
+    put_byte(4);
+    put_bytes(script, 4);
+    BENCH_CHECK(decode(decoder) == 6);
+
+    /* A padded zero still fits */
+    update[SCRIPT_UPDATE_HEADER_SIZE + 5] = 0;
+    BENCH_CHECK(decode(decoder) == 0);
+    BENCH_CHECK(Flasher::end_write() == 0);
+    BENCH_CHECK(holds(script, 4));
+
+    /* A sixth byte */
+    update_size = SCRIPT_UPDATE_HEADER_SIZE + 1;
+    put_bytes("\x80\x80\x80\x80\x80\x00", 6);
+    BENCH_CHECK(decode(decoder) == 6);
+}
+
+int main() {
+    SimFlash::instance().reset();
+
+    test_compressed();
+    test_delta();
+    test_varint();
+
+    return bench_report("test_script_update");
+}
@@ -0,0 +1,251 @@
+/**
+ ******************************************************************************
+ * @file    test_sensor_dsp.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Test of the SensorDSP chain: biquad design, decimation and window
+ *          features against known signals.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <math.h>
+#include "SimCheck.h"
+#include "SensorDSP.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+#define RATE                100.0f
+
+/* Functions -----------------------------------------------------------------*/
+
+/* Runs one value through a single channel chain with windows of one sample,
+   returns whether an output came out and writes it */
+static bool step(SensorDSP &dsp, float value, float *out) {
+    float features[SENSOR_DSP_MAX_CHANNELS * SENSOR_DSP_FEATURES];
+
+    if (!dsp.process(&value, features)) {
+        return false;
+    }
+    *out = features[0];
+    return true;
+}
+
+/* Gain of a cookbook biquad at a frequency, designed in double precision */
+static double design_gain(int type, double freq, double q, double rate, double at) {
+    double w0 = 2.0 * M_PI * freq / rate;
+    double alpha = sin(w0) / (2.0 * q);
+    double b[3], a[3] = { 1.0 + alpha, -2.0 * cos(w0), 1.0 - alpha };
+
+    if (type == 0) {
+        b[0] = b[2] = (1.0 - cos(w0)) / 2.0;
+        b[1] = 1.0 - cos(w0);
+    } else if (type == 1) {
+        b[0] = b[2] = (1.0 + cos(w0)) / 2.0;
+        b[1] = -(1.0 + cos(w0));
+    } else {
+        b[0] = alpha;
+        b[1] = 0.0;
+        b[2] = -alpha;
+    }
+
+    // H(z) on the unit circle, z = e^jw
+    double w = 2.0 * M_PI * at / rate;
+    double num_re = b[0] + b[1] * cos(w) + b[2] * cos(2.0 * w);
+    double num_im = -b[1] * sin(w) - b[2] * sin(2.0 * w);
+    double den_re = a[0] + a[1] * cos(w) + a[2] * cos(2.0 * w);
+    double den_im = -a[1] * sin(w) - a[2] * sin(2.0 * w);
+    return sqrt((num_re * num_re + num_im * num_im) / (den_re * den_re + den_im * den_im));
+}
+
+/* Mean, rms and peak of constant, sine and square signals, on selected values */
+static void test_window() {
+    SensorDSP dsp;
+    const uint8_t channels[3] = { 2, 0, 1 };
+    BENCH_CHECK(dsp.configure(RATE, 3, channels, 3) == 0);
+    BENCH_CHECK(dsp.set_window(100) == 0);
+
+    // 5 full periods of a sine on value 0, a constant on value 2 and a
+    // square wave on value 1
+    float features[3 * SENSOR_DSP_FEATURES];
+    for (int pass = 0; pass < 2; pass++) {
+        for (int n = 0; n < 100; n++) {
+            float values[3] = {
+                2.5f * sinf(2.0f * 3.14159265f * 5.0f * n / 100.0f),
+                (n % 10) < 5 ? 1.5f : -0.5f,
+                -3.0f
+            };
+            bool done = dsp.process(values, features);
+            BENCH_CHECK(done == (n == 99));
+        }
+
+        BENCH_NEAR(features[0], -3.0, 1e-5);
+        BENCH_NEAR(features[1], 3.0, 1e-5);
+        BENCH_NEAR(features[2], 3.0, 1e-6);
+
+        BENCH_NEAR(features[3], 0.0, 1e-5);
+        BENCH_NEAR(features[4], 2.5 / sqrt(2.0), 1e-4);
+        BENCH_NEAR(features[5], 2.5, 1e-4);
+
+        BENCH_NEAR(features[6], 0.5, 1e-5);
+        BENCH_NEAR(features[7], sqrt((1.5 * 1.5 + 0.5 * 0.5) / 2.0), 1e-5);
+        BENCH_NEAR(features[8], 1.5, 1e-6);
+    }
+
+    const uint8_t bad[1] = { 3 };
+    BENCH_CHECK(dsp.configure(RATE, 3, bad, 1) == 1);
+    BENCH_CHECK(dsp.set_window(0) == 1);
+}
+
+/* Averages of consecutive groups, at the rate divided by the factors */
+static void test_decimator() {
+    SensorDSP dsp;
+    const uint8_t channel[1] = { 0 };
+    BENCH_CHECK(dsp.configure(RATE, 1, channel, 1) == 0);
+    BENCH_CHECK(dsp.add_decimator(1) == 1);
+    BENCH_CHECK(dsp.add_decimator(4) == 0);
+    BENCH_CHECK(dsp.add_decimator(5) == 0);
+    BENCH_NEAR(dsp.get_rate(), RATE / 20.0, 1e-6);
+
+    // A ramp: each output is the mean of 20 consecutive inputs
+    int outputs = 0;
+    for (int n = 0; n < 200; n++) {
+        float out;
+        bool done = step(dsp, (float)n, &out);
+        BENCH_CHECK(done == ((n % 20) == 19));
+        if (done) {
+            BENCH_NEAR(out, n - 9.5, 1e-4);
+            outputs++;
+        }
+    }
+    BENCH_CHECK(outputs == 10);
+
+    dsp.clear();
+    BENCH_NEAR(dsp.get_rate(), RATE, 1e-6);
+}
+
+/* Designed filters reach the gain of the double precision design on sines,
+   at the rate after the decimators before them */
+static void test_biquad_design() {
+    static const struct {
+        int type;
+        float freq;
+        float q;
+        float at;
+    } cases[] = {
+        { 0, 5.0f, 0.7071f, 0.5f },
+        { 0, 5.0f, 0.7071f, 5.0f },
+        { 0, 5.0f, 0.7071f, 15.0f },
+        { 1, 5.0f, 0.7071f, 1.0f },
+        { 1, 5.0f, 0.7071f, 5.0f },
+        { 1, 5.0f, 0.7071f, 20.0f },
+        { 2, 8.0f, 2.0f, 8.0f },
+        { 2, 8.0f, 2.0f, 2.0f },
+        { 0, 2.0f, 4.0f, 2.0f },
+    };
+
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        SensorDSP dsp;
+        const uint8_t channel[1] = { 0 };
+        BENCH_CHECK(dsp.configure(RATE, 1, channel, 1) == 0);
+
+        // Designed at 50 Hz, after a decimator that halves the rate
+        BENCH_CHECK(dsp.add_decimator(2) == 0);
+        int result = cases[i].type == 0 ? dsp.add_lowpass(cases[i].freq, cases[i].q) :
+                     cases[i].type == 1 ? dsp.add_highpass(cases[i].freq, cases[i].q) :
+                                          dsp.add_bandpass(cases[i].freq, cases[i].q);
+        BENCH_CHECK(result == 0);
+
+        // The gain of a decimator averaging two samples of a sine at f
+        double rate = RATE / 2.0;
+        double expected = design_gain(cases[i].type, cases[i].freq, cases[i].q, rate, cases[i].at) *
+                          fabs(cos(M_PI * cases[i].at / RATE));
+
+        // Settle for 20 s, then measure the rms over 10 s, whole periods
+        BENCH_CHECK(dsp.set_window((uint32_t)(10 * rate)) == 0);
+        float features[SENSOR_DSP_FEATURES];
+        float rms = 0.0f;
+        int windows = 0;
+        for (int n = 0; n < (int)(30 * RATE); n++) {
+            float value = sinf(2.0f * 3.14159265f * cases[i].at * n / RATE);
+            if (dsp.process(&value, features)) {
+                rms = features[1];
+                windows++;
+            }
+        }
+        BENCH_CHECK(windows == 3);
+        BENCH_NEAR(rms * sqrt(2.0), expected, 2e-3);
+    }
+
+    // Frequencies must be below half the rate at the end of the chain
+    SensorDSP dsp;
+    const uint8_t channel[1] = { 0 };
+    BENCH_CHECK(dsp.configure(RATE, 1, channel, 1) == 0);
+    BENCH_CHECK(dsp.add_lowpass(49.0f, 0.7071f) == 0);
+    BENCH_CHECK(dsp.add_decimator(2) == 0);
+    BENCH_CHECK(dsp.add_lowpass(25.0f, 0.7071f) == 1);
+    BENCH_CHECK(dsp.add_highpass(0.0f, 0.7071f) == 1);
+    BENCH_CHECK(dsp.add_bandpass(10.0f, 0.0f) == 1);
+}
+
+/* A biquad given its coefficients has the impulse response of its difference
+   equation: y[n] = x[n] + 0.5 x[n-1] + 0.9 y[n-1] - 0.2 y[n-2] */
+static void test_biquad_coeffs() {
+    SensorDSP dsp;
+    const uint8_t channel[1] = { 0 };
+    const float coeffs[5] = { 1.0f, 0.5f, 0.0f, -0.9f, 0.2f };
+    BENCH_CHECK(dsp.configure(RATE, 1, channel, 1) == 0);
+    BENCH_CHECK(dsp.add_biquad(coeffs) == 0);
+
+    double x1 = 0.0, y1 = 0.0, y2 = 0.0;
+    for (int n = 0; n < 40; n++) {
+        double x = n == 0 ? 1.0 : 0.0;
+        double y = x + 0.5 * x1 + 0.9 * y1 - 0.2 * y2;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+
+        float out = 0.0f;
+        BENCH_CHECK(step(dsp, (float)x, &out));
+        BENCH_NEAR(out, y, 1e-6);
+    }
+}
+
+int main() {
+    test_window();
+    test_decimator();
+    test_biquad_design();
+    test_biquad_coeffs();
+
+    return bench_report("test_sensor_dsp");
+}
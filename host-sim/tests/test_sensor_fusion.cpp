@@ -0,0 +1,326 @@
+/**
+ ******************************************************************************
+ * @file    test_sensor_fusion.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Test of the fixed point SensorFusion filter against a double precision
+ *          Mahony reference.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <math.h>
+#include "SimCheck.h"
+#include "SensorFusion.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/* Largest LSM6DSL rate at 2000 dps full scale, mdps */
+#define GYRO_FULL_SCALE     2293690
+
+/* Largest distance allowed between the filter and the reference quaternions */
+#define QUATERNION_TOL      2e-4
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * The Mahony filter of SensorFusion in double precision, on the same inputs.
+ */
+class MahonyReference {
+public:
+    MahonyReference(float kp, float ki) : two_kp(q16(kp)), two_ki(q16(ki)), mag_valid(false),
+        last_time(0), started(false) {
+        q[0] = 1.0;
+        q[1] = q[2] = q[3] = 0.0;
+        integral[0] = integral[1] = integral[2] = 0.0;
+    }
+
+    void set_mag(const int32_t *m) {
+        mag_valid = normalize(m, mag);
+    }
+
+    void update(uint64_t time, const int32_t *acc, const int32_t *gyro) {
+        if (!started || time <= last_time) {
+            started = true;
+            last_time = time;
+            return;
+        }
+
+        uint64_t step = time - last_time;
+        last_time = time;
+        if (step > SENSOR_FUSION_MAX_STEP_US) {
+            step = SENSOR_FUSION_MAX_STEP_US;
+        }
+        double dt = step * 1e-6;
+
+        double q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+        double g[3];
+        for (int i = 0; i < 3; i++) {
+            g[i] = gyro[i] * M_PI / 180000.0;
+        }
+
+        double a[3];
+        if (normalize(acc, a)) {
+            double halfvx = q1 * q3 - q0 * q2;
+            double halfvy = q0 * q1 + q2 * q3;
+            double halfvz = q0 * q0 - 0.5 + q3 * q3;
+
+            double e[3];
+            e[0] = a[1] * halfvz - a[2] * halfvy;
+            e[1] = a[2] * halfvx - a[0] * halfvz;
+            e[2] = a[0] * halfvy - a[1] * halfvx;
+
+            if (mag_valid) {
+                double mx = mag[0], my = mag[1], mz = mag[2];
+                double hx = 2.0 * (mx * (0.5 - q2 * q2 - q3 * q3) + my * (q1 * q2 - q0 * q3) + mz * (q1 * q3 + q0 * q2));
+                double hy = 2.0 * (mx * (q1 * q2 + q0 * q3) + my * (0.5 - q1 * q1 - q3 * q3) + mz * (q2 * q3 - q0 * q1));
+                double bx = sqrt(hx * hx + hy * hy);
+                double bz = 2.0 * (mx * (q1 * q3 - q0 * q2) + my * (q2 * q3 + q0 * q1) + mz * (0.5 - q1 * q1 - q2 * q2));
+
+                double halfwx = bx * (0.5 - q2 * q2 - q3 * q3) + bz * (q1 * q3 - q0 * q2);
+                double halfwy = bx * (q1 * q2 - q0 * q3) + bz * (q0 * q1 + q2 * q3);
+                double halfwz = bx * (q0 * q2 + q1 * q3) + bz * (0.5 - q1 * q1 - q2 * q2);
+
+                e[0] += my * halfwz - mz * halfwy;
+                e[1] += mz * halfwx - mx * halfwz;
+                e[2] += mx * halfwy - my * halfwx;
+            }
+
+            for (int i = 0; i < 3; i++) {
+                if (two_ki > 0.0) {
+                    integral[i] += two_ki * e[i] * dt;
+                    g[i] += integral[i];
+                } else {
+                    integral[i] = 0.0;
+                }
+                g[i] += two_kp * e[i];
+            }
+        }
+
+        for (int i = 0; i < 3; i++) {
+            g[i] *= 0.5 * dt;
+        }
+
+        double n[4];
+        n[0] = q0 - q1 * g[0] - q2 * g[1] - q3 * g[2];
+        n[1] = q1 + q0 * g[0] + q2 * g[2] - q3 * g[1];
+        n[2] = q2 + q0 * g[1] - q1 * g[2] + q3 * g[0];
+        n[3] = q3 + q0 * g[2] + q1 * g[1] - q2 * g[0];
+
+        double norm = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2] + n[3] * n[3]);
+        for (int i = 0; i < 4; i++) {
+            q[i] = n[i] / norm;
+        }
+    }
+
+    double q[4];
+
+private:
+    /* Twice a gain, rounded to the Q16 of set_gains() */
+    static double q16(float gain) {
+        return (int32_t)(2.0f * gain * 65536.0f + 0.5f) / 65536.0;
+    }
+
+    static bool normalize(const int32_t *in, double *out) {
+        double norm = sqrt((double)in[0] * in[0] + (double)in[1] * in[1] + (double)in[2] * in[2]);
+        if (norm == 0.0) {
+            return false;
+        }
+        for (int i = 0; i < 3; i++) {
+            out[i] = in[i] / norm;
+        }
+        return true;
+    }
+
+    double two_kp;
+    double two_ki;
+    double integral[3];
+    double mag[3];
+    bool mag_valid;
+    uint64_t last_time;
+    bool started;
+};
+
+/* Functions -----------------------------------------------------------------*/
+
+/* Largest difference between the quaternion components, after the sign is
+   aligned since q and -q are the same orientation */
+static double distance(SensorFusion &fusion, const MahonyReference &ref) {
+    int32_t fixed[4];
+    fusion.get_quaternion(fixed);
+
+    double dot = 0.0;
+    for (int i = 0; i < 4; i++) {
+        dot += fixed[i] / (double)SENSOR_FUSION_Q30_ONE * ref.q[i];
+    }
+    double sign = dot < 0.0 ? -1.0 : 1.0;
+
+    double worst = 0.0;
+    for (int i = 0; i < 4; i++) {
+        double d = fabs(fixed[i] / (double)SENSOR_FUSION_Q30_ONE - sign * ref.q[i]);
+        if (d > worst) {
+            worst = d;
+        }
+    }
+    return worst;
+}
+
+static double quaternion_norm(SensorFusion &fusion) {
+    int32_t fixed[4];
+    fusion.get_quaternion(fixed);
+
+    double n2 = 0.0;
+    for (int i = 0; i < 4; i++) {
+        double v = fixed[i] / (double)SENSOR_FUSION_Q30_ONE;
+        n2 += v * v;
+    }
+    return sqrt(n2);
+}
+
+/* A tilted sensor at rest settles on the roll measured by the accelerometer */
+static void test_tilt() {
+    SensorFusion fusion;
+    BENCH_CHECK(fusion.set_gains(2.0f, 0.0f) == 0);
+
+    const int32_t acc[3] = { 0, 500, 866 };
+    const int32_t gyro[3] = { 0, 0, 0 };
+    for (uint64_t time = 0; time <= 5000000; time += 10000) {
+        fusion.update(time, acc, gyro);
+    }
+
+    int32_t q[4];
+    float euler[3];
+    fusion.get_quaternion(q);
+    SensorFusion::to_euler(q, euler);
+    BENCH_NEAR(euler[0], 30.0, 0.1);
+    BENCH_NEAR(euler[1], 0.0, 0.1);
+    BENCH_NEAR(euler[2], 0.0, 0.1);
+}
+
+/* Varying rates, gravity and field at an uneven sample rate, with the
+   integral feedback on */
+static void test_reference() {
+    SensorFusion fusion;
+    MahonyReference ref(1.0f, 0.1f);
+    BENCH_CHECK(fusion.set_gains(1.0f, 0.1f) == 0);
+
+    double worst = 0.0;
+    uint64_t time = 0;
+    for (int i = 0; i < 20000; i++) {
+        double t = time * 1e-6;
+        int32_t acc[3] = {
+            (int32_t)(300.0 * sin(0.7 * t)),
+            (int32_t)(-200.0 * cos(1.3 * t)),
+            (int32_t)(950.0 + 40.0 * sin(5.0 * t))
+        };
+        int32_t gyro[3] = {
+            (int32_t)(90000.0 * sin(0.9 * t)),
+            (int32_t)(-45000.0 * cos(0.4 * t)),
+            (int32_t)(120000.0 * sin(0.2 * t + 1.0))
+        };
+        int32_t mag[3] = {
+            (int32_t)(400.0 * cos(0.3 * t)),
+            (int32_t)(400.0 * sin(0.3 * t)),
+            -300
+        };
+
+        fusion.set_mag(mag);
+        ref.set_mag(mag);
+        fusion.update(time, acc, gyro);
+        ref.update(time, acc, gyro);
+
+        double d = distance(fusion, ref);
+        if (d > worst) {
+            worst = d;
+        }
+
+        // 1 to 20 ms between samples
+        time += 1000 + (i * 7919) % 19000;
+    }
+
+    BENCH_NEAR(worst, 0.0, QUATERNION_TOL);
+    BENCH_NEAR(quaternion_norm(fusion), 1.0, 1e-6);
+}
+
+/* Full scale rates on every axis with the largest gains, the strongest field
+   and steps of SENSOR_FUSION_MAX_STEP_US, or longer and clamped: the largest
+   64 bit intermediates of an update */
+static void test_full_scale() {
+    static const float gains[][2] = { { 8.0f, 0.0f }, { 8.0f, 8.0f }, { 0.0f, 0.0f } };
+    static const int8_t signs[][3] = { { 1, 1, 1 }, { -1, -1, -1 }, { 1, -1, 1 }, { -1, 1, -1 } };
+
+    for (unsigned k = 0; k < sizeof(gains) / sizeof(gains[0]); k++) {
+        for (unsigned s = 0; s < sizeof(signs) / sizeof(signs[0]); s++) {
+            SensorFusion fusion;
+            MahonyReference ref(gains[k][0], gains[k][1]);
+            BENCH_CHECK(fusion.set_gains(gains[k][0], gains[k][1]) == 0);
+
+            // Largest magnetometer reading of the LSM303AGR, mgauss
+            const int32_t mag[3] = { 49152, -49152, 49152 };
+            fusion.set_mag(mag);
+            ref.set_mag(mag);
+
+            double worst = 0.0;
+            uint64_t time = 0;
+            for (int i = 0; i < 200; i++) {
+                // Full scale accelerometer reading at 16 g, mg
+                int32_t acc[3] = { (i & 1) ? 16000 : -16000, 16000, (i & 2) ? -16000 : 16000 };
+                int32_t gyro[3];
+                for (int j = 0; j < 3; j++) {
+                    gyro[j] = signs[s][j] * GYRO_FULL_SCALE;
+                }
+
+                fusion.update(time, acc, gyro);
+                ref.update(time, acc, gyro);
+
+                double d = distance(fusion, ref);
+                if (d > worst) {
+                    worst = d;
+                }
+
+                time += (i % 10) == 9 ? 3 * SENSOR_FUSION_MAX_STEP_US : SENSOR_FUSION_MAX_STEP_US;
+            }
+
+            BENCH_NEAR(worst, 0.0, QUATERNION_TOL);
+            BENCH_NEAR(quaternion_norm(fusion), 1.0, 1e-6);
+        }
+    }
+}
+
+int main() {
+    test_tilt();
+    test_reference();
+    test_full_scale();
+
+    return bench_report("test_sensor_fusion");
+}
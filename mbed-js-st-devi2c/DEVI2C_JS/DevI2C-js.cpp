@@ -43,8 +43,72 @@
 
 // Load the library that we'll wrap
 #include "DevI2C.h"
+#include "JsByteArray.h"
 
 #include "mbed.h"
+#include "jerryscript-mbed-event-loop/EventLoop.h"
+
+/* Queued transactions -------------------------------------------------------*/
+
+/**
+ * Transaction queued from JavaScript by read_async() or write_async().
+ * It holds the bytes on the wire and the callback, and frees itself once
+ * the callback has run on the event loop.
+ */
+class DevI2CJsTransaction {
+public:
+    DevI2CJsTransaction(jerry_value_t obj, jerry_value_t callback, uint16_t size) :
+        buffer(new uint8_t[size]),
+        this_obj(jerry_acquire_value(obj)),
+        cb(jerry_acquire_value(callback)),
+        result(0) {
+        transaction.done = mbed::Callback<void(int)>(this, &DevI2CJsTransaction::done);
+    }
+
+    ~DevI2CJsTransaction() {
+        jerry_release_value(cb);
+        jerry_release_value(this_obj);
+        delete[] buffer;
+    }
+
+    DevI2CTransaction transaction;
+    uint8_t *buffer;
+
+private:
+    /* Runs on the DevI2C thread when the transaction has completed */
+    void done(int ret) {
+        result = ret;
+        mbed::js::EventLoop::getInstance().nativeCallback(mbed::Callback<void()>(this, &DevI2CJsTransaction::deliver));
+    }
+
+    /* Calls the callback with the result and the data read, on the event loop */
+    void deliver() {
+        if (jerry_value_is_function(cb)) {
+            jerry_value_t args[2];
+            args[0] = jerry_create_number(result);
+
+            if (result == 0 && transaction.rx_len) {
+                args[1] = jerry_create_array(transaction.rx_len);
+                js_byte_array_write(args[1], 0, transaction.rx, transaction.rx_len);
+            } else {
+                args[1] = jerry_create_undefined();
+            }
+
+            jerry_value_t ret_val = jerry_call_function(cb, this_obj, args, 2);
+
+            jerry_release_value(ret_val);
+            jerry_release_value(args[0]);
+            jerry_release_value(args[1]);
+        }
+
+        delete this;
+    }
+
+    // The DevI2C object is kept alive until the transaction has completed
+    jerry_value_t this_obj;
+    jerry_value_t cb;
+    int result;
+};
 
 /* Class Implementation ------------------------------------------------------*/
 
@@ -84,7 +148,7 @@ DECLARE_CLASS_FUNCTION(DevI2C, frequency) {
                                   (const jerry_char_t *) "Failed to get native DevI2C pointer");
     }
 
-    I2C *native_ptr = static_cast<I2C*>(void_ptr);
+    DevI2C *native_ptr = static_cast<DevI2C*>(void_ptr);
 
     int hz = jerry_get_number_value(args[0]);
     native_ptr->frequency(hz);
@@ -107,10 +171,10 @@ DECLARE_CLASS_FUNCTION(DevI2C, frequency) {
  * Read a series of bytes from the DevI2C bus
  *
  * @param address DevI2C address to read from
- * @param data Array to read into
+ * @param data Array or TypedArray to read into
  * @param length Length of data to read
  *
- * @returns array: Data read from the DevI2C bus
+ * @returns array: data, holding the bytes read from the DevI2C bus
  */
 DECLARE_CLASS_FUNCTION(DevI2C, read) {
     CHECK_ARGUMENT_COUNT(DevI2C, read, (args_count == 1 || args_count == 3 || args_count == 4));
@@ -134,7 +198,7 @@ DECLARE_CLASS_FUNCTION(DevI2C, read) {
         return jerry_create_number(result);
     } else {
         CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, read, 0, number);
-        CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, read, 1, array);
+        CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, read, 1, object);
         CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, read, 2, number);
 
         CHECK_ARGUMENT_TYPE_ON_CONDITION(DevI2C, read, 3, boolean, (args_count == 4));
@@ -150,38 +214,42 @@ DECLARE_CLASS_FUNCTION(DevI2C, read) {
 
         I2C *native_ptr = static_cast<I2C*>(void_ptr);
 
-        const uint32_t data_len = jerry_get_array_length(args[1]);
+        const uint32_t data_len = js_byte_array_length(args[1]);
 
         int address = jerry_get_number_value(args[0]);
-        int length = jerry_get_number_value(args[2]);
+        uint32_t length;
+        if (!js_byte_array_get_index(args[2], JS_BYTE_ARRAY_MAX_LENGTH, &length)) {
+            return jerry_create_error(JERRY_ERROR_RANGE,
+                                      (const jerry_char_t *) "Invalid DevI2C read length");
+        }
 
-        char *data = new char[data_len];
+        // Never read past the end of the caller's array
+        if (length > data_len) {
+            length = data_len;
+        }
+
+        uint8_t *data = new uint8_t[length];
 
         bool repeated = false;
         if (args_count == 4) {
             repeated = jerry_get_boolean_value(args[3]);
         }
 
-        int result = native_ptr->read(address, data, length, repeated);
-
-        jerry_value_t out_array = jerry_create_array(data_len);
+        int result = native_ptr->read(address, (char *) data, length, repeated);
 
-        for (uint32_t i = 0; i < data_len; i++) {
-            jerry_value_t val = jerry_create_number(double(data[i]));
-            jerry_set_property_by_index(out_array, i, val);
-            jerry_release_value(val);
+        if (result == 0) {
+            js_byte_array_write(args[1], 0, data, length);
         }
 
         delete[] data;
 
         if (result == 0) {
             // ACK
-            return out_array;
+            return jerry_acquire_value(args[1]);
         } else {
             // NACK
             const char *error_msg = "NACK received from DevI2C bus";
 
-            jerry_release_value(out_array);
             return jerry_create_error(JERRY_ERROR_COMMON, reinterpret_cast<const jerry_char_t *>(error_msg));
         }
     }
@@ -202,7 +270,7 @@ DECLARE_CLASS_FUNCTION(DevI2C, read) {
  * Write an array of data to a certain address on the DevI2C bus
  *
  * @param address 8-bit DevI2C slave address
- * @param data Array of bytes to send
+ * @param data Array or TypedArray of bytes to send
  * @param length Length of data to write
  * @param repeated (optional) If true, do not send stop at end.
  *
@@ -234,7 +302,7 @@ DECLARE_CLASS_FUNCTION(DevI2C, write) {
     } else {
         // 3 or 4
         CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, write, 0, number);
-        CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, write, 1, array);
+        CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, write, 1, object);
         CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, write, 2, number);
         CHECK_ARGUMENT_TYPE_ON_CONDITION(DevI2C, write, 3, boolean, (args_count == 4));
 
@@ -252,17 +320,24 @@ DECLARE_CLASS_FUNCTION(DevI2C, write) {
 
         // Unwrap arguments
         int address = jerry_get_number_value(args[0]);
-        const uint32_t data_len = jerry_get_array_length(args[1]);
-        int length = jerry_get_number_value(args[2]);
+        const uint32_t data_len = js_byte_array_length(args[1]);
         bool repeated = args_count == 4 && jerry_get_boolean_value(args[3]);
+        uint32_t length;
+        if (!js_byte_array_get_index(args[2], JS_BYTE_ARRAY_MAX_LENGTH, &length)) {
+            return jerry_create_error(JERRY_ERROR_RANGE,
+                                      (const jerry_char_t *) "Invalid DevI2C write length");
+        }
 
-        // Construct data byte array
-        char *data = new char[data_len];
-        for (uint32_t i = 0; i < data_len; i++) {
-            data[i] = jerry_get_number_value(jerry_get_property_by_index(args[1], i));
+        // Never send past the end of the caller's array
+        if (length > data_len) {
+            length = data_len;
         }
 
-        int result = native_ptr->write(address, data, length, repeated);
+        // Construct data byte array
+        uint8_t *data = new uint8_t[length];
+        js_byte_array_read(args[1], data, length);
+
+        int result = native_ptr->write(address, (const char *) data, length, repeated);
 
         // free dynamically allocated resources
         delete[] data;
@@ -271,6 +346,302 @@ DECLARE_CLASS_FUNCTION(DevI2C, write) {
     }
 }
 
+/**
+ * DevI2C#read_registers (native JavaScript method)
+ * @brief	Reads consecutive registers in one transaction.
+ *
+ * @param address 8-bit DevI2C slave address
+ * @param register Register to start reading from (must be correctly masked)
+ * @param length Number of bytes to read
+ * @param target (optional) Array or TypedArray the bytes are written to
+ * @param offset (optional) Index of the first byte in target, 0 by default
+ *
+ * @returns a new array of the bytes read, or with a target the index
+ *          following the last byte written
+ */
+DECLARE_CLASS_FUNCTION(DevI2C, read_registers) {
+    CHECK_ARGUMENT_COUNT(DevI2C, read_registers, (args_count >= 3 && args_count <= 5));
+    CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, read_registers, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, read_registers, 1, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, read_registers, 2, number);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(DevI2C, read_registers, 3, object, (args_count >= 4));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(DevI2C, read_registers, 4, number, (args_count == 5));
+
+    // Extract native DevI2C object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native DevI2C pointer");
+    }
+
+    DevI2C *native_ptr = static_cast<DevI2C*>(void_ptr);
+
+    // Unwrap arguments
+    int address = jerry_get_number_value(args[0]);
+    int reg = jerry_get_number_value(args[1]);
+    uint32_t length;
+    uint32_t offset = 0;
+
+    if (!js_byte_array_get_index(args[2], JS_BYTE_ARRAY_MAX_LENGTH, &length) || length == 0) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Invalid DevI2C read length");
+    }
+    if (args_count == 5 && !js_byte_array_get_index(args[4], 0x7FFFFFFF - length, &offset)) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Offset must be a non-negative integer index");
+    }
+
+    uint8_t *data = new uint8_t[length];
+
+    int result = native_ptr->i2c_read(data, address, (uint8_t) reg, length);
+
+    jerry_value_t out;
+    if (result != 0) {
+        out = jerry_create_error(JERRY_ERROR_COMMON, (const jerry_char_t *) "NACK received from DevI2C bus");
+    } else if (args_count >= 4) {
+        out = jerry_create_number(js_byte_array_write(args[3], offset, data, length));
+    } else {
+        out = jerry_create_array(length);
+        js_byte_array_write(out, 0, data, length);
+    }
+
+    delete[] data;
+
+    return out;
+}
+
+/**
+ * DevI2C#transfer (native JavaScript method)
+ * @brief	Runs a list of transactions back to back, holding the DevI2C bus.
+ *
+ * @param transactions Array of [address, tx, rx] transactions: the bytes of
+ *        the Array or TypedArray tx are written, then if the optional rx is
+ *        given rx.length bytes are read into it after a repeated start
+ *
+ * @returns the number of transactions completed, less than the number of
+ *          transactions if one failed
+ */
+DECLARE_CLASS_FUNCTION(DevI2C, transfer) {
+    CHECK_ARGUMENT_COUNT(DevI2C, transfer, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, transfer, 0, array);
+
+    // Extract native DevI2C object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native DevI2C pointer");
+    }
+
+    DevI2C *native_ptr = static_cast<DevI2C*>(void_ptr);
+
+    // Copy the transactions out of JavaScript before holding the bus
+    JsTransferList list(args[0]);
+    uint32_t done;
+
+    native_ptr->lock();
+
+    for (done = 0; done < list.count(); done++) {
+        JsTransferList::Item *t = list.get(done);
+
+        if (native_ptr->i2c_transfer(t->target, t->tx, t->tx_len, t->rx, t->rx_len)) {
+            break;
+        }
+    }
+
+    native_ptr->unlock();
+
+    list.write_back(done);
+
+    return jerry_create_number(done);
+}
+
+/**
+ * DevI2C#read_async (native JavaScript method)
+ * @brief	Queues a register read, without waiting for the DevI2C bus.
+ *
+ * @param address 8-bit DevI2C slave address
+ * @param register Register to start reading from
+ * @param length Number of bytes to read
+ * @param callback Called with (0, data array) when done, or (-1, undefined) on an I2C error
+ *
+ * @returns 0 if queued, non-0 on failure
+ */
+DECLARE_CLASS_FUNCTION(DevI2C, read_async) {
+    CHECK_ARGUMENT_COUNT(DevI2C, read_async, (args_count == 4));
+    CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, read_async, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, read_async, 1, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, read_async, 2, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, read_async, 3, function);
+
+    // Extract native DevI2C object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native DevI2C pointer");
+    }
+
+    DevI2C *native_ptr = static_cast<DevI2C*>(void_ptr);
+
+    // Unwrap arguments
+    int address = jerry_get_number_value(args[0]);
+    int reg = jerry_get_number_value(args[1]);
+    uint32_t length;
+
+    if (!js_byte_array_get_index(args[2], JS_BYTE_ARRAY_MAX_LENGTH - 1, &length) || length == 0) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Invalid DevI2C read length");
+    }
+
+    // The register address goes first, the data is read in after it
+    DevI2CJsTransaction *t = new DevI2CJsTransaction(this_obj, args[3], length + 1);
+    t->buffer[0] = reg;
+    t->transaction.address = address;
+    t->transaction.tx = t->buffer;
+    t->transaction.tx_len = 1;
+    t->transaction.rx = t->buffer + 1;
+    t->transaction.rx_len = length;
+
+    int result = native_ptr->submit(&t->transaction);
+    if (result) {
+        delete t;
+    }
+
+    return jerry_create_number(result);
+}
+
+/**
+ * DevI2C#write_async (native JavaScript method)
+ * @brief	Queues a register write, without waiting for the DevI2C bus.
+ *
+ * @param address 8-bit DevI2C slave address
+ * @param register Register to start writing to
+ * @param data Array or TypedArray of bytes to write, of any length
+ * @param callback (optional) Called with 0 when done, or -1 on an I2C error
+ *
+ * @returns 0 if queued, non-0 on failure
+ */
+DECLARE_CLASS_FUNCTION(DevI2C, write_async) {
+    CHECK_ARGUMENT_COUNT(DevI2C, write_async, (args_count == 3 || args_count == 4));
+    CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, write_async, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, write_async, 1, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(DevI2C, write_async, 2, object);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(DevI2C, write_async, 3, function, (args_count == 4));
+
+    // Extract native DevI2C object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native DevI2C pointer");
+    }
+
+    DevI2C *native_ptr = static_cast<DevI2C*>(void_ptr);
+
+    // Unwrap arguments
+    int address = jerry_get_number_value(args[0]);
+    int reg = jerry_get_number_value(args[1]);
+    const uint32_t data_len = js_byte_array_length(args[2]);
+
+    if (data_len >= JS_BYTE_ARRAY_MAX_LENGTH) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Invalid DevI2C write length");
+    }
+
+    // The register address goes first, followed by the data
+    jerry_value_t cb = (args_count == 4) ? args[3] : jerry_create_undefined();
+    DevI2CJsTransaction *t = new DevI2CJsTransaction(this_obj, cb, data_len + 1);
+    t->buffer[0] = reg;
+    js_byte_array_read(args[2], t->buffer + 1, data_len);
+    t->transaction.address = address;
+    t->transaction.tx = t->buffer;
+    t->transaction.tx_len = data_len + 1;
+    t->transaction.rx = NULL;
+    t->transaction.rx_len = 0;
+
+    int result = native_ptr->submit(&t->transaction);
+    if (result) {
+        delete t;
+    }
+
+    return jerry_create_number(result);
+}
+
+/**
+ * DevI2C#get_stats (native JavaScript method)
+ * @brief	Returns the bus usage of the sensor drivers, batched and queued transactions.
+ *
+ * @returns array: [transactions, bytes on the wire, failed transactions,
+ *          estimated bus time in us] since the DevI2C was created or reset_stats()
+ */
+DECLARE_CLASS_FUNCTION(DevI2C, get_stats) {
+    CHECK_ARGUMENT_COUNT(DevI2C, get_stats, (args_count == 0));
+
+    // Extract native DevI2C object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native DevI2C pointer");
+    }
+
+    DevI2C *native_ptr = static_cast<DevI2C*>(void_ptr);
+
+    DevI2CStats stats;
+    native_ptr->get_stats(&stats);
+
+    double values[4] = {
+        (double) stats.transactions,
+        (double) stats.bytes,
+        (double) stats.errors,
+        (double) (stats.bus_time / 1000)
+    };
+
+    jerry_value_t out_array = jerry_create_array(4);
+    for (uint32_t i = 0; i < 4; i++) {
+        jerry_value_t val = jerry_create_number(values[i]);
+        jerry_release_value(jerry_set_property_by_index(out_array, i, val));
+        jerry_release_value(val);
+    }
+
+    return out_array;
+}
+
+/**
+ * DevI2C#reset_stats (native JavaScript method)
+ * @brief	Clears the bus usage counters.
+ */
+DECLARE_CLASS_FUNCTION(DevI2C, reset_stats) {
+    CHECK_ARGUMENT_COUNT(DevI2C, reset_stats, (args_count == 0));
+
+    // Extract native DevI2C object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native DevI2C pointer");
+    }
+
+    DevI2C *native_ptr = static_cast<DevI2C*>(void_ptr);
+
+    native_ptr->reset_stats();
+    return jerry_create_undefined();
+}
+
 /**
  * DevI2C#start (native JavaScript method)
  * @brief	Creates a start condition on the DevI2C bus.
@@ -340,6 +711,12 @@ DECLARE_CLASS_CONSTRUCTOR(DevI2C) {
     ATTACH_CLASS_FUNCTION(js_object, DevI2C, frequency);
     ATTACH_CLASS_FUNCTION(js_object, DevI2C, read);
     ATTACH_CLASS_FUNCTION(js_object, DevI2C, write);
+    ATTACH_CLASS_FUNCTION(js_object, DevI2C, read_registers);
+    ATTACH_CLASS_FUNCTION(js_object, DevI2C, transfer);
+    ATTACH_CLASS_FUNCTION(js_object, DevI2C, read_async);
+    ATTACH_CLASS_FUNCTION(js_object, DevI2C, write_async);
+    ATTACH_CLASS_FUNCTION(js_object, DevI2C, get_stats);
+    ATTACH_CLASS_FUNCTION(js_object, DevI2C, reset_stats);
     ATTACH_CLASS_FUNCTION(js_object, DevI2C, start);
     ATTACH_CLASS_FUNCTION(js_object, DevI2C, stop);
 
@@ -45,7 +45,7 @@
 /* Class Implementation ------------------------------------------------------*/
 
 HTS221Sensor::HTS221Sensor(SPI *spi, PinName cs_pin, PinName drdy_pin) : 
-                           _dev_spi(spi), _cs_pin(cs_pin), _drdy_pin(drdy_pin)  // SPI3W ONLY
+                           _dev_spi(spi), _cs_pin(cs_pin), _drdy_pin(drdy_pin), _calib_valid(false)  // SPI3W ONLY
 {    
     assert(spi); 
     _dev_i2c = NULL;
@@ -56,7 +56,7 @@ HTS221Sensor::HTS221Sensor(SPI *spi, PinName cs_pin, PinName drdy_pin) :
  * @param address the address of the component's instance
  */
 HTS221Sensor::HTS221Sensor(DevI2C *i2c, uint8_t address, PinName drdy_pin) :
-                           _dev_i2c(i2c), _address(address), _cs_pin(NC), _drdy_pin(drdy_pin)
+                           _dev_i2c(i2c), _address(address), _cs_pin(NC), _drdy_pin(drdy_pin), _calib_valid(false)
 {
     assert(i2c);
     _dev_spi = NULL;
@@ -85,10 +85,38 @@ int HTS221Sensor::init(void *init)
   {
     return 1;
   }
+
+  /* Read the factory calibration once */
+  _calib_valid = false;
+  if(load_calibration() != 0)
+  {
+    return 1;
+  }
   
   return 0;
 }
 
+/**
+ * @brief  Read the factory calibration registers into the cache if needed
+ * @retval 0 in case of success, an error code otherwise
+ */
+int HTS221Sensor::load_calibration(void)
+{
+  if(_calib_valid)
+  {
+    return 0;
+  }
+
+  if ( HTS221_Get_Calibration( (void *)this, &_calib ) == HTS221_ERROR )
+  {
+    return 1;
+  }
+
+  _calib_valid = true;
+
+  return 0;
+}
+
 /**
  * @brief  Enable HTS221
  * @retval 0 in case of success, an error code otherwise
@@ -163,6 +191,9 @@ int HTS221Sensor::reset(void)
     {
       return 1;
     }
+
+    /* The calibration is reloaded by the reboot */
+    _calib_valid = false;
     
     return 0;
 }
@@ -175,9 +206,20 @@ int HTS221Sensor::reset(void)
 int HTS221Sensor::get_humidity(float* pfData)
 {
   uint16_t uint16data = 0;
+  int16_t raw;
+
+  if ( load_calibration() != 0 )
+  {
+    return 1;
+  }
 
   /* Read data from HTS221. */
-  if ( HTS221_Get_Humidity( (void *)this, &uint16data ) == HTS221_ERROR )
+  if ( HTS221_Get_HumidityRaw( (void *)this, &raw ) == HTS221_ERROR )
+  {
+    return 1;
+  }
+
+  if ( HTS221_Calc_Humidity( &_calib, raw, &uint16data ) == HTS221_ERROR )
   {
     return 1;
   }
@@ -195,9 +237,20 @@ int HTS221Sensor::get_humidity(float* pfData)
 int HTS221Sensor::get_temperature(float* pfData)
 {
   int16_t int16data = 0;
+  int16_t raw;
+
+  if ( load_calibration() != 0 )
+  {
+    return 1;
+  }
 
   /* Read data from HTS221. */
-  if ( HTS221_Get_Temperature( (void *)this, &int16data ) == HTS221_ERROR )
+  if ( HTS221_Get_TemperatureRaw( (void *)this, &raw ) == HTS221_ERROR )
+  {
+    return 1;
+  }
+
+  if ( HTS221_Calc_Temperature( &_calib, raw, &int16data ) == HTS221_ERROR )
   {
     return 1;
   }
@@ -264,6 +317,35 @@ int HTS221Sensor::set_odr(float odr)
   return 0;
 }
 
+/**
+ * @brief  Enable the data ready signal on the DRDY pin
+ * @retval 0 in case of success, an error code otherwise
+ * @note   The pin stays high until the humidity and temperature are read
+ */
+int HTS221Sensor::enable_drdy_irq(void)
+{
+  if ( HTS221_Set_IrqEnable( (void *)this, HTS221_ENABLE ) == HTS221_ERROR )
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief  Disable the data ready signal on the DRDY pin
+ * @retval 0 in case of success, an error code otherwise
+ */
+int HTS221Sensor::disable_drdy_irq(void)
+{
+  if ( HTS221_Set_IrqEnable( (void *)this, HTS221_DISABLE ) == HTS221_ERROR )
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
 
 /**
  * @brief Read the data from register
@@ -292,6 +374,8 @@ int HTS221Sensor::read_reg( uint8_t reg, uint8_t *data )
  */
 int HTS221Sensor::write_reg( uint8_t reg, uint8_t data )
 {
+  /* Raw register access may change anything the cache relies on */
+  _calib_valid = false;
 
   if ( HTS221_write_reg( (void *)this, reg, 1, &data ) == HTS221_ERROR )
   {
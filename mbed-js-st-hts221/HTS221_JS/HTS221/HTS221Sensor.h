@@ -45,6 +45,7 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include "DevI2C.h"
+#include "DevSPI.h"
 #include "HTS221_driver.h"
 #include "HumiditySensor.h"
 #include "TempSensor.h"
@@ -69,6 +70,8 @@ class HTS221Sensor : public HumiditySensor, public TempSensor
     int reset(void);
     int get_odr(float *odr);
     int set_odr(float odr);
+    int enable_drdy_irq(void);
+    int disable_drdy_irq(void);
     int read_reg(uint8_t reg, uint8_t *data);
     int write_reg(uint8_t reg, uint8_t data);
     /**
@@ -81,15 +84,8 @@ class HTS221Sensor : public HumiditySensor, public TempSensor
     uint8_t io_read(uint8_t* pBuffer, uint8_t RegisterAddr, uint16_t NumByteToRead)
     {
         if (_dev_spi) {
-        /* Write Reg Address */
-            _dev_spi->lock();
-            _cs_pin = 0;           
-            /* Write RD Reg Address with RD bit*/
-            uint8_t TxByte = RegisterAddr | 0x80;    
-            _dev_spi->write((char *)&TxByte, 1, (char *)pBuffer, (int) NumByteToRead);
-            _cs_pin = 1;
-            _dev_spi->unlock(); 
-            return 0;
+            /* Write RD Reg Address with RD bit, and read on the same line */
+            return (uint8_t) DevSPI::spi_read_reg_3w(_dev_spi, _cs_pin, spi_address(RegisterAddr) | 0x80, pBuffer, NumByteToRead);
         }                       
         if (_dev_i2c) return (uint8_t) _dev_i2c->i2c_read(pBuffer, _address, RegisterAddr, NumByteToRead);
         return 1;
@@ -104,20 +100,53 @@ class HTS221Sensor : public HumiditySensor, public TempSensor
      */
     uint8_t io_write(uint8_t* pBuffer, uint8_t RegisterAddr, uint16_t NumByteToWrite)
     {
-        if (_dev_spi) { 
-            _dev_spi->lock();
-            _cs_pin = 0;
-            int data = _dev_spi->write(RegisterAddr);                    
-            _dev_spi->write((char *)pBuffer, (int) NumByteToWrite, NULL, 0);                     
-            _cs_pin = 1;                    
-            _dev_spi->unlock();
-            return data;                    
-        }        
+        if (_dev_spi) {
+            /* Write Reg Address, then the data, in block transfers */
+            return (uint8_t) DevSPI::spi_write_reg(_dev_spi, _cs_pin, spi_address(RegisterAddr), pBuffer, NumByteToWrite);
+        }
         if (_dev_i2c) return (uint8_t) _dev_i2c->i2c_write(pBuffer, _address, RegisterAddr, NumByteToWrite);    
         return 1;
     }
 
+    /**
+     * @brief  Attaching an interrupt handler to the DRDY interrupt.
+     * @param  fptr An interrupt handler.
+     * @retval None.
+     */
+    void attach_int_irq(Callback<void()> fptr)
+    {
+        _drdy_pin.rise(fptr);
+    }
+
+    /**
+     * @brief  Enabling the DRDY interrupt handling.
+     * @param  None.
+     * @retval None.
+     */
+    void enable_int_irq(void)
+    {
+        _drdy_pin.enable_irq();
+    }
+    
+    /**
+     * @brief  Disabling the DRDY interrupt handling.
+     * @param  None.
+     * @retval None.
+     */
+    void disable_int_irq(void)
+    {
+        _drdy_pin.disable_irq();
+    }
+
   private:
+    int load_calibration(void);
+
+    /* The driver sets bit 7 of the register address to auto-increment, as
+       over I2C; over SPI that is the read bit, and bit 6 (MS) increments */
+    static uint8_t spi_address(uint8_t RegisterAddr)
+    {
+        return (RegisterAddr & 0x3F) | ((RegisterAddr & 0x80) ? 0x40 : 0x00);
+    }
 
     /* Helper classes. */
     DevI2C *_dev_i2c;
@@ -127,6 +156,10 @@ class HTS221Sensor : public HumiditySensor, public TempSensor
     uint8_t _address;
     DigitalOut  _cs_pin;        
     InterruptIn _drdy_pin;    
+
+    /* Factory calibration, read once and reused for every sample */
+    HTS221_Calibration_st _calib;
+    bool _calib_valid;
 };
 
 #ifdef __cplusplus
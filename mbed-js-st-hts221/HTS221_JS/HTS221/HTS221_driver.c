@@ -309,36 +309,16 @@ HTS221_Error_et HTS221_Get_RawMeasurement(void *handle, int16_t* humidity, int16
 */
 HTS221_Error_et HTS221_Get_Humidity(void *handle, uint16_t* value)
 {
-  int16_t H0_T0_out, H1_T0_out, H_T_out;
-  int16_t H0_rh, H1_rh;
-  uint8_t buffer[2];
-  float   tmp_f;
+  HTS221_Calibration_st calib;
+  int16_t H_T_out;
 
-  if(HTS221_read_reg(handle, HTS221_H0_RH_X2, 2, buffer))
+  if(HTS221_Get_Calibration(handle, &calib))
     return HTS221_ERROR;
-  H0_rh = buffer[0] >> 1;
-  H1_rh = buffer[1] >> 1;
 
-  if(HTS221_read_reg(handle, HTS221_H0_T0_OUT_L, 2, buffer))
+  if(HTS221_Get_HumidityRaw(handle, &H_T_out))
     return HTS221_ERROR;
-  H0_T0_out = (((uint16_t)buffer[1]) << 8) | (uint16_t)buffer[0];
-
-  if(HTS221_read_reg(handle, HTS221_H1_T0_OUT_L, 2, buffer))
-    return HTS221_ERROR;
-  H1_T0_out = (((uint16_t)buffer[1]) << 8) | (uint16_t)buffer[0];
-
-  if(HTS221_read_reg(handle, HTS221_HR_OUT_L_REG, 2, buffer))
-    return HTS221_ERROR;
-  H_T_out = (((uint16_t)buffer[1]) << 8) | (uint16_t)buffer[0];
-
-  tmp_f = (float)(H_T_out - H0_T0_out) * (float)(H1_rh - H0_rh) / (float)(H1_T0_out - H0_T0_out)  +  H0_rh;
-  tmp_f *= 10.0f;
 
-  *value = ( tmp_f > 1000.0f ) ? 1000
-           : ( tmp_f <    0.0f ) ?    0
-           : ( uint16_t )tmp_f;
-
-  return HTS221_OK;
+  return HTS221_Calc_Humidity(&calib, H_T_out, value);
 }
 
 /**
@@ -367,54 +347,112 @@ HTS221_Error_et HTS221_Get_HumidityRaw(void *handle, int16_t* value)
 */
 HTS221_Error_et HTS221_Get_Temperature(void *handle, int16_t *value)
 {
-  int16_t T0_out, T1_out, T_out, T0_degC_x8_u16, T1_degC_x8_u16;
-  int16_t T0_degC, T1_degC;
-  uint8_t buffer[4], tmp;
-  float   tmp_f;
+  HTS221_Calibration_st calib;
+  int16_t T_out;
 
-  if(HTS221_read_reg(handle, HTS221_T0_DEGC_X8, 2, buffer))
+  if(HTS221_Get_Calibration(handle, &calib))
     return HTS221_ERROR;
-  if(HTS221_read_reg(handle, HTS221_T0_T1_DEGC_H2, 1, &tmp))
+
+  if(HTS221_Get_TemperatureRaw(handle, &T_out))
     return HTS221_ERROR;
 
-  T0_degC_x8_u16 = (((uint16_t)(tmp & 0x03)) << 8) | ((uint16_t)buffer[0]);
-  T1_degC_x8_u16 = (((uint16_t)(tmp & 0x0C)) << 6) | ((uint16_t)buffer[1]);
-  T0_degC = T0_degC_x8_u16 >> 3;
-  T1_degC = T1_degC_x8_u16 >> 3;
+  return HTS221_Calc_Temperature(&calib, T_out, value);
+}
 
-  if(HTS221_read_reg(handle, HTS221_T0_OUT_L, 4, buffer))
+/**
+* @brief  Read HTS221 temperature output registers.
+* @param  *handle Device handle.
+* @param  Pointer to the returned temperature raw value.
+* @retval Error code [HTS221_OK, HTS221_ERROR].
+*/
+HTS221_Error_et HTS221_Get_TemperatureRaw(void *handle, int16_t* value)
+{
+  uint8_t buffer[2];
+
+  if(HTS221_read_reg(handle, HTS221_TEMP_OUT_L_REG, 2, buffer))
     return HTS221_ERROR;
 
-  T0_out = (((uint16_t)buffer[1]) << 8) | (uint16_t)buffer[0];
-  T1_out = (((uint16_t)buffer[3]) << 8) | (uint16_t)buffer[2];
+  *value = (int16_t)((((uint16_t)buffer[1]) << 8) | (uint16_t)buffer[0]);
 
-  if(HTS221_read_reg(handle, HTS221_TEMP_OUT_L_REG, 2, buffer))
+  return HTS221_OK;
+}
+
+/**
+* @brief  Read the HTS221 factory calibration registers.
+*         The whole calibration area is read in a single transfer; the values
+*         never change at run time and can be kept by the caller.
+* @param  *handle Device handle.
+* @param  calib pointer to the returned calibration coefficients.
+*         This parameter is a pointer to @ref HTS221_Calibration_st.
+* @retval Error code [HTS221_OK, HTS221_ERROR].
+*/
+HTS221_Error_et HTS221_Get_Calibration(void *handle, HTS221_Calibration_st* calib)
+{
+  uint8_t buffer[16];
+  uint16_t T0_degC_x8_u16, T1_degC_x8_u16;
+
+  if(HTS221_read_reg(handle, HTS221_H0_RH_X2, 16, buffer))
     return HTS221_ERROR;
 
-  T_out = (((uint16_t)buffer[1]) << 8) | (uint16_t)buffer[0];
+  calib->H0_rh = buffer[HTS221_H0_RH_X2 - HTS221_H0_RH_X2] >> 1;
+  calib->H1_rh = buffer[HTS221_H1_RH_X2 - HTS221_H0_RH_X2] >> 1;
+
+  calib->H0_T0_out = (int16_t)((((uint16_t)buffer[HTS221_H0_T0_OUT_H - HTS221_H0_RH_X2]) << 8) | (uint16_t)buffer[HTS221_H0_T0_OUT_L - HTS221_H0_RH_X2]);
+  calib->H1_T0_out = (int16_t)((((uint16_t)buffer[HTS221_H1_T0_OUT_H - HTS221_H0_RH_X2]) << 8) | (uint16_t)buffer[HTS221_H1_T0_OUT_L - HTS221_H0_RH_X2]);
+
+  T0_degC_x8_u16 = (((uint16_t)(buffer[HTS221_T0_T1_DEGC_H2 - HTS221_H0_RH_X2] & 0x03)) << 8) | ((uint16_t)buffer[HTS221_T0_DEGC_X8 - HTS221_H0_RH_X2]);
+  T1_degC_x8_u16 = (((uint16_t)(buffer[HTS221_T0_T1_DEGC_H2 - HTS221_H0_RH_X2] & 0x0C)) << 6) | ((uint16_t)buffer[HTS221_T1_DEGC_X8 - HTS221_H0_RH_X2]);
+  calib->T0_degC = T0_degC_x8_u16 >> 3;
+  calib->T1_degC = T1_degC_x8_u16 >> 3;
+
+  calib->T0_out = (int16_t)((((uint16_t)buffer[HTS221_T0_OUT_H - HTS221_H0_RH_X2]) << 8) | (uint16_t)buffer[HTS221_T0_OUT_L - HTS221_H0_RH_X2]);
+  calib->T1_out = (int16_t)((((uint16_t)buffer[HTS221_T1_OUT_H - HTS221_H0_RH_X2]) << 8) | (uint16_t)buffer[HTS221_T1_OUT_L - HTS221_H0_RH_X2]);
+
+  return HTS221_OK;
+}
+
+/**
+* @brief  Calculate humidity from a raw humidity value and the calibration coefficients.
+* @param  calib pointer to the calibration coefficients read by @ref HTS221_Get_Calibration.
+* @param  raw humidity raw value.
+* @param  Pointer to the returned humidity value that must be divided by 10 to get the value in [%].
+* @retval Error code [HTS221_OK, HTS221_ERROR].
+*/
+HTS221_Error_et HTS221_Calc_Humidity(const HTS221_Calibration_st* calib, int16_t raw, uint16_t* value)
+{
+  float   tmp_f;
 
-  tmp_f = (float)(T_out - T0_out) * (float)(T1_degC - T0_degC) / (float)(T1_out - T0_out)  +  T0_degC;
+  if(calib->H1_T0_out == calib->H0_T0_out)
+    return HTS221_ERROR;
+
+  tmp_f = (float)(raw - calib->H0_T0_out) * (float)(calib->H1_rh - calib->H0_rh) / (float)(calib->H1_T0_out - calib->H0_T0_out)  +  calib->H0_rh;
   tmp_f *= 10.0f;
 
-  *value = ( int16_t )tmp_f;
+  *value = ( tmp_f > 1000.0f ) ? 1000
+           : ( tmp_f <    0.0f ) ?    0
+           : ( uint16_t )tmp_f;
 
   return HTS221_OK;
 }
 
 /**
-* @brief  Read HTS221 temperature output registers.
-* @param  *handle Device handle.
-* @param  Pointer to the returned temperature raw value.
+* @brief  Calculate temperature from a raw temperature value and the calibration coefficients.
+* @param  calib pointer to the calibration coefficients read by @ref HTS221_Get_Calibration.
+* @param  raw temperature raw value.
+* @param  Pointer to the returned temperature value that must be divided by 10 to get the value in ['C].
 * @retval Error code [HTS221_OK, HTS221_ERROR].
 */
-HTS221_Error_et HTS221_Get_TemperatureRaw(void *handle, int16_t* value)
+HTS221_Error_et HTS221_Calc_Temperature(const HTS221_Calibration_st* calib, int16_t raw, int16_t* value)
 {
-  uint8_t buffer[2];
+  float   tmp_f;
 
-  if(HTS221_read_reg(handle, HTS221_TEMP_OUT_L_REG, 2, buffer))
+  if(calib->T1_out == calib->T0_out)
     return HTS221_ERROR;
 
-  *value = (int16_t)((((uint16_t)buffer[1]) << 8) | (uint16_t)buffer[0]);
+  tmp_f = (float)(raw - calib->T0_out) * (float)(calib->T1_degC - calib->T0_degC) / (float)(calib->T1_out - calib->T0_out)  +  calib->T0_degC;
+  tmp_f *= 10.0f;
+
+  *value = ( int16_t )tmp_f;
 
   return HTS221_OK;
 }
@@ -195,6 +195,21 @@ typedef struct
   HTS221_State_et       irq_enable;       /*!< HTS221_ENABLE/HTS221_DISABLE interrupt on DRDY pin */
 } HTS221_Init_st;
 
+/**
+* @brief  HTS221 calibration coefficients structure definition.
+*/
+typedef struct
+{
+  int16_t   H0_rh;        /*!< Humidity of the first calibration point [%] */
+  int16_t   H1_rh;        /*!< Humidity of the second calibration point [%] */
+  int16_t   H0_T0_out;    /*!< Humidity raw output at H0_rh */
+  int16_t   H1_T0_out;    /*!< Humidity raw output at H1_rh */
+  int16_t   T0_degC;      /*!< Temperature of the first calibration point ['C] */
+  int16_t   T1_degC;      /*!< Temperature of the second calibration point ['C] */
+  int16_t   T0_out;       /*!< Temperature raw output at T0_degC */
+  int16_t   T1_out;       /*!< Temperature raw output at T1_degC */
+} HTS221_Calibration_st;
+
 /**
 * @}
 */
@@ -468,6 +483,9 @@ HTS221_Error_et HTS221_Get_Humidity(void *handle, uint16_t* value);
 HTS221_Error_et HTS221_Get_HumidityRaw(void *handle, int16_t* value);
 HTS221_Error_et HTS221_Get_TemperatureRaw(void *handle, int16_t* value);
 HTS221_Error_et HTS221_Get_Temperature(void *handle, int16_t* value);
+HTS221_Error_et HTS221_Get_Calibration(void *handle, HTS221_Calibration_st* calib);
+HTS221_Error_et HTS221_Calc_Humidity(const HTS221_Calibration_st* calib, int16_t raw, uint16_t* value);
+HTS221_Error_et HTS221_Calc_Temperature(const HTS221_Calibration_st* calib, int16_t raw, int16_t* value);
 HTS221_Error_et HTS221_Get_DataStatus(void *handle, HTS221_BitStatus_et* humidity, HTS221_BitStatus_et* temperature);
 HTS221_Error_et HTS221_Activate(void *handle);
 HTS221_Error_et HTS221_DeActivate(void *handle);
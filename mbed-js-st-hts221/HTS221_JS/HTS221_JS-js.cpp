@@ -44,6 +44,7 @@
 
 // Load the library that we'll wrap
 #include "HTS221_JS.h"
+#include "JsValueArray.h"
 
 #include "mbed.h"
 
@@ -221,8 +222,8 @@ DECLARE_CLASS_FUNCTION(HTS221_JS, get_temperature_string) {
 
     HTS221_JS *native_ptr = static_cast<HTS221_JS*>(void_ptr);
  
-    char * result = new char[128];
-    result = native_ptr->get_temperature_string(result);
+    char result[128];
+    native_ptr->get_temperature_string(result);
     
     //pc.printf("Temperature: %s", result);
 
@@ -230,9 +231,6 @@ DECLARE_CLASS_FUNCTION(HTS221_JS, get_temperature_string) {
     jerry_value_t out = jerry_create_string((unsigned char *)result);
     
     //printf("temperature: %s\n", result);
-   
-    // Recycle the result from function
-    delete result;
 
     // Return the output
     return out;
@@ -289,16 +287,13 @@ DECLARE_CLASS_FUNCTION(HTS221_JS, get_humidity_string) {
 
     HTS221_JS *native_ptr = static_cast<HTS221_JS*>(void_ptr);
  
-    char * result = new char[128];
-    result = native_ptr->get_humidity_string(result);
+    char result[128];
+    native_ptr->get_humidity_string(result);
     
     // Cast it back to JavaScript
     jerry_value_t out = jerry_create_string((unsigned char *)result);
     
     //printf("humidity: %s\n", result);
-   
-    // Recycle the result from function
-    delete result;
 
     // Return the output
     return out;
@@ -348,6 +343,84 @@ DECLARE_CLASS_FUNCTION(HTS221_JS, led_on) {
 }
 
 
+/**
+ * HTS221_JS#get_humidity_temperature_into (native JavaScript method)
+ * @brief   Writes the humidity in % and the temperature in degC into an array
+ * @param   Array or TypedArray the values are written to
+ * @param   Optional index of the first value, 0 by default
+ * @returns Index following the last value written, or -1 on a sensor error or if the values do not fit
+ */
+DECLARE_CLASS_FUNCTION(HTS221_JS, get_humidity_temperature_into) {
+    CHECK_ARGUMENT_COUNT(HTS221_JS, get_humidity_temperature_into, (args_count == 1 || args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(HTS221_JS, get_humidity_temperature_into, 0, object);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(HTS221_JS, get_humidity_temperature_into, 1, number, args_count == 2);
+
+    if (!js_value_array_is_valid(args[0])) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Target must be an Array or a TypedArray");
+    }
+
+    // Unwrap native HTS221_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native HTS221_JS pointer");
+    }
+
+    HTS221_JS *native_ptr = static_cast<HTS221_JS*>(void_ptr);
+
+    uint32_t offset = 0;
+    if (args_count == 2 && !js_value_array_get_offset(args[1], 2, &offset)) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Offset must be a non-negative integer index");
+    }
+
+    // Get the result from the C++ API
+    float values[2];
+    if (native_ptr->get_humidity_temperature(&values[0], &values[1]) != 0) {
+        return jerry_create_number(-1);
+    }
+
+    // Write it to the caller's array
+    return jerry_create_number(js_value_array_write(args[0], offset, values, 2));
+}
+
+/**
+ * HTS221_JS#onDataReady (native JavaScript method)
+ * @brief   Calls a function each time a new sample is ready, or stops the
+ *          events when called without arguments
+ * @param   Callback, called with an array of [humidity, temperature] in % and degC
+ *          and the number of data-ready interrupts since the previous
+ *          call, more than 1 when samples were skipped
+ * @returns 0 on success, 1 on a sensor error, 2 if no DRDY pin was given,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(HTS221_JS, onDataReady) {
+    CHECK_ARGUMENT_COUNT(HTS221_JS, onDataReady, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(HTS221_JS, onDataReady, 0, function, args_count == 1);
+
+    // Unwrap native HTS221_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native HTS221_JS pointer");
+    }
+
+    HTS221_JS *native_ptr = static_cast<HTS221_JS*>(void_ptr);
+
+    // Call the native function
+    int result = (args_count == 1) ? native_ptr->on_data_ready(this_obj, args[0])
+                                   : native_ptr->stop_data_ready();
+
+    return jerry_create_number(result);
+}
+
 /**
  * HTS221_JS (native JavaScript constructor)
  * @brief   Constructor for Javascript wrapper
@@ -370,6 +443,8 @@ DECLARE_CLASS_CONSTRUCTOR(HTS221_JS) {
     ATTACH_CLASS_FUNCTION(js_object, HTS221_JS, get_temperature_string);
     ATTACH_CLASS_FUNCTION(js_object, HTS221_JS, get_humidity);
     ATTACH_CLASS_FUNCTION(js_object, HTS221_JS, get_humidity_string);
+    ATTACH_CLASS_FUNCTION(js_object, HTS221_JS, get_humidity_temperature_into);
+    ATTACH_CLASS_FUNCTION(js_object, HTS221_JS, onDataReady);
     ATTACH_CLASS_FUNCTION(js_object, HTS221_JS, led_on);
 
     return js_object;
@@ -118,6 +118,7 @@ HTS221_JS::HTS221_JS(DevI2C &devI2c, uint8_t address, PinName drdy_pin){
  */
 void HTS221_JS::init(DevI2C &devI2c, uint8_t address, PinName drdy_pin){
 	hum_temp = new HTS221Sensor(&devI2c, address, drdy_pin);
+	drdy = drdy_pin;
 	hum_temp->init(NULL);
 	hum_temp->enable();
 }
@@ -158,6 +159,7 @@ HTS221_JS::HTS221_JS(SPI &spi, PinName cs_pin, PinName drdy_pin){
  */
 void HTS221_JS::init(SPI &spi, PinName cs_pin, PinName drdy_pin){
 	hum_temp = new HTS221Sensor(&spi, cs_pin, drdy_pin);
+	drdy = drdy_pin;
 	hum_temp->init(NULL);
 	hum_temp->enable();
 }
@@ -222,4 +224,117 @@ char *HTS221_JS::get_humidity_string(char *buffer){
 	hum_temp->get_humidity(&value);
     print_double(buffer, value);
 	return buffer;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief	Get the humidity and temperature readings from HTS221
+ * @param	Pointer where the humidity in % is stored
+ * @param	Pointer where the temperature in degC is stored
+ * @retval	0 on success, 1 on error
+ */
+int HTS221_JS::get_humidity_temperature(float *humidity, float *temperature){
+	if(hum_temp == NULL){
+		return 1;
+	}
+	if(hum_temp->get_humidity(humidity) || hum_temp->get_temperature(temperature)){
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * @brief	Calls a JavaScript function each time a new sample is ready
+ * @param	JavaScript object kept alive while events are enabled
+ * @param	JavaScript callback, called with an array of [humidity, temperature] in % and degC
+ *		and the number of data-ready interrupts since the previous call
+ * @retval	0 on success, 1 on a sensor error, 2 if no DRDY pin was given,
+ *		3 if the sensor is not initialized
+ */
+int HTS221_JS::on_data_ready(jerry_value_t this_obj, jerry_value_t cb){
+	if(hum_temp == NULL){
+		return 3;
+	}
+	if(drdy == NC){
+		return 2;
+	}
+
+	stop_data_ready();
+
+	hum_temp->attach_int_irq(callback(this, &HTS221_JS::drdy_interrupt));
+	if(hum_temp->enable_drdy_irq()){
+		hum_temp->disable_int_irq();
+		return 1;
+	}
+
+	// Keep the object and the callback while samples may arrive
+	drdy_delivery.start(this_obj, cb);
+
+	hum_temp->enable_int_irq();
+
+	// A sample already waiting holds the pin high; read it so the next one raises an edge
+	float values[2];
+	get_humidity_temperature(&values[0], &values[1]);
+
+	return 0;
+}
+
+/**
+ * @brief	Stops data-ready events
+ * @retval	0 on success, 1 on a sensor error
+ */
+int HTS221_JS::stop_data_ready(){
+	int result = 0;
+
+	if(drdy_delivery.is_started()){
+		hum_temp->disable_int_irq();
+		result = hum_temp->disable_drdy_irq();
+	}
+
+	// This may release the last reference to this object, so it comes last
+	drdy_delivery.stop();
+
+	return result;
+}
+
+/**
+ * @brief	DRDY handler, runs in interrupt context
+ */
+void HTS221_JS::drdy_interrupt(){
+	// Later samples are coalesced into a delivery already waiting
+	drdy_delivery.post(mbed::Callback<void()>(this, &HTS221_JS::deliver_drdy));
+}
+
+/**
+ * @brief	Passes the latest sample to JavaScript, on the event loop
+ */
+void HTS221_JS::deliver_drdy(){
+	// Stopped since this delivery was posted, this object may be freed
+	uint32_t count;
+	if(!drdy_delivery.begin(&count)){
+		return;
+	}
+
+	// Reading the sample also lowers the pin for the next edge
+	float values[2];
+	if(get_humidity_temperature(&values[0], &values[1])){
+		return;
+	}
+
+	jerry_value_t out_array = jerry_create_array(2);
+	for(uint32_t i = 0; i < 2; i++){
+		jerry_value_t val = jerry_create_number(values[i]);
+		jerry_release_value(jerry_set_property_by_index(out_array, i, val));
+		jerry_release_value(val);
+	}
+
+	jerry_value_t args[2] = {
+		out_array,
+		jerry_create_number(count)
+	};
+
+	// The callback may stop the events and free this object
+	drdy_delivery.call(args, 2);
+
+	jerry_release_value(args[0]);
+	jerry_release_value(args[1]);
+}
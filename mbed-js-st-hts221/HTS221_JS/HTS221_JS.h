@@ -47,6 +47,9 @@
 #include <stdint.h>
 #include "mbed.h"
 #include "HTS221Sensor.h"
+#include "JsDelivery.h"
+
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
 
 /* Class Declaration ---------------------------------------------------------*/
 
@@ -57,6 +60,13 @@ class HTS221_JS {
 private:
     /* Helper classes. */
     HTS221Sensor *hum_temp = NULL;
+    
+    /* Data-ready events. */
+    PinName drdy = NC;
+    JsDelivery drdy_delivery;
+    
+    void drdy_interrupt();
+    void deliver_drdy();
 
 public:
     /* Constructors */
@@ -81,6 +91,9 @@ public:
     char *get_temperature_string(char *);
     float get_humidity();
     char *get_humidity_string(char *);
+    int get_humidity_temperature(float *humidity, float *temperature);
+    int on_data_ready(jerry_value_t this_obj, jerry_value_t cb);
+    int stop_data_ready();
     void led_on(DigitalOut &led) {
         //printf("led status: %d\n", led);
         led = 1;
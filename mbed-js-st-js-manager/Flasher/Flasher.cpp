@@ -42,6 +42,29 @@
 
 FlashIAP Flasher::flash;
 
+char *Flasher::page_buffer = NULL;
+uint32_t Flasher::page_fill = 0;
+uint32_t Flasher::bank_addr = 0;
+uint32_t Flasher::bank_end = 0;
+uint32_t Flasher::write_addr = 0;
+uint32_t Flasher::erased_until = 0;
+uint32_t Flasher::expected = 0;
+uint32_t Flasher::written = 0;
+bool Flasher::flushed = false;
+uint32_t Flasher::running_crc = 0;
+flasher_header_t Flasher::pending;
+
+flasher_header_t Flasher::checked[FLASHER_BANK_COUNT];
+bool Flasher::checked_valid[FLASHER_BANK_COUNT];
+
+/* CRC32 (IEEE 802.3, reflected) lookup table, one entry per nibble. */
+static const uint32_t crc32_table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
 /** Constructor
  * @brief	Constructor.
  */
@@ -81,19 +104,80 @@ uint32_t Flasher::get_flash_address(){
     
     return addr;
 }
+
+/** get_bank_address
+ * @brief	Returns the start address of a script bank. Bank 0 starts at the
+ *          flash address, bank 1 at the first sector boundary past the middle
+ *          of the script area.
+ * @param	bank Bank number
+ * @return  Bank start address
+ */
+uint32_t Flasher::get_bank_address(int bank){
+    uint32_t addr = get_flash_address();
+    if(bank == 0){
+        return addr;
+    }
+
+    uint32_t flash_end = flash.get_flash_start() + flash.get_flash_size();
+    uint32_t middle = addr + (flash_end - addr) / 2;
+    while(addr < middle){
+        addr = addr + flash.get_sector_size(addr);
+    }
+    return addr;
+}
+
+/** get_bank_size
+ * @brief	Returns the size of a script bank.
+ * @param	bank Bank number
+ * @return  Bank size in bytes
+ */
+uint32_t Flasher::get_bank_size(int bank){
+    uint32_t end = bank == 0 ? get_bank_address(1) : flash.get_flash_start() + flash.get_flash_size();
+    return end - get_bank_address(bank);
+}
+
+/** header_size
+ * @brief	Returns the space reserved for the header, rounded up to a page.
+ * @return  Header size in bytes
+ */
+uint32_t Flasher::header_size(){
+    uint32_t page_size = flash.get_page_size();
+    return ((sizeof(flasher_header_t) + page_size - 1) / page_size) * page_size;
+}
     
 /** erase_flash
- * @brief	Erases theflash.
+ * @brief	Erases the header sector of both banks, which invalidates all
+ *          stored scripts.
  * @return  Return code
  */
 int Flasher::erase_flash(){
+    for(int bank = 0; bank < FLASHER_BANK_COUNT; bank++){
+        if(invalidate_bank(bank) != 0){
+            printf("Error erasing Flash...\n");
+            return 1; // Error while erasing
+        }
+    }
+    return 0;
+}
+
+/** invalidate_bank
+ * @brief	Erases the header sector of a bank, so the other bank becomes
+ *          the active one.
+ * @param	bank Bank number
+ * @return  Return code
+ */
+int Flasher::invalidate_bank(int bank){
+    if(get_bank_size(bank) == 0){
+        return 0; // Nothing to erase
+    }
+
     flash.init();
-    uint32_t addr = get_flash_address();
+    uint32_t addr = get_bank_address(bank);
     if(flash.erase(addr, flash.get_sector_size(addr)) != 0){
-        printf("Error erasing Flash...\n");
         flash.deinit();
         return 1; // Error while erasing
     }
+    flash.deinit();
     return 0;
 }
 
@@ -103,131 +187,476 @@ int Flasher::erase_flash(){
  * @return  Return code
  */
 int Flasher::write_to_flash(string buffer){
-    return write_to_flash((char *)buffer.c_str());
+    return write_to_flash(buffer.c_str(), buffer.length());
 }
 
 /** write_to_flash
- * @brief	Writes char pointer to flash.
+ * @brief	Writes null terminated char pointer to flash.
  * @return  Return code
  */
 int Flasher::write_to_flash(char *data){
-    //printf("Flashing: %s\r\nLength: %i\r\n", data, strlen(data));
-      
+    return write_to_flash(data, strlen(data));
+}
+
+/** write_to_flash
+ * @brief	Writes a buffer to flash as one script image.
+ * @param	data Payload
+ * @param	length Payload length in bytes
+ * @param	flags FLASHER_FLAG_* stored in the header
+ * @return  Return code
+ */
+int Flasher::write_to_flash(const char *data, uint32_t length, uint16_t flags){
+    int ret = begin_write(length, flags);
+    if(ret != 0){
+        return ret;
+    }
+
+    ret = write_chunk(data, length);
+    if(ret != 0){
+        return ret;
+    }
+
+    ret = end_write();
+    if(ret == 0){
+        printf("Flashed %lu bytes\n", (unsigned long)length);
+    }
+    return ret;
+}
+
+/** begin_write
+ * @brief	Starts a streamed write of a script image into the inactive bank.
+ *          The active bank is left untouched until end_write() succeeds.
+ * @param	length Total payload length in bytes, or FLASHER_LENGTH_UNKNOWN
+ *          if it is only known once all chunks have been written
+ * @param	flags FLASHER_FLAG_* stored in the header
+ * @return  Return code
+ */
+int Flasher::begin_write(uint32_t length, uint16_t flags){
+    abort_write();
+
+    int active = get_active_bank();
+    int bank = get_inactive_bank();
+
     flash.init();
-    
-    uint32_t addr = get_flash_address();
-    //uint32_t next_sector = addr + flash.get_sector_size(addr);
-    //size_t pages_flashed = 0;
-    //uint32_t percent_done = 0;
-    bool sector_erased = false;
-    
-    while (true) {
 
-        // Read data for this page
-        /*
-        memset(page_buffer, 0, sizeof(page_buffer));
-        int size_read = fread(page_buffer, 1, page_size, file);
-        if (size_read <= 0) {
-            break;
-        }
-        */
+    uint32_t page_size = flash.get_page_size();
+    uint32_t padded = ((length + page_size - 1) / page_size) * page_size;
 
-        // Erase this page if it hasn't been erased
-        if (!sector_erased) {
-            if(flash.erase(addr, flash.get_sector_size(addr)) != 0){
-                //printf("Error erasing Flash...\n");
-                flash.deinit();
-                return 1; // Error while erasing
+    if(length != FLASHER_LENGTH_UNKNOWN && header_size() + padded > get_bank_size(bank)){
+        flash.deinit();
+        return 3; // Script does not fit
+    }
+
+    bank_addr = get_bank_address(bank);
+    bank_end = bank_addr + get_bank_size(bank);
+    erased_until = bank_addr;
+    if(ensure_erased(bank_addr + 1) != 0){
+        flash.deinit();
+        return 1; // Error while erasing
+    }
+
+    page_buffer = new char[page_size];
+    page_fill = 0;
+    write_addr = bank_addr + header_size();
+    expected = length;
+    written = 0;
+    flushed = false;
+    running_crc = 0;
+
+    pending.magic = FLASHER_MAGIC;
+    pending.format = FLASHER_FORMAT_VERSION;
+    pending.flags = flags;
+    pending.version = active < 0 ? 1 : get_header(active)->version + 1;
+    pending.length = 0;
+    pending.crc = 0;
+
+    return 0;
+}
+
+/** write_chunk
+ * @brief	Appends payload bytes to the image being written. Whole pages are
+ *          programmed straight from the caller buffer; only a trailing
+ *          partial page is kept back in the page buffer.
+ * @param	data Payload bytes
+ * @param	size Number of bytes
+ * @return  Return code
+ */
+int Flasher::write_chunk(const char *data, uint32_t size){
+    if(page_buffer == NULL || flushed ||
+       (expected != FLASHER_LENGTH_UNKNOWN && size > expected - written)){
+        abort_write();
+        return 5; // No write in progress or too much data
+    }
+
+    uint32_t page_size = flash.get_page_size();
+    running_crc = crc32(data, size, running_crc);
+    written += size;
+
+    // Complete a partially filled page first
+    if(page_fill > 0){
+        uint32_t count = page_size - page_fill;
+        if(count > size){
+            count = size;
+        }
+        memcpy(page_buffer + page_fill, data, count);
+        page_fill += count;
+        data += count;
+        size -= count;
+
+        if(page_fill == page_size){
+            int ret = program_pages(page_buffer, page_size);
+            if(ret != 0){
+                abort_write();
+                return ret;
             }
-            printf("Erased Flash...\n");
-            sector_erased = true;
+            page_fill = 0;
         }
+    }
 
-        // Program page
-        if(flash.program(data, addr, flash.get_page_size()) != 0){
-            //printf("Error Flashing...\n");
-            flash.deinit();
-            return 2; // Error while flashing
+    // Program whole pages directly
+    uint32_t whole = (size / page_size) * page_size;
+    if(whole > 0){
+        int ret = program_pages(data, whole);
+        if(ret != 0){
+            abort_write();
+            return ret;
         }
+        data += whole;
+        size -= whole;
+    }
 
-        printf("Flashed %i bytes\n", strlen(data));
-    
-        // Multiple sector write support. Not implemented yet
-        /*
-        addr += page_size;
-        if (addr >= next_sector) {
-            next_sector = addr + flash.get_sector_size(addr);
-            sector_erased = false;
-        }
-        */
-        /*
-        if (++pages_flashed % 3 == 0) {
-            uint32_t percent_done_new = ftell(file) * 100 / len;
-            if (percent_done != percent_done_new) {
-                percent_done = percent_done_new;
-                printf("Flashed %3ld%%\r", percent_done);
-            }
+    // Keep the rest for the next call
+    if(size > 0){
+        memcpy(page_buffer, data, size);
+        page_fill = size;
+    }
+
+    return 0;
+}
+
+/** flush_write
+ * @brief	Programs the last partial page and verifies the payload, without
+ *          programming the header. The payload can then be inspected with
+ *          get_write_data() before it is made active with end_write().
+ * @return  Return code
+ */
+int Flasher::flush_write(){
+    if(page_buffer == NULL ||
+       (expected != FLASHER_LENGTH_UNKNOWN && written != expected)){
+        abort_write();
+        return 5; // No write in progress or missing data
+    }
+    if(flushed){
+        return 0;
+    }
+
+    uint32_t page_size = flash.get_page_size();
+    if(page_fill > 0){
+        memset(page_buffer + page_fill, 0xFF, page_size - page_fill);
+        int ret = program_pages(page_buffer, page_size);
+        if(ret != 0){
+            abort_write();
+            return ret;
         }
-        */
+        page_fill = 0;
+    }
+
+    if(crc32(flash_pointer(bank_addr + header_size()), written) != running_crc){
+        abort_write();
+        return 4; // Read back does not match
+    }
+
+    flushed = true;
+    return 0;
+}
+
+/** end_write
+ * @brief	Flushes the last page, verifies the payload and programs the
+ *          header. Programming the header is what makes the new bank the
+ *          active one. The page holding the magic is programmed last, so a
+ *          header cut short by a power loss does not carry it, and a torn
+ *          header that does is still rejected by its length and CRC32.
+ * @return  Return code
+ */
+int Flasher::end_write(){
+    int ret = flush_write();
+    if(ret != 0){
+        return ret;
+    }
+
+    pending.length = written;
+    pending.crc = running_crc;
+
+    uint32_t size = header_size();
+    char *header = new char[size];
+    memset(header, 0xFF, size);
+    memcpy(header, &pending, sizeof(flasher_header_t));
+    uint32_t page_size = flash.get_page_size();
+    if(size > page_size){
+        ret = flash.program(header + page_size, bank_addr + page_size, size - page_size);
+        size = page_size;
+    }
+    if(ret == 0){
+        ret = flash.program(header, bank_addr, size);
+    }
+    delete[] header;
+
+    abort_write();
+    return ret != 0 ? 2 : 0;
+}
+
+/** abort_write
+ * @brief	Drops a streamed write. The bank being written is left without a
+ *          valid header; the active bank is not affected.
+ */
+void Flasher::abort_write(){
+    if(page_buffer != NULL){
+        delete[] page_buffer;
+        page_buffer = NULL;
         flash.deinit();
-        break;
-        
     }
-    
-    //char *data_check;
-    //read_from_flash(data_check);
-    //delete[] page_buffer;
+    page_fill = 0;
+    written = 0;
+    flushed = false;
+}
+
+/** get_write_data
+ * @brief	Returns the payload of the write in progress, once flushed.
+ * @param	length Set to the payload length
+ * @return  Data, or 0 if no flushed write is in progress
+ */
+const char *Flasher::get_write_data(uint32_t *length){
+    if(page_buffer == NULL || !flushed){
+        return 0;
+    }
+    if(length){
+        *length = written;
+    }
+    return (const char *)flash_pointer(bank_addr + header_size());
+}
+
+/** read_back
+ * @brief	Reads payload bytes already passed to write_chunk(), from flash or
+ *          from the page buffer for the part not programmed yet.
+ * @param	offset Offset in the payload
+ * @param	data Destination
+ * @param	size Number of bytes
+ * @return  Return code
+ */
+int Flasher::read_back(uint32_t offset, char *data, uint32_t size){
+    if(page_buffer == NULL || offset > written || size > written - offset){
+        return 5; // No write in progress or not written yet
+    }
+
+    uint32_t programmed = written - page_fill;
+    if(offset < programmed){
+        uint32_t count = programmed - offset;
+        if(count > size){
+            count = size;
+        }
+        memcpy(data, flash_pointer(bank_addr + header_size() + offset), count);
+        data += count;
+        offset += count;
+        size -= count;
+    }
+    memcpy(data, page_buffer + (offset - programmed), size);
+
     return 0;
 }
 
+/** get_write_crc
+ * @brief	Returns the CRC32 of the bytes written so far.
+ * @return  CRC32
+ */
+uint32_t Flasher::get_write_crc(){
+    return running_crc;
+}
+
+/** ensure_erased
+ * @brief	Erases sectors until the given address is covered.
+ * @param	end First address that does not need to be erased
+ * @return  Return code
+ */
+int Flasher::ensure_erased(uint32_t end){
+    while(erased_until < end){
+        uint32_t sector_size = flash.get_sector_size(erased_until);
+        if(flash.erase(erased_until, sector_size) != 0){
+            return 1; // Error while erasing
+        }
+        erased_until += sector_size;
+    }
+    return 0;
+}
+
+/** program_pages
+ * @brief	Programs whole pages at the write address and advances it.
+ * @param	data Page aligned data
+ * @param	size Multiple of the page size
+ * @return  Return code
+ */
+int Flasher::program_pages(const char *data, uint32_t size){
+    if(write_addr + size > bank_end){
+        return 3; // Script does not fit
+    }
+    if(ensure_erased(write_addr + size) != 0){
+        return 1; // Error while erasing
+    }
+    if(flash.program(data, write_addr, size) != 0){
+        return 2; // Error while flashing
+    }
+    write_addr += size;
+    return 0;
+}
+
+/** flash_pointer
+ * @brief	Returns a pointer to memory mapped flash. Addresses are kept as
+ *          uint32_t, as FlashIAP takes them, and only turned into pointers
+ *          here.
+ * @param	addr Flash address
+ * @return  Pointer to the flash contents at addr
+ */
+const uint8_t *Flasher::flash_pointer(uint32_t addr){
+    return (const uint8_t *)(uintptr_t)addr;
+}
+
+/** get_header
+ * @brief	Returns the header of the script stored in a bank. A header is
+ *          only valid with a length that fits in the bank and a payload
+ *          matching its CRC32, so a header torn by a power loss never makes
+ *          its bank the active one. The CRC32 is computed once per header.
+ * @param	bank Bank number
+ * @return  Header, or 0 if the bank holds no valid script
+ */
+const flasher_header_t *Flasher::get_header(int bank){
+    uint32_t bank_size = get_bank_size(bank);
+    if(bank_size < header_size()){
+        return 0;
+    }
+
+    const flasher_header_t *header = (const flasher_header_t *)flash_pointer(get_bank_address(bank));
+    if(header->magic != FLASHER_MAGIC || header->format != FLASHER_FORMAT_VERSION ||
+       header->length > bank_size - header_size()){
+        return 0;
+    }
+
+    if(memcmp(&checked[bank], header, sizeof(flasher_header_t)) != 0){
+        checked[bank] = *header;
+        checked_valid[bank] = crc32((const char *)header + header_size(), header->length) == header->crc;
+    }
+    return checked_valid[bank] ? header : 0;
+}
+
+/** get_active_bank
+ * @brief	Returns the bank holding the newest valid script.
+ * @return  Bank number, or -1 if no valid script is stored
+ */
+int Flasher::get_active_bank(){
+    int active = -1;
+    for(int bank = 0; bank < FLASHER_BANK_COUNT; bank++){
+        const flasher_header_t *header = get_header(bank);
+        if(header != 0 && (active < 0 || header->version > get_header(active)->version)){
+            active = bank;
+        }
+    }
+    return active;
+}
+
+/** get_inactive_bank
+ * @brief	Returns the bank the next script will be written to.
+ * @return  Bank number
+ */
+int Flasher::get_inactive_bank(){
+    int active = get_active_bank();
+    if(active < 0 || get_bank_size(1 - active) == 0){
+        return 0;
+    }
+    return 1 - active;
+}
+
+/** read_from_flash
+ * @brief	Returns a stored script straight from flash. The payload is not
+ *          null terminated.
+ * @param	bank Bank number
+ * @param	length Set to the payload length
+ * @return  Data, or 0 if the bank holds no valid script
+ */
+const char *Flasher::read_from_flash(int bank, uint32_t *length){
+    const flasher_header_t *header = get_header(bank);
+    if(header == 0){
+        return 0;
+    }
+    if(length){
+        *length = header->length;
+    }
+    return (const char *)header + header_size();
+}
+
 /** read_from_flash
- * @brief	Reads data from flash.
- * @return  Data
+ * @brief	Returns the active script straight from flash.
+ * @param	length Set to the payload length
+ * @return  Data, or 0 if no valid script is stored
  */
-char *Flasher::read_from_flash(){
-    //uint32_t address = POST_APPLICATION_ADDR;
-    char *data = (char *)get_flash_address();
-    if((int)data[0] == 255){
+const char *Flasher::read_from_flash(uint32_t *length){
+    int bank = get_active_bank();
+    if(bank < 0){
         return 0;
     }
-    return data;
+    return read_from_flash(bank, length);
 }
 
+/** verify_flash
+ * @brief	Checks a stored payload against its header CRC again, to catch
+ *          flash gone bad since the header was checked.
+ * @param	bank Bank number
+ * @return  0 if valid, 1 if no script is stored, 4 on CRC mismatch
+ */
+int Flasher::verify_flash(int bank){
+    uint32_t length;
+    const char *data = read_from_flash(bank, &length);
+    if(data == 0){
+        return 1; // No data exists
+    }
+    return crc32(data, length) == get_header(bank)->crc ? 0 : 4;
+}
 
 /** print_flash
- * @brief	Print the data in flash to terminal.
+ * @brief	Print the active script to terminal.
  * @return  Return code
  */
 int Flasher::print_flash(){
-    uint32_t address = get_flash_address();
-    char *data = (char *)address;
-    
-    flash.init();
-    
-    if(flash.read(data, address, flash.get_page_size()) != 0){
-        //printf("Error reading Flash...\n");
-        flash.deinit();
-        return 1; // Error reading
-    }
+    int bank = get_active_bank();
+    uint32_t length;
+    const char *data = read_from_flash(&length);
 
-    if((int)data[0] == 255){
+    if(data == 0){
         //printf("No data exists in flash...\n");
-        flash.deinit();
         return 2; // No data exists 
     }
 
-    printf("Data: ");
-    for(int i = 0; data[i] != '\0'; i++){
-        //printf("%c", *((char *) (address+i)));
-        printf("%c", data[i]);
-    }
+    printf("Data (bank %i, %lu bytes, version %lu): ", bank, (unsigned long)length, (unsigned long)get_header(bank)->version);
+    fwrite(data, 1, length, stdout);
     printf("\n");
-
-    flash.deinit();
         
     return 0;
 }
 
+/** crc32
+ * @brief	Computes the CRC32 of a buffer.
+ * @param	data Buffer
+ * @param	size Buffer size
+ * @param	crc CRC of the preceding data when computing in chunks
+ * @return  CRC32
+ */
+uint32_t Flasher::crc32(const void *data, uint32_t size, uint32_t crc){
+    const uint8_t *bytes = (const uint8_t *)data;
+    crc = ~crc;
+    for(uint32_t i = 0; i < size; i++){
+        crc = crc32_table[(crc ^ bytes[i]) & 0x0F] ^ (crc >> 4);
+        crc = crc32_table[(crc ^ (bytes[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
 /* Sample code for applying update----------------------------------------------*/
 /*
 //#include "SDBlockDevice.h"
@@ -322,4 +751,4 @@ void apply_update(FILE *file, uint32_t address)
 
     flash.deinit();
 }
-*/
\ No newline at end of file
+*/
\ No newline at end of file
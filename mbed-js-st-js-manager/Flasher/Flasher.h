@@ -48,26 +48,114 @@
 #include <string>
 using namespace std;
 
+/* Defines -------------------------------------------------------------------*/
+
+/** Marks the start of a valid script image ("JSSC"). */
+#define FLASHER_MAGIC           0x4353534A
+
+/** Layout version of the script image written by this library. */
+#define FLASHER_FORMAT_VERSION  1
+
+/** Number of script banks the flash area is split into. */
+#define FLASHER_BANK_COUNT      2
+
+/** Length to pass to begin_write() when it is not known in advance. */
+#define FLASHER_LENGTH_UNKNOWN  0xFFFFFFFF
+
+/** Header flag: the payload is a JerryScript snapshot, not source. */
+#define FLASHER_FLAG_SNAPSHOT   0x0001
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/**
+ * Header stored in front of every script image in flash.
+ * It is programmed after the payload has been written and verified, with the
+ * magic last, and a header is only trusted if its length fits in the bank
+ * and the payload matches its CRC32, so an interrupted write never leaves an
+ * image that looks valid.
+ */
+typedef struct {
+    uint32_t magic;     /**< FLASHER_MAGIC */
+    uint16_t format;    /**< FLASHER_FORMAT_VERSION */
+    uint16_t flags;     /**< FLASHER_FLAG_* */
+    uint32_t version;   /**< Incremented on every write, newest bank wins */
+    uint32_t length;    /**< Payload length in bytes */
+    uint32_t crc;       /**< CRC32 of the payload */
+} flasher_header_t;
+
 /* Class Declaration ---------------------------------------------------------*/
 
 /**
  * Library for performing flash tasks like wrting, erasing.
+ *
+ * A script is stored as a flasher_header_t followed by the payload. Writes
+ * may span several sectors and are streamed page by page, either in one go
+ * with write_to_flash() or in chunks with begin_write(), write_chunk() and
+ * end_write(). Only one page is buffered in RAM while streaming.
+ *
+ * The script area is split into two banks. A write always goes to the
+ * inactive bank and the valid bank with the highest version is the active
+ * one, so the previous script survives an interrupted write and stays
+ * available for rollback.
+ *
+ * Return codes: 0 ok, 1 erase error, 2 program error, 3 image too large,
+ * 4 verification failed, 5 no write in progress or length mismatch.
  */
 class Flasher{
 private:
     static FlashIAP flash;
 
+    /* Streaming write state. */
+    static char *page_buffer;
+    static uint32_t page_fill;
+    static uint32_t bank_addr;
+    static uint32_t bank_end;
+    static uint32_t write_addr;
+    static uint32_t erased_until;
+    static uint32_t expected;
+    static uint32_t written;
+    static bool flushed;
+    static uint32_t running_crc;
+    static flasher_header_t pending;
+
+    /* Last header seen in each bank and whether its payload CRC32 matched. */
+    static flasher_header_t checked[FLASHER_BANK_COUNT];
+    static bool checked_valid[FLASHER_BANK_COUNT];
+
+    static int ensure_erased(uint32_t end);
+    static int program_pages(const char *data, uint32_t size);
+    static const uint8_t *flash_pointer(uint32_t addr);
+
 public:
 
     Flasher();
     ~Flasher();
     
     static uint32_t get_flash_address();
+    static uint32_t get_bank_address(int bank);
+    static uint32_t get_bank_size(int bank);
+    static uint32_t header_size();
     static int erase_flash();
+    static int invalidate_bank(int bank);
     static int write_to_flash(char *data);
     static int write_to_flash(string);
-    static char *read_from_flash();
+    static int write_to_flash(const char *data, uint32_t length, uint16_t flags = 0);
+    static int begin_write(uint32_t length, uint16_t flags = 0);
+    static int write_chunk(const char *data, uint32_t size);
+    static int flush_write();
+    static int end_write();
+    static void abort_write();
+    static const char *get_write_data(uint32_t *length);
+    static int read_back(uint32_t offset, char *data, uint32_t size);
+    static uint32_t get_write_crc();
+    static const flasher_header_t *get_header(int bank);
+    static int get_active_bank();
+    static int get_inactive_bank();
+    static const char *read_from_flash(int bank, uint32_t *length);
+    static const char *read_from_flash(uint32_t *length = NULL);
+    static int verify_flash(int bank);
     static int print_flash();
+    static uint32_t crc32(const void *data, uint32_t size, uint32_t crc = 0);
 
 };
 
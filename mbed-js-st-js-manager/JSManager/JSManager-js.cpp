@@ -104,6 +104,32 @@ DECLARE_CLASS_FUNCTION(JSManager, erase_flash) {
 }
 
 
+/**
+ * JSManager#rollback (native JavaScript method)
+ *
+ * Makes the previously flashed program active again.
+ */
+DECLARE_CLASS_FUNCTION(JSManager, rollback) {
+    CHECK_ARGUMENT_COUNT(JSManager, rollback, (args_count == 0));
+    
+    // Unwrap native JSManager object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native JSManager pointer");
+    }
+
+    JSManager *native_ptr = static_cast<JSManager*>(void_ptr);
+
+    int ret = native_ptr->rollback();
+
+    return jerry_create_number(ret);
+}
+
+
 /**
  * JSManager#write_to_flash (native JavaScript method)
  *
@@ -134,7 +160,7 @@ DECLARE_CLASS_FUNCTION(JSManager, write_to_flash) {
 
     JSManager *native_ptr = static_cast<JSManager*>(void_ptr);
 
-    native_ptr->write_to_flash(code);
+    native_ptr->write_to_flash(code, code_length);
 
     free(code);
     return jerry_create_undefined();
@@ -203,6 +229,60 @@ DECLARE_CLASS_FUNCTION(JSManager, reboot) {
     return jerry_create_undefined();
 }
 
+#ifdef JSMANAGER_PROFILE
+/**
+ * JSManager#profile (native JavaScript method)
+ *
+ * Counts the calls and time spent in every function of an object.
+ *
+ * @param object Object to profile, e.g. a sensor
+ * @param name Name printed before the function names
+ * @returns number of functions profiled
+ */
+DECLARE_CLASS_FUNCTION(JSManager, profile) {
+    CHECK_ARGUMENT_COUNT(JSManager, profile, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(JSManager, profile, 0, object);
+    CHECK_ARGUMENT_TYPE_ALWAYS(JSManager, profile, 1, string);
+
+    size_t name_length = jerry_get_string_length(args[1]);
+
+    // add an extra character to ensure there's a null character after the name
+    char* name = (char*)calloc(name_length + 1, sizeof(char));
+    jerry_string_to_char_buffer(args[1], (jerry_char_t*)name, name_length);
+
+    int ret = Profiler::wrap(args[0], name);
+
+    free(name);
+    return jerry_create_number(ret);
+}
+
+/**
+ * JSManager#print_profile (native JavaScript method)
+ *
+ * Prints the calls and time spent in the profiled functions.
+ */
+DECLARE_CLASS_FUNCTION(JSManager, print_profile) {
+    CHECK_ARGUMENT_COUNT(JSManager, print_profile, (args_count == 0));
+
+    Profiler::print();
+
+    return jerry_create_undefined();
+}
+
+/**
+ * JSManager#reset_profile (native JavaScript method)
+ *
+ * Clears the profile counts.
+ */
+DECLARE_CLASS_FUNCTION(JSManager, reset_profile) {
+    CHECK_ARGUMENT_COUNT(JSManager, reset_profile, (args_count == 0));
+
+    Profiler::reset();
+
+    return jerry_create_undefined();
+}
+#endif // JSMANAGER_PROFILE
+
 /**
  * JSManager (native JavaScript constructor)
  *
@@ -218,11 +298,17 @@ DECLARE_CLASS_CONSTRUCTOR(JSManager) {
 
     
     ATTACH_CLASS_FUNCTION(js_object, JSManager, erase_flash);
+    ATTACH_CLASS_FUNCTION(js_object, JSManager, rollback);
     ATTACH_CLASS_FUNCTION(js_object, JSManager, run_js_flash);
     ATTACH_CLASS_FUNCTION(js_object, JSManager, write_to_flash);
     ATTACH_CLASS_FUNCTION(js_object, JSManager, reboot);
     ATTACH_CLASS_FUNCTION(js_object, JSManager, load_http_program);
     ATTACH_CLASS_FUNCTION(js_object, JSManager, connect_to_network);
+#ifdef JSMANAGER_PROFILE
+    ATTACH_CLASS_FUNCTION(js_object, JSManager, profile);
+    ATTACH_CLASS_FUNCTION(js_object, JSManager, print_profile);
+    ATTACH_CLASS_FUNCTION(js_object, JSManager, reset_profile);
+#endif
     
     return js_object;
 }
@@ -1,6 +1,6 @@
 #include "JSManager.h"
 
-JSManager::JSManager(){
+JSManager::JSManager() : stream_error(0), request(NULL){
 }
 
 int JSManager::connect_to_network(){
@@ -27,49 +27,71 @@ void JSManager::reboot(){
 /**
  * run_js_flash
  *
- * Parse and run a dynamically loaded javascript file
+ * Parse and run a dynamically loaded javascript file. If the active bank
+ * does not parse, it is invalidated and the previous bank is run instead.
+ * A snapshot on firmware built without snapshot support is kept, for a
+ * firmware that can run it, and the previous bank is run.
  */
 int JSManager::run_js_flash(){
-    char *code = Flasher::read_from_flash();
-    if(code == 0){
+    int bank = Flasher::get_active_bank();
+    if(bank < 0){
         return 1; //Flash is empty
     }
-    else{
-        const size_t length = strlen(code); //strlen(main_js::get_code()); //sizeof (code) / sizeof (code[0]); //24; //code.length;
-        //printf("Length of code: %i\n", (int)length);
-        jerry_value_t parsed_code = jerry_parse((const jerry_char_t *)code, length, false);
-
-        if (jerry_value_has_error_flag(parsed_code)) {
-            jerry_release_value(parsed_code);
-            jsmbed_js_exit();
-            return 2; //jerry_parse failed
-        }
-
-        jerry_value_t returned_value = jerry_run(parsed_code);
-        jerry_release_value(parsed_code);
 
-        if (jerry_value_has_error_flag(returned_value)) {
-            jerry_release_value(returned_value);
-            jsmbed_js_exit();
-            return 3; //jerry_run failed
-        }
-
-        jerry_release_value(returned_value);
-        return 0;
+    int ret = run_js_bank(bank);
+    if(ret == 2 && Flasher::get_header(1 - bank) != 0){
+        printf("JSManager: Script in bank %i does not parse, rolling back...\r\n", bank);
+        Flasher::invalidate_bank(bank);
+        ret = run_js_bank(1 - bank);
+    }
+    else if(ret == 4 && Flasher::get_header(1 - bank) != 0){
+        printf("JSManager: Script in bank %i is a snapshot, not supported by this firmware\r\n", bank);
+        ret = run_js_bank(1 - bank);
+    }
+    return ret;
+}
 
+/**
+ * run_js_bank
+ *
+ * Run the javascript file stored in one bank, from source or snapshot.
+ */
+int JSManager::run_js_bank(int bank){
+    int ret = ScriptLoader::run(bank);
+    if(ret >= 2){
+        jsmbed_js_exit();
     }
+    return ret;
 }
 
-int JSManager::write_to_flash(char *data){
-    //int len = strlen(data);
-    //data[len] = '\0';
-    return Flasher::write_to_flash(data);
+int JSManager::write_to_flash(const char *data, uint32_t length){
+    return ScriptLoader::store(data, length);
 }
 
 int JSManager::erase_flash(){
     return Flasher::erase_flash();
 }
 
+/**
+ * rollback
+ *
+ * Invalidates the active bank so the previous script runs after reboot.
+ * returns code
+ * 0 for success
+ * 1 for no previous script to roll back to
+ * 2 for error erasing flash
+ */
+int JSManager::rollback(){
+    int bank = Flasher::get_active_bank();
+    if(bank < 0 || Flasher::get_header(1 - bank) == 0){
+        return 1; // Nothing to roll back to
+    }
+    if(Flasher::invalidate_bank(bank) != 0){
+        return 2; // Error erasing
+    }
+    return 0;
+}
+
 void JSManager::cleanup(){
     printf("JSManager: Cleaning up...\r\n");
     
@@ -107,8 +129,26 @@ void JSManager::print_response(HttpResponse* res) {
     }
     // */
     
-    // Print body
-    printf("code (%d bytes):\n\n%s\n\n", res->get_body_length(), res->get_body_as_string().c_str());
+    // The body is streamed into flash and not kept in the response
+}
+
+/**
+ * on_body_chunk
+ *
+ * Decodes a chunk of the HTTP response body into flash. The body is either
+ * the program source, or a compressed or delta update (see ScriptUpdate.h).
+ * The body of any other status than 200 is dropped: the inactive bank, which
+ * holds the previous program, is only erased for a new one.
+ */
+void JSManager::on_body_chunk(const char *data, size_t size){
+    HttpResponse *res = request->get_response();
+    if(res == NULL || res->get_status_code() != 200){
+        return;
+    }
+
+    if(stream_error == 0){
+        stream_error = update.write(data, size);
+    }
 }
 
 /**
@@ -120,6 +160,11 @@ void JSManager::print_response(HttpResponse* res) {
  * 1 for no network available
  * 2 for request status not ok
  * 3 for error in parsin code 
+ * 4 for network could not be located
+ * 5 for error writing to flash
+ * 6 for checksum mismatch or malformed update
+ * 7 for delta update not built against the installed program
+ * 8 for delta update in snapshot mode
  */
 int JSManager::load_http_program(char *url){
     // Connect to the network (see mbed_app.json for the connectivity method used)
@@ -130,15 +175,18 @@ int JSManager::load_http_program(char *url){
 
     // Do a GET request to httpbin.org
     {
-        // By default the body is automatically parsed and stored in a buffer, this is memory heavy.
-        // To receive chunked response, pass in a callback as last parameter to the constructor.
-        //HttpRequest* get_req = new HttpRequest(network, HTTP_GET, "http://httpbin.org/status/418");
-        HttpRequest* get_req = new HttpRequest(getNetworkInterface(), HTTP_GET, url);
-        //HttpRequest* get_req = new HttpRequest(network, HTTP_GET, "http://os.mbed.com/cookbook/HTTP-Client#hello-world");
+        // The body is decoded into the inactive bank as it arrives, so only
+        // one flash page of the program is held in RAM
+        update.reset();
+        stream_error = 0;
+        HttpRequest* get_req = new HttpRequest(getNetworkInterface(), HTTP_GET, url,
+                                               Callback<void(const char*, size_t)>(this, &JSManager::on_body_chunk));
+        request = get_req;
         
         HttpResponse* get_res = get_req->send();
         if (!get_res) {
             //printf("HttpRequest failed (error code %d)\n", get_req->get_error());
+            Flasher::abort_write();
             delete get_req;
             return 1; // Request failed.
         }
@@ -146,29 +194,47 @@ int JSManager::load_http_program(char *url){
         
         if(get_res->get_status_code() == 200){
             print_response(get_res);
-                
-            string data = get_res->get_body_as_string();
 
-            jerry_value_t parsed_code = jerry_parse((const jerry_char_t *)data.c_str(), data.length(), false);
+            if(stream_error == 0){
+                stream_error = update.finish();
+            }
+            if(stream_error != 0){
+                Flasher::abort_write();
+                delete get_req;
+                return stream_error >= 6 ? stream_error : 5; // Bad update or error writing to flash
+            }
 
-            if (jerry_value_has_error_flag(parsed_code)) {
+            // Optional end to end check, the server can send the CRC32 of the program
+            for (size_t ix = 0; ix < get_res->get_headers_length(); ix++) {
+                if(strcasecmp(get_res->get_headers_fields()[ix]->c_str(), "X-Script-CRC32") == 0){
+                    uint32_t crc = strtoul(get_res->get_headers_values()[ix]->c_str(), NULL, 16);
+                    if(crc != Flasher::get_write_crc()){
+                        Flasher::abort_write();
+                        delete get_req;
+                        return 6; // Checksum mismatch
+                    }
+                }
+            }
+
+            // Checked in place from flash, the running script stays valid
+            // until the new one has been verified
+            int ret = ScriptLoader::commit();
+            if(ret == 6){
                 //LOG_PRINT_ALWAYS("Error parsing program. Contains error(s)");
-                jerry_release_value(parsed_code);
                 delete get_req;
                 return 3; // Error parsing program.
             }
-            else{
-                
-                //printf("priting: %s", data.c_str());
-                Flasher::write_to_flash((char *)data.c_str());
-
-                jerry_release_value(parsed_code);
-                reboot();
+            else if(ret != 0){
+                delete get_req;
+                return 5; // Error writing to flash
             }
+
+            reboot();
             
         }
         else{
             //printf("Could not get program from server!\n");
+            Flasher::abort_write();
             delete get_req;
             return 2; // File not found.
         }
@@ -17,6 +17,9 @@
 
 #include "string.h"
 #include "Flasher.h"
+#include "ScriptLoader.h"
+#include "ScriptUpdate.h"
+#include "Profiler.h"
 
 using namespace std;
 
@@ -34,13 +37,28 @@ public:
     /**
      * run_js_flash
      *
-     * Parse and run a dynamically loaded javascript file
+     * Parse and run a dynamically loaded javascript file, falling back to
+     * the previous bank if the active one does not parse
      */
     int run_js_flash();
 
-    int write_to_flash(char *data);
+    /**
+     * run_js_bank
+     *
+     * Run the javascript file stored in one bank, from source or snapshot
+     */
+    int run_js_bank(int bank);
+
+    int write_to_flash(const char *data, uint32_t length);
 
     int erase_flash();
+
+    /**
+     * rollback
+     *
+     * Makes the previous script active again, without a download
+     */
+    int rollback();
     
     void cleanup();
 
@@ -62,11 +80,28 @@ public:
      * 1 for no network available
      * 2 for request status not ok
      * 3 for error in parsin code 
+     * 4 for network could not be located
+     * 5 for error writing to flash
+     * 6 for checksum mismatch or malformed update
+     * 7 for delta update not built against the installed program
+     * 8 for delta update in snapshot mode
      */
     int load_http_program(char *url);
 
     void jsmbed_js_exit();
 
+private:
+    /**
+     * on_body_chunk
+     *
+     * Decodes a chunk of the HTTP response body into flash.
+     */
+    void on_body_chunk(const char *data, size_t size);
+
+    UpdateDecoder update;
+    int stream_error;
+    HttpRequest *request;
+
 };
 
 #endif // _JS_MANAGER_H
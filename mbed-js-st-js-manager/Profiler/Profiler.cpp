@@ -0,0 +1,206 @@
+/**
+ ******************************************************************************
+ * @file    Profiler.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Call counts and time spent in native JS bindings.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Profiler.h"
+
+#include "us_ticker_api.h"
+
+#ifdef JSMANAGER_PROFILE
+
+/* Static Members ------------------------------------------------------------*/
+
+Profiler::binding_t Profiler::bindings[PROFILER_MAX_BINDINGS];
+size_t Profiler::binding_count = 0;
+uint32_t Profiler::start_time = 0;
+
+/** Marks wrapper functions, their native pointer is the binding_t. */
+static const jerry_object_native_info_t profiler_type_info = {
+    .free_cb = NULL
+};
+
+/** Property of a wrapper holding the original function. */
+static const jerry_char_t ORIGINAL_PROPERTY[] = "__profiled";
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** wrap
+ * @brief	Profiles every function of an object.
+ * @param	object Object, e.g. a sensor returned by its constructor
+ * @param	name Name printed before the function names, e.g. "LSM6DSL_JS"
+ * @return  Number of functions wrapped
+ */
+int Profiler::wrap(jerry_value_t object, const char *name){
+    if(binding_count == 0 && start_time == 0){
+        reset();
+    }
+
+    int wrapped = 0;
+    jerry_value_t keys = jerry_get_object_keys(object);
+    uint32_t length = jerry_get_array_length(keys);
+
+    for(uint32_t ix = 0; ix < length; ix++){
+        jerry_value_t key = jerry_get_property_by_index(keys, ix);
+        jerry_value_t value = jerry_get_property(object, key);
+
+        void *void_ptr;
+        const jerry_object_native_info_t *type_ptr;
+        bool profiled = jerry_value_is_function(value) &&
+                        jerry_get_object_native_pointer(value, &void_ptr, &type_ptr) &&
+                        type_ptr == &profiler_type_info;
+
+        if(jerry_value_is_function(value) && !profiled && jerry_value_is_string(key)){
+            if(binding_count == PROFILER_MAX_BINDINGS){
+                jerry_release_value(value);
+                jerry_release_value(key);
+                break; // Table full
+            }
+
+            binding_t *binding = &bindings[binding_count++];
+            jerry_size_t key_size = jerry_get_string_size(key);
+            char key_name[PROFILER_NAME_SIZE];
+            if(key_size >= sizeof(key_name)){
+                key_size = sizeof(key_name) - 1;
+            }
+            jerry_string_to_char_buffer(key, (jerry_char_t *)key_name, key_size);
+            key_name[key_size] = '\0';
+            snprintf(binding->name, sizeof(binding->name), "%s.%s", name, key_name);
+            binding->calls = 0;
+            binding->total_us = 0;
+            binding->max_us = 0;
+
+            jerry_value_t wrapper = jerry_create_external_function(Profiler::call);
+            jerry_set_object_native_pointer(wrapper, binding, &profiler_type_info);
+
+            jerry_value_t original_key = jerry_create_string(ORIGINAL_PROPERTY);
+            jerry_release_value(jerry_set_property(wrapper, original_key, value));
+            jerry_release_value(original_key);
+
+            jerry_release_value(jerry_set_property(object, key, wrapper));
+            jerry_release_value(wrapper);
+            wrapped++;
+        }
+
+        jerry_release_value(value);
+        jerry_release_value(key);
+    }
+
+    jerry_release_value(keys);
+    return wrapped;
+}
+
+/** reset
+ * @brief	Clears the counts and restarts the measurement period.
+ */
+void Profiler::reset(){
+    for(size_t ix = 0; ix < binding_count; ix++){
+        bindings[ix].calls = 0;
+        bindings[ix].total_us = 0;
+        bindings[ix].max_us = 0;
+    }
+    start_time = us_ticker_read();
+}
+
+/** print
+ * @brief	Prints the bindings sorted by total time, with their share of the
+ *          time since the last reset.
+ */
+void Profiler::print(){
+    uint8_t order[PROFILER_MAX_BINDINGS];
+    for(size_t ix = 0; ix < binding_count; ix++){
+        order[ix] = ix;
+    }
+
+    // Insertion sort, the table is small
+    for(size_t ix = 1; ix < binding_count; ix++){
+        uint8_t current = order[ix];
+        size_t jx = ix;
+        while(jx > 0 && bindings[order[jx - 1]].total_us < bindings[current].total_us){
+            order[jx] = order[jx - 1];
+            jx--;
+        }
+        order[jx] = current;
+    }
+
+    uint32_t elapsed = us_ticker_read() - start_time;
+
+    printf("\r\n%-40s %8s %10s %8s %8s %6s\r\n", "binding", "calls", "total us", "avg us", "max us", "time");
+    for(size_t ix = 0; ix < binding_count; ix++){
+        const binding_t *binding = &bindings[order[ix]];
+        uint32_t average = binding->calls ? (uint32_t)(binding->total_us / binding->calls) : 0;
+        uint32_t permille = elapsed ? (uint32_t)(binding->total_us * 1000 / elapsed) : 0;
+
+        printf("%-40s %8lu %10lu %8lu %8lu %3lu.%lu%%\r\n", binding->name, (unsigned long)binding->calls,
+               (unsigned long)binding->total_us, (unsigned long)average, (unsigned long)binding->max_us,
+               (unsigned long)(permille / 10), (unsigned long)(permille % 10));
+    }
+    printf("%lu us since reset\r\n", (unsigned long)elapsed);
+}
+
+/** call
+ * @brief	Native handler of the wrappers: calls the original function and
+ *          records the time it took.
+ */
+jerry_value_t Profiler::call(const jerry_value_t function_obj, const jerry_value_t this_val,
+                             const jerry_value_t args[], const jerry_length_t args_count){
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    if(!jerry_get_object_native_pointer(function_obj, &void_ptr, &type_ptr) || type_ptr != &profiler_type_info){
+        return jerry_create_error(JERRY_ERROR_TYPE, (const jerry_char_t *) "Not a profiled function");
+    }
+    binding_t *binding = static_cast<binding_t*>(void_ptr);
+
+    jerry_value_t original_key = jerry_create_string(ORIGINAL_PROPERTY);
+    jerry_value_t original = jerry_get_property(function_obj, original_key);
+    jerry_release_value(original_key);
+
+    uint32_t start = us_ticker_read();
+    jerry_value_t ret = jerry_call_function(original, this_val, args, args_count);
+    uint32_t elapsed = us_ticker_read() - start;
+
+    jerry_release_value(original);
+
+    binding->calls++;
+    binding->total_us += elapsed;
+    if(elapsed > binding->max_us){
+        binding->max_us = elapsed;
+    }
+
+    return ret;
+}
+
+#endif // JSMANAGER_PROFILE
@@ -0,0 +1,91 @@
+/**
+ ******************************************************************************
+ * @file    Profiler.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Call counts and time spent in native JS bindings.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+#ifndef _PROFILER_H
+#define _PROFILER_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mbed.h"
+#include "jerry-core/include/jerryscript.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Number of bindings that can be profiled. */
+#ifndef PROFILER_MAX_BINDINGS
+#define PROFILER_MAX_BINDINGS   32
+#endif
+
+/** Longest binding name kept, e.g. "LSM6DSL_JS.get_accelerometer_axes". */
+#define PROFILER_NAME_SIZE      40
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Opt-in profiler for native bindings, built when JSMANAGER_PROFILE is
+ * defined.
+ *
+ * wrap() replaces every function of an object, such as the one returned by
+ * new LSM6DSL_JS(), with a native wrapper that counts the calls and measures
+ * the time until the binding returns, then calls the original function.
+ * Time is inclusive: JS callbacks run by a binding count for the binding.
+ * print() prints a table sorted by total time.
+ */
+class Profiler {
+public:
+    static int wrap(jerry_value_t object, const char *name);
+    static void reset();
+    static void print();
+
+private:
+    typedef struct {
+        char name[PROFILER_NAME_SIZE];
+        uint32_t calls;
+        uint64_t total_us;
+        uint32_t max_us;
+    } binding_t;
+
+    static jerry_value_t call(const jerry_value_t function_obj, const jerry_value_t this_val,
+                              const jerry_value_t args[], const jerry_length_t args_count);
+
+    static binding_t bindings[PROFILER_MAX_BINDINGS];
+    static size_t binding_count;
+    static uint32_t start_time;
+};
+
+#endif // _PROFILER_H
@@ -0,0 +1,174 @@
+/**
+ ******************************************************************************
+ * @file    ScriptLoader.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Stores and runs JS programs from flash, as source or snapshot.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ScriptLoader.h"
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** store
+ * @brief	Compiles a program and writes it to the inactive bank.
+ * @param	source Program source
+ * @param	length Source length in bytes
+ * @return  Return code
+ */
+int ScriptLoader::store(const char *source, uint32_t length){
+#ifdef JSMANAGER_USE_SNAPSHOT
+    uint32_t *snapshot = new uint32_t[JSMANAGER_SNAPSHOT_BUFFER_SIZE / sizeof(uint32_t)];
+
+    size_t size = jerry_parse_and_save_snapshot((const jerry_char_t *)source, length, true, false,
+                                                snapshot, JSMANAGER_SNAPSHOT_BUFFER_SIZE);
+    if(size == 0){
+        delete[] snapshot;
+        return 6; // Does not compile or does not fit the buffer
+    }
+
+    int ret = Flasher::write_to_flash((const char *)snapshot, size, FLASHER_FLAG_SNAPSHOT);
+    delete[] snapshot;
+    return ret;
+#else
+    jerry_value_t parsed_code = jerry_parse((const jerry_char_t *)source, length, false);
+    bool has_error = jerry_value_has_error_flag(parsed_code);
+    jerry_release_value(parsed_code);
+
+    if(has_error){
+        return 6; // Does not compile
+    }
+
+    return Flasher::write_to_flash(source, length);
+#endif
+}
+
+/** commit
+ * @brief	Finishes a program source streamed with Flasher::begin_write() and
+ *          Flasher::write_chunk(). The source is compiled from flash, so it
+ *          never has to be held in RAM. In snapshot mode the bank is then
+ *          rewritten with the compiled snapshot.
+ * @return  Return code
+ */
+int ScriptLoader::commit(){
+    int ret = Flasher::flush_write();
+    if(ret != 0){
+        return ret;
+    }
+
+    uint32_t length;
+    const char *source = Flasher::get_write_data(&length);
+
+#ifdef JSMANAGER_USE_SNAPSHOT
+    uint32_t *snapshot = new uint32_t[JSMANAGER_SNAPSHOT_BUFFER_SIZE / sizeof(uint32_t)];
+
+    size_t size = jerry_parse_and_save_snapshot((const jerry_char_t *)source, length, true, false,
+                                                snapshot, JSMANAGER_SNAPSHOT_BUFFER_SIZE);
+    Flasher::abort_write();
+    if(size == 0){
+        delete[] snapshot;
+        return 6; // Does not compile or does not fit the buffer
+    }
+
+    // The source bank is still inactive, it is simply written again
+    ret = Flasher::write_to_flash((const char *)snapshot, size, FLASHER_FLAG_SNAPSHOT);
+    delete[] snapshot;
+    return ret;
+#else
+    jerry_value_t parsed_code = jerry_parse((const jerry_char_t *)source, length, false);
+    bool has_error = jerry_value_has_error_flag(parsed_code);
+    jerry_release_value(parsed_code);
+
+    if(has_error){
+        Flasher::abort_write();
+        return 6; // Does not compile
+    }
+
+    return Flasher::end_write();
+#endif
+}
+
+/** run
+ * @brief	Runs the program stored in a bank.
+ * @param	bank Bank number
+ * @return  Return code
+ */
+int ScriptLoader::run(int bank){
+    uint32_t length;
+    const char *code = Flasher::read_from_flash(bank, &length);
+    if(code == 0){
+        return 1; // Flash is empty
+    }
+
+    bool is_snapshot = (Flasher::get_header(bank)->flags & FLASHER_FLAG_SNAPSHOT) != 0;
+
+#ifdef JSMANAGER_PROFILE_LOAD
+    uint32_t start = us_ticker_read();
+#endif
+
+    jerry_value_t returned_value;
+    if(is_snapshot){
+#ifdef JSMANAGER_USE_SNAPSHOT
+        // Bytecode is used in place from flash, not copied to the heap
+        returned_value = jerry_exec_snapshot((const uint32_t *)code, length, false);
+#else
+        return 4; // Snapshot support is not built in
+#endif
+    }
+    else{
+        jerry_value_t parsed_code = jerry_parse((const jerry_char_t *)code, length, false);
+
+        if (jerry_value_has_error_flag(parsed_code)) {
+            jerry_release_value(parsed_code);
+            return 2; // jerry_parse failed
+        }
+
+        returned_value = jerry_run(parsed_code);
+        jerry_release_value(parsed_code);
+    }
+
+#ifdef JSMANAGER_PROFILE_LOAD
+    uint32_t elapsed = us_ticker_read() - start;
+    printf("ScriptLoader: %s loaded and run in %lu us\r\n", is_snapshot ? "snapshot" : "source", (unsigned long)elapsed);
+
+    jerry_heap_stats_t stats;
+    if(jerry_get_memory_stats(&stats)){
+        printf("ScriptLoader: heap peak %u of %u bytes\r\n", (unsigned)stats.peak_allocated_bytes, (unsigned)stats.size);
+    }
+#endif
+
+    bool has_error = jerry_value_has_error_flag(returned_value);
+    jerry_release_value(returned_value);
+
+    return has_error ? 3 : 0; // 3 if jerry_run failed
+}
@@ -0,0 +1,86 @@
+/**
+ ******************************************************************************
+ * @file    ScriptLoader.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Stores and runs JS programs from flash, as source or snapshot.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+#ifndef _SCRIPT_LOADER_H
+#define _SCRIPT_LOADER_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mbed.h"
+#include "jerry-core/include/jerryscript.h"
+
+#include "Flasher.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Size of the RAM buffer a snapshot is compiled into before flashing. */
+#ifndef JSMANAGER_SNAPSHOT_BUFFER_SIZE
+#define JSMANAGER_SNAPSHOT_BUFFER_SIZE  16384
+#endif
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Stores JS programs in flash and runs them from there.
+ *
+ * When JSMANAGER_USE_SNAPSHOT is defined (JerryScript must be built with
+ * snapshot save and exec support), a program is compiled to a bytecode
+ * snapshot once, when it is stored, and later executed in place from flash
+ * without parsing. Otherwise the source is stored and parsed on every run.
+ *
+ * When JSMANAGER_PROFILE_LOAD is defined, the time spent loading and running
+ * the top level of a program and the peak JS heap usage are printed, so the
+ * two modes can be compared.
+ *
+ * Programs can also be streamed into the inactive bank with the Flasher
+ * begin_write()/write_chunk() calls and then passed to commit(), which checks
+ * the source in place from flash before making it active.
+ *
+ * store() and commit() return the Flasher codes, or 6 if the program does
+ * not compile.
+ * run() returns 0 ok, 1 flash is empty, 2 parse failed, 3 run failed,
+ * 4 the bank holds a snapshot and snapshot support is not built in.
+ */
+class ScriptLoader {
+public:
+    static int store(const char *source, uint32_t length);
+    static int commit();
+    static int run(int bank);
+};
+
+#endif // _SCRIPT_LOADER_H
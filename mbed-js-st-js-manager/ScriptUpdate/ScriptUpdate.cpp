@@ -0,0 +1,333 @@
+/**
+ ******************************************************************************
+ * @file    ScriptUpdate.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Decodes compressed and delta script updates into flash.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ScriptUpdate.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Bytes copied at a time when reading back from flash. */
+#define SCRIPT_UPDATE_COPY_SIZE     32
+
+/* Helper Functions ----------------------------------------------------------*/
+
+static uint32_t read_u32(const char *data){
+    const uint8_t *bytes = (const uint8_t *)data;
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+/* Class Implementation ------------------------------------------------------*/
+
+UpdateDecoder::UpdateDecoder(){
+    reset();
+}
+
+/** reset
+ * @brief	Prepares the decoder for a new payload.
+ */
+void UpdateDecoder::reset(){
+    state = STATE_HEADER;
+    error = 0;
+    header_fill = 0;
+    type = 0;
+    script_length = 0;
+    script_crc = 0;
+    base = 0;
+    base_length = 0;
+    op = 0;
+    op_length = 0;
+    value = 0;
+    shift = 0;
+    out_length = 0;
+}
+
+/** write
+ * @brief	Decodes the next part of the payload. Chunks may be split at any
+ *          byte.
+ * @param	data Payload bytes
+ * @param	size Number of bytes
+ * @return  Return code
+ */
+int UpdateDecoder::write(const char *data, uint32_t size){
+    while(size > 0 && state != STATE_ERROR){
+        switch(state){
+        case STATE_HEADER: {
+            uint32_t count = SCRIPT_UPDATE_HEADER_SIZE - header_fill;
+            if(count > size){
+                count = size;
+            }
+            memcpy(header + header_fill, data, count);
+            header_fill += count;
+            data += count;
+            size -= count;
+
+            if(header_fill >= 4 && read_u32(header) != SCRIPT_UPDATE_MAGIC){
+                // Plain script source
+                int ret = Flasher::begin_write(FLASHER_LENGTH_UNKNOWN);
+                if(ret != 0){
+                    return fail(ret);
+                }
+                state = STATE_RAW;
+                emit(header, header_fill);
+            }
+            else if(header_fill == SCRIPT_UPDATE_HEADER_SIZE){
+                start();
+            }
+            break;
+        }
+
+        case STATE_RAW:
+            emit(data, size);
+            size = 0;
+            break;
+
+        case STATE_TAG:
+            op = *data++;
+            size--;
+            if(op > SCRIPT_UPDATE_OP_BASE || (op == SCRIPT_UPDATE_OP_BASE && type != SCRIPT_UPDATE_DELTA)){
+                return fail(6); // Unknown operation
+            }
+            value = 0;
+            shift = 0;
+            state = STATE_LENGTH;
+            break;
+
+        case STATE_LENGTH:
+        case STATE_ARG: {
+            uint8_t byte = *data++;
+            size--;
+            if(shift > 28 || (shift == 28 && (byte & 0x70))){
+                return fail(6); // Varint too long, or more than 32 bits
+            }
+            value |= (uint32_t)(byte & 0x7F) << shift;
+            shift += 7;
+            if(byte & 0x80){
+                break;
+            }
+
+            if(state == STATE_LENGTH){
+                if(value > script_length - out_length){
+                    return fail(6); // Longer than the script
+                }
+                op_length = value;
+                value = 0;
+                shift = 0;
+                if(op != SCRIPT_UPDATE_OP_LITERAL){
+                    state = STATE_ARG;
+                }
+                else{
+                    state = op_length > 0 ? STATE_LITERAL : STATE_TAG;
+                }
+            }
+            else{
+                state = STATE_TAG;
+                copy(op, value, op_length);
+            }
+            break;
+        }
+
+        case STATE_LITERAL: {
+            uint32_t count = op_length < size ? op_length : size;
+            emit(data, count);
+            data += count;
+            size -= count;
+            op_length -= count;
+            if(op_length == 0 && state == STATE_LITERAL){
+                state = STATE_TAG;
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    return error;
+}
+
+/** finish
+ * @brief	Checks that the whole script has been decoded. The script is then
+ *          left flushed in the inactive bank, ready for ScriptLoader::commit().
+ * @return  Return code
+ */
+int UpdateDecoder::finish(){
+    if(state == STATE_ERROR){
+        return error;
+    }
+
+    if(state == STATE_HEADER){
+        if(header_fill == 0){
+            return fail(5); // Nothing received
+        }
+        if(header_fill >= 4){
+            return fail(6); // Truncated header
+        }
+
+        // Plain script shorter than the magic
+        int ret = Flasher::begin_write(header_fill);
+        if(ret != 0){
+            return fail(ret);
+        }
+        state = STATE_RAW;
+        return emit(header, header_fill);
+    }
+
+    if(state == STATE_RAW){
+        return 0;
+    }
+
+    if(state != STATE_TAG || out_length != script_length || Flasher::get_write_crc() != script_crc){
+        return fail(6); // Truncated or corrupted
+    }
+
+    return 0;
+}
+
+/** start
+ * @brief	Checks the update header and starts writing the script.
+ * @return  Return code
+ */
+int UpdateDecoder::start(){
+    type = header[4];
+    script_length = read_u32(header + 8);
+    script_crc = read_u32(header + 12);
+
+    if(type == SCRIPT_UPDATE_DELTA){
+#ifdef JSMANAGER_USE_SNAPSHOT
+        // The installed program is a snapshot, its source is not on the device
+        return fail(8);
+#else
+        int bank = Flasher::get_active_bank();
+        if(bank < 0 || Flasher::get_header(bank)->crc != read_u32(header + 16)){
+            return fail(7); // Not built against the installed script
+        }
+        if(Flasher::get_header(bank)->flags & FLASHER_FLAG_SNAPSHOT){
+            return fail(8); // Stored by a snapshot build
+        }
+        base = Flasher::read_from_flash(bank, &base_length);
+#endif
+    }
+    else if(type != SCRIPT_UPDATE_COMPRESSED){
+        return fail(6); // Unknown update type
+    }
+
+    int ret = Flasher::begin_write(script_length);
+    if(ret != 0){
+        return fail(ret);
+    }
+
+    state = STATE_TAG;
+    return 0;
+}
+
+/** emit
+ * @brief	Writes decoded script bytes.
+ * @param	data Script bytes
+ * @param	size Number of bytes
+ * @return  Return code
+ */
+int UpdateDecoder::emit(const char *data, uint32_t size){
+    int ret = Flasher::write_chunk(data, size);
+    if(ret != 0){
+        return fail(ret);
+    }
+    out_length += size;
+    return 0;
+}
+
+/** copy
+ * @brief	Repeats bytes of the installed script or of the script written so
+ *          far. Copies from the script written so far may overlap the bytes
+ *          they produce.
+ * @param	op SCRIPT_UPDATE_OP_COPY or SCRIPT_UPDATE_OP_BASE
+ * @param	arg Distance back or offset in the installed script
+ * @param	length Number of bytes
+ * @return  Return code
+ */
+int UpdateDecoder::copy(uint32_t op, uint32_t arg, uint32_t length){
+    char buffer[SCRIPT_UPDATE_COPY_SIZE];
+
+    if(op == SCRIPT_UPDATE_OP_BASE){
+        if(arg > base_length || length > base_length - arg){
+            return fail(6); // Outside the installed script
+        }
+        while(length > 0){
+            uint32_t count = length < sizeof(buffer) ? length : sizeof(buffer);
+            memcpy(buffer, base + arg, count);
+            if(emit(buffer, count) != 0){
+                return error;
+            }
+            arg += count;
+            length -= count;
+        }
+        return 0;
+    }
+
+    if(arg == 0 || arg > out_length){
+        return fail(6); // Before the start of the script
+    }
+    uint32_t from = out_length - arg;
+    while(length > 0){
+        uint32_t count = length < sizeof(buffer) ? length : sizeof(buffer);
+        if(count > arg){
+            count = arg;
+        }
+        int ret = Flasher::read_back(from, buffer, count);
+        if(ret != 0){
+            return fail(ret);
+        }
+        if(emit(buffer, count) != 0){
+            return error;
+        }
+        from += count;
+        length -= count;
+    }
+    return 0;
+}
+
+/** fail
+ * @brief	Drops the write in progress and stops decoding.
+ * @param	ret Return code
+ * @return  Return code
+ */
+int UpdateDecoder::fail(int ret){
+    Flasher::abort_write();
+    state = STATE_ERROR;
+    error = ret;
+    return ret;
+}
@@ -0,0 +1,136 @@
+/**
+ ******************************************************************************
+ * @file    ScriptUpdate.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Decodes compressed and delta script updates into flash.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+#ifndef _SCRIPT_UPDATE_H
+#define _SCRIPT_UPDATE_H
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mbed.h"
+
+#include "Flasher.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Magic at the start of an encoded update ("JSUP"). */
+#define SCRIPT_UPDATE_MAGIC         0x5055534A
+
+/** Size of the update header in bytes. */
+#define SCRIPT_UPDATE_HEADER_SIZE   20
+
+/** Update types. */
+#define SCRIPT_UPDATE_COMPRESSED    1
+#define SCRIPT_UPDATE_DELTA         2
+
+/** Update operations. */
+#define SCRIPT_UPDATE_OP_LITERAL    0
+#define SCRIPT_UPDATE_OP_COPY       1
+#define SCRIPT_UPDATE_OP_BASE       2
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Streams a script update into the inactive bank.
+ *
+ * A payload that does not start with SCRIPT_UPDATE_MAGIC is plain script
+ * source and is written as is. Otherwise it starts with a little endian
+ * header:
+ *
+ *   uint32 magic, uint8 type, uint8 reserved[3],
+ *   uint32 script length, uint32 script CRC32, uint32 base CRC32
+ *
+ * followed by operations, each a tag byte, a varint (LEB128) length and,
+ * for copies, a varint argument:
+ *
+ *   SCRIPT_UPDATE_OP_LITERAL length, then length bytes
+ *   SCRIPT_UPDATE_OP_COPY    length, distance back in the script written so far
+ *   SCRIPT_UPDATE_OP_BASE    length, offset in the installed script
+ *
+ * A SCRIPT_UPDATE_COMPRESSED update only uses literals and copies, a
+ * SCRIPT_UPDATE_DELTA update may also copy from the installed script, whose
+ * CRC32 must then match the base CRC32. Copies read back from flash, so
+ * decoding needs no window in RAM.
+ *
+ * write() and finish() return the Flasher codes, or 6 if the payload is
+ * malformed or the script CRC32 does not match, 7 if the installed script is
+ * not the base of a delta, 8 for a delta in snapshot mode, where the
+ * installed script is a snapshot and not its source.
+ */
+class UpdateDecoder {
+public:
+    UpdateDecoder();
+
+    void reset();
+    int write(const char *data, uint32_t size);
+    int finish();
+
+private:
+    int start();
+    int emit(const char *data, uint32_t size);
+    int copy(uint32_t op, uint32_t arg, uint32_t length);
+    int fail(int ret);
+
+    enum State {
+        STATE_HEADER,
+        STATE_RAW,
+        STATE_TAG,
+        STATE_LENGTH,
+        STATE_ARG,
+        STATE_LITERAL,
+        STATE_ERROR
+    };
+
+    State state;
+    int error;
+    char header[SCRIPT_UPDATE_HEADER_SIZE];
+    uint32_t header_fill;
+
+    uint8_t type;
+    uint32_t script_length;
+    uint32_t script_crc;
+    const char *base;
+    uint32_t base_length;
+
+    uint8_t op;
+    uint32_t op_length;
+    uint32_t value;
+    uint32_t shift;
+    uint32_t out_length;
+};
+
+#endif // _SCRIPT_UPDATE_H
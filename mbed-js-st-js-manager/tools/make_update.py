@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""
+Builds a JS Manager script update, to be served to load_http_program().
+
+    make_update.py new.js update.bin                  compressed script
+    make_update.py --base installed.js new.js update.bin   delta against the
+                                                      installed script
+
+See ScriptUpdate/ScriptUpdate.h for the format.
+"""
+
+import argparse
+import struct
+import zlib
+
+MAGIC = 0x5055534A
+COMPRESSED = 1
+DELTA = 2
+OP_LITERAL = 0
+OP_COPY = 1
+OP_BASE = 2
+
+MIN_MATCH = 4
+MAX_CHAIN = 64
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def index(data):
+    table = {}
+    for pos in range(len(data) - MIN_MATCH + 1):
+        table.setdefault(data[pos:pos + MIN_MATCH], []).append(pos)
+    return table
+
+
+def longest(data, pos, source, candidates, limit=None):
+    best_len, best_pos = 0, 0
+    for cand in reversed(candidates[-MAX_CHAIN:]):
+        if limit is not None and cand >= limit:
+            continue
+        length = 0
+        while (pos + length < len(data) and cand + length < len(source) and
+               source[cand + length] == data[pos + length]):
+            length += 1
+        if length > best_len:
+            best_len, best_pos = length, cand
+    return best_len, best_pos
+
+
+def encode(data, base=None):
+    base_index = index(base) if base is not None else {}
+    out_index = {}
+    ops = bytearray()
+    literal = bytearray()
+
+    def flush():
+        if literal:
+            ops.extend(bytes([OP_LITERAL]) + varint(len(literal)) + literal)
+            literal.clear()
+
+    pos = 0
+    while pos < len(data):
+        key = data[pos:pos + MIN_MATCH]
+        base_len, base_pos = longest(data, pos, base, base_index.get(key, [])) if base else (0, 0)
+        # Copies from the script itself may overlap the bytes they produce
+        copy_len, copy_pos = longest(data, pos, data, out_index.get(key, []), pos)
+
+        if max(base_len, copy_len) >= MIN_MATCH:
+            flush()
+            if base_len >= copy_len:
+                ops.extend(bytes([OP_BASE]) + varint(base_len) + varint(base_pos))
+                length = base_len
+            else:
+                ops.extend(bytes([OP_COPY]) + varint(copy_len) + varint(pos - copy_pos))
+                length = copy_len
+        else:
+            literal.append(data[pos])
+            length = 1
+
+        for p in range(pos, pos + length):
+            out_index.setdefault(data[p:p + MIN_MATCH], []).append(p)
+        pos += length
+    flush()
+
+    header = struct.pack('<IB3xIII', MAGIC, DELTA if base is not None else COMPRESSED,
+                         len(data), zlib.crc32(data) & 0xFFFFFFFF,
+                         zlib.crc32(base) & 0xFFFFFFFF if base is not None else 0)
+    return header + bytes(ops)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Build a JS Manager script update')
+    parser.add_argument('--base', help='script installed on the device, for a delta update')
+    parser.add_argument('script', help='new script')
+    parser.add_argument('output', help='update payload')
+    args = parser.parse_args()
+
+    with open(args.script, 'rb') as f:
+        data = f.read()
+    base = None
+    if args.base:
+        with open(args.base, 'rb') as f:
+            base = f.read()
+
+    update = encode(data, base)
+    with open(args.output, 'wb') as f:
+        f.write(update)
+    print('%s: %d bytes, script %d bytes' % (args.output, len(update), len(data)))
+
+
+if __name__ == '__main__':
+    main()
@@ -247,6 +247,195 @@ int LPS22HBSensor::get_temperature(float *pfData)
   return 0;
 }
 
+/**
+ * @brief  Read LPS22HB output registers once, and calculate pressure and temperature
+ * @param  pfPress the pressure value in hPa
+ * @param  pfTemp the temperature value in degC
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LPS22HBSensor::get_pressure_temperature(float *pfPress, float *pfTemp)
+{
+  LPS22HB_MeasureTypeDef_st value;
+
+  /* Read data from LPS22HB. */
+  if ( LPS22HB_Get_Measurement( (void *)this, &value ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  *pfPress = ( float )value.Pout / 100.0f;
+  *pfTemp = ( float )value.Tout / 10.0f;
+
+  return 0;
+}
+
+/**
+ * @brief  Enable the LPS22HB FIFO
+ * @param  mode the FIFO mode, F_MODE[2:0] of CTRL_FIFO: 1 FIFO (stops when full),
+ *         2 stream, 3 stream-to-FIFO, 4 bypass-to-stream, 7 bypass-to-FIFO
+ * @param  watermark the FIFO threshold level [1 31]
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LPS22HBSensor::enable_fifo(uint8_t mode, uint8_t watermark)
+{
+  LPS22HB_FifoMode_et fifo_mode = ( LPS22HB_FifoMode_et )( mode << 5 );
+
+  if ( mode > 7 || !IS_LPS22HB_FifoMode( fifo_mode ) || !IS_LPS22HB_WtmLevel( watermark ) )
+  {
+    return 1;
+  }
+
+  /* Pass through bypass mode to discard any stale content */
+  if ( LPS22HB_Set_FifoMode( (void *)this, LPS22HB_FIFO_BYPASS_MODE ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  if ( LPS22HB_Set_FifoWatermarkLevel( (void *)this, watermark ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  if ( LPS22HB_Set_FifoModeUse( (void *)this, LPS22HB_ENABLE ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  if ( LPS22HB_Set_FifoMode( (void *)this, fifo_mode ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief  Disable the LPS22HB FIFO, the output registers hold the latest sample again
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LPS22HBSensor::disable_fifo(void)
+{
+  if ( LPS22HB_Set_FifoMode( (void *)this, LPS22HB_FIFO_BYPASS_MODE ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  if ( LPS22HB_Set_FifoModeUse( (void *)this, LPS22HB_DISABLE ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief  Read the LPS22HB FIFO status
+ * @param  level the pointer where the number of stored samples [0 32] is written
+ * @param  flags the pointer where the FTH_FIFO (0x80) and OVR (0x40) flags are written
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LPS22HBSensor::get_fifo_status(uint8_t *level, uint8_t *flags)
+{
+  uint8_t status;
+
+  if ( LPS22HB_read_reg( (void *)this, LPS22HB_STATUS_FIFO_REG, 1, &status ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  *level = status & LPS22HB_LEVEL_FIFO_MASK;
+  *flags = status & ( LPS22HB_FTH_FIFO_MASK | LPS22HB_OVR_FIFO_MASK );
+
+  return 0;
+}
+
+/**
+ * @brief  Read samples from the LPS22HB FIFO in one burst
+ * @param  pfPress the array where the pressure values in mbar are stored
+ * @param  pfTemp the array where the temperature values in degC are stored
+ * @param  num the number of samples to read [1 32], at most the FIFO level
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LPS22HBSensor::get_fifo_data(float *pfPress, float *pfTemp, uint8_t num)
+{
+  uint8_t buffer[5 * LPS22HB_FIFO_FULL];
+  uint8_t *slot = buffer;
+
+  if ( LPS22HB_Get_FifoData( (void *)this, buffer, num ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  for ( uint8_t i = 0; i < num; i++, slot += 5 )
+  {
+    /* Sign extend the 24 bit pressure */
+    int32_t raw_press = ( int32_t )( ( ( uint32_t )slot[2] << 24 ) | ( ( uint32_t )slot[1] << 16 ) | ( ( uint32_t )slot[0] << 8 ) ) >> 8;
+    int16_t raw_temp = ( int16_t )( ( ( uint16_t )slot[4] << 8 ) | slot[3] );
+
+    pfPress[i] = ( float )raw_press / 4096.0f;
+    pfTemp[i] = ( float )raw_temp / 100.0f;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief  Route the FIFO threshold flag to the INT_DRDY pin
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LPS22HBSensor::enable_fifo_watermark_irq(void)
+{
+  if ( LPS22HB_Set_FIFO_FTH_Interrupt( (void *)this, LPS22HB_ENABLE ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief  Stop routing the FIFO threshold flag to the INT_DRDY pin
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LPS22HBSensor::disable_fifo_watermark_irq(void)
+{
+  if ( LPS22HB_Set_FIFO_FTH_Interrupt( (void *)this, LPS22HB_DISABLE ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief  Route the data ready signal to the INT_DRDY pin
+ * @retval 0 in case of success, an error code otherwise
+ * @note   The pin stays high until the pressure and temperature are read
+ */
+int LPS22HBSensor::enable_drdy_irq(void)
+{
+  if ( LPS22HB_Set_DRDYInterrupt( (void *)this, LPS22HB_ENABLE ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief  Stop routing the data ready signal to the INT_DRDY pin
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LPS22HBSensor::disable_drdy_irq(void)
+{
+  if ( LPS22HB_Set_DRDYInterrupt( (void *)this, LPS22HB_DISABLE ) == LPS22HB_ERROR )
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
 /**
  * @brief  Read LPS22HB output data rate
  * @param  odr the pointer to the output data rate
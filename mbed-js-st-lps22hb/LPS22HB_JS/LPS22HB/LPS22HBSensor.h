@@ -45,6 +45,7 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include "DevI2C.h"
+#include "DevSPI.h"
 #include "LPS22HB_driver.h"
 #include "PressureSensor.h"
 #include "TempSensor.h"
@@ -66,6 +67,15 @@ class LPS22HBSensor : public PressureSensor, public TempSensor
     virtual int read_id(uint8_t *id);
     virtual int get_pressure(float *pfData);
     virtual int get_temperature(float *pfData);
+    int get_pressure_temperature(float *pfPress, float *pfTemp);
+    int enable_fifo(uint8_t mode, uint8_t watermark);
+    int disable_fifo(void);
+    int get_fifo_status(uint8_t *level, uint8_t *flags);
+    int get_fifo_data(float *pfPress, float *pfTemp, uint8_t num);
+    int enable_fifo_watermark_irq(void);
+    int disable_fifo_watermark_irq(void);
+    int enable_drdy_irq(void);
+    int disable_drdy_irq(void);
     int enable(void);
     int disable(void);
     int reset(void);
@@ -82,24 +92,14 @@ class LPS22HBSensor : public PressureSensor, public TempSensor
      * @retval 0 if ok, an error code otherwise.
      */
     uint8_t io_read(uint8_t* pBuffer, uint8_t RegisterAddr, uint16_t NumByteToRead)
-    {
+    {        
         if (_dev_spi) {
-        /* Write Reg Address */
-            _dev_spi->lock();
-            _cs_pin = 0;           
-            if (_spi_type == SPI4W) {            
-                _dev_spi->write(RegisterAddr | 0x80);
-                for (int i=0; i<NumByteToRead; i++) {
-                    *(pBuffer+i) = _dev_spi->write(0x00);
-                }
-            } else if (_spi_type == SPI3W){
-                /* Write RD Reg Address with RD bit*/
-                uint8_t TxByte = RegisterAddr | 0x80;    
-                _dev_spi->write((char *)&TxByte, 1, (char *)pBuffer, (int) NumByteToRead);
-            }            
-            _cs_pin = 1;
-            _dev_spi->unlock(); 
-            return 0;
+            if (_spi_type == SPI4W) {
+                /* Write RD Reg Address with RD bit, then the data, in block transfers */
+                return (uint8_t) DevSPI::spi_read_reg(_dev_spi, _cs_pin, RegisterAddr | 0x80, pBuffer, NumByteToRead);
+            }
+            /* SPI3W: Write RD Reg Address with RD bit */
+            return (uint8_t) DevSPI::spi_read_reg_3w(_dev_spi, _cs_pin, RegisterAddr | 0x80, pBuffer, NumByteToRead);
         }                       
         if (_dev_i2c) return (uint8_t) _dev_i2c->i2c_read(pBuffer, _address, RegisterAddr, NumByteToRead);
         return 1;
@@ -114,19 +114,44 @@ class LPS22HBSensor : public PressureSensor, public TempSensor
      */
     uint8_t io_write(uint8_t* pBuffer, uint8_t RegisterAddr, uint16_t NumByteToWrite)
     {
-        if (_dev_spi) { 
-            _dev_spi->lock();
-            _cs_pin = 0;
-            int data = _dev_spi->write(RegisterAddr);                    
-            _dev_spi->write((char *)pBuffer, (int) NumByteToWrite, NULL, 0);                     
-            _cs_pin = 1;                    
-            _dev_spi->unlock();
-            return data;                    
-        }        
+        if (_dev_spi) {
+            /* Write Reg Address, then the data, in block transfers */
+            return (uint8_t) DevSPI::spi_write_reg(_dev_spi, _cs_pin, RegisterAddr, pBuffer, NumByteToWrite);
+        }
         if (_dev_i2c) return (uint8_t) _dev_i2c->i2c_write(pBuffer, _address, RegisterAddr, NumByteToWrite);    
         return 1;
     }
 
+    /**
+     * @brief  Attaching an interrupt handler to the INT_DRDY interrupt.
+     * @param  fptr An interrupt handler.
+     * @retval None.
+     */
+    void attach_int_irq(Callback<void()> fptr)
+    {
+        _int_pin.rise(fptr);
+    }
+
+    /**
+     * @brief  Enabling the INT_DRDY interrupt handling.
+     * @param  None.
+     * @retval None.
+     */
+    void enable_int_irq(void)
+    {
+        _int_pin.enable_irq();
+    }
+    
+    /**
+     * @brief  Disabling the INT_DRDY interrupt handling.
+     * @param  None.
+     * @retval None.
+     */
+    void disable_int_irq(void)
+    {
+        _int_pin.disable_irq();
+    }
+
   private:
     int Set_ODR_When_Enabled(float odr);
     int Set_ODR_When_Disabled(float odr);
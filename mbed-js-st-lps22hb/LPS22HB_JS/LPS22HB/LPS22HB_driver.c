@@ -1267,6 +1267,26 @@ LPS22HB_Error_et LPS22HB_Get_FifoStatus(void *handle, LPS22HB_FifoStatus_st* sta
   return LPS22HB_OK;
 }
 
+/**
+* @brief    Read FIFO slots in a single burst
+* @detail   With the FIFO enabled the register address rolls back from TEMP_OUT_H
+*           to PRESS_OUT_XL, so consecutive slots are read in one transaction.
+* @param  *handle Device handle.
+* @param    Buffer to empty with 5 bytes per slot: PRESS_OUT_XL/L/H, TEMP_OUT_L/H
+* @param    Number of slots to read [1 32]
+* @retval   Error Code [LPS22HB_ERROR, LPS22HB_OK]
+*/
+LPS22HB_Error_et LPS22HB_Get_FifoData(void *handle, uint8_t *buffer, uint8_t nsamples)
+{
+  if(nsamples == 0 || nsamples > LPS22HB_FIFO_FULL)
+    return LPS22HB_ERROR;
+
+  if(LPS22HB_read_reg(handle, LPS22HB_PRESS_OUT_XL_REG, 5 * (uint16_t)nsamples, buffer))
+    return LPS22HB_ERROR;
+
+  return LPS22HB_OK;
+}
+
 /**
 * @brief  Get the reference pressure after soldering for computing differential pressure (hPA)
 * @param  *handle Device handle.
@@ -1352,18 +1372,24 @@ LPS22HB_Error_et LPS22HB_IsMeasurementCompleted(void *handle, uint8_t* Is_Measur
 */
 LPS22HB_Error_et LPS22HB_Get_Measurement(void *handle, LPS22HB_MeasureTypeDef_st *Measurement_Value)
 {
-  int16_t Tout;
-  int32_t Pout;
+  uint8_t buffer[5];
+  uint32_t tmp = 0;
+  uint8_t i;
 
-  if(LPS22HB_Get_Temperature(handle, &Tout))
+  /* PRESS_OUT_XL..TEMP_OUT_H are contiguous: read both values in one burst */
+  if(LPS22HB_read_reg(handle, LPS22HB_PRESS_OUT_XL_REG, 5, buffer))
     return LPS22HB_ERROR;
 
-  Measurement_Value->Tout=Tout;
+  /* Build the raw pressure */
+  for(i=0; i<3; i++)
+    tmp |= (((uint32_t)buffer[i]) << (8*i));
 
-  if(LPS22HB_Get_Pressure(handle, &Pout))
-    return LPS22HB_ERROR;
+  /* convert the 2's complement 24 bit to 2's complement 32 bit */
+  if(tmp & 0x00800000)
+    tmp |= 0xFF000000;
 
-  Measurement_Value->Pout=Pout;
+  Measurement_Value->Pout=(((int32_t)tmp)*100)/4096;
+  Measurement_Value->Tout=(((int16_t)((((uint16_t)buffer[4]) << 8) + (uint16_t)buffer[3]))*10)/100;
 
   return LPS22HB_OK;
 
@@ -1202,6 +1202,14 @@ LPS22HB_Error_et LPS22HB_Get_FifoWatermarkLevel(void *handle, uint8_t *wtmlevel)
 */
 LPS22HB_Error_et LPS22HB_Get_FifoStatus(void *handle, LPS22HB_FifoStatus_st* status);
 
+/**
+* @brief  Read FIFO slots in a single burst.
+* @param  Buffer to empty with 5 bytes per slot: PRESS_OUT_XL/L/H, TEMP_OUT_L/H
+* @param  Number of slots to read [1 32]
+* @retval Status [LPS22HB_ERROR, LPS22HB_OK]
+*/
+LPS22HB_Error_et LPS22HB_Get_FifoData(void *handle, uint8_t *buffer, uint8_t nsamples);
+
 
 /**
 * @brief  Get the reference pressure after soldering for computing differential pressure (hPA)
@@ -44,6 +44,7 @@
 
 // Load the library that we'll wrap
 #include "LPS22HB_JS.h"
+#include "JsValueArray.h"
 
 #include "mbed.h"
 
@@ -211,8 +212,8 @@ DECLARE_CLASS_FUNCTION(LPS22HB_JS, get_temperature) {
     // Get the result from the C++ API
     //float result = native_ptr->get_temperature();
     
-    char * result = new char[128];
-    result = native_ptr->get_temperature_string(result);
+    char result[128];
+    native_ptr->get_temperature_string(result);
     
     //pc.printf("Temperature: %s", result);
 
@@ -220,9 +221,6 @@ DECLARE_CLASS_FUNCTION(LPS22HB_JS, get_temperature) {
     jerry_value_t out = jerry_create_string((unsigned char *)result);
     
     //printf("temp: %s\n", result);
-   
-    // Recycle the result from function
-    delete result;
 
     // Return the output
     return out;
@@ -251,8 +249,8 @@ DECLARE_CLASS_FUNCTION(LPS22HB_JS, get_temperature_string) {
     LPS22HB_JS *native_ptr = static_cast<LPS22HB_JS*>(void_ptr);
  
     // Get the result from the C++ API
-    char * result = new char[128];
-    result = native_ptr->get_temperature_string(result);
+    char result[128];
+    native_ptr->get_temperature_string(result);
     
     //pc.printf("Temperature: %s", result);
 
@@ -260,9 +258,6 @@ DECLARE_CLASS_FUNCTION(LPS22HB_JS, get_temperature_string) {
     jerry_value_t out = jerry_create_string((unsigned char *)result);
     
     //printf("temp: %s\n", result);
-   
-    // Recycle the result from function
-    delete result;
 
     // Return the output
     return out;
@@ -319,21 +314,268 @@ DECLARE_CLASS_FUNCTION(LPS22HB_JS, get_pressure_string) {
 
     LPS22HB_JS *native_ptr = static_cast<LPS22HB_JS*>(void_ptr);
  
-    char * result = new char[128];
-    result = native_ptr->get_pressure_string(result);
+    char result[128];
+    native_ptr->get_pressure_string(result);
     
     // Cast it back to JavaScript
     jerry_value_t out = jerry_create_string((unsigned char *)result);
     
     //printf("pressure: %s\n", result);
-   
-    // Recycle the result from function
-    delete result;
 
     // Return the output
     return out;
 }
 
+/**
+ * LPS22HB_JS#enable_fifo (native JavaScript method)
+ * @brief   Enables the FIFO
+ * @param   FIFO mode: 1 FIFO (stops when full), 2 stream, 3 stream-to-FIFO,
+ *          4 bypass-to-stream, 7 bypass-to-FIFO
+ * @param   Watermark level [1 31]
+ * @returns 0 on success, 1 on error, 2 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LPS22HB_JS, enable_fifo) {
+    CHECK_ARGUMENT_COUNT(LPS22HB_JS, enable_fifo, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LPS22HB_JS, enable_fifo, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(LPS22HB_JS, enable_fifo, 1, number);
+
+    // Unwrap native LPS22HB_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LPS22HB_JS pointer");
+    }
+
+    LPS22HB_JS *native_ptr = static_cast<LPS22HB_JS*>(void_ptr);
+
+    int mode = jerry_get_number_value(args[0]);
+    int watermark = jerry_get_number_value(args[1]);
+
+    if (mode < 0 || mode > 7 || watermark < 0 || watermark > 31) {
+        return jerry_create_number(1);
+    }
+
+    // Call the native function
+    int result = native_ptr->enable_fifo((uint8_t) mode, (uint8_t) watermark);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LPS22HB_JS#disable_fifo (native JavaScript method)
+ * @brief   Disables the FIFO
+ * @returns 0 on success, 1 on error, 2 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LPS22HB_JS, disable_fifo) {
+    CHECK_ARGUMENT_COUNT(LPS22HB_JS, disable_fifo, (args_count == 0));
+
+    // Unwrap native LPS22HB_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LPS22HB_JS pointer");
+    }
+
+    LPS22HB_JS *native_ptr = static_cast<LPS22HB_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->disable_fifo();
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LPS22HB_JS#get_fifo_level (native JavaScript method)
+ * @brief   Gets the number of samples stored in the FIFO
+ * @returns Number of samples [0 32], -1 on error
+ */
+DECLARE_CLASS_FUNCTION(LPS22HB_JS, get_fifo_level) {
+    CHECK_ARGUMENT_COUNT(LPS22HB_JS, get_fifo_level, (args_count == 0));
+
+    // Unwrap native LPS22HB_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LPS22HB_JS pointer");
+    }
+
+    LPS22HB_JS *native_ptr = static_cast<LPS22HB_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->get_fifo_level();
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LPS22HB_JS#read_fifo (native JavaScript method)
+ * @brief   Drains the FIFO in one burst
+ * @returns Array of [pressure, temperature, pressure, temperature, ...]
+ *          with the oldest sample first, undefined on error
+ */
+DECLARE_CLASS_FUNCTION(LPS22HB_JS, read_fifo) {
+    CHECK_ARGUMENT_COUNT(LPS22HB_JS, read_fifo, (args_count == 0));
+
+    // Unwrap native LPS22HB_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LPS22HB_JS pointer");
+    }
+
+    LPS22HB_JS *native_ptr = static_cast<LPS22HB_JS*>(void_ptr);
+
+    float press[32];
+    float temp[32];
+
+    // Call the native function
+    int count = native_ptr->read_fifo(press, temp);
+
+    if (count < 0) {
+        return jerry_create_undefined();
+    }
+
+    // Cast it back to JavaScript
+    jerry_value_t out = jerry_create_array(2 * count);
+
+    for (int i = 0; i < count; i++) {
+        jerry_value_t val = jerry_create_number(press[i]);
+        jerry_release_value(jerry_set_property_by_index(out, 2 * i, val));
+        jerry_release_value(val);
+
+        val = jerry_create_number(temp[i]);
+        jerry_release_value(jerry_set_property_by_index(out, 2 * i + 1, val));
+        jerry_release_value(val);
+    }
+
+    // Return the output
+    return out;
+}
+
+/**
+ * LPS22HB_JS#get_pressure_temperature_into (native JavaScript method)
+ * @brief   Writes the pressure in hPa and the temperature in degC into an array
+ * @param   Array or TypedArray the values are written to
+ * @param   Optional index of the first value, 0 by default
+ * @returns Index following the last value written, or -1 on a sensor error or if the values do not fit
+ */
+DECLARE_CLASS_FUNCTION(LPS22HB_JS, get_pressure_temperature_into) {
+    CHECK_ARGUMENT_COUNT(LPS22HB_JS, get_pressure_temperature_into, (args_count == 1 || args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LPS22HB_JS, get_pressure_temperature_into, 0, object);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LPS22HB_JS, get_pressure_temperature_into, 1, number, args_count == 2);
+
+    if (!js_value_array_is_valid(args[0])) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Target must be an Array or a TypedArray");
+    }
+
+    // Unwrap native LPS22HB_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LPS22HB_JS pointer");
+    }
+
+    LPS22HB_JS *native_ptr = static_cast<LPS22HB_JS*>(void_ptr);
+
+    uint32_t offset = 0;
+    if (args_count == 2 && !js_value_array_get_offset(args[1], 2, &offset)) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Offset must be a non-negative integer index");
+    }
+
+    // Get the result from the C++ API
+    float values[2];
+    if (native_ptr->get_pressure_temperature(&values[0], &values[1]) != 0) {
+        return jerry_create_number(-1);
+    }
+
+    // Write it to the caller's array
+    return jerry_create_number(js_value_array_write(args[0], offset, values, 2));
+}
+
+/**
+ * LPS22HB_JS#onDataReady (native JavaScript method)
+ * @brief   Calls a function each time a new sample is ready, or stops the
+ *          events when called without arguments
+ * @param   Callback, called with an array of [pressure, temperature] in hPa and degC
+ *          and the number of data-ready interrupts since the previous
+ *          call, more than 1 when samples were skipped
+ * @returns 0 on success, 1 on a sensor error, 2 if no INT_DRDY pin was given,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LPS22HB_JS, onDataReady) {
+    CHECK_ARGUMENT_COUNT(LPS22HB_JS, onDataReady, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LPS22HB_JS, onDataReady, 0, function, args_count == 1);
+
+    // Unwrap native LPS22HB_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LPS22HB_JS pointer");
+    }
+
+    LPS22HB_JS *native_ptr = static_cast<LPS22HB_JS*>(void_ptr);
+
+    // Call the native function
+    int result = (args_count == 1) ? native_ptr->on_data_ready(this_obj, args[0])
+                                   : native_ptr->stop_data_ready();
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LPS22HB_JS#onFifoWatermark (native JavaScript method)
+ * @brief   Calls a function with the FIFO contents each time the FIFO
+ *          reaches its watermark level, or stops the events when called
+ *          without arguments; enable the FIFO first
+ * @param   Callback, called with an array of [pressure, temperature, ...] in
+ *          hPa and degC, oldest first, and the number of watermark
+ *          interrupts since the previous call
+ * @returns 0 on success, 1 on a sensor error, 2 if no INT_DRDY pin was given,
+ *          3 if the sensor is not initialized, 4 if the FIFO is not enabled
+ */
+DECLARE_CLASS_FUNCTION(LPS22HB_JS, onFifoWatermark) {
+    CHECK_ARGUMENT_COUNT(LPS22HB_JS, onFifoWatermark, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LPS22HB_JS, onFifoWatermark, 0, function, args_count == 1);
+
+    // Unwrap native LPS22HB_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LPS22HB_JS pointer");
+    }
+
+    LPS22HB_JS *native_ptr = static_cast<LPS22HB_JS*>(void_ptr);
+
+    // Call the native function
+    int result = (args_count == 1) ? native_ptr->on_fifo_watermark(this_obj, args[0])
+                                   : native_ptr->stop_fifo_watermark();
+
+    return jerry_create_number(result);
+}
+
 /**
  * LPS22HB_JS (native JavaScript constructor)
  * @brief   Constructor for Javascript wrapper
@@ -356,6 +598,13 @@ DECLARE_CLASS_CONSTRUCTOR(LPS22HB_JS) {
     ATTACH_CLASS_FUNCTION(js_object, LPS22HB_JS, get_temperature_string);
     ATTACH_CLASS_FUNCTION(js_object, LPS22HB_JS, get_pressure);
     ATTACH_CLASS_FUNCTION(js_object, LPS22HB_JS, get_pressure_string);
+    ATTACH_CLASS_FUNCTION(js_object, LPS22HB_JS, get_pressure_temperature_into);
+    ATTACH_CLASS_FUNCTION(js_object, LPS22HB_JS, enable_fifo);
+    ATTACH_CLASS_FUNCTION(js_object, LPS22HB_JS, disable_fifo);
+    ATTACH_CLASS_FUNCTION(js_object, LPS22HB_JS, get_fifo_level);
+    ATTACH_CLASS_FUNCTION(js_object, LPS22HB_JS, read_fifo);
+    ATTACH_CLASS_FUNCTION(js_object, LPS22HB_JS, onDataReady);
+    ATTACH_CLASS_FUNCTION(js_object, LPS22HB_JS, onFifoWatermark);
     
     return js_object;
 }
@@ -119,6 +119,7 @@ LPS22HB_JS::LPS22HB_JS(DevI2C &devI2c, uint8_t address, PinName int_pin){
  */
 void LPS22HB_JS::init(DevI2C &devI2c, uint8_t address, PinName int_pin){
 	press_temp = new LPS22HBSensor(&devI2c, address, int_pin);
+	int_drdy = int_pin;
 	press_temp->init(NULL);
 	press_temp->enable();
 }
@@ -163,6 +164,7 @@ LPS22HB_JS::LPS22HB_JS(SPI &spi, PinName cs_pin, PinName int_pin, int spi_type){
  */
 void LPS22HB_JS::init(SPI &spi, PinName cs_pin, PinName int_pin, int spi_type){
 	press_temp = new LPS22HBSensor(&spi, cs_pin, int_pin, spi_type == 3? LPS22HBSensor::SPI3W: LPS22HBSensor::SPI4W);
+	int_drdy = int_pin;
 	press_temp->init(NULL);
 	press_temp->enable();
 }
@@ -226,4 +228,298 @@ char *LPS22HB_JS::get_pressure_string(char *buffer){
 	press_temp->get_pressure(&value);
     print_double(buffer, value);
 	return buffer;
-}
\ No newline at end of file
+}
+
+/** get_pressure_temperature
+ * @brief	Gets the pressure and temperature readings from LPS22HB in one read
+ * @param	Pointer where the pressure in hPa is stored
+ * @param	Pointer where the temperature in degC is stored
+ * @retval	0 on success, 1 on error
+ */
+int LPS22HB_JS::get_pressure_temperature(float *pressure, float *temperature){
+	if(press_temp == NULL){
+		return 1;
+	}
+	return press_temp->get_pressure_temperature(pressure, temperature);
+}
+
+/** enable_fifo
+ * @brief	Enables the LPS22HB FIFO
+ * @param	FIFO mode: 1 FIFO (stops when full), 2 stream, 3 stream-to-FIFO,
+ *		4 bypass-to-stream, 7 bypass-to-FIFO
+ * @param	Watermark level [1 31]
+ * @retval	0 on success, 1 on error, 2 if the sensor is not initialized
+ */
+int LPS22HB_JS::enable_fifo(uint8_t mode, uint8_t watermark){
+	if(press_temp == NULL){
+		return 2;
+	}
+	stop_data_ready();
+	stop_fifo_watermark();
+	if(press_temp->enable_fifo(mode, watermark)){
+		return 1;
+	}
+	fifo_mode = mode;
+	fifo_watermark = watermark;
+	return 0;
+}
+
+/** disable_fifo
+ * @brief	Disables the LPS22HB FIFO
+ * @retval	0 on success, 1 on error, 2 if the sensor is not initialized
+ */
+int LPS22HB_JS::disable_fifo(){
+	if(press_temp == NULL){
+		return 2;
+	}
+	stop_fifo_watermark();
+	fifo_mode = 0;
+	return press_temp->disable_fifo();
+}
+
+/** get_fifo_level
+ * @brief	Gets the number of samples stored in the FIFO
+ * @retval	Number of samples [0 32], -1 on error
+ */
+int LPS22HB_JS::get_fifo_level(){
+	uint8_t level, flags;
+	if(press_temp == NULL || press_temp->get_fifo_status(&level, &flags)){
+		return -1;
+	}
+	return level;
+}
+
+/** read_fifo
+ * @brief	Drains the FIFO in one burst
+ * @param	Array of 32 floats where the pressures are stored
+ * @param	Array of 32 floats where the temperatures are stored
+ * @retval	Number of samples read, -1 on error
+ */
+int LPS22HB_JS::read_fifo(float *press, float *temp){
+	uint8_t level, flags;
+	if(press_temp == NULL || press_temp->get_fifo_status(&level, &flags)){
+		return -1;
+	}
+	if(level == 0){
+		return 0;
+	}
+	if(press_temp->get_fifo_data(press, temp, level)){
+		return -1;
+	}
+	/* FIFO mode stops collecting once full, restart it for the next batch */
+	if(fifo_mode == 1 && level == 32){
+		if(press_temp->enable_fifo(fifo_mode, fifo_watermark)){
+			return -1;
+		}
+	}
+	return level;
+}
+
+/** on_data_ready
+ * @brief	Calls a JavaScript function each time a new sample is ready
+ * @param	JavaScript object kept alive while events are enabled
+ * @param	JavaScript callback, called with an array of [pressure, temperature] in hPa and degC
+ *		and the number of data-ready interrupts since the previous call
+ * @retval	0 on success, 1 on a sensor error, 2 if no INT_DRDY pin was given,
+ *		3 if the sensor is not initialized
+ */
+int LPS22HB_JS::on_data_ready(jerry_value_t this_obj, jerry_value_t cb){
+	if(press_temp == NULL){
+		return 3;
+	}
+	if(int_drdy == NC){
+		return 2;
+	}
+
+	// Reading the output registers would pop samples from the FIFO
+	if(fifo_mode != 0){
+		disable_fifo();
+	}
+	stop_data_ready();
+
+	press_temp->attach_int_irq(callback(this, &LPS22HB_JS::drdy_interrupt));
+	if(press_temp->enable_drdy_irq()){
+		press_temp->disable_int_irq();
+		return 1;
+	}
+
+	// Keep the object and the callback while samples may arrive
+	drdy_delivery.start(this_obj, cb);
+
+	press_temp->enable_int_irq();
+
+	// A sample already waiting holds the pin high; read it so the next one raises an edge
+	float values[2];
+	get_pressure_temperature(&values[0], &values[1]);
+
+	return 0;
+}
+
+/** stop_data_ready
+ * @brief	Stops data-ready events
+ * @retval	0 on success, 1 on a sensor error
+ */
+int LPS22HB_JS::stop_data_ready(){
+	int result = 0;
+
+	if(drdy_delivery.is_started()){
+		press_temp->disable_int_irq();
+		result = press_temp->disable_drdy_irq();
+	}
+
+	// This may release the last reference to this object, so it comes last
+	drdy_delivery.stop();
+
+	return result;
+}
+
+/** drdy_interrupt
+ * @brief	INT_DRDY handler, runs in interrupt context
+ */
+void LPS22HB_JS::drdy_interrupt(){
+	// Later samples are coalesced into a delivery already waiting
+	drdy_delivery.post(mbed::Callback<void()>(this, &LPS22HB_JS::deliver_drdy));
+}
+
+/** deliver_drdy
+ * @brief	Passes the latest sample to JavaScript, on the event loop
+ */
+void LPS22HB_JS::deliver_drdy(){
+	// Stopped since this delivery was posted, this object may be freed
+	uint32_t count;
+	if(!drdy_delivery.begin(&count)){
+		return;
+	}
+
+	// Reading the sample also lowers the pin for the next edge
+	float values[2];
+	if(get_pressure_temperature(&values[0], &values[1])){
+		return;
+	}
+
+	jerry_value_t out_array = jerry_create_array(2);
+	for(uint32_t i = 0; i < 2; i++){
+		jerry_value_t val = jerry_create_number(values[i]);
+		jerry_release_value(jerry_set_property_by_index(out_array, i, val));
+		jerry_release_value(val);
+	}
+
+	jerry_value_t args[2] = {
+		out_array,
+		jerry_create_number(count)
+	};
+
+	// The callback may stop the events and free this object
+	drdy_delivery.call(args, 2);
+
+	jerry_release_value(args[0]);
+	jerry_release_value(args[1]);
+}
+
+/** on_fifo_watermark
+ * @brief	Calls a JavaScript function with the FIFO contents each time the
+ *		FIFO reaches its watermark level
+ * @param	JavaScript object kept alive while events are enabled
+ * @param	JavaScript callback, called with an array of [pressure, temperature, ...]
+ *		in hPa and degC, oldest first, and the number of watermark interrupts
+ *		since the previous call
+ * @retval	0 on success, 1 on a sensor error, 2 if no INT_DRDY pin was given,
+ *		3 if the sensor is not initialized, 4 if the FIFO is not enabled
+ */
+int LPS22HB_JS::on_fifo_watermark(jerry_value_t this_obj, jerry_value_t cb){
+	if(press_temp == NULL){
+		return 3;
+	}
+	if(int_drdy == NC){
+		return 2;
+	}
+	if(fifo_mode == 0){
+		return 4;
+	}
+
+	stop_fifo_watermark();
+
+	press_temp->attach_int_irq(callback(this, &LPS22HB_JS::wtm_interrupt));
+	if(press_temp->enable_fifo_watermark_irq()){
+		press_temp->disable_int_irq();
+		return 1;
+	}
+
+	// Keep the object and the callback while batches may arrive
+	wtm_delivery.start(this_obj, cb);
+
+	press_temp->enable_int_irq();
+
+	// A FIFO already past its watermark holds the pin high without an edge;
+	// post a delivery so that it is drained
+	wtm_interrupt();
+
+	return 0;
+}
+
+/** stop_fifo_watermark
+ * @brief	Stops FIFO watermark events; the FIFO keeps collecting samples
+ * @retval	0 on success, 1 on a sensor error
+ */
+int LPS22HB_JS::stop_fifo_watermark(){
+	int result = 0;
+
+	if(wtm_delivery.is_started()){
+		press_temp->disable_int_irq();
+		result = press_temp->disable_fifo_watermark_irq();
+	}
+
+	// This may release the last reference to this object, so it comes last
+	wtm_delivery.stop();
+
+	return result;
+}
+
+/** wtm_interrupt
+ * @brief	INT_DRDY handler for the FIFO watermark, runs in interrupt context
+ */
+void LPS22HB_JS::wtm_interrupt(){
+	// Later interrupts are coalesced into a delivery already waiting
+	wtm_delivery.post(mbed::Callback<void()>(this, &LPS22HB_JS::deliver_wtm));
+}
+
+/** deliver_wtm
+ * @brief	Passes the FIFO contents to JavaScript, on the event loop
+ */
+void LPS22HB_JS::deliver_wtm(){
+	// Stopped since this delivery was posted, this object may be freed
+	uint32_t count;
+	if(!wtm_delivery.begin(&count)){
+		return;
+	}
+
+	// Draining the FIFO below the watermark lowers the pin for the next edge
+	float press[32];
+	float temp[32];
+	int level = read_fifo(press, temp);
+	if(level <= 0){
+		return;
+	}
+
+	jerry_value_t out_array = jerry_create_array(2 * level);
+	for(int i = 0; i < level; i++){
+		jerry_value_t val = jerry_create_number(press[i]);
+		jerry_release_value(jerry_set_property_by_index(out_array, 2 * i, val));
+		jerry_release_value(val);
+
+		val = jerry_create_number(temp[i]);
+		jerry_release_value(jerry_set_property_by_index(out_array, 2 * i + 1, val));
+		jerry_release_value(val);
+	}
+
+	jerry_value_t args[2] = {
+		out_array,
+		jerry_create_number(count)
+	};
+
+	// The callback may stop the events and free this object
+	wtm_delivery.call(args, 2);
+
+	jerry_release_value(args[0]);
+	jerry_release_value(args[1]);
+}
@@ -47,6 +47,9 @@
 #include <stdint.h>
 #include "mbed.h"
 #include "LPS22HBSensor.h"
+#include "JsDelivery.h"
+
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
 
 /* Class Declaration ---------------------------------------------------------*/
 
@@ -57,6 +60,23 @@ class LPS22HB_JS {
 private:
     /* Helper classes. */
     LPS22HBSensor *press_temp = NULL;
+    
+    /* FIFO configuration, 0 when the FIFO is disabled. */
+    uint8_t fifo_mode = 0;
+    uint8_t fifo_watermark = 0;
+    
+    /* Data-ready events. */
+    PinName int_drdy = NC;
+    JsDelivery drdy_delivery;
+    
+    void drdy_interrupt();
+    void deliver_drdy();
+    
+    /* FIFO watermark events, on the same pin. */
+    JsDelivery wtm_delivery;
+    
+    void wtm_interrupt();
+    void deliver_wtm();
 
 public:
     /* Constructors */
@@ -81,6 +101,15 @@ public:
     char *get_temperature_string(char *);
     float get_pressure();
     char *get_pressure_string(char *);
+    int get_pressure_temperature(float *pressure, float *temperature);
+    int enable_fifo(uint8_t mode, uint8_t watermark);
+    int disable_fifo();
+    int get_fifo_level();
+    int read_fifo(float *press, float *temp);
+    int on_data_ready(jerry_value_t this_obj, jerry_value_t cb);
+    int stop_data_ready();
+    int on_fifo_watermark(jerry_value_t this_obj, jerry_value_t cb);
+    int stop_fifo_watermark();
 };
 
 #endif
\ No newline at end of file
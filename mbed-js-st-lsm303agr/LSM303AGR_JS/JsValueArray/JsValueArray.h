@@ -0,0 +1,132 @@
+/**
+ ******************************************************************************
+ * @file    JsValueArray.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Arrays of sensor values written by the _into() bindings.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __JS_VALUE_ARRAY_H__
+#define __JS_VALUE_ARRAY_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <math.h>
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
+
+/* Value arrays --------------------------------------------------------------*/
+
+/**
+ * Returns whether a value is an Array or a TypedArray; ArrayBuffers and
+ * other objects have no indexed elements and are not valid targets
+ */
+static inline bool js_value_array_is_valid(jerry_value_t value) {
+    if (jerry_value_is_array(value)) {
+        return true;
+    }
+    if (!jerry_value_is_object(value)) {
+        return false;
+    }
+
+    jerry_value_t name = jerry_create_string((const jerry_char_t *) "BYTES_PER_ELEMENT");
+    jerry_value_t size = jerry_get_property(value, name);
+    bool result = jerry_value_is_number(size);
+
+    jerry_release_value(size);
+    jerry_release_value(name);
+
+    return result;
+}
+
+/**
+ * Converts the index of the first of count values to write
+ * @param value Number passed by the script
+ * @param offset Set to the index
+ * @returns false if the index is not a non-negative integer or if the index
+ *          following the values would not fit in the int32_t returned by
+ *          js_value_array_write()
+ */
+static inline bool js_value_array_get_offset(jerry_value_t value, uint32_t count, uint32_t *offset) {
+    double index = jerry_get_number_value(value);
+
+    // NaN fails every comparison
+    if (!(index >= 0 && index <= (double) (0x7FFFFFFF - count)) || floor(index) != index) {
+        return false;
+    }
+
+    *offset = (uint32_t) index;
+    return true;
+}
+
+/**
+ * Writes values into a caller-provided Array or TypedArray
+ * @param target Array, or TypedArray view over an ArrayBuffer
+ * @param offset Index of the first value, from js_value_array_get_offset()
+ * @returns the index following the last value written, or -1 if the values
+ *          do not fit in a TypedArray or could not be stored
+ */
+template <typename T>
+static inline int32_t js_value_array_write(jerry_value_t target, uint32_t offset, const T *values, uint32_t count) {
+    // TypedArrays silently drop elements past their end
+    if (!jerry_value_is_array(target)) {
+        jerry_value_t name = jerry_create_string((const jerry_char_t *) "length");
+        jerry_value_t length = jerry_get_property(target, name);
+        bool fits = jerry_value_is_number(length) && (double) offset + count <= jerry_get_number_value(length);
+
+        jerry_release_value(length);
+        jerry_release_value(name);
+
+        if (!fits) {
+            return -1;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        jerry_value_t val = jerry_create_number(values[i]);
+        jerry_value_t ret_val = jerry_set_property_by_index(target, offset + i, val);
+        bool failed = jerry_value_has_error_flag(ret_val);
+
+        jerry_release_value(ret_val);
+        jerry_release_value(val);
+
+        if (failed) {
+            return -1;
+        }
+    }
+
+    return offset + count;
+}
+
+#endif // __JS_VALUE_ARRAY_H__
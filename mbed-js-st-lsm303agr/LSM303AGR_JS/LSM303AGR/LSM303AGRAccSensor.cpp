@@ -56,6 +56,8 @@ LSM303AGRAccSensor::LSM303AGRAccSensor(SPI *spi, PinName cs_pin, PinName int1_pi
     }       
     _cs_pin = 0;     // enable SPI3W disable I2C
     _dev_i2c=NULL;    
+    _x_shift = 0;
+    _x_scale = 0;
 
   LSM303AGR_ACC_W_SPI_mode((void *)this, LSM303AGR_ACC_SIM_3_WIRES);  
 }
@@ -70,6 +72,8 @@ LSM303AGRAccSensor::LSM303AGRAccSensor(DevI2C *i2c, uint8_t address, PinName int
 {
     assert (i2c);
     _dev_spi = NULL;
+    _x_shift = 0;
+    _x_scale = 0;
 };
 
 /**
@@ -207,18 +211,49 @@ int LSM303AGRAccSensor::read_id(uint8_t *id)
  */
 int LSM303AGRAccSensor::get_x_axes(int32_t *pData)
 {
-  int data[3];
+  Type3Axis16bit_U raw_data;
+  u8_t shift;
+  int scale;
+  
+  if ( get_x_scale( &shift, &scale ) == 1 )
+  {
+    return 1;
+  }
   
   /* Read data from LSM303AGR. */
-  if ( !LSM303AGR_ACC_Get_Acceleration((void *)this, data) )
+  if ( !LSM303AGR_ACC_Get_Raw_Acceleration( (void *)this, raw_data.u8bit ) )
   {
     return 1;
   }
   
-  /* Calculate the data. */
-  pData[0] = (int32_t)data[0];
-  pData[1] = (int32_t)data[1];
-  pData[2] = (int32_t)data[2];
+  /* Calculate the data, as LSM303AGR_ACC_Get_Acceleration() does. */
+  pData[0] = ( int32_t )( ( ( raw_data.i16bit[0] >> shift ) * scale + 500 ) / 1000 );
+  pData[1] = ( int32_t )( ( ( raw_data.i16bit[1] >> shift ) * scale + 500 ) / 1000 );
+  pData[2] = ( int32_t )( ( ( raw_data.i16bit[2] >> shift ) * scale + 500 ) / 1000 );
+  
+  return 0;
+}
+
+/**
+ * @brief  Get the raw data shift and the sensitivity of the current mode
+ * @param  shift the pointer where the right shift of the raw samples is stored
+ * @param  scale the pointer where the sensitivity in ug/digit is stored
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM303AGRAccSensor::get_x_scale(u8_t *shift, int *scale)
+{
+  /* Operating mode and full scale only change through this class */
+  if ( _x_scale == 0 )
+  {
+    if ( !LSM303AGR_ACC_Get_Acceleration_Scale( (void *)this, &_x_shift, &_x_scale ) )
+    {
+      _x_scale = 0;
+      return 1;
+    }
+  }
+  
+  *shift = _x_shift;
+  *scale = _x_scale;
   
   return 0;
 }
@@ -387,28 +422,11 @@ int LSM303AGRAccSensor::get_x_axes_raw(int16_t *pData)
 {
   uint8_t regValue[6] = {0, 0, 0, 0, 0, 0};
   u8_t shift = 0;
-  LSM303AGR_ACC_LPEN_t lp;
-  LSM303AGR_ACC_HR_t hr;
+  int scale;
   
   /* Determine which operational mode the acc is set */
-  if(!LSM303AGR_ACC_R_HiRes( (void *)this, &hr )) {
-    return 1;
-  }
-
-  if(!LSM303AGR_ACC_R_LOWPWR_EN( (void *)this, &lp )) {
-    return 1;
-  }
-  
-  if (lp == LSM303AGR_ACC_LPEN_ENABLED && hr == LSM303AGR_ACC_HR_DISABLED) {
-    /* op mode is LP 8-bit */
-    shift = 8;
-  } else if (lp == LSM303AGR_ACC_LPEN_DISABLED && hr == LSM303AGR_ACC_HR_DISABLED) {
-    /* op mode is Normal 10-bit */
-    shift = 6;
-  } else if (lp == LSM303AGR_ACC_LPEN_DISABLED && hr == LSM303AGR_ACC_HR_ENABLED) {
-    /* op mode is HR 12-bit */
-    shift = 4;
-  } else {
+  if ( get_x_scale( &shift, &scale ) == 1 )
+  {
     return 1;
   }
   
@@ -593,6 +611,8 @@ int LSM303AGRAccSensor::set_x_fs(float fullScale)
          : ( fullScale <= 8.0f ) ? LSM303AGR_ACC_FS_8G
          :                         LSM303AGR_ACC_FS_16G;
            
+  _x_scale = 0;
+  
   if ( LSM303AGR_ACC_W_FullScale( (void *)this, new_fs ) == MEMS_ERROR )
   {
     return 1;
@@ -628,6 +648,8 @@ int LSM303AGRAccSensor::read_reg( uint8_t reg, uint8_t *data )
  */
 int LSM303AGRAccSensor::write_reg( uint8_t reg, uint8_t data )
 {
+  /* The operating mode or the full scale may change */
+  _x_scale = 0;
 
   if ( LSM303AGR_ACC_write_reg( (void *)this, reg, data ) == MEMS_ERROR )
   {
@@ -637,6 +659,135 @@ int LSM303AGRAccSensor::write_reg( uint8_t reg, uint8_t data )
   return 0;
 }
 
+/**
+ * @brief  Set the FIFO mode
+ * @param  mode 0 bypass, 1 FIFO (stops when full), 2 stream, 3 stream-to-FIFO
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM303AGRAccSensor::set_fifo_mode(uint8_t mode)
+{
+  if ( mode > 3 )
+  {
+    return 1;
+  }
+  
+  if ( LSM303AGR_ACC_W_FifoMode( (void *)this, ( LSM303AGR_ACC_FM_t )( mode << 6 ) ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  if ( LSM303AGR_ACC_W_FIFO_EN( (void *)this, mode ? LSM303AGR_ACC_FIFO_EN_ENABLED : LSM303AGR_ACC_FIFO_EN_DISABLED ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Set the FIFO watermark level
+ * @param  level the watermark level in samples [0 31]
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM303AGRAccSensor::set_fifo_watermark_level(uint8_t level)
+{
+  if ( level > 31 )
+  {
+    return 1;
+  }
+  
+  if ( LSM303AGR_ACC_W_FifoThreshold( (void *)this, level ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Route the FIFO watermark flag to the INT1 pin
+ * @param  status 1 to enable, 0 to disable
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM303AGRAccSensor::set_fifo_int1_watermark(uint8_t status)
+{
+  if ( LSM303AGR_ACC_W_FIFO_Watermark_on_INT1( (void *)this, status ? LSM303AGR_ACC_I1_WTM_ENABLED : LSM303AGR_ACC_I1_WTM_DISABLED ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Enable/disable the data ready signal on INT1
+ * @param  status 1 to enable, 0 to disable
+ * @retval 0 in case of success, an error code otherwise
+ * @note   The pin stays high until the output registers are read
+ */
+int LSM303AGRAccSensor::set_int1_drdy(uint8_t status)
+{
+  if ( LSM303AGR_ACC_W_FIFO_DRDY1_on_INT1( (void *)this, status ? LSM303AGR_ACC_I1_DRDY1_ENABLED : LSM303AGR_ACC_I1_DRDY1_DISABLED ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Get the FIFO status
+ * @param  num_samples the pointer where the number of stored samples [0 32] is written
+ * @param  flags the pointer where the WTM (0x80), OVRN_FIFO (0x40) and EMPTY (0x20) flags are written
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM303AGRAccSensor::get_fifo_status(uint8_t *num_samples, uint8_t *flags)
+{
+  uint8_t status;
+  
+  if ( LSM303AGR_ACC_read_reg( (void *)this, LSM303AGR_ACC_FIFO_SRC_REG, &status ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  /* FSS counts up to 31, the overrun flag tells that all 32 slots are full */
+  *num_samples = ( status & LSM303AGR_ACC_OVRN_FIFO_MASK ) ? 32 : ( status & LSM303AGR_ACC_FSS_MASK );
+  *flags = status & ( LSM303AGR_ACC_WTM_MASK | LSM303AGR_ACC_OVRN_FIFO_MASK | LSM303AGR_ACC_EMPTY_MASK );
+  
+  return 0;
+}
+
+/**
+ * @brief  Read samples from the FIFO in one burst
+ * @param  pData the array where the samples are stored as x, y, z in mg
+ * @param  num_samples the number of samples to read [1 32], at most the stored ones
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM303AGRAccSensor::get_fifo_data(int32_t *pData, uint8_t num_samples)
+{
+  uint8_t regValue[6 * 32];
+  u8_t shift;
+  int scale;
+  
+  if ( get_x_scale( &shift, &scale ) == 1 )
+  {
+    return 1;
+  }
+  
+  if ( !LSM303AGR_ACC_Get_Raw_Acceleration_FIFO( (void *)this, regValue, num_samples ) )
+  {
+    return 1;
+  }
+  
+  for ( int i = 0; i < 3 * num_samples; i++ )
+  {
+    int16_t raw = ( int16_t )( ( ( uint16_t )regValue[2 * i + 1] << 8 ) | regValue[2 * i] );
+    pData[i] = ( int32_t )( ( ( raw >> shift ) * scale + 500 ) / 1000 );
+  }
+  
+  return 0;
+}
+
 uint8_t LSM303AGR_ACC_io_write( void *handle, uint8_t WriteAddr, uint8_t *pBuffer, uint16_t nBytesToWrite )
 {
   return ((LSM303AGRAccSensor *)handle)->io_write(pBuffer, WriteAddr, nBytesToWrite);
@@ -45,6 +45,7 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include "DevI2C.h"
+#include "DevSPI.h"
 #include "LSM303AGR_acc_driver.h"
 #include "MotionSensor.h"
 #include <assert.h>
@@ -87,6 +88,12 @@ class LSM303AGRAccSensor : public MotionSensor
     int disable(void);
     int read_reg(uint8_t reg, uint8_t *data);
     int write_reg(uint8_t reg, uint8_t data);
+    int set_fifo_mode(uint8_t mode);
+    int set_fifo_watermark_level(uint8_t level);
+    int set_fifo_int1_watermark(uint8_t status);
+    int set_int1_drdy(uint8_t status);
+    int get_fifo_status(uint8_t *num_samples, uint8_t *flags);
+    int get_fifo_data(int32_t *pData, uint8_t num_samples);
     
     /**
      * @brief Utility function to read data.
@@ -98,17 +105,11 @@ class LSM303AGRAccSensor : public MotionSensor
     uint8_t io_read(uint8_t* pBuffer, uint8_t RegisterAddr, uint16_t NumByteToRead)
     {
         if (_dev_spi) {
-        /* Write Reg Address */
-            _dev_spi->lock();
-            _cs_pin = 0;           
-            /* Write RD Reg Address with RD bit*/
-            uint8_t TxByte = RegisterAddr | 0x80;    
-            _dev_spi->write((char *)&TxByte, 1, (char *)pBuffer, (int) NumByteToRead);
-            _cs_pin = 1;
-            _dev_spi->unlock(); 
-            return 0;
+            /* Write RD Reg Address with RD bit, and MS bit to auto increment multiple reads */
+            return (uint8_t) DevSPI::spi_read_reg_3w(_dev_spi, _cs_pin, RegisterAddr | 0x80 | (NumByteToRead > 1 ? 0x40 : 0), pBuffer, NumByteToRead);
         }                       
-        if (_dev_i2c) return (uint8_t) _dev_i2c->i2c_read(pBuffer, _address, RegisterAddr, NumByteToRead);
+        /* MSB of the sub-address auto increments multiple reads */
+        if (_dev_i2c) return (uint8_t) _dev_i2c->i2c_read(pBuffer, _address, (uint8_t) (RegisterAddr | (NumByteToRead > 1 ? 0x80 : 0)), NumByteToRead);
         return 1;
     }
     
@@ -121,20 +122,46 @@ class LSM303AGRAccSensor : public MotionSensor
      */
     uint8_t io_write(uint8_t* pBuffer, uint8_t RegisterAddr, uint16_t NumByteToWrite)
     {
-        if (_dev_spi) { 
-            _dev_spi->lock();
-            _cs_pin = 0;
-            int data = _dev_spi->write(RegisterAddr);                    
-            _dev_spi->write((char *)pBuffer, (int) NumByteToWrite, NULL, 0);                     
-            _cs_pin = 1;                    
-            _dev_spi->unlock();
-            return data;                    
-        }                
-        if (_dev_i2c) return (uint8_t)_dev_i2c->i2c_write(pBuffer, _address, RegisterAddr, NumByteToWrite);
+        if (_dev_spi) {
+            /* Write Reg Address, then the data, in block transfers */
+            return (uint8_t) DevSPI::spi_write_reg(_dev_spi, _cs_pin, RegisterAddr | (NumByteToWrite > 1 ? 0x40 : 0), pBuffer, NumByteToWrite);
+        }
+        if (_dev_i2c) return (uint8_t)_dev_i2c->i2c_write(pBuffer, _address, (uint8_t) (RegisterAddr | (NumByteToWrite > 1 ? 0x80 : 0)), NumByteToWrite);
         return 1;
     }
 
+    /**
+     * @brief  Attaching an interrupt handler to the INT1 interrupt.
+     * @param  fptr An interrupt handler.
+     * @retval None.
+     */
+    void attach_int1_irq(Callback<void()> fptr)
+    {
+        _int1_pin.rise(fptr);
+    }
+
+    /**
+     * @brief  Enabling the INT1 interrupt handling.
+     * @param  None.
+     * @retval None.
+     */
+    void enable_int1_irq(void)
+    {
+        _int1_pin.enable_irq();
+    }
+    
+    /**
+     * @brief  Disabling the INT1 interrupt handling.
+     * @param  None.
+     * @retval None.
+     */
+    void disable_int1_irq(void)
+    {
+        _int1_pin.disable_irq();
+    }
+
   private:
+    int get_x_scale(u8_t *shift, int *scale);
     int set_x_odr_when_enabled(float odr);
     int set_x_odr_when_disabled(float odr);
     int get_x_sensitivity_normal_mode(float *sensitivity );
@@ -153,6 +180,10 @@ class LSM303AGRAccSensor : public MotionSensor
     
     uint8_t _is_enabled;
     float _last_odr;
+    
+    /* Raw data shift and sensitivity in ug/digit, 0 when unknown */
+    u8_t _x_shift;
+    int _x_scale;
 };
 
 #ifdef __cplusplus
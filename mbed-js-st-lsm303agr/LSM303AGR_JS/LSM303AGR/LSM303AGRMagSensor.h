@@ -45,6 +45,7 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include "DevI2C.h"
+#include "DevSPI.h"
 #include "LSM303AGR_mag_driver.h"
 #include "LSM303AGR_acc_driver.h"
 #include "MagneticSensor.h"
@@ -85,15 +86,8 @@ class LSM303AGRMagSensor : public MagneticSensor
     uint8_t io_read(uint8_t* pBuffer, uint8_t RegisterAddr, uint16_t NumByteToRead)
     {
         if (_dev_spi) {
-        /* Write Reg Address */
-            _dev_spi->lock();
-            _cs_pin = 0;           
-            /* Write RD Reg Address with RD bit*/
-            uint8_t TxByte = RegisterAddr | 0x80;    
-            _dev_spi->write((char *)&TxByte, 1, (char *)pBuffer, (int) NumByteToRead);
-            _cs_pin = 1;
-            _dev_spi->unlock(); 
-            return 0;
+            /* Write RD Reg Address with RD bit, and read on the same line */
+            return (uint8_t) DevSPI::spi_read_reg_3w(_dev_spi, _cs_pin, RegisterAddr | 0x80, pBuffer, NumByteToRead);
         }                       
         if (_dev_i2c) return (uint8_t) _dev_i2c->i2c_read(pBuffer, _address, RegisterAddr, NumByteToRead);
         return 1;
@@ -108,15 +102,10 @@ class LSM303AGRMagSensor : public MagneticSensor
      */
     uint8_t io_write(uint8_t* pBuffer, uint8_t RegisterAddr, uint16_t NumByteToWrite)
     {
-        if (_dev_spi) { 
-            _dev_spi->lock();
-            _cs_pin = 0;
-            int data = _dev_spi->write(RegisterAddr);                    
-            _dev_spi->write((char *)pBuffer, (int) NumByteToWrite, NULL, 0);                     
-            _cs_pin = 1;                    
-            _dev_spi->unlock();
-            return data;                    
-        }        
+        if (_dev_spi) {
+            /* Write Reg Address, then the data, in block transfers */
+            return (uint8_t) DevSPI::spi_write_reg(_dev_spi, _cs_pin, RegisterAddr, pBuffer, NumByteToWrite);
+        }
         if (_dev_i2c) return (uint8_t) _dev_i2c->i2c_write(pBuffer, _address, RegisterAddr, NumByteToWrite);    
         return 1;
     }
@@ -73,6 +73,26 @@ mems_status_t LSM303AGR_ACC_read_reg(void *handle, u8_t Reg, u8_t* Data)
   }
 }
 
+/*******************************************************************************
+* Function Name     : LSM303AGR_ACC_read_regs
+* Description       : Generic multiple reading function, the register address
+*                   : is incremented after each byte
+* Input             : Register Address, length of buffer
+* Output            : Data Read
+* Return            : None
+*******************************************************************************/
+mems_status_t LSM303AGR_ACC_read_regs( void *handle, u8_t Reg, u8_t* Data, u16_t len ) 
+{
+  if (LSM303AGR_ACC_io_read(handle, Reg, Data, len))
+  {
+    return MEMS_ERROR;
+  }
+  else
+  {
+    return MEMS_SUCCESS;
+  }
+}
+
 /*******************************************************************************
 * Function Name     : LSM303AGR_ACC_write_reg
 * Description       : Generic Writing function. It must be fullfilled with either
@@ -3828,25 +3848,32 @@ mems_status_t LSM303AGR_ACC_Get_Voltage_ADC(void *handle, u8_t *buff)
 *******************************************************************************/
 mems_status_t LSM303AGR_ACC_Get_Raw_Acceleration(void *handle, u8_t *buff) 
 {
-  u8_t i, j, k;
-  u8_t numberOfByteForDimension;
-  
-  numberOfByteForDimension=6/3;
-
-  k=0;
-  for (i=0; i<3;i++ ) 
-  {
-    for (j=0; j<numberOfByteForDimension;j++ )
-    {   
-        if( !LSM303AGR_ACC_read_reg(handle, LSM303AGR_ACC_OUT_X_L+k, &buff[k]))
-          return MEMS_ERROR;
-        k++;    
-    }
-  }
+  /* One burst read of the 6 output registers */
+  if( !LSM303AGR_ACC_read_regs(handle, LSM303AGR_ACC_OUT_X_L, buff, 6))
+    return MEMS_ERROR;
 
   return MEMS_SUCCESS; 
 }
 
+/*******************************************************************************
+* Function Name  : mems_status_t LSM303AGR_ACC_Get_Raw_Acceleration_FIFO(u8_t *buff, u8_t samples)
+* Description    : Read several FIFO samples in one burst, the output register
+*                  address rolls back from OUT_Z_H to OUT_X_L while the FIFO is enabled
+* Input          : pointer to [u8_t] of 6 bytes per sample, number of samples [1 32]
+* Output         : Acceleration buffer u8_t
+* Return         : Status [MEMS_ERROR, MEMS_SUCCESS]
+*******************************************************************************/
+mems_status_t LSM303AGR_ACC_Get_Raw_Acceleration_FIFO(void *handle, u8_t *buff, u8_t samples)
+{
+  if( samples == 0 || samples > 32 )
+    return MEMS_ERROR;
+
+  if( !LSM303AGR_ACC_read_regs(handle, LSM303AGR_ACC_OUT_X_L, buff, 6 * (u16_t)samples))
+    return MEMS_ERROR;
+
+  return MEMS_SUCCESS;
+}
+
 /*
  * Following is the table of sensitivity values for each case.
  * Values are espressed in ug/digit.
@@ -3877,13 +3904,16 @@ const long long LSM303AGR_ACC_Sensitivity_List[3][4] = {
     },
 };
 
-/*
- * Values returned are espressed in mg.
- */
-mems_status_t LSM303AGR_ACC_Get_Acceleration(void *handle, int *buff)
+/*******************************************************************************
+* Function Name  : mems_status_t LSM303AGR_ACC_Get_Acceleration_Scale(u8_t *shift, int *sensitivity)
+* Description    : Read the operating mode and full scale the acceleration is expressed in
+* Input          : pointer to [u8_t], pointer to [int]
+* Output         : Right shift of the raw samples, sensitivity in ug/digit
+* Return         : Status [MEMS_ERROR, MEMS_SUCCESS]
+*******************************************************************************/
+mems_status_t LSM303AGR_ACC_Get_Acceleration_Scale(void *handle, u8_t *shift, int *sensitivity)
 {
-  Type3Axis16bit_U raw_data_tmp;
-  u8_t op_mode = 0, fs_mode = 0, shift = 0;
+  u8_t op_mode = 0, fs_mode = 0;
   LSM303AGR_ACC_LPEN_t lp;
   LSM303AGR_ACC_HR_t hr;
   LSM303AGR_ACC_FS_t fs;
@@ -3900,15 +3930,15 @@ mems_status_t LSM303AGR_ACC_Get_Acceleration(void *handle, int *buff)
   if (lp == LSM303AGR_ACC_LPEN_ENABLED && hr == LSM303AGR_ACC_HR_DISABLED) {
     /* op mode is LP 8-bit */
     op_mode = 2;
-    shift = 8;
+    *shift = 8;
   } else if (lp == LSM303AGR_ACC_LPEN_DISABLED && hr == LSM303AGR_ACC_HR_DISABLED) {
     /* op mode is Normal 10-bit */
     op_mode = 1;
-    shift = 6;
+    *shift = 6;
   } else if (lp == LSM303AGR_ACC_LPEN_DISABLED && hr == LSM303AGR_ACC_HR_ENABLED) {
     /* op mode is HR 12-bit */
     op_mode = 0;
-    shift = 4;
+    *shift = 4;
   } else {
     return MEMS_ERROR;
   }
@@ -3936,15 +3966,33 @@ mems_status_t LSM303AGR_ACC_Get_Acceleration(void *handle, int *buff)
     break;
   }
 
+  *sensitivity = LSM303AGR_ACC_Sensitivity_List[op_mode][fs_mode];
+
+  return MEMS_SUCCESS;
+}
+
+/*
+ * Values returned are espressed in mg.
+ */
+mems_status_t LSM303AGR_ACC_Get_Acceleration(void *handle, int *buff)
+{
+  Type3Axis16bit_U raw_data_tmp;
+  u8_t shift = 0;
+  int sensitivity = 0;
+
+  if(!LSM303AGR_ACC_Get_Acceleration_Scale(handle, &shift, &sensitivity)) {
+    return MEMS_ERROR;
+  }
+
   /* Read out raw accelerometer samples */
   if(!LSM303AGR_ACC_Get_Raw_Acceleration(handle, raw_data_tmp.u8bit)) {
     return MEMS_ERROR;
   }
 
   /* Apply proper shift and sensitivity */
-  buff[0] = ((raw_data_tmp.i16bit[0] >> shift) * LSM303AGR_ACC_Sensitivity_List[op_mode][fs_mode] + 500) / 1000;
-  buff[1] = ((raw_data_tmp.i16bit[1] >> shift) * LSM303AGR_ACC_Sensitivity_List[op_mode][fs_mode] + 500) / 1000;
-  buff[2] = ((raw_data_tmp.i16bit[2] >> shift) * LSM303AGR_ACC_Sensitivity_List[op_mode][fs_mode] + 500) / 1000;
+  buff[0] = ((raw_data_tmp.i16bit[0] >> shift) * sensitivity + 500) / 1000;
+  buff[1] = ((raw_data_tmp.i16bit[1] >> shift) * sensitivity + 500) / 1000;
+  buff[2] = ((raw_data_tmp.i16bit[2] >> shift) * sensitivity + 500) / 1000;
 
   return MEMS_SUCCESS;
 }
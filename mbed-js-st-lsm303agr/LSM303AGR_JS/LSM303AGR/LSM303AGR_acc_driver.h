@@ -108,6 +108,7 @@ void LSM303AGR_ACC_SwapHighLowByte(u8_t *bufferToSwap, u8_t numberOfByte, u8_t d
 /* Public Function Prototypes ------------------------------------------------*/
 
 mems_status_t LSM303AGR_ACC_read_reg( void *handle, u8_t Reg, u8_t* Data );
+mems_status_t LSM303AGR_ACC_read_regs( void *handle, u8_t Reg, u8_t* Data, u16_t len );
 mems_status_t LSM303AGR_ACC_write_reg( void *handle, u8_t Reg, u8_t Data ); 
 
 
@@ -1599,6 +1600,8 @@ mems_status_t LSM303AGR_ACC_Get_Voltage_ADC(void *handle, u8_t *buff);
 * Permission    : RO 
 *******************************************************************************/
 mems_status_t LSM303AGR_ACC_Get_Raw_Acceleration(void *handle, u8_t *buff); 
+mems_status_t LSM303AGR_ACC_Get_Raw_Acceleration_FIFO(void *handle, u8_t *buff, u8_t samples);
+mems_status_t LSM303AGR_ACC_Get_Acceleration_Scale(void *handle, u8_t *shift, int *sensitivity);
 mems_status_t LSM303AGR_ACC_Get_Acceleration(void *handle, int *buff);
 
 #ifdef __cplusplus
@@ -73,6 +73,26 @@ mems_status_t LSM303AGR_MAG_read_reg( void *handle, u8_t Reg, u8_t* Data )
   }
 }
 
+/*******************************************************************************
+* Function Name     : LSM303AGR_MAG_read_regs
+* Description       : Generic multiple reading function, the register address
+*                   : is incremented after each byte
+* Input             : Register Address, length of buffer
+* Output            : Data Read
+* Return            : None
+*******************************************************************************/
+mems_status_t LSM303AGR_MAG_read_regs( void *handle, u8_t Reg, u8_t* Data, u16_t len ) 
+{
+  if (LSM303AGR_MAG_io_read(handle, Reg, Data, len))
+  {
+    return MEMS_ERROR;
+  }
+  else
+  {
+    return MEMS_SUCCESS;
+  }
+}
+
 /*******************************************************************************
 * Function Name     : LSM303AGR_MAG_write_reg
 * Description       : Generic Writing function. It must be fullfilled with either
@@ -1544,21 +1564,9 @@ mems_status_t LSM303AGR_MAG_R_ZYXOR(void *handle, LSM303AGR_MAG_ZYXOR_t *value)
 *******************************************************************************/
 mems_status_t LSM303AGR_MAG_Get_Raw_Magnetic(void *handle, u8_t *buff) 
 {
-  u8_t i, j, k;
-  u8_t numberOfByteForDimension;
-  
-  numberOfByteForDimension=6/3;
-
-  k=0;
-  for (i=0; i<3;i++ ) 
-  {
-    for (j=0; j<numberOfByteForDimension;j++ )
-    {   
-        if( !LSM303AGR_MAG_read_reg(handle, LSM303AGR_MAG_OUTX_L_REG+k, &buff[k]))
-          return MEMS_ERROR;
-        k++;    
-    }
-  }
+  /* One burst read of the 6 output registers */
+  if( !LSM303AGR_MAG_read_regs(handle, LSM303AGR_MAG_OUTX_L_REG, buff, 6))
+    return MEMS_ERROR;
 
   return MEMS_SUCCESS; 
 }
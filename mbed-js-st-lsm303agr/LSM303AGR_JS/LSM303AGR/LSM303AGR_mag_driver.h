@@ -108,6 +108,7 @@ void LSM303AGR_MAG_SwapHighLowByte(u8_t *bufferToSwap, u8_t numberOfByte, u8_t d
 /* Public Function Prototypes -------------------------------------------------------*/
 
 mems_status_t LSM303AGR_MAG_read_reg( void *handle, u8_t Reg, u8_t* Data );
+mems_status_t LSM303AGR_MAG_read_regs( void *handle, u8_t Reg, u8_t* Data, u16_t len );
 mems_status_t LSM303AGR_MAG_write_reg( void *handle, u8_t Reg, u8_t Data ); 
 
 
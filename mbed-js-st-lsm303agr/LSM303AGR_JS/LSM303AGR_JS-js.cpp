@@ -44,6 +44,7 @@
 
 // Load the library that we'll wrap
 #include "LSM303AGR_JS.h"
+#include "JsValueArray.h"
 
 #include "mbed.h"
 
@@ -332,15 +333,13 @@ DECLARE_CLASS_FUNCTION(LSM303AGR_JS, get_accelerometer_axes) {
     LSM303AGR_JS *native_ptr = static_cast<LSM303AGR_JS*>(void_ptr);
  
     // Get the result from the C++ API
-    char *result = new char[128];
+    char result[128];
     native_ptr->get_accelerometer_axes_json(result);
     
     // Cast it back to JavaScript
     jerry_value_t out = jerry_create_string((unsigned char *)result);
     
     //printf("acc: %s\n", result);
-    // Recycle the result from function
-    delete result;
 
     // Return the output
     return out;
@@ -369,20 +368,328 @@ DECLARE_CLASS_FUNCTION(LSM303AGR_JS, get_magnetometer_axes) {
     LSM303AGR_JS *native_ptr = static_cast<LSM303AGR_JS*>(void_ptr);
  
     // Get the result from the C++ API
-    char *result = new char[128];
+    char result[128];
     native_ptr->get_magnetometer_axes_json(result);
     
     // Cast it back to JavaScript
     jerry_value_t out = jerry_create_string((unsigned char *)result);
     
     //printf("mag: %s\n", result);
-    // Recycle the result from function
-    delete result;
 
     // Return the output
     return out;
 }
 
+/**
+ * LSM303AGR_JS#get_axes (native JavaScript method)
+ * @brief   Gets accelerometer and magnetometer readings in one group of reads
+ * @returns Array of [acc x, y, z (mg), mag x, y, z (mgauss)], undefined on error
+ */
+DECLARE_CLASS_FUNCTION(LSM303AGR_JS, get_axes) {
+    CHECK_ARGUMENT_COUNT(LSM303AGR_JS, get_axes, (args_count == 0));
+
+    // Unwrap native LSM303AGR_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM303AGR_JS pointer");
+    }
+
+    LSM303AGR_JS *native_ptr = static_cast<LSM303AGR_JS*>(void_ptr);
+
+    int32_t axes[6];
+
+    // Get the result from the C++ API
+    if (native_ptr->get_axes(axes) != 0) {
+        return jerry_create_undefined();
+    }
+
+    // Cast it back to JavaScript
+    jerry_value_t out = jerry_create_array(6);
+
+    for (int i = 0; i < 6; i++) {
+        jerry_value_t val = jerry_create_number(axes[i]);
+        jerry_release_value(jerry_set_property_by_index(out, i, val));
+        jerry_release_value(val);
+    }
+
+    // Return the output
+    return out;
+}
+
+/**
+ * LSM303AGR_JS#enable_accelerometer_fifo (native JavaScript method)
+ * @brief   Enables the accelerometer FIFO
+ * @param   FIFO mode: 1 FIFO (stops when full), 2 stream, 3 stream-to-FIFO
+ * @param   Watermark level [0 31]
+ * @returns 0 on success, 1 on error, 2 if the accelerometer is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM303AGR_JS, enable_accelerometer_fifo) {
+    CHECK_ARGUMENT_COUNT(LSM303AGR_JS, enable_accelerometer_fifo, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM303AGR_JS, enable_accelerometer_fifo, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM303AGR_JS, enable_accelerometer_fifo, 1, number);
+
+    // Unwrap native LSM303AGR_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM303AGR_JS pointer");
+    }
+
+    LSM303AGR_JS *native_ptr = static_cast<LSM303AGR_JS*>(void_ptr);
+
+    int mode = jerry_get_number_value(args[0]);
+    int watermark = jerry_get_number_value(args[1]);
+
+    if (mode < 0 || mode > 3 || watermark < 0 || watermark > 31) {
+        return jerry_create_number(1);
+    }
+
+    // Call the native function
+    int result = native_ptr->enable_accelerometer_fifo((uint8_t) mode, (uint8_t) watermark);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM303AGR_JS#disable_accelerometer_fifo (native JavaScript method)
+ * @brief   Disables the accelerometer FIFO
+ * @returns 0 on success, 1 on error, 2 if the accelerometer is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM303AGR_JS, disable_accelerometer_fifo) {
+    CHECK_ARGUMENT_COUNT(LSM303AGR_JS, disable_accelerometer_fifo, (args_count == 0));
+
+    // Unwrap native LSM303AGR_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM303AGR_JS pointer");
+    }
+
+    LSM303AGR_JS *native_ptr = static_cast<LSM303AGR_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->disable_accelerometer_fifo();
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM303AGR_JS#read_accelerometer_fifo (native JavaScript method)
+ * @brief   Drains the accelerometer FIFO in one burst
+ * @returns Array of [x, y, z, x, y, z, ...] in mg with the oldest sample first,
+ *          undefined on error
+ */
+DECLARE_CLASS_FUNCTION(LSM303AGR_JS, read_accelerometer_fifo) {
+    CHECK_ARGUMENT_COUNT(LSM303AGR_JS, read_accelerometer_fifo, (args_count == 0));
+
+    // Unwrap native LSM303AGR_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM303AGR_JS pointer");
+    }
+
+    LSM303AGR_JS *native_ptr = static_cast<LSM303AGR_JS*>(void_ptr);
+
+    int32_t data[3 * 32];
+
+    // Get the result from the C++ API
+    int count = native_ptr->read_accelerometer_fifo(data);
+
+    if (count < 0) {
+        return jerry_create_undefined();
+    }
+
+    // Cast it back to JavaScript
+    jerry_value_t out = jerry_create_array(3 * count);
+
+    for (int i = 0; i < 3 * count; i++) {
+        jerry_value_t val = jerry_create_number(data[i]);
+        jerry_release_value(jerry_set_property_by_index(out, i, val));
+        jerry_release_value(val);
+    }
+
+    // Return the output
+    return out;
+}
+
+/**
+ * LSM303AGR_JS#get_accelerometer_axes_into (native JavaScript method)
+ * @brief   Writes the accelerometer x, y, z in mg into an array
+ * @param   Array or TypedArray the values are written to
+ * @param   Optional index of the first value, 0 by default
+ * @returns Index following the last value written, or -1 if the values do not fit
+ */
+DECLARE_CLASS_FUNCTION(LSM303AGR_JS, get_accelerometer_axes_into) {
+    CHECK_ARGUMENT_COUNT(LSM303AGR_JS, get_accelerometer_axes_into, (args_count == 1 || args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM303AGR_JS, get_accelerometer_axes_into, 0, object);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM303AGR_JS, get_accelerometer_axes_into, 1, number, args_count == 2);
+
+    if (!js_value_array_is_valid(args[0])) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Target must be an Array or a TypedArray");
+    }
+
+    // Unwrap native LSM303AGR_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM303AGR_JS pointer");
+    }
+
+    LSM303AGR_JS *native_ptr = static_cast<LSM303AGR_JS*>(void_ptr);
+
+    uint32_t offset = 0;
+    if (args_count == 2 && !js_value_array_get_offset(args[1], 3, &offset)) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Offset must be a non-negative integer index");
+    }
+
+    // Get the result from the C++ API
+    int32_t axes[3];
+    native_ptr->get_accelerometer_axes(axes);
+
+    // Write it to the caller's array
+    return jerry_create_number(js_value_array_write(args[0], offset, axes, 3));
+}
+
+/**
+ * LSM303AGR_JS#get_magnetometer_axes_into (native JavaScript method)
+ * @brief   Writes the magnetometer x, y, z in mgauss into an array
+ * @param   Array or TypedArray the values are written to
+ * @param   Optional index of the first value, 0 by default
+ * @returns Index following the last value written, or -1 if the values do not fit
+ */
+DECLARE_CLASS_FUNCTION(LSM303AGR_JS, get_magnetometer_axes_into) {
+    CHECK_ARGUMENT_COUNT(LSM303AGR_JS, get_magnetometer_axes_into, (args_count == 1 || args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM303AGR_JS, get_magnetometer_axes_into, 0, object);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM303AGR_JS, get_magnetometer_axes_into, 1, number, args_count == 2);
+
+    if (!js_value_array_is_valid(args[0])) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Target must be an Array or a TypedArray");
+    }
+
+    // Unwrap native LSM303AGR_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM303AGR_JS pointer");
+    }
+
+    LSM303AGR_JS *native_ptr = static_cast<LSM303AGR_JS*>(void_ptr);
+
+    uint32_t offset = 0;
+    if (args_count == 2 && !js_value_array_get_offset(args[1], 3, &offset)) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Offset must be a non-negative integer index");
+    }
+
+    // Get the result from the C++ API
+    int32_t axes[3];
+    native_ptr->get_magnetometer_axes(axes);
+
+    // Write it to the caller's array
+    return jerry_create_number(js_value_array_write(args[0], offset, axes, 3));
+}
+
+/**
+ * LSM303AGR_JS#get_axes_into (native JavaScript method)
+ * @brief   Writes accelerometer and magnetometer x, y, z read in one group into an array
+ * @param   Array or TypedArray the values are written to
+ * @param   Optional index of the first value, 0 by default
+ * @returns Index following the last value written, or -1 on a sensor error or if the values do not fit
+ */
+DECLARE_CLASS_FUNCTION(LSM303AGR_JS, get_axes_into) {
+    CHECK_ARGUMENT_COUNT(LSM303AGR_JS, get_axes_into, (args_count == 1 || args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM303AGR_JS, get_axes_into, 0, object);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM303AGR_JS, get_axes_into, 1, number, args_count == 2);
+
+    if (!js_value_array_is_valid(args[0])) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Target must be an Array or a TypedArray");
+    }
+
+    // Unwrap native LSM303AGR_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM303AGR_JS pointer");
+    }
+
+    LSM303AGR_JS *native_ptr = static_cast<LSM303AGR_JS*>(void_ptr);
+
+    uint32_t offset = 0;
+    if (args_count == 2 && !js_value_array_get_offset(args[1], 6, &offset)) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Offset must be a non-negative integer index");
+    }
+
+    // Get the result from the C++ API
+    int32_t axes[6];
+    if (native_ptr->get_axes(axes) != 0) {
+        return jerry_create_number(-1);
+    }
+
+    // Write it to the caller's array
+    return jerry_create_number(js_value_array_write(args[0], offset, axes, 6));
+}
+
+/**
+ * LSM303AGR_JS#onDataReady (native JavaScript method)
+ * @brief   Calls a function each time a new sample is ready, or stops the
+ *          events when called without arguments
+ * @param   Callback, called with an array of [x, y, z] accelerometer values in mg
+ *          and the number of data-ready interrupts since the previous
+ *          call, more than 1 when samples were skipped
+ * @returns 0 on success, 1 on a sensor error, 2 if no accelerometer INT1 pin was given,
+ *          3 if the accelerometer is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM303AGR_JS, onDataReady) {
+    CHECK_ARGUMENT_COUNT(LSM303AGR_JS, onDataReady, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM303AGR_JS, onDataReady, 0, function, args_count == 1);
+
+    // Unwrap native LSM303AGR_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM303AGR_JS pointer");
+    }
+
+    LSM303AGR_JS *native_ptr = static_cast<LSM303AGR_JS*>(void_ptr);
+
+    // Call the native function
+    int result = (args_count == 1) ? native_ptr->on_data_ready(this_obj, args[0])
+                                   : native_ptr->stop_data_ready();
+
+    return jerry_create_number(result);
+}
+
 /**
  * LSM303AGR_JS (native JavaScript constructor)
  * @brief   Constructor for Javascript wrapper
@@ -400,6 +707,14 @@ DECLARE_CLASS_CONSTRUCTOR(LSM303AGR_JS) {
     // attach methods
     ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, get_accelerometer_axes);
     ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, get_magnetometer_axes);
+    ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, get_axes);
+    ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, get_accelerometer_axes_into);
+    ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, get_magnetometer_axes_into);
+    ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, get_axes_into);
+    ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, enable_accelerometer_fifo);
+    ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, disable_accelerometer_fifo);
+    ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, read_accelerometer_fifo);
+    ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, onDataReady);
     ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, init_acc_i2c);
     ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, init_acc_spi);
     ATTACH_CLASS_FUNCTION(js_object, LSM303AGR_JS, init_mag_i2c);
@@ -83,24 +83,19 @@ static char *print_double(char* str, double v, int decimalDigits=2)
 /* Helper function for creating JSON for data */
 char *LSM303AGR_JS::make_json(char* str, int32_t *data, char *axes, int data_count)
 {
-	char *ptr;
-	ptr = str;
-	str[0] = 0;
+	char *ptr = str;
 
+	/* Keep a write pointer instead of rescanning the string */
+	*ptr++ = '{';
 	for(int i = 0; i < data_count; i++){
-		//printf("len: %i\n", strlen(str));
-		if(i == 0){
-			sprintf(ptr, "{");
-			ptr = &str[strlen(str)];
-		}
-		else{
-			sprintf(ptr, ",");
-			ptr = &str[strlen(str)];
+		if(i != 0){
+			*ptr++ = ',';
 		}
-		sprintf(ptr, "\"%c\":%i", axes[i], static_cast<int>(data[i]));
-		ptr = &str[strlen(str)];
+		ptr += sprintf(ptr, "\"%c\":%i", axes[i], static_cast<int>(data[i]));
 	}
-	sprintf(ptr, "}");
+	*ptr++ = '}';
+	*ptr = 0;
+
 	return str;
 }
 
@@ -113,6 +108,7 @@ char *LSM303AGR_JS::make_json(char* str, int32_t *data, char *axes, int data_cou
  */
 void LSM303AGR_JS::init_acc(SPI &spi, PinName cs_pin){
 	accelerometer = new LSM303AGRAccSensor (&spi, cs_pin);
+	acc_spi = &spi;
 	accelerometer->init(NULL);
 	accelerometer->enable();
 }
@@ -126,6 +122,8 @@ void LSM303AGR_JS::init_acc(SPI &spi, PinName cs_pin){
  */
 void LSM303AGR_JS::init_acc(SPI &spi, PinName cs_pin, PinName int1_pin, PinName int2_pin){
 	accelerometer = new LSM303AGRAccSensor (&spi, cs_pin, int1_pin, int2_pin);
+	acc_int1 = int1_pin;
+	acc_spi = &spi;
 	accelerometer->init(NULL);
 	accelerometer->enable();
 }
@@ -136,6 +134,7 @@ void LSM303AGR_JS::init_acc(SPI &spi, PinName cs_pin, PinName int1_pin, PinName
  */
 void LSM303AGR_JS::init_acc(DevI2C &devI2c){
 	accelerometer = new LSM303AGRAccSensor (&devI2c);
+	acc_i2c = &devI2c;
 	accelerometer->init(NULL);
 	accelerometer->enable();
 }
@@ -148,6 +147,8 @@ void LSM303AGR_JS::init_acc(DevI2C &devI2c){
  */
 void LSM303AGR_JS::init_acc(DevI2C &devI2c, PinName int1_pin, PinName int2_pin){
 	accelerometer = new LSM303AGRAccSensor (&devI2c, LSM303AGR_ACC_I2C_ADDRESS, int1_pin, int2_pin);
+	acc_int1 = int1_pin;
+	acc_i2c = &devI2c;
 	accelerometer->init(NULL);
 	accelerometer->enable();
 }
@@ -161,6 +162,8 @@ void LSM303AGR_JS::init_acc(DevI2C &devI2c, PinName int1_pin, PinName int2_pin){
  */
 void LSM303AGR_JS::init_acc(DevI2C &devI2c, PinName int1_pin, PinName int2_pin, uint8_t address){
 	accelerometer = new LSM303AGRAccSensor (&devI2c, address, int1_pin, int2_pin);
+	acc_int1 = int1_pin;
+	acc_i2c = &devI2c;
 	accelerometer->init(NULL);
 	accelerometer->enable();
 }
@@ -172,6 +175,7 @@ void LSM303AGR_JS::init_acc(DevI2C &devI2c, PinName int1_pin, PinName int2_pin,
  */
 void LSM303AGR_JS::init_mag(SPI &spi, PinName cs_pin){
 	magnetometer = new LSM303AGRMagSensor (&spi, cs_pin);
+	mag_spi = &spi;
 	magnetometer->init(NULL);
 	magnetometer->enable();
 }
@@ -184,6 +188,7 @@ void LSM303AGR_JS::init_mag(SPI &spi, PinName cs_pin){
  */
 void LSM303AGR_JS::init_mag(SPI &spi, PinName cs_pin, PinName int_pin){
 	magnetometer = new LSM303AGRMagSensor (&spi, cs_pin, int_pin);
+	mag_spi = &spi;
 	magnetometer->init(NULL);
 	magnetometer->enable();
 }
@@ -194,6 +199,7 @@ void LSM303AGR_JS::init_mag(SPI &spi, PinName cs_pin, PinName int_pin){
  */
 void LSM303AGR_JS::init_mag(DevI2C &devI2c){
 	magnetometer = new LSM303AGRMagSensor (&devI2c);
+	mag_i2c = &devI2c;
 	magnetometer->init(NULL);
 	magnetometer->enable();
 }
@@ -205,6 +211,7 @@ void LSM303AGR_JS::init_mag(DevI2C &devI2c){
  */
 void LSM303AGR_JS::init_mag(DevI2C &devI2c, PinName int_pin){
 	magnetometer = new LSM303AGRMagSensor (&devI2c, LSM303AGR_MAG_I2C_ADDRESS, int_pin);
+	mag_i2c = &devI2c;
 	magnetometer->init(NULL);
 	magnetometer->enable();
 }
@@ -217,6 +224,7 @@ void LSM303AGR_JS::init_mag(DevI2C &devI2c, PinName int_pin){
  */
 void LSM303AGR_JS::init_mag(DevI2C &devI2c, PinName int_pin, uint8_t address){
 	magnetometer = new LSM303AGRMagSensor (&devI2c, address, int_pin);
+	mag_i2c = &devI2c;
 	magnetometer->init(NULL);
 	magnetometer->enable();
 }
@@ -260,7 +268,6 @@ uint8_t LSM303AGR_JS::read_accelerometer_id(){
  */
 int32_t *LSM303AGR_JS::get_accelerometer_axes(int32_t *axes){
 	accelerometer->get_x_axes(axes);
-    printf("LSM303AGR [acc/mg]:        %6ld, %6ld, %6ld\r\n", axes[0], axes[1], axes[2]);
 	return axes;
 }
 
@@ -287,7 +294,6 @@ char *LSM303AGR_JS::get_accelerometer_axes_json(char *data){
  */
 int32_t *LSM303AGR_JS::get_magnetometer_axes(int32_t *axes){
 	magnetometer->get_m_axes(axes);
-    printf("LSM303AGR [mag/mgauss]:     %6ld, %6ld, %6ld\r\n", axes[0], axes[1], axes[2]);
     return axes;
 }
 
@@ -305,3 +311,199 @@ char *LSM303AGR_JS::get_magnetometer_axes_json(char * data){
 	
 	return data;
 }
+
+/**
+ * @brief  Get the accelerometer and magnetometer readings in one group
+ * @param  Array of 6 values where [acc x, y, z (mg), mag x, y, z (mgauss)] are stored
+ * @retval 0 on success, 1 on error, 2 if a sensor is not initialized
+ */
+int LSM303AGR_JS::get_axes(int32_t *axes){
+	if(accelerometer == NULL || magnetometer == NULL){
+		return 2;
+	}
+
+	/* Hold a shared bus so both reads go out back to back */
+	if(acc_i2c != NULL && acc_i2c == mag_i2c){
+		acc_i2c->lock();
+	}
+	else if(acc_spi != NULL && acc_spi == mag_spi){
+		acc_spi->lock();
+	}
+
+	int result = accelerometer->get_x_axes(axes) || magnetometer->get_m_axes(axes + 3);
+
+	if(acc_i2c != NULL && acc_i2c == mag_i2c){
+		acc_i2c->unlock();
+	}
+	else if(acc_spi != NULL && acc_spi == mag_spi){
+		acc_spi->unlock();
+	}
+
+	return result;
+}
+
+/**
+ * @brief  Enable the accelerometer FIFO
+ * @param  FIFO mode: 1 FIFO (stops when full), 2 stream, 3 stream-to-FIFO
+ * @param  Watermark level [0 31]
+ * @retval 0 on success, 1 on error, 2 if the accelerometer is not initialized
+ */
+int LSM303AGR_JS::enable_accelerometer_fifo(uint8_t mode, uint8_t watermark){
+	if(accelerometer == NULL){
+		return 2;
+	}
+	if(mode == 0 || mode > 3){
+		return 1;
+	}
+	stop_data_ready();
+
+	/* Pass through bypass mode to discard any stale content */
+	if(accelerometer->set_fifo_mode(0) || accelerometer->set_fifo_watermark_level(watermark)
+	   || accelerometer->set_fifo_mode(mode)){
+		return 1;
+	}
+
+	fifo_mode = mode;
+	return 0;
+}
+
+/**
+ * @brief  Disable the accelerometer FIFO
+ * @retval 0 on success, 1 on error, 2 if the accelerometer is not initialized
+ */
+int LSM303AGR_JS::disable_accelerometer_fifo(){
+	if(accelerometer == NULL){
+		return 2;
+	}
+	fifo_mode = 0;
+	return accelerometer->set_fifo_mode(0);
+}
+
+/**
+ * @brief  Drain the accelerometer FIFO in one burst
+ * @param  Array of 96 values where the samples are stored as x, y, z in mg
+ * @retval Number of samples read, -1 on error
+ */
+int LSM303AGR_JS::read_accelerometer_fifo(int32_t *data){
+	uint8_t num_samples, flags;
+
+	if(accelerometer == NULL || accelerometer->get_fifo_status(&num_samples, &flags)){
+		return -1;
+	}
+	if(num_samples == 0){
+		return 0;
+	}
+	if(accelerometer->get_fifo_data(data, num_samples)){
+		return -1;
+	}
+
+	/* FIFO mode stops collecting once full, restart it for the next batch */
+	if(fifo_mode == 1 && num_samples == 32){
+		if(accelerometer->set_fifo_mode(0) || accelerometer->set_fifo_mode(fifo_mode)){
+			return -1;
+		}
+	}
+
+	return num_samples;
+}
+
+/**
+ * @brief  Calls a JavaScript function each time a new sample is ready
+ * @param  JavaScript object kept alive while events are enabled
+ * @param  JavaScript callback, called with an array of [x, y, z] accelerometer values in mg
+ *         and the number of data-ready interrupts since the previous call
+ * @retval 0 on success, 1 on a sensor error, 2 if no accelerometer INT1 pin was given,
+ *         3 if the accelerometer is not initialized
+ */
+int LSM303AGR_JS::on_data_ready(jerry_value_t this_obj, jerry_value_t cb){
+	if(accelerometer == NULL){
+		return 3;
+	}
+	if(acc_int1 == NC){
+		return 2;
+	}
+
+	// Reading the output registers would pop samples from the FIFO
+	if(fifo_mode != 0){
+		disable_accelerometer_fifo();
+	}
+	stop_data_ready();
+
+	accelerometer->attach_int1_irq(callback(this, &LSM303AGR_JS::drdy_interrupt));
+	if(accelerometer->set_int1_drdy(1)){
+		accelerometer->disable_int1_irq();
+		return 1;
+	}
+
+	// Keep the object and the callback while samples may arrive
+	drdy_delivery.start(this_obj, cb);
+
+	accelerometer->enable_int1_irq();
+
+	// A sample already waiting holds the pin high; read it so the next one raises an edge
+	int32_t values[3];
+	accelerometer->get_x_axes(values);
+
+	return 0;
+}
+
+/**
+ * @brief  Stops data-ready events
+ * @retval 0 on success, 1 on a sensor error
+ */
+int LSM303AGR_JS::stop_data_ready(){
+	int result = 0;
+
+	if(drdy_delivery.is_started()){
+		accelerometer->disable_int1_irq();
+		result = accelerometer->set_int1_drdy(0);
+	}
+
+	// This may release the last reference to this object, so it comes last
+	drdy_delivery.stop();
+
+	return result;
+}
+
+/**
+ * @brief  accelerometer INT1 handler, runs in interrupt context
+ */
+void LSM303AGR_JS::drdy_interrupt(){
+	// Later samples are coalesced into a delivery already waiting
+	drdy_delivery.post(mbed::Callback<void()>(this, &LSM303AGR_JS::deliver_drdy));
+}
+
+/**
+ * @brief  Passes the latest sample to JavaScript, on the event loop
+ */
+void LSM303AGR_JS::deliver_drdy(){
+	// Stopped since this delivery was posted, this object may be freed
+	uint32_t count;
+	if(!drdy_delivery.begin(&count)){
+		return;
+	}
+
+	// Reading the sample also lowers the pin for the next edge
+	int32_t values[3];
+	if(accelerometer->get_x_axes(values)){
+		return;
+	}
+
+	jerry_value_t out_array = jerry_create_array(3);
+	for(uint32_t i = 0; i < 3; i++){
+		jerry_value_t val = jerry_create_number(values[i]);
+		jerry_release_value(jerry_set_property_by_index(out_array, i, val));
+		jerry_release_value(val);
+	}
+
+	jerry_value_t args[2] = {
+		out_array,
+		jerry_create_number(count)
+	};
+
+	// The callback may stop the events and free this object
+	drdy_delivery.call(args, 2);
+
+	jerry_release_value(args[0]);
+	jerry_release_value(args[1]);
+}
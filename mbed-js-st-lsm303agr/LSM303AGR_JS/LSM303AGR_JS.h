@@ -48,6 +48,9 @@
 #include "mbed.h"
 #include "LSM303AGRMagSensor.h"
 #include "LSM303AGRAccSensor.h"
+#include "JsDelivery.h"
+
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
 
 /* Class Declaration ---------------------------------------------------------*/
 
@@ -59,6 +62,22 @@ private:
     /* Helper classes. */
     LSM303AGRMagSensor *magnetometer = NULL;
     LSM303AGRAccSensor *accelerometer = NULL;
+    
+    /* Buses of each sensor, used to group accelerometer and magnetometer reads. */
+    DevI2C *acc_i2c = NULL;
+    DevI2C *mag_i2c = NULL;
+    SPI *acc_spi = NULL;
+    SPI *mag_spi = NULL;
+    
+    /* Accelerometer FIFO mode, 0 when the FIFO is disabled. */
+    uint8_t fifo_mode = 0;
+    
+    /* Data-ready events. */
+    PinName acc_int1 = NC;
+    JsDelivery drdy_delivery;
+    
+    void drdy_interrupt();
+    void deliver_drdy();
 
 public:
     /* Constructors */
@@ -94,6 +113,12 @@ public:
     char *get_accelerometer_axes_json(char *);
     int32_t *get_magnetometer_axes(int32_t *);
     char *get_magnetometer_axes_json(char *);
+    int get_axes(int32_t *);
+    int enable_accelerometer_fifo(uint8_t mode, uint8_t watermark);
+    int disable_accelerometer_fifo();
+    int read_accelerometer_fifo(int32_t *);
+    int on_data_ready(jerry_value_t this_obj, jerry_value_t cb);
+    int stop_data_ready();
     
 };
 
@@ -45,7 +45,8 @@
 /* Class Implementation ------------------------------------------------------*/
 
 LSM6DSLSensor::LSM6DSLSensor(SPI *spi, PinName cs_pin, PinName int1_pin, PinName int2_pin, SPI_type_t spi_type ) : 
-                             _dev_spi(spi), _cs_pin(cs_pin), _int1_irq(int1_pin), _int2_irq(int2_pin), _spi_type(spi_type)
+                             _dev_spi(spi), _cs_pin(cs_pin), _int1_irq(int1_pin), _int2_irq(int2_pin), _spi_type(spi_type),
+                             _x_sensitivity(0), _g_sensitivity(0)
 {
     assert (spi);
     if (cs_pin == NC) 
@@ -69,7 +70,8 @@ LSM6DSLSensor::LSM6DSLSensor(SPI *spi, PinName cs_pin, PinName int1_pin, PinName
  * @param address the address of the component's instance
  */
 LSM6DSLSensor::LSM6DSLSensor(DevI2C *i2c, uint8_t address, PinName int1_pin, PinName int2_pin) :
-                             _dev_i2c(i2c), _address(address), _cs_pin(NC), _int1_irq(int1_pin), _int2_irq(int2_pin)
+                             _dev_i2c(i2c), _address(address), _cs_pin(NC), _int1_irq(int1_pin), _int2_irq(int2_pin),
+                             _x_sensitivity(0), _g_sensitivity(0)
 {
     assert (i2c);
     _dev_spi = NULL;
@@ -132,6 +134,12 @@ int LSM6DSLSensor::init(void *init)
   _g_last_odr = 104.0f;
 
   _g_is_enabled = 0;
+
+  /* Cache the sensitivities so that reading the axes needs no register access */
+  if ( get_x_sensitivity( &_x_sensitivity ) == 1 || get_g_sensitivity( &_g_sensitivity ) == 1 )
+  {
+    return 1;
+  }
   
   return 0;
 }
@@ -321,6 +329,41 @@ int LSM6DSLSensor::get_g_axes(int32_t *pData)
   return 0;
 }
 
+/**
+ * @brief  Read data from LSM6DSL Accelerometer and Gyroscope in one bus transaction
+ * @param  pAcc the pointer where the accelerometer data are stored, in mg
+ * @param  pGyro the pointer where the gyroscope data are stored, in mdps
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM6DSLSensor::get_x_g_axes(int32_t *pAcc, int32_t *pGyro)
+{
+  int16_t accRaw[3];
+  int16_t gyroRaw[3];
+  float accSensitivity = 0;
+  float gyroSensitivity = 0;
+  
+  /* Read raw data from LSM6DSL output registers. */
+  if ( get_x_g_axes_raw( accRaw, gyroRaw ) == 1 )
+  {
+    return 1;
+  }
+  
+  /* Get LSM6DSL actual sensitivities. */
+  if ( get_x_sensitivity( &accSensitivity ) == 1 || get_g_sensitivity( &gyroSensitivity ) == 1 )
+  {
+    return 1;
+  }
+  
+  /* Calculate the data. */
+  for ( int i = 0; i < 3; i++ )
+  {
+    pAcc[i] = ( int32_t )( accRaw[i] * accSensitivity );
+    pGyro[i] = ( int32_t )( gyroRaw[i] * gyroSensitivity );
+  }
+  
+  return 0;
+}
+
 /**
  * @brief  Read Accelerometer Sensitivity
  * @param  pfData the pointer where the accelerometer sensitivity is stored
@@ -330,6 +373,13 @@ int LSM6DSLSensor::get_x_sensitivity(float *pfData)
 {
   LSM6DSL_ACC_GYRO_FS_XL_t fullScale;
   
+  /* Use the cached value when the full scale has not changed. */
+  if ( _x_sensitivity > 0 )
+  {
+    *pfData = _x_sensitivity;
+    return 0;
+  }
+  
   /* Read actual full scale selection from sensor. */
   if ( LSM6DSL_ACC_GYRO_R_FS_XL( (void *)this, &fullScale ) == MEMS_ERROR )
   {
@@ -356,6 +406,8 @@ int LSM6DSLSensor::get_x_sensitivity(float *pfData)
       return 1;
   }
   
+  _x_sensitivity = *pfData;
+  
   return 0;
 }
 
@@ -369,6 +421,13 @@ int LSM6DSLSensor::get_g_sensitivity(float *pfData)
   LSM6DSL_ACC_GYRO_FS_125_t fullScale125;
   LSM6DSL_ACC_GYRO_FS_G_t   fullScale;
   
+  /* Use the cached value when the full scale has not changed. */
+  if ( _g_sensitivity > 0 )
+  {
+    *pfData = _g_sensitivity;
+    return 0;
+  }
+  
   /* Read full scale 125 selection from sensor. */
   if ( LSM6DSL_ACC_GYRO_R_FS_125( (void *)this, &fullScale125 ) == MEMS_ERROR )
   {
@@ -410,6 +469,8 @@ int LSM6DSLSensor::get_g_sensitivity(float *pfData)
     }
   }
   
+  _g_sensitivity = *pfData;
+  
   return 0;
 }
 
@@ -459,6 +520,32 @@ int LSM6DSLSensor::get_g_axes_raw(int16_t *pData)
   return 0;
 }
 
+/**
+ * @brief  Read raw data from LSM6DSL Accelerometer and Gyroscope in one bus transaction
+ * @param  pAcc the pointer where the accelerometer raw data are stored
+ * @param  pGyro the pointer where the gyroscope raw data are stored
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM6DSLSensor::get_x_g_axes_raw(int16_t *pAcc, int16_t *pGyro)
+{
+  uint8_t regValue[12];
+  
+  /* Read output registers from LSM6DSL_ACC_GYRO_OUTX_L_G to LSM6DSL_ACC_GYRO_OUTZ_H_XL. */
+  if ( LSM6DSL_ACC_GYRO_GetRawAccGyroData( (void *)this, regValue ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  /* Format the data, gyroscope registers come first. */
+  for ( int i = 0; i < 3; i++ )
+  {
+    pGyro[i] = ( ( ( ( int16_t )regValue[2 * i + 1] ) << 8 ) + ( int16_t )regValue[2 * i] );
+    pAcc[i] = ( ( ( ( int16_t )regValue[2 * i + 7] ) << 8 ) + ( int16_t )regValue[2 * i + 6] );
+  }
+  
+  return 0;
+}
+
 /**
  * @brief  Read LSM6DSL Accelerometer output data rate
  * @param  odr the pointer to the output data rate
@@ -819,6 +906,8 @@ int LSM6DSLSensor::set_x_fs(float fullScale)
          : ( fullScale <= 4.0f ) ? LSM6DSL_ACC_GYRO_FS_XL_4g
          : ( fullScale <= 8.0f ) ? LSM6DSL_ACC_GYRO_FS_XL_8g
          :                         LSM6DSL_ACC_GYRO_FS_XL_16g;
+  
+  _x_sensitivity = 0;
            
   if ( LSM6DSL_ACC_GYRO_W_FS_XL( (void *)this, new_fs ) == MEMS_ERROR )
   {
@@ -837,6 +926,8 @@ int LSM6DSLSensor::set_g_fs(float fullScale)
 {
   LSM6DSL_ACC_GYRO_FS_G_t new_fs;
   
+  _g_sensitivity = 0;
+  
   if ( fullScale <= 125.0f )
   {
     if ( LSM6DSL_ACC_GYRO_W_FS_125( (void *)this, LSM6DSL_ACC_GYRO_FS_125_ENABLED ) == MEMS_ERROR )
@@ -864,6 +955,269 @@ int LSM6DSLSensor::set_g_fs(float fullScale)
   return 0;
 }
 
+/**
+ * @brief  Set the FIFO output data rate
+ * @param  odr the output data rate to be set
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM6DSLSensor::set_fifo_odr(float odr)
+{
+  LSM6DSL_ACC_GYRO_ODR_FIFO_t new_odr;
+  
+  new_odr = ( odr <=   13.0f ) ? LSM6DSL_ACC_GYRO_ODR_FIFO_10Hz
+          : ( odr <=   26.0f ) ? LSM6DSL_ACC_GYRO_ODR_FIFO_25Hz
+          : ( odr <=   52.0f ) ? LSM6DSL_ACC_GYRO_ODR_FIFO_50Hz
+          : ( odr <=  104.0f ) ? LSM6DSL_ACC_GYRO_ODR_FIFO_100Hz
+          : ( odr <=  208.0f ) ? LSM6DSL_ACC_GYRO_ODR_FIFO_200Hz
+          : ( odr <=  416.0f ) ? LSM6DSL_ACC_GYRO_ODR_FIFO_400Hz
+          : ( odr <=  833.0f ) ? LSM6DSL_ACC_GYRO_ODR_FIFO_800Hz
+          : ( odr <= 1660.0f ) ? LSM6DSL_ACC_GYRO_ODR_FIFO_1600Hz
+          : ( odr <= 3330.0f ) ? LSM6DSL_ACC_GYRO_ODR_FIFO_3300Hz
+          :                      LSM6DSL_ACC_GYRO_ODR_FIFO_6600Hz;
+            
+  if ( LSM6DSL_ACC_GYRO_W_ODR_FIFO( (void *)this, new_odr ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Set the FIFO mode
+ * @param  mode the FIFO mode, one of LSM6DSL_ACC_GYRO_FIFO_MODE_t
+ * @retval 0 in case of success, an error code otherwise
+ * @note   Switching to bypass mode empties the FIFO
+ */
+int LSM6DSLSensor::set_fifo_mode(uint8_t mode)
+{
+  if ( LSM6DSL_ACC_GYRO_W_FIFO_MODE( (void *)this, (LSM6DSL_ACC_GYRO_FIFO_MODE_t)mode ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Set the accelerometer FIFO decimation
+ * @param  decimation 0 to keep the accelerometer out of the FIFO, 1 for no
+ *         decimation, or 2, 3, 4, 8, 16, 32
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM6DSLSensor::set_fifo_x_decimation(uint8_t decimation)
+{
+  LSM6DSL_ACC_GYRO_DEC_FIFO_XL_t new_dec;
+  
+  switch( decimation )
+  {
+    case 0:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_XL_DATA_NOT_IN_FIFO;
+      break;
+    case 1:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_XL_NO_DECIMATION;
+      break;
+    case 2:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_XL_DECIMATION_BY_2;
+      break;
+    case 3:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_XL_DECIMATION_BY_3;
+      break;
+    case 4:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_XL_DECIMATION_BY_4;
+      break;
+    case 8:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_XL_DECIMATION_BY_8;
+      break;
+    case 16:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_XL_DECIMATION_BY_16;
+      break;
+    case 32:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_XL_DECIMATION_BY_32;
+      break;
+    default:
+      return 1;
+  }
+  
+  if ( LSM6DSL_ACC_GYRO_W_DEC_FIFO_XL( (void *)this, new_dec ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Set the gyroscope FIFO decimation
+ * @param  decimation 0 to keep the gyroscope out of the FIFO, 1 for no
+ *         decimation, or 2, 3, 4, 8, 16, 32
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM6DSLSensor::set_fifo_g_decimation(uint8_t decimation)
+{
+  LSM6DSL_ACC_GYRO_DEC_FIFO_G_t new_dec;
+  
+  switch( decimation )
+  {
+    case 0:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_G_DATA_NOT_IN_FIFO;
+      break;
+    case 1:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_G_NO_DECIMATION;
+      break;
+    case 2:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_G_DECIMATION_BY_2;
+      break;
+    case 3:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_G_DECIMATION_BY_3;
+      break;
+    case 4:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_G_DECIMATION_BY_4;
+      break;
+    case 8:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_G_DECIMATION_BY_8;
+      break;
+    case 16:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_G_DECIMATION_BY_16;
+      break;
+    case 32:
+      new_dec = LSM6DSL_ACC_GYRO_DEC_FIFO_G_DECIMATION_BY_32;
+      break;
+    default:
+      return 1;
+  }
+  
+  if ( LSM6DSL_ACC_GYRO_W_DEC_FIFO_G( (void *)this, new_dec ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Set the FIFO watermark level
+ * @param  watermark the threshold in FIFO words (16 bit), 0 to 2047
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM6DSLSensor::set_fifo_watermark_level(uint16_t watermark)
+{
+  if ( watermark > 2047 )
+  {
+    return 1;
+  }
+  
+  if ( LSM6DSL_ACC_GYRO_W_FIFO_Watermark( (void *)this, watermark ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Route the FIFO watermark interrupt to INT1
+ * @param  status 1 to enable, 0 to disable
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM6DSLSensor::set_fifo_int1_watermark(uint8_t status)
+{
+  if ( LSM6DSL_ACC_GYRO_W_FIFO_TSHLD_on_INT1( (void *)this, status ? LSM6DSL_ACC_GYRO_INT1_FTH_ENABLED : LSM6DSL_ACC_GYRO_INT1_FTH_DISABLED ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Enable/disable the accelerometer data ready signal on INT1
+ * @param  status 1 to route it to INT1 as a pulse, 0 to disable it and go back to latched mode
+ * @retval 0 in case of success, an error code otherwise
+ * @note   In pulsed mode every new sample raises an edge even if the previous
+ *         one was not read, so no interrupt is lost when the reader falls behind
+ */
+int LSM6DSLSensor::set_int1_drdy(uint8_t status)
+{
+  if ( LSM6DSL_ACC_GYRO_W_DRDY_PULSE( (void *)this, status ? LSM6DSL_ACC_GYRO_DRDY_PULSE : LSM6DSL_ACC_GYRO_DRDY_LATCH ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  if ( LSM6DSL_ACC_GYRO_W_DRDY_XL_on_INT1( (void *)this, status ? LSM6DSL_ACC_GYRO_INT1_DRDY_XL_ENABLED : LSM6DSL_ACC_GYRO_INT1_DRDY_XL_DISABLED ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Enable/disable latched mode of the free fall, wake up, tap and 6D interrupts
+ * @param  status 1 to keep the interrupt signal and the source registers until
+ *         the source registers are read, 0 to pulse them
+ * @retval 0 in case of success, an error code otherwise
+ * @note   Latched events can be read with get_event_status() long after the
+ *         interrupt, which clears them
+ */
+int LSM6DSLSensor::set_interrupt_latch(uint8_t status)
+{
+  if ( LSM6DSL_ACC_GYRO_W_LIR( (void *)this, status ? LSM6DSL_ACC_GYRO_LIR_ENABLED : LSM6DSL_ACC_GYRO_LIR_DISABLED ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief  Read the FIFO status registers in one transaction
+ * @param  num_words the pointer where the number of unread FIFO words is stored
+ * @param  pattern the pointer where the index of the next word in the data set is stored
+ * @param  flags the pointer where the FIFO_STATUS2 flags are stored (watermark,
+ *         overrun, full and empty, see LSM6DSL_ACC_GYRO_WTM_MASK and following)
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM6DSLSensor::get_fifo_status(uint16_t *num_words, uint16_t *pattern, uint8_t *flags)
+{
+  uint8_t regValue[4];
+  
+  if ( LSM6DSL_ACC_GYRO_Get_FIFOStatus( (void *)this, regValue ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  *num_words = ( ( ( uint16_t )( regValue[1] & LSM6DSL_ACC_GYRO_DIFF_FIFO_STATUS2_MASK ) ) << 8 ) | regValue[0];
+  *pattern = ( ( ( uint16_t )( regValue[3] & LSM6DSL_ACC_GYRO_FIFO_STATUS4_PATTERN_MASK ) ) << 8 ) | regValue[2];
+  *flags = regValue[1] & ( LSM6DSL_ACC_GYRO_WTM_MASK | LSM6DSL_ACC_GYRO_OVERRUN_MASK | LSM6DSL_ACC_GYRO_FIFO_FULL_MASK | LSM6DSL_ACC_GYRO_FIFO_EMPTY_MASK );
+  
+  return 0;
+}
+
+/**
+ * @brief  Read FIFO words in one transaction
+ * @param  pData the pointer where the words are stored
+ * @param  num_words the number of words to read
+ * @retval 0 in case of success, an error code otherwise
+ */
+int LSM6DSLSensor::get_fifo_data(int16_t *pData, uint16_t num_words)
+{
+  uint8_t *regValue = ( uint8_t * )pData;
+  
+  /* Read the bytes in place, then build the words. */
+  if ( LSM6DSL_ACC_GYRO_Get_FIFODataBlock( (void *)this, regValue, num_words * 2 ) == MEMS_ERROR )
+  {
+    return 1;
+  }
+  
+  for ( uint16_t i = 0; i < num_words; i++ )
+  {
+    pData[i] = ( int16_t )( ( ( ( uint16_t )regValue[2 * i + 1] ) << 8 ) | ( uint16_t )regValue[2 * i] );
+  }
+  
+  return 0;
+}
+
 /**
  * @brief  Enable free fall detection
  * @param pin the interrupt pin to be used
@@ -879,7 +1233,7 @@ int LSM6DSLSensor::enable_free_fall_detection(LSM6DSL_Interrupt_Pin_t pin)
   }
   
   /* Full scale selection */
-  if ( LSM6DSL_ACC_GYRO_W_FS_XL( (void *)this, LSM6DSL_ACC_GYRO_FS_XL_2g ) == MEMS_ERROR )
+  if( set_x_fs(2.0f) == 1 )
   {
     return 1;
   }
@@ -2118,6 +2472,9 @@ int LSM6DSLSensor::read_reg( uint8_t reg, uint8_t *data )
  */
 int LSM6DSLSensor::write_reg( uint8_t reg, uint8_t data )
 {
+  /* Raw register access may change the full scales */
+  _x_sensitivity = 0;
+  _g_sensitivity = 0;
 
   if ( LSM6DSL_ACC_GYRO_write_reg( (void *)this, reg, &data, 1 ) == MEMS_ERROR )
   {
@@ -46,6 +46,7 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include "DevI2C.h"
+#include "DevSPI.h"
 #include "LSM6DSL_acc_gyro_driver.h"
 #include "MotionSensor.h"
 #include "GyroSensor.h"
@@ -133,10 +134,12 @@ class LSM6DSLSensor : public MotionSensor, public GyroSensor
     virtual int read_id(uint8_t *id);
     virtual int get_x_axes(int32_t *pData);
     virtual int get_g_axes(int32_t *pData);
+    int get_x_g_axes(int32_t *pAcc, int32_t *pGyro);
     virtual int get_x_sensitivity(float *pfData);
     virtual int get_g_sensitivity(float *pfData);
     virtual int get_x_axes_raw(int16_t *pData);
     virtual int get_g_axes_raw(int16_t *pData);
+    int get_x_g_axes_raw(int16_t *pAcc, int16_t *pGyro);
     virtual int get_x_odr(float *odr);
     virtual int get_g_odr(float *odr);
     virtual int set_x_odr(float odr);
@@ -149,6 +152,16 @@ class LSM6DSLSensor : public MotionSensor, public GyroSensor
     int enable_g(void);
     int disable_x(void);
     int disable_g(void);
+    int set_fifo_odr(float odr);
+    int set_fifo_mode(uint8_t mode);
+    int set_fifo_x_decimation(uint8_t decimation);
+    int set_fifo_g_decimation(uint8_t decimation);
+    int set_fifo_watermark_level(uint16_t watermark);
+    int set_fifo_int1_watermark(uint8_t status);
+    int set_int1_drdy(uint8_t status);
+    int set_interrupt_latch(uint8_t status);
+    int get_fifo_status(uint16_t *num_words, uint16_t *pattern, uint8_t *flags);
+    int get_fifo_data(int16_t *pData, uint16_t num_words);
     int enable_free_fall_detection(LSM6DSL_Interrupt_Pin_t pin = LSM6DSL_INT1_PIN);
     int disable_free_fall_detection(void);
     int set_free_fall_threshold(uint8_t thr);
@@ -187,7 +200,7 @@ class LSM6DSLSensor : public MotionSensor, public GyroSensor
      * @param  fptr An interrupt handler.
      * @retval None.
      */
-    void attach_int1_irq(void (*fptr)(void))
+    void attach_int1_irq(Callback<void()> fptr)
     {
         _int1_irq.rise(fptr);
     }
@@ -217,7 +230,7 @@ class LSM6DSLSensor : public MotionSensor, public GyroSensor
      * @param  fptr An interrupt handler.
      * @retval None.
      */
-    void attach_int2_irq(void (*fptr)(void))
+    void attach_int2_irq(Callback<void()> fptr)
     {
         _int2_irq.rise(fptr);
     }
@@ -252,22 +265,12 @@ class LSM6DSLSensor : public MotionSensor, public GyroSensor
     uint8_t io_read(uint8_t* pBuffer, uint8_t RegisterAddr, uint16_t NumByteToRead)
     {        
         if (_dev_spi) {
-        /* Write Reg Address */
-            _dev_spi->lock();
-            _cs_pin = 0;           
-            if (_spi_type == SPI4W) {            
-                _dev_spi->write(RegisterAddr | 0x80);
-                for (int i=0; i<NumByteToRead; i++) {
-                    *(pBuffer+i) = _dev_spi->write(0x00);
-                }
-            } else if (_spi_type == SPI3W){
-                /* Write RD Reg Address with RD bit*/
-                uint8_t TxByte = RegisterAddr | 0x80;    
-                _dev_spi->write((char *)&TxByte, 1, (char *)pBuffer, (int) NumByteToRead);
-            }            
-            _cs_pin = 1;
-            _dev_spi->unlock(); 
-            return 0;
+            if (_spi_type == SPI4W) {
+                /* Write RD Reg Address with RD bit, then the data, in block transfers */
+                return (uint8_t) DevSPI::spi_read_reg(_dev_spi, _cs_pin, RegisterAddr | 0x80, pBuffer, NumByteToRead);
+            }
+            /* SPI3W: Write RD Reg Address with RD bit */
+            return (uint8_t) DevSPI::spi_read_reg_3w(_dev_spi, _cs_pin, RegisterAddr | 0x80, pBuffer, NumByteToRead);
         }                       
         if (_dev_i2c) return (uint8_t) _dev_i2c->i2c_read(pBuffer, _address, RegisterAddr, NumByteToRead);
         return 1;
@@ -282,16 +285,10 @@ class LSM6DSLSensor : public MotionSensor, public GyroSensor
      */
     uint8_t io_write(uint8_t* pBuffer, uint8_t RegisterAddr, uint16_t NumByteToWrite)
     {
-        int data;   
-        if (_dev_spi) { 
-            _dev_spi->lock();
-            _cs_pin = 0;
-            data = _dev_spi->write(RegisterAddr);                    
-            _dev_spi->write((char *)pBuffer, (int) NumByteToWrite, NULL, 0);                     
-            _cs_pin = 1;                    
-            _dev_spi->unlock();
-            return data;                    
-        }        
+        if (_dev_spi) {
+            /* Write Reg Address, then the data, in block transfers */
+            return (uint8_t) DevSPI::spi_write_reg(_dev_spi, _cs_pin, RegisterAddr, pBuffer, NumByteToWrite);
+        }
         if (_dev_i2c) return (uint8_t) _dev_i2c->i2c_write(pBuffer, _address, RegisterAddr, NumByteToWrite);    
         return 1;
     }
@@ -317,6 +314,10 @@ class LSM6DSLSensor : public MotionSensor, public GyroSensor
     float _x_last_odr;
     uint8_t _g_is_enabled;
     float _g_last_odr;
+
+    /* Sensitivities for the current full scales, 0 when not read yet */
+    float _x_sensitivity;
+    float _g_sensitivity;
 };
 
 #ifdef __cplusplus
@@ -205,21 +205,9 @@ mems_status_t LSM6DSL_ACC_GYRO_R_FS_XL(void *handle, LSM6DSL_ACC_GYRO_FS_XL_t *v
 *******************************************************************************/
 mems_status_t LSM6DSL_ACC_GYRO_GetRawAccData(void *handle, u8_t *buff) 
 {
-  u8_t i, j, k;
-  u8_t numberOfByteForDimension;
-  
-  numberOfByteForDimension=6/3;
-
-  k=0;
-  for (i=0; i<3;i++ ) 
-  {
-    for (j=0; j<numberOfByteForDimension;j++ )
-    {   
-        if( !LSM6DSL_ACC_GYRO_read_reg(handle, LSM6DSL_ACC_GYRO_OUTX_L_XL+k, &buff[k], 1))
-          return MEMS_ERROR;
-        k++;    
-    }
-  }
+  /* One burst read of the 6 output registers, IF_INC is set by the sensor init */
+  if( !LSM6DSL_ACC_GYRO_read_reg(handle, LSM6DSL_ACC_GYRO_OUTX_L_XL, buff, 6))
+    return MEMS_ERROR;
 
   return MEMS_SUCCESS; 
 }
@@ -429,21 +417,25 @@ mems_status_t LSM6DSL_ACC_GYRO_R_FS_G(void *handle, LSM6DSL_ACC_GYRO_FS_G_t *val
 *******************************************************************************/
 mems_status_t LSM6DSL_ACC_GYRO_GetRawGyroData(void *handle, u8_t *buff) 
 {
-  u8_t i, j, k;
-  u8_t numberOfByteForDimension;
-  
-  numberOfByteForDimension=6/3;
+  /* One burst read of the 6 output registers, IF_INC is set by the sensor init */
+  if( !LSM6DSL_ACC_GYRO_read_reg(handle, LSM6DSL_ACC_GYRO_OUTX_L_G, buff, 6))
+    return MEMS_ERROR;
 
-  k=0;
-  for (i=0; i<3;i++ ) 
-  {
-    for (j=0; j<numberOfByteForDimension;j++ )
-    {   
-        if( !LSM6DSL_ACC_GYRO_read_reg(handle, LSM6DSL_ACC_GYRO_OUTX_L_G+k, &buff[k], 1))
-          return MEMS_ERROR;
-        k++;    
-    }
-  }
+  return MEMS_SUCCESS; 
+}
+
+/*******************************************************************************
+* Function Name  : mems_status_t LSM6DSL_ACC_GYRO_GetRawAccGyroData(u8_t *buff)
+* Description    : Read GetGyroData and GetAccData output registers in one burst
+* Input          : pointer to [u8_t], 12 bytes
+* Output         : gyroscope data in buff[0..5], accelerometer data in buff[6..11]
+* Return         : Status [MEMS_ERROR, MEMS_SUCCESS]
+*******************************************************************************/
+mems_status_t LSM6DSL_ACC_GYRO_GetRawAccGyroData(void *handle, u8_t *buff) 
+{
+  /* OUTX_L_G to OUTZ_H_XL are contiguous */
+  if( !LSM6DSL_ACC_GYRO_read_reg(handle, LSM6DSL_ACC_GYRO_OUTX_L_G, buff, 12))
+    return MEMS_ERROR;
 
   return MEMS_SUCCESS; 
 }
@@ -6164,6 +6156,38 @@ mems_status_t LSM6DSL_ACC_GYRO_Get_GetFIFOData(void *handle, u8_t *buff)
   return MEMS_SUCCESS; 
 }
 
+/*******************************************************************************
+* Function Name  : mems_status_t LSM6DSL_ACC_GYRO_Get_FIFODataBlock(u8_t *buff, u16_t len)
+* Description    : Read several FIFO words in one burst
+* Input          : pointer to [u8_t], number of bytes to read (2 per FIFO word)
+* Output         : FIFO words, low byte first
+* Return         : Status [MEMS_ERROR, MEMS_SUCCESS]
+*******************************************************************************/
+mems_status_t LSM6DSL_ACC_GYRO_Get_FIFODataBlock(void *handle, u8_t *buff, u16_t len) 
+{
+  /* With IF_INC set the address rolls back from FIFO_DATA_OUT_H to
+     FIFO_DATA_OUT_L, so the whole block is a single read */
+  if( !LSM6DSL_ACC_GYRO_read_reg(handle, LSM6DSL_ACC_GYRO_FIFO_DATA_OUT_L, buff, len))
+    return MEMS_ERROR;
+
+  return MEMS_SUCCESS; 
+}
+
+/*******************************************************************************
+* Function Name  : mems_status_t LSM6DSL_ACC_GYRO_Get_FIFOStatus(u8_t *buff)
+* Description    : Read FIFO_STATUS1 to FIFO_STATUS4 in one burst
+* Input          : pointer to [u8_t], 4 bytes
+* Output         : number of unread words, flags and pattern as in FIFO_STATUS1..4
+* Return         : Status [MEMS_ERROR, MEMS_SUCCESS]
+*******************************************************************************/
+mems_status_t LSM6DSL_ACC_GYRO_Get_FIFOStatus(void *handle, u8_t *buff) 
+{
+  if( !LSM6DSL_ACC_GYRO_read_reg(handle, LSM6DSL_ACC_GYRO_FIFO_STATUS1, buff, 4))
+    return MEMS_ERROR;
+
+  return MEMS_SUCCESS; 
+}
+
 /*******************************************************************************
 * Function Name  : mems_status_t LSM6DSL_ACC_GYRO_Get_GetTimestamp(u8_t *buff)
 * Description    : Read GetTimestamp output register
@@ -386,6 +386,13 @@ mems_status_t LSM6DSL_ACC_GYRO_translate_ODR_G(LSM6DSL_ACC_GYRO_ODR_G_t value, u
 mems_status_t LSM6DSL_ACC_GYRO_GetRawGyroData(void *handle, u8_t *buff); 
 mems_status_t LSM6DSL_ACC_Get_AngularRate(void *handle, int *buff, u8_t from_fifo);
 
+/*******************************************************************************
+* Register      : <REGISTER_L> - <REGISTER_H>
+* Output Type   : GetGyroData followed by GetAccData
+* Permission    : RO 
+*******************************************************************************/
+mems_status_t LSM6DSL_ACC_GYRO_GetRawAccGyroData(void *handle, u8_t *buff); 
+
 /*******************************************************************************
 * Register      : CTRL1_XL
 * Address       : 0X10
@@ -2711,6 +2718,20 @@ mems_status_t LSM6DSL_ACC_Get_Acceleration(void *handle, int *buff, u8_t from_fi
 * Permission    : RO 
 *******************************************************************************/
 mems_status_t LSM6DSL_ACC_GYRO_Get_GetFIFOData(void *handle, u8_t *buff); 
+
+/*******************************************************************************
+* Register      : FIFO_DATA_OUT_L - FIFO_DATA_OUT_H
+* Output Type   : GetFIFODataBlock
+* Permission    : RO 
+*******************************************************************************/
+mems_status_t LSM6DSL_ACC_GYRO_Get_FIFODataBlock(void *handle, u8_t *buff, u16_t len); 
+
+/*******************************************************************************
+* Register      : FIFO_STATUS1 - FIFO_STATUS4
+* Output Type   : GetFIFOStatus
+* Permission    : RO 
+*******************************************************************************/
+mems_status_t LSM6DSL_ACC_GYRO_Get_FIFOStatus(void *handle, u8_t *buff); 
 /*******************************************************************************
 * Register      : <REGISTER_L> - <REGISTER_H>
 * Output Type   : GetTimestamp
@@ -0,0 +1,311 @@
+/**
+ ******************************************************************************
+ * @file    LSM6DSLStream.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   FIFO streaming of LSM6DSL accelerometer and gyroscope samples.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "LSM6DSLStream.h"
+
+#if (LSM6DSL_STREAM_RING_SIZE & (LSM6DSL_STREAM_RING_SIZE - 1)) != 0
+#error "LSM6DSL_STREAM_RING_SIZE must be a power of two"
+#endif
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** Constructor
+ * @brief	Creates a stream on an initialized sensor.
+ * @param	Sensor, with the accelerometer and gyroscope enabled
+ * @param	true if the sensor INT1 pin is connected
+ */
+LSM6DSLStream::LSM6DSLStream(LSM6DSLSensor *sensor, bool use_int1) :
+        sensor(sensor), use_int1(use_int1),
+        thread(osPriorityAboveNormal, LSM6DSL_STREAM_STACK_SIZE),
+        queue(4 * EVENTS_EVENT_SIZE), thread_started(false),
+        block(0), watermark(0), running(false), drain_pending(false), ready_pending(false),
+        lost(0), overruns(0), head(0), tail(0) {
+}
+
+/** Destructor
+ * @brief	Stops streaming and the stream thread.
+ */
+LSM6DSLStream::~LSM6DSLStream() {
+    stop();
+    if (thread_started) {
+        queue.break_dispatch();
+        thread.join();
+    }
+}
+
+/** start
+ * @brief	Configures the FIFO and starts streaming.
+ * @param	Output data rate of both sensors in Hz
+ * @param	FIFO decimation applied to both sensors: 1, 2, 3, 4, 8, 16 or 32
+ * @param	Number of samples per block passed to the consumer
+ * @param	Called from the stream thread when a block is waiting
+ * @return	0 on success, 1 on a sensor error, 2 on an invalid argument
+ */
+int LSM6DSLStream::start(float odr, uint8_t decimation, uint16_t block, Callback<void()> ready) {
+    if (decimation == 0 || block == 0 || block > LSM6DSL_STREAM_RING_SIZE) {
+        return 2;
+    }
+
+    stop();
+
+    this->ready = ready;
+    this->block = block;
+    watermark = block < LSM6DSL_STREAM_WATERMARK_MAX ? block : LSM6DSL_STREAM_WATERMARK_MAX;
+    tail = head;
+    ready_pending = false;
+
+    // Bypass mode empties the FIFO; both sensors share the rate so that every
+    // data set is a gyroscope sample followed by an accelerometer sample
+    if (sensor->set_fifo_mode(LSM6DSL_ACC_GYRO_FIFO_MODE_BYPASS) ||
+        sensor->set_x_odr(odr) || sensor->set_g_odr(odr) ||
+        sensor->set_fifo_x_decimation(decimation) || sensor->set_fifo_g_decimation(decimation) ||
+        sensor->set_fifo_odr(odr) ||
+        sensor->set_fifo_watermark_level(watermark * LSM6DSL_STREAM_AXES)) {
+        return 1;
+    }
+
+    if (!thread_started) {
+        if (thread.start(callback(&queue, &EventQueue::dispatch_forever)) != osOK) {
+            return 1;
+        }
+        thread_started = true;
+    }
+
+    running = true;
+
+    if (use_int1) {
+        if (sensor->set_fifo_int1_watermark(1)) {
+            running = false;
+            return 1;
+        }
+        sensor->attach_int1_irq(callback(this, &LSM6DSLStream::interrupt));
+        sensor->enable_int1_irq();
+    } else {
+        // Poll twice per watermark period
+        float period = (float)watermark * decimation / odr / 2;
+        ticker.attach(callback(this, &LSM6DSLStream::interrupt), period);
+    }
+
+    if (sensor->set_fifo_mode(LSM6DSL_ACC_GYRO_FIFO_MODE_STREAM)) {
+        stop();
+        return 1;
+    }
+
+    return 0;
+}
+
+/** stop
+ * @brief	Stops streaming and returns the FIFO to bypass mode.
+ * @return	0 on success, 1 on a sensor error
+ */
+int LSM6DSLStream::stop() {
+    if (!running) {
+        return 0;
+    }
+
+    running = false;
+
+    if (use_int1) {
+        sensor->disable_int1_irq();
+        sensor->set_fifo_int1_watermark(0);
+    } else {
+        ticker.detach();
+    }
+
+    return sensor->set_fifo_mode(LSM6DSL_ACC_GYRO_FIFO_MODE_BYPASS);
+}
+
+/** is_running
+ * @brief	Checks whether the stream is started.
+ * @return	true while streaming
+ */
+bool LSM6DSLStream::is_running() {
+    return running;
+}
+
+/** acknowledge
+ * @brief	Allows the next ready callback, called by the consumer before
+ *          it reads the waiting blocks.
+ */
+void LSM6DSLStream::acknowledge() {
+    ready_pending = false;
+}
+
+/** count
+ * @brief	Returns the number of samples waiting.
+ * @return	Number of samples
+ */
+size_t LSM6DSLStream::count() {
+    return head - tail;
+}
+
+/** read
+ * @brief	Removes the oldest samples, called by the consumer.
+ * @param	Destination, LSM6DSL_STREAM_AXES raw values per sample
+ * @param	Largest number of samples to read
+ * @return	Number of samples read
+ */
+size_t LSM6DSLStream::read(int16_t *data, size_t samples) {
+    uint32_t t = tail;
+    size_t n = head - t;
+
+    if (n > samples) {
+        n = samples;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        memcpy(data + i * LSM6DSL_STREAM_AXES, ring[(t + i) & (LSM6DSL_STREAM_RING_SIZE - 1)],
+               sizeof(ring[0]));
+    }
+
+    // The samples must be copied before the stream thread can reuse their slots
+    __DMB();
+    tail = t + n;
+    return n;
+}
+
+/** get_lost
+ * @brief	Returns the number of samples dropped because the ring was full.
+ * @return	Number of samples since the stream was created
+ */
+uint32_t LSM6DSLStream::get_lost() {
+    return lost;
+}
+
+/** get_overruns
+ * @brief	Returns how many times the hardware FIFO was found overrun.
+ * @return	Number of overruns since the stream was created
+ */
+uint32_t LSM6DSLStream::get_overruns() {
+    return overruns;
+}
+
+/** interrupt
+ * @brief	Watermark interrupt or poll tick, schedules a drain.
+ */
+void LSM6DSLStream::interrupt() {
+    if (!drain_pending) {
+        drain_pending = true;
+        queue.call(this, &LSM6DSLStream::drain);
+    }
+}
+
+/** drain
+ * @brief	Reads the FIFO down below the watermark, on the stream thread.
+ */
+void LSM6DSLStream::drain() {
+    // Cleared first: an edge while draining schedules another pass
+    drain_pending = false;
+
+    bool drained = false;
+
+    while (running) {
+        uint16_t words, pattern;
+        uint8_t flags;
+
+        if (sensor->get_fifo_status(&words, &pattern, &flags)) {
+            break;
+        }
+
+        if (flags & LSM6DSL_ACC_GYRO_OVERRUN_MASK) {
+            overruns++;
+        }
+
+        // After an overrun the oldest data set may be partly overwritten;
+        // drop words up to the next gyroscope x
+        if (pattern != 0) {
+            uint16_t skip = LSM6DSL_STREAM_AXES - pattern;
+            if (skip > words || sensor->get_fifo_data(chunk, skip)) {
+                break;
+            }
+            words -= skip;
+        }
+
+        // Read everything that is there; once the FIFO has been emptied and is
+        // below the watermark, INT1 is low again and the next edge restarts us
+        uint16_t samples = words / LSM6DSL_STREAM_AXES;
+        if (samples == 0 || (drained && samples < watermark)) {
+            break;
+        }
+
+        if (samples > LSM6DSL_STREAM_CHUNK) {
+            samples = LSM6DSL_STREAM_CHUNK;
+        } else {
+            drained = true;
+        }
+
+        if (sensor->get_fifo_data(chunk, samples * LSM6DSL_STREAM_AXES)) {
+            break;
+        }
+
+        for (uint16_t i = 0; i < samples; i++) {
+            push(chunk + i * LSM6DSL_STREAM_AXES);
+        }
+
+        if (count() >= block && !ready_pending) {
+            ready_pending = true;
+            ready();
+        }
+    }
+}
+
+/** push
+ * @brief	Adds one FIFO data set to the ring, on the stream thread.
+ * @param	Gyroscope x, y, z followed by accelerometer x, y, z
+ */
+void LSM6DSLStream::push(const int16_t *words) {
+    uint32_t h = head;
+
+    if (h - tail == LSM6DSL_STREAM_RING_SIZE) {
+        lost++;
+        return;
+    }
+
+    int16_t *sample = ring[h & (LSM6DSL_STREAM_RING_SIZE - 1)];
+    sample[0] = words[3];
+    sample[1] = words[4];
+    sample[2] = words[5];
+    sample[3] = words[0];
+    sample[4] = words[1];
+    sample[5] = words[2];
+
+    // The sample must be stored before the consumer can see the new head
+    __DMB();
+    head = h + 1;
+}
@@ -0,0 +1,136 @@
+/**
+ ******************************************************************************
+ * @file    LSM6DSLStream.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   FIFO streaming of LSM6DSL accelerometer and gyroscope samples.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __LSM6DSL_STREAM_H__
+#define __LSM6DSL_STREAM_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "mbed.h"
+#include "LSM6DSLSensor.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Number of samples held between the FIFO and JavaScript, must be a power of two. */
+#ifndef LSM6DSL_STREAM_RING_SIZE
+#define LSM6DSL_STREAM_RING_SIZE    512
+#endif
+
+/** Largest number of samples read from the FIFO in one bus transaction. */
+#ifndef LSM6DSL_STREAM_CHUNK
+#define LSM6DSL_STREAM_CHUNK        32
+#endif
+
+/** Stack size of the thread draining the FIFO. */
+#ifndef LSM6DSL_STREAM_STACK_SIZE
+#define LSM6DSL_STREAM_STACK_SIZE   1024
+#endif
+
+/** Values per sample: accelerometer x, y, z then gyroscope x, y, z. */
+#define LSM6DSL_STREAM_AXES         6
+
+/** Highest watermark in samples, half of the 4 kB FIFO. */
+#define LSM6DSL_STREAM_WATERMARK_MAX    170
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Streams accelerometer and gyroscope samples through the LSM6DSL FIFO.
+ *
+ * The FIFO watermark interrupt on INT1 (or a ticker when INT1 is not wired)
+ * wakes a dedicated thread, which reads the FIFO in bursts into a sample
+ * ring. The ready callback is called from that thread when a block of
+ * samples is waiting; the consumer calls acknowledge() and read() from its
+ * own thread. Draining does not depend on the JavaScript thread, so the
+ * ring absorbs garbage collection pauses and slow callbacks.
+ */
+class LSM6DSLStream {
+public:
+    /* Constructor and destructor. */
+    LSM6DSLStream(LSM6DSLSensor *sensor, bool use_int1);
+    ~LSM6DSLStream();
+
+    /* Control. */
+    int start(float odr, uint8_t decimation, uint16_t block, Callback<void()> ready);
+    int stop();
+    bool is_running();
+
+    /* Consumer side. */
+    void acknowledge();
+    size_t count();
+    size_t read(int16_t *data, size_t samples);
+    uint32_t get_lost();
+    uint32_t get_overruns();
+
+private:
+    void interrupt();
+    void drain();
+    void push(const int16_t *words);
+
+    LSM6DSLSensor *sensor;
+    bool use_int1;
+
+    Thread thread;
+    EventQueue queue;
+    Ticker ticker;
+    bool thread_started;
+
+    Callback<void()> ready;
+    uint16_t block;
+    uint16_t watermark;
+
+    volatile bool running;
+    volatile bool drain_pending;
+    volatile bool ready_pending;
+
+    /* Statistics, written by the stream thread only. */
+    volatile uint32_t lost;
+    volatile uint32_t overruns;
+
+    /* Burst buffer, used by the stream thread only. */
+    int16_t chunk[LSM6DSL_STREAM_CHUNK * LSM6DSL_STREAM_AXES];
+
+    /* Sample ring; head is written by the stream thread, tail by the consumer. */
+    int16_t ring[LSM6DSL_STREAM_RING_SIZE][LSM6DSL_STREAM_AXES];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+};
+
+#endif // __LSM6DSL_STREAM_H__
@@ -44,6 +44,7 @@
 
 // Load the library that we'll wrap
 #include "LSM6DSL_JS.h"
+#include "JsValueArray.h"
 
 #include "mbed.h"
 
@@ -216,7 +217,7 @@ DECLARE_CLASS_FUNCTION(LSM6DSL_JS, get_accelerometer_axes) {
     LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
  
     // Get the result from the C++ API
-    char *result = new char[128];
+    char result[128];
     native_ptr->get_accelerometer_axes_json(result);
     
     // Cast it back to JavaScript
@@ -224,9 +225,6 @@ DECLARE_CLASS_FUNCTION(LSM6DSL_JS, get_accelerometer_axes) {
     
     //mbed::Serial pc((PinName)0x2C, (PinName)0x32);
     //printf("accele: %s\n", result);
-   
-    // Recycle the result from function
-    delete result;
 
     // Return the output
     return out;
@@ -254,20 +252,882 @@ DECLARE_CLASS_FUNCTION(LSM6DSL_JS, get_gyroscope_axes) {
     LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
  
     // Get the result from the C++ API
-    char *result = new char[128];
+    char result[128];
     native_ptr->get_gyroscope_axes_json(result);
     
     // Cast it back to JavaScript
     jerry_value_t out = jerry_create_string((unsigned char *)result);
-    
-    // Recycle the result from function
-    delete result;
 
     // Return the output
     return out;
 }
 
 
+/**
+ * LSM6DSL_JS#start_fifo (native JavaScript method)
+ * @brief   Streams accelerometer and gyroscope samples through the FIFO
+ * @param   Output data rate in Hz
+ * @param   FIFO decimation: 1, 2, 3, 4, 8, 16 or 32
+ * @param   Number of samples per block
+ * @param   Callback, called with an array of [ax, ay, az, gx, gy, gz, ...]
+ *          in mg and mdps, the number of samples dropped and whether the
+ *          hardware FIFO overran since the previous block
+ * @returns 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, start_fifo) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, start_fifo, (args_count == 4));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM6DSL_JS, start_fifo, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM6DSL_JS, start_fifo, 1, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM6DSL_JS, start_fifo, 2, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM6DSL_JS, start_fifo, 3, function);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    float odr = jerry_get_number_value(args[0]);
+    int decimation = jerry_get_number_value(args[1]);
+    int block = jerry_get_number_value(args[2]);
+
+    if (decimation < 0 || decimation > 255 || block < 0 || block > 65535) {
+        return jerry_create_number(2);
+    }
+
+    // Call the native function
+    int result = native_ptr->start_fifo(odr, (uint8_t)decimation, (uint16_t)block, this_obj, args[3]);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#stop_fifo (native JavaScript method)
+ * @brief   Stops FIFO streaming
+ * @returns 0 on success, 1 on a sensor error
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, stop_fifo) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, stop_fifo, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->stop_fifo();
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#onDataReady (native JavaScript method)
+ * @brief   Calls a function each time a new sample is ready on INT1, or
+ *          stops the events when called without arguments
+ * @param   Callback, called with an array of [ax, ay, az, gx, gy, gz] in
+ *          mg and mdps and the number of data-ready interrupts since the
+ *          previous call, more than 1 when samples were skipped
+ * @returns 0 on success, 1 on a sensor error, 2 if no INT1 pin was given,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, onDataReady) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, onDataReady, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM6DSL_JS, onDataReady, 0, function, args_count == 1);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = (args_count == 1) ? native_ptr->on_data_ready(this_obj, args[0])
+                                   : native_ptr->stop_data_ready();
+
+    return jerry_create_number(result);
+}
+
+
+/**
+ * LSM6DSL_JS#get_accelerometer_axes_into (native JavaScript method)
+ * @brief   Writes the accelerometer x, y, z in mg into an array
+ * @param   Array or TypedArray the values are written to
+ * @param   Optional index of the first value, 0 by default
+ * @returns Index following the last value written, or -1 if the values do not fit
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, get_accelerometer_axes_into) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, get_accelerometer_axes_into, (args_count == 1 || args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM6DSL_JS, get_accelerometer_axes_into, 0, object);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM6DSL_JS, get_accelerometer_axes_into, 1, number, args_count == 2);
+
+    if (!js_value_array_is_valid(args[0])) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Target must be an Array or a TypedArray");
+    }
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    uint32_t offset = 0;
+    if (args_count == 2 && !js_value_array_get_offset(args[1], 3, &offset)) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Offset must be a non-negative integer index");
+    }
+
+    // Get the result from the C++ API
+    int32_t axes[3];
+    native_ptr->get_accelerometer_axes(axes);
+
+    // Write it to the caller's array
+    return jerry_create_number(js_value_array_write(args[0], offset, axes, 3));
+}
+
+/**
+ * LSM6DSL_JS#get_gyroscope_axes_into (native JavaScript method)
+ * @brief   Writes the gyroscope x, y, z in mdps into an array
+ * @param   Array or TypedArray the values are written to
+ * @param   Optional index of the first value, 0 by default
+ * @returns Index following the last value written, or -1 if the values do not fit
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, get_gyroscope_axes_into) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, get_gyroscope_axes_into, (args_count == 1 || args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM6DSL_JS, get_gyroscope_axes_into, 0, object);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM6DSL_JS, get_gyroscope_axes_into, 1, number, args_count == 2);
+
+    if (!js_value_array_is_valid(args[0])) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Target must be an Array or a TypedArray");
+    }
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    uint32_t offset = 0;
+    if (args_count == 2 && !js_value_array_get_offset(args[1], 3, &offset)) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Offset must be a non-negative integer index");
+    }
+
+    // Get the result from the C++ API
+    int32_t axes[3];
+    native_ptr->get_gyroscope_axes(axes);
+
+    // Write it to the caller's array
+    return jerry_create_number(js_value_array_write(args[0], offset, axes, 3));
+}
+
+/**
+ * LSM6DSL_JS#enable_pedometer (native JavaScript method)
+ * @brief   Enables the pedometer on INT1; sets its own accelerometer
+ *          rate and full scale
+ * @returns 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, enable_pedometer) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, enable_pedometer, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->enable_event(LSM6DSL_JS_STEP, 1);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#disable_pedometer (native JavaScript method)
+ * @brief   Disables the pedometer
+ * @returns 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, disable_pedometer) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, disable_pedometer, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->disable_event(LSM6DSL_JS_STEP);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#enable_free_fall_detection (native JavaScript method)
+ * @brief   Enables free fall detection and routes it to an interrupt pin
+ *          of the sensor; sets its own accelerometer rate and full scale
+ * @param   Optional interrupt pin, 1 or 2, INT1 by default
+ * @returns 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, enable_free_fall_detection) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, enable_free_fall_detection, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM6DSL_JS, enable_free_fall_detection, 0, number, args_count == 1);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int pin = (args_count == 1) ? jerry_get_number_value(args[0]) : 0;
+    int result = (pin < 0 || pin > 2) ? 2 : native_ptr->enable_event(LSM6DSL_JS_FREE_FALL, pin);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#disable_free_fall_detection (native JavaScript method)
+ * @brief   Disables free fall detection
+ * @returns 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, disable_free_fall_detection) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, disable_free_fall_detection, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->disable_event(LSM6DSL_JS_FREE_FALL);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#enable_single_tap_detection (native JavaScript method)
+ * @brief   Enables single tap detection and routes it to an interrupt pin
+ *          of the sensor; sets its own accelerometer rate and full scale
+ * @param   Optional interrupt pin, 1 or 2, INT1 by default
+ * @returns 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, enable_single_tap_detection) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, enable_single_tap_detection, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM6DSL_JS, enable_single_tap_detection, 0, number, args_count == 1);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int pin = (args_count == 1) ? jerry_get_number_value(args[0]) : 0;
+    int result = (pin < 0 || pin > 2) ? 2 : native_ptr->enable_event(LSM6DSL_JS_SINGLE_TAP, pin);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#disable_single_tap_detection (native JavaScript method)
+ * @brief   Disables single tap detection
+ * @returns 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, disable_single_tap_detection) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, disable_single_tap_detection, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->disable_event(LSM6DSL_JS_SINGLE_TAP);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#enable_double_tap_detection (native JavaScript method)
+ * @brief   Enables double tap detection and routes it to an interrupt pin
+ *          of the sensor; sets its own accelerometer rate and full scale
+ * @param   Optional interrupt pin, 1 or 2, INT1 by default
+ * @returns 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, enable_double_tap_detection) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, enable_double_tap_detection, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM6DSL_JS, enable_double_tap_detection, 0, number, args_count == 1);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int pin = (args_count == 1) ? jerry_get_number_value(args[0]) : 0;
+    int result = (pin < 0 || pin > 2) ? 2 : native_ptr->enable_event(LSM6DSL_JS_DOUBLE_TAP, pin);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#disable_double_tap_detection (native JavaScript method)
+ * @brief   Disables double tap detection
+ * @returns 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, disable_double_tap_detection) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, disable_double_tap_detection, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->disable_event(LSM6DSL_JS_DOUBLE_TAP);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#enable_tilt_detection (native JavaScript method)
+ * @brief   Enables tilt detection and routes it to an interrupt pin
+ *          of the sensor; sets its own accelerometer rate and full scale
+ * @param   Optional interrupt pin, 1 or 2, INT1 by default
+ * @returns 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, enable_tilt_detection) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, enable_tilt_detection, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM6DSL_JS, enable_tilt_detection, 0, number, args_count == 1);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int pin = (args_count == 1) ? jerry_get_number_value(args[0]) : 0;
+    int result = (pin < 0 || pin > 2) ? 2 : native_ptr->enable_event(LSM6DSL_JS_TILT, pin);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#disable_tilt_detection (native JavaScript method)
+ * @brief   Disables tilt detection
+ * @returns 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, disable_tilt_detection) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, disable_tilt_detection, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->disable_event(LSM6DSL_JS_TILT);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#enable_wake_up_detection (native JavaScript method)
+ * @brief   Enables wake up detection and routes it to an interrupt pin
+ *          of the sensor; sets its own accelerometer rate and full scale
+ * @param   Optional interrupt pin, 1 or 2, INT2 by default
+ * @returns 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, enable_wake_up_detection) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, enable_wake_up_detection, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM6DSL_JS, enable_wake_up_detection, 0, number, args_count == 1);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int pin = (args_count == 1) ? jerry_get_number_value(args[0]) : 0;
+    int result = (pin < 0 || pin > 2) ? 2 : native_ptr->enable_event(LSM6DSL_JS_WAKE_UP, pin);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#disable_wake_up_detection (native JavaScript method)
+ * @brief   Disables wake up detection
+ * @returns 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, disable_wake_up_detection) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, disable_wake_up_detection, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->disable_event(LSM6DSL_JS_WAKE_UP);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#enable_6d_orientation (native JavaScript method)
+ * @brief   Enables 6D orientation detection and routes it to an interrupt pin
+ *          of the sensor; sets its own accelerometer rate and full scale
+ * @param   Optional interrupt pin, 1 or 2, INT1 by default
+ * @returns 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, enable_6d_orientation) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, enable_6d_orientation, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM6DSL_JS, enable_6d_orientation, 0, number, args_count == 1);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int pin = (args_count == 1) ? jerry_get_number_value(args[0]) : 0;
+    int result = (pin < 0 || pin > 2) ? 2 : native_ptr->enable_event(LSM6DSL_JS_6D, pin);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#disable_6d_orientation (native JavaScript method)
+ * @brief   Disables 6D orientation detection
+ * @returns 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, disable_6d_orientation) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, disable_6d_orientation, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->disable_event(LSM6DSL_JS_6D);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#set_free_fall_threshold (native JavaScript method)
+ * @brief   Sets the free fall threshold
+ * @param   Threshold, 0 to 7 for 156, 219, 250, 312, 344, 406, 469
+ *          or 500 mg
+ * @returns 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, set_free_fall_threshold) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, set_free_fall_threshold, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM6DSL_JS, set_free_fall_threshold, 0, number);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int threshold = jerry_get_number_value(args[0]);
+    int result = (threshold < 0 || threshold > 255) ? 2 : native_ptr->set_event_threshold(LSM6DSL_JS_FREE_FALL, threshold);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#set_tap_threshold (native JavaScript method)
+ * @brief   Sets the single and double tap threshold
+ * @param   Threshold, 0 to 31, in 1/32 of the full scale
+ * @returns 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, set_tap_threshold) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, set_tap_threshold, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM6DSL_JS, set_tap_threshold, 0, number);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int threshold = jerry_get_number_value(args[0]);
+    int result = (threshold < 0 || threshold > 255) ? 2 : native_ptr->set_event_threshold(LSM6DSL_JS_SINGLE_TAP, threshold);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#set_wake_up_threshold (native JavaScript method)
+ * @brief   Sets the wake up threshold
+ * @param   Threshold, 0 to 63, in 1/64 of the full scale
+ * @returns 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, set_wake_up_threshold) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, set_wake_up_threshold, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM6DSL_JS, set_wake_up_threshold, 0, number);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int threshold = jerry_get_number_value(args[0]);
+    int result = (threshold < 0 || threshold > 255) ? 2 : native_ptr->set_event_threshold(LSM6DSL_JS_WAKE_UP, threshold);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#set_pedometer_threshold (native JavaScript method)
+ * @brief   Sets the pedometer threshold
+ * @param   Threshold, 0 to 31, in 32 mg
+ * @returns 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *          3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, set_pedometer_threshold) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, set_pedometer_threshold, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(LSM6DSL_JS, set_pedometer_threshold, 0, number);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int threshold = jerry_get_number_value(args[0]);
+    int result = (threshold < 0 || threshold > 255) ? 2 : native_ptr->set_event_threshold(LSM6DSL_JS_STEP, threshold);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#get_step_counter (native JavaScript method)
+ * @brief   Gets the number of steps counted by the pedometer
+ * @returns Step count, or undefined on a sensor error
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, get_step_counter) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, get_step_counter, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    uint16_t steps;
+    if (native_ptr->get_step_counter(&steps)) {
+        return jerry_create_undefined();
+    }
+
+    return jerry_create_number(steps);
+}
+
+/**
+ * LSM6DSL_JS#reset_step_counter (native JavaScript method)
+ * @brief   Resets the step counter of the pedometer
+ * @returns 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, reset_step_counter) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, reset_step_counter, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->reset_step_counter();
+
+    return jerry_create_number(result);
+}
+
+/**
+ * LSM6DSL_JS#get_6d_orientation (native JavaScript method)
+ * @brief   Gets the latest 6D orientation
+ * @returns Array of [xl, xh, yl, yh, zl, zh], 1 for the axis over the
+ *          threshold in that direction, or undefined on a sensor error
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, get_6d_orientation) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, get_6d_orientation, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    uint8_t orientation[6];
+    if (native_ptr->get_6d_orientation(orientation)) {
+        return jerry_create_undefined();
+    }
+
+    jerry_value_t out_array = jerry_create_array(6);
+    for (uint32_t i = 0; i < 6; i++) {
+        jerry_value_t val = jerry_create_number(orientation[i]);
+        jerry_release_value(jerry_set_property_by_index(out_array, i, val));
+        jerry_release_value(val);
+    }
+
+    return out_array;
+}
+
+/**
+ * LSM6DSL_JS#get_event_status (native JavaScript method)
+ * @brief   Reads and clears the status of the enabled motion engines,
+ *          to poll them without onEvent()
+ * @returns Object of the detected events, as passed to onEvent(), or
+ *          undefined on a sensor error
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, get_event_status) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, get_event_status, (args_count == 0));
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    LSM6DSL_Event_Status_t status;
+    if (native_ptr->get_event_status(&status)) {
+        return jerry_create_undefined();
+    }
+
+    return native_ptr->make_event_object(&status);
+}
+
+/**
+ * LSM6DSL_JS#onEvent (native JavaScript method)
+ * @brief   Calls a function each time an enabled motion engine raises
+ *          INT1 or INT2, or stops the events when called without arguments
+ * @param   Callback, called with an object of booleans free_fall, single_tap,
+ *          double_tap, wake_up, step, tilt and orientation_6d, with steps
+ *          when a step was detected and orientation as returned by
+ *          get_6d_orientation() when the 6D orientation changed, and the
+ *          number of interrupts since the previous call
+ * @returns 0 on success, 1 on a sensor error, 2 if no INT1 or INT2 pin was
+ *          given, 3 if the sensor is not initialized
+ */
+DECLARE_CLASS_FUNCTION(LSM6DSL_JS, onEvent) {
+    CHECK_ARGUMENT_COUNT(LSM6DSL_JS, onEvent, (args_count == 0 || args_count == 1));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(LSM6DSL_JS, onEvent, 0, function, args_count == 1);
+
+    // Unwrap native LSM6DSL_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    LSM6DSL_JS *native_ptr = static_cast<LSM6DSL_JS*>(void_ptr);
+
+    // Call the native function
+    int result = (args_count == 1) ? native_ptr->on_event(this_obj, args[0])
+                                   : native_ptr->stop_event();
+
+    return jerry_create_number(result);
+}
+
 /**
  * LSM6DSL_JS (native JavaScript constructor)
  * @brief   Constructor for Javascript wrapper
@@ -287,6 +1147,34 @@ DECLARE_CLASS_CONSTRUCTOR(LSM6DSL_JS) {
     ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, init_i2c);
     ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, get_accelerometer_axes);
     ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, get_gyroscope_axes);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, get_accelerometer_axes_into);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, get_gyroscope_axes_into);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, start_fifo);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, stop_fifo);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, onDataReady);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, enable_pedometer);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, disable_pedometer);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, enable_free_fall_detection);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, disable_free_fall_detection);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, enable_single_tap_detection);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, disable_single_tap_detection);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, enable_double_tap_detection);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, disable_double_tap_detection);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, enable_tilt_detection);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, disable_tilt_detection);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, enable_wake_up_detection);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, disable_wake_up_detection);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, enable_6d_orientation);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, disable_6d_orientation);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, set_free_fall_threshold);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, set_tap_threshold);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, set_wake_up_threshold);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, set_pedometer_threshold);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, get_step_counter);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, reset_step_counter);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, get_6d_orientation);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, get_event_status);
+    ATTACH_CLASS_FUNCTION(js_object, LSM6DSL_JS, onEvent);
     
     return js_object;
 }
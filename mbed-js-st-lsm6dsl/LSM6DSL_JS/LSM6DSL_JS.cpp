@@ -44,6 +44,9 @@
 #include <stdlib.h>     /* atof */
 #include "mbed.h"
 
+/* Samples converted per step when delivering FIFO blocks */
+#define LSM6DSL_JS_DELIVER_STEP 16
+
 /* Helper function for printing floats & doubles */
 static char *print_double(char* str, double v, int decimalDigits=2)
 {
@@ -83,28 +86,62 @@ static char *print_double(char* str, double v, int decimalDigits=2)
 /* Helper function for creating JSON for data */
 char *LSM6DSL_JS::make_json(char* str, int32_t *data, char *axes, int data_count)
 {
-	char *ptr;
-	ptr = str;
-	str[0] = 0;
+	char *ptr = str;
 
+	/* Keep a write pointer instead of rescanning the string */
+	*ptr++ = '{';
 	for(int i = 0; i < data_count; i++){
-		//printf("len: %i\n", strlen(str));
-		if(i == 0){
-			sprintf(ptr, "{");
-			ptr = &str[strlen(str)];
+		if(i != 0){
+			*ptr++ = ',';
 		}
-		else{
-			sprintf(ptr, ",");
-			ptr = &str[strlen(str)];
-		}
-		sprintf(ptr, "\"%c\":%i", axes[i], static_cast<int>(data[i]));
-		ptr = &str[strlen(str)];
-		
+		ptr += sprintf(ptr, "\"%c\":%i", axes[i], static_cast<int>(data[i]));
 	}
-	sprintf(ptr, "}");
+	*ptr++ = '}';
+	*ptr = 0;
+
 	return str;
 }
 
+/* Helper function for setting a named property of an object */
+static void set_property(jerry_value_t object, const char *name, jerry_value_t value)
+{
+	jerry_value_t key = jerry_create_string((const jerry_char_t *) name);
+	jerry_release_value(jerry_set_property(object, key, value));
+	jerry_release_value(key);
+	jerry_release_value(value);
+}
+
+/* Helper function for creating an object of the detected motion events */
+jerry_value_t LSM6DSL_JS::make_event_object(LSM6DSL_Event_Status_t *status)
+{
+	jerry_value_t out_object = jerry_create_object();
+	set_property(out_object, "free_fall", jerry_create_boolean(status->FreeFallStatus));
+	set_property(out_object, "single_tap", jerry_create_boolean(status->TapStatus));
+	set_property(out_object, "double_tap", jerry_create_boolean(status->DoubleTapStatus));
+	set_property(out_object, "wake_up", jerry_create_boolean(status->WakeUpStatus));
+	set_property(out_object, "step", jerry_create_boolean(status->StepStatus));
+	set_property(out_object, "tilt", jerry_create_boolean(status->TiltStatus));
+	set_property(out_object, "orientation_6d", jerry_create_boolean(status->D6DOrientationStatus));
+
+	uint16_t steps;
+	if(status->StepStatus && acc_gyro->get_step_counter(&steps) == 0){
+		set_property(out_object, "steps", jerry_create_number(steps));
+	}
+
+	uint8_t orientation[6];
+	if(status->D6DOrientationStatus && get_6d_orientation(orientation) == 0){
+		jerry_value_t out_array = jerry_create_array(6);
+		for(uint32_t i = 0; i < 6; i++){
+			jerry_value_t val = jerry_create_number(orientation[i]);
+			jerry_release_value(jerry_set_property_by_index(out_array, i, val));
+			jerry_release_value(val);
+		}
+		set_property(out_object, "orientation", out_array);
+	}
+
+	return out_object;
+}
+
 /* Class Implementation ------------------------------------------------------*/
 
 /** Constructor
@@ -121,6 +158,8 @@ LSM6DSL_JS::LSM6DSL_JS(DevI2C &devI2c){
  */
 void LSM6DSL_JS::init(DevI2C &devI2c){
 	acc_gyro = new LSM6DSLSensor(&devI2c, LSM6DSL_ACC_GYRO_I2C_ADDRESS_HIGH, D4, D5);
+	int1 = D4;
+	int2 = D5;
 	acc_gyro->init(NULL);
 	acc_gyro->enable_x();
 	acc_gyro->enable_g();
@@ -144,6 +183,8 @@ LSM6DSL_JS::LSM6DSL_JS(DevI2C &devI2c, PinName int1_pin, PinName int2_pin){
  */
 void LSM6DSL_JS::init(DevI2C &devI2c, PinName int1_pin, PinName int2_pin){
 	acc_gyro = new LSM6DSLSensor(&devI2c, LSM6DSL_ACC_GYRO_I2C_ADDRESS_HIGH, int1_pin, int2_pin);
+	int1 = int1_pin;
+	int2 = int2_pin;
 	acc_gyro->init(NULL);
 	acc_gyro->enable_x();
 	acc_gyro->enable_g();
@@ -169,6 +210,8 @@ LSM6DSL_JS::LSM6DSL_JS(DevI2C &devI2c, PinName int1_pin, PinName int2_pin, uint8
  */
 void LSM6DSL_JS::init(DevI2C &devI2c, PinName int1_pin, PinName int2_pin, uint8_t address){
 	acc_gyro = new LSM6DSLSensor(&devI2c, address, int1_pin, int2_pin);
+	int1 = int1_pin;
+	int2 = int2_pin;
 	acc_gyro->init(NULL);
 	acc_gyro->enable_x();
 	acc_gyro->enable_g();
@@ -219,6 +262,8 @@ LSM6DSL_JS::LSM6DSL_JS(SPI &spi, PinName cs_pin, PinName int1_pin, PinName int2_
 void LSM6DSL_JS::init(SPI &spi, PinName cs_pin, PinName int1_pin, PinName int2_pin, int spi_type){
 	//acc_gyro = new LSM6DSLSensor(&spi, PB_12, NC, PA_2, LSM6DSLSensor::SPI3W);
 	acc_gyro = new LSM6DSLSensor(&spi, cs_pin, int1_pin, int2_pin, spi_type == 3? LSM6DSLSensor::SPI3W: LSM6DSLSensor::SPI4W);
+	int1 = int1_pin;
+	int2 = int2_pin;
 	acc_gyro->init(NULL);
 	acc_gyro->enable_x();
 	acc_gyro->enable_g();
@@ -229,6 +274,9 @@ void LSM6DSL_JS::init(SPI &spi, PinName cs_pin, PinName int1_pin, PinName int2_p
  *  Deletes the Sensor Object
  */
 LSM6DSL_JS::~LSM6DSL_JS(){
+	if(stream != NULL){
+		delete stream;
+	}
 	if(acc_gyro != NULL){
 		delete acc_gyro;
 	}
@@ -250,7 +298,6 @@ uint8_t LSM6DSL_JS::readID(){
  */
 int32_t *LSM6DSL_JS::get_accelerometer_axes(int32_t *axes){
 	acc_gyro->get_x_axes(axes);
-    printf("LSM6DSL [acc/mg]:        %6ld, %6ld, %6ld\r\n", axes[0], axes[1], axes[2]);
 	return axes;
 }
 
@@ -277,7 +324,6 @@ char *LSM6DSL_JS::get_accelerometer_axes_json(char *data){
  */
 int32_t *LSM6DSL_JS::get_gyroscope_axes(int32_t * axes){
 	acc_gyro->get_g_axes(axes);
-    printf("LSM6DSL [gyro/mdps]:     %6ld, %6ld, %6ld\r\n", axes[0], axes[1], axes[2]);
     return axes;
 }
 
@@ -295,3 +341,569 @@ char *LSM6DSL_JS::get_gyroscope_axes_json(char * data){
 	
 	return data;
 }
+
+/**
+ * @brief  Get the accelerometer and gyroscope readings in one bus transaction
+ * @param  Array of 6 values: accelerometer x, y, z in mg then gyroscope
+ *         x, y, z in mdps
+ * @retval 0 on success, 1 on a sensor error, 2 if the sensor is not initialized
+ */
+int LSM6DSL_JS::get_axes(int32_t *axes){
+	if(acc_gyro == NULL){
+		return 2;
+	}
+	return acc_gyro->get_x_g_axes(axes, axes + 3) ? 1 : 0;
+}
+
+/**
+ * @brief  Start streaming accelerometer and gyroscope samples through the FIFO
+ * @param  Output data rate in Hz
+ * @param  FIFO decimation: 1, 2, 3, 4, 8, 16 or 32
+ * @param  Number of samples passed to each callback
+ * @param  JavaScript object kept alive while streaming
+ * @param  JavaScript callback, called with an array of
+ *         [ax, ay, az, gx, gy, gz, ...] in mg and mdps, the number of
+ *         samples dropped since the previous block and whether the
+ *         hardware FIFO overran since the previous block
+ * @retval 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *         3 if the sensor is not initialized
+ */
+int LSM6DSL_JS::start_fifo(float odr, uint8_t decimation, uint16_t block, jerry_value_t this_obj, jerry_value_t cb){
+	if(acc_gyro == NULL){
+		return 3;
+	}
+
+	stop_fifo();
+	stop_data_ready();
+	stop_event();
+
+	if(stream == NULL){
+		stream = new LSM6DSLStream(acc_gyro, int1 != NC);
+	}
+
+	fifo_lost = stream->get_lost();
+	fifo_overruns = stream->get_overruns();
+
+	fifo_block = block;
+
+	// Keep the object and the callback while samples may arrive, from before
+	// the stream can post a delivery
+	fifo_delivery.start(this_obj, cb);
+
+	int result = stream->start(odr, decimation, block, callback(this, &LSM6DSL_JS::fifo_ready));
+	if(result != 0){
+		stop_fifo();
+		return result;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief  Stop FIFO streaming
+ * @retval 0 on success, 1 on a sensor error
+ */
+int LSM6DSL_JS::stop_fifo(){
+	int result = 0;
+
+	if(stream != NULL){
+		result = stream->stop();
+	}
+
+	// This may release the last reference to this object, so it comes last
+	fifo_delivery.stop();
+
+	return result;
+}
+
+/**
+ * @brief  Called from the stream thread when a block is waiting
+ */
+void LSM6DSL_JS::fifo_ready(){
+	// Later blocks are read by a delivery already waiting
+	fifo_delivery.post(mbed::Callback<void()>(this, &LSM6DSL_JS::deliver_fifo));
+}
+
+/**
+ * @brief  Pass the waiting blocks to JavaScript, on the event loop
+ */
+void LSM6DSL_JS::deliver_fifo(){
+	// Stopped since this delivery was posted, this object may be freed
+	if(!fifo_delivery.begin()){
+		return;
+	}
+
+	// Allow the next notification first so that samples pushed meanwhile are not missed
+	stream->acknowledge();
+
+	float acc_sensitivity, gyro_sensitivity;
+	if(acc_gyro->get_x_sensitivity(&acc_sensitivity) || acc_gyro->get_g_sensitivity(&gyro_sensitivity)){
+		return;
+	}
+
+	// The callback may stop the stream; keep the object until we are done
+	jerry_value_t this_obj = fifo_delivery.keep();
+
+	int16_t raw[LSM6DSL_JS_DELIVER_STEP * LSM6DSL_STREAM_AXES];
+	size_t blocks = stream->count() / fifo_block;
+
+	while(blocks-- > 0 && fifo_delivery.is_started()){
+		jerry_value_t out_array = jerry_create_array(fifo_block * LSM6DSL_STREAM_AXES);
+		uint32_t index = 0;
+
+		for(size_t done = 0; done < fifo_block; ){
+			size_t step = fifo_block - done;
+			if(step > LSM6DSL_JS_DELIVER_STEP){
+				step = LSM6DSL_JS_DELIVER_STEP;
+			}
+			size_t n = stream->read(raw, step);
+
+			for(size_t i = 0; i < n * LSM6DSL_STREAM_AXES; i++){
+				float sensitivity = (i % LSM6DSL_STREAM_AXES) < 3 ? acc_sensitivity : gyro_sensitivity;
+				jerry_value_t val = jerry_create_number((int32_t)(raw[i] * sensitivity));
+				jerry_release_value(jerry_set_property_by_index(out_array, index++, val));
+				jerry_release_value(val);
+			}
+			done += n;
+		}
+
+		uint32_t lost = stream->get_lost();
+		uint32_t overruns = stream->get_overruns();
+
+		jerry_value_t args[3] = {
+			out_array,
+			jerry_create_number(lost - fifo_lost),
+			jerry_create_boolean(overruns != fifo_overruns)
+		};
+		fifo_lost = lost;
+		fifo_overruns = overruns;
+
+		fifo_delivery.call(args, 3);
+
+		jerry_release_value(args[0]);
+		jerry_release_value(args[1]);
+		jerry_release_value(args[2]);
+	}
+
+	jerry_release_value(this_obj);
+}
+
+/**
+ * @brief  Call a JavaScript function each time a new sample is ready
+ * @param  JavaScript object kept alive while events are enabled
+ * @param  JavaScript callback, called with an array of
+ *         [ax, ay, az, gx, gy, gz] in mg and mdps and the number of
+ *         data-ready interrupts since the previous call
+ * @retval 0 on success, 1 on a sensor error, 2 if no INT1 pin was given,
+ *         3 if the sensor is not initialized
+ * @note   Replaces FIFO streaming and motion events, which use the same pin
+ */
+int LSM6DSL_JS::on_data_ready(jerry_value_t this_obj, jerry_value_t cb){
+	if(acc_gyro == NULL){
+		return 3;
+	}
+	if(int1 == NC){
+		return 2;
+	}
+
+	stop_fifo();
+	stop_data_ready();
+	stop_event();
+
+	acc_gyro->attach_int1_irq(callback(this, &LSM6DSL_JS::drdy_interrupt));
+	if(acc_gyro->set_int1_drdy(1)){
+		acc_gyro->disable_int1_irq();
+		return 1;
+	}
+
+	// Keep the object and the callback while samples may arrive
+	drdy_delivery.start(this_obj, cb);
+
+	acc_gyro->enable_int1_irq();
+
+	return 0;
+}
+
+/**
+ * @brief  Stop data-ready events
+ * @retval 0 on success, 1 on a sensor error
+ */
+int LSM6DSL_JS::stop_data_ready(){
+	int result = 0;
+
+	if(drdy_delivery.is_started()){
+		acc_gyro->disable_int1_irq();
+		result = acc_gyro->set_int1_drdy(0);
+	}
+
+	// This may release the last reference to this object, so it comes last
+	drdy_delivery.stop();
+
+	return result;
+}
+
+/**
+ * @brief  INT1 handler, runs in interrupt context
+ */
+void LSM6DSL_JS::drdy_interrupt(){
+	// Later samples are coalesced into a delivery already waiting
+	drdy_delivery.post(mbed::Callback<void()>(this, &LSM6DSL_JS::deliver_drdy));
+}
+
+/**
+ * @brief  Pass the latest sample to JavaScript, on the event loop
+ */
+void LSM6DSL_JS::deliver_drdy(){
+	// Stopped since this delivery was posted, this object may be freed
+	uint32_t count;
+	if(!drdy_delivery.begin(&count)){
+		return;
+	}
+
+	int32_t values[6];
+	if(acc_gyro->get_x_g_axes(values, values + 3)){
+		return;
+	}
+
+	jerry_value_t out_array = jerry_create_array(6);
+	for(uint32_t i = 0; i < 6; i++){
+		jerry_value_t val = jerry_create_number(values[i]);
+		jerry_release_value(jerry_set_property_by_index(out_array, i, val));
+		jerry_release_value(val);
+	}
+
+	jerry_value_t args[2] = {
+		out_array,
+		jerry_create_number(count)
+	};
+
+	// The callback may stop the events and free this object
+	drdy_delivery.call(args, 2);
+
+	jerry_release_value(args[0]);
+	jerry_release_value(args[1]);
+}
+
+/**
+ * @brief  Enable an embedded motion engine and route it to an interrupt pin
+ * @param  Engine
+ * @param  Interrupt pin of the sensor, 1 or 2, or 0 for the default: INT2
+ *         for wake up, INT1 otherwise
+ * @retval 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *         3 if the sensor is not initialized
+ * @note   The engines select their own accelerometer rate and full scale
+ */
+int LSM6DSL_JS::enable_event(LSM6DSL_JS_Event_t event, uint8_t pin){
+	if(acc_gyro == NULL){
+		return 3;
+	}
+	if(pin == 0){
+		pin = (event == LSM6DSL_JS_WAKE_UP) ? 2 : 1;
+	}
+	if(pin != 1 && pin != 2){
+		return 2;
+	}
+
+	LSM6DSL_Interrupt_Pin_t int_pin = (pin == 2) ? LSM6DSL_INT2_PIN : LSM6DSL_INT1_PIN;
+	int result;
+
+	switch(event){
+		case LSM6DSL_JS_FREE_FALL:
+			result = acc_gyro->enable_free_fall_detection(int_pin);
+			break;
+		case LSM6DSL_JS_SINGLE_TAP:
+			result = acc_gyro->enable_single_tap_detection(int_pin);
+			break;
+		case LSM6DSL_JS_DOUBLE_TAP:
+			result = acc_gyro->enable_double_tap_detection(int_pin);
+			break;
+		case LSM6DSL_JS_WAKE_UP:
+			result = acc_gyro->enable_wake_up_detection(int_pin);
+			break;
+		case LSM6DSL_JS_STEP:
+			// The step detector can only be routed to INT1
+			if(pin != 1){
+				return 2;
+			}
+			result = acc_gyro->enable_pedometer();
+			break;
+		case LSM6DSL_JS_TILT:
+			result = acc_gyro->enable_tilt_detection(int_pin);
+			break;
+		case LSM6DSL_JS_6D:
+			result = acc_gyro->enable_6d_orientation(int_pin);
+			break;
+		default:
+			return 2;
+	}
+
+	return result ? 1 : 0;
+}
+
+/**
+ * @brief  Disable an embedded motion engine
+ * @param  Engine
+ * @retval 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *         3 if the sensor is not initialized
+ */
+int LSM6DSL_JS::disable_event(LSM6DSL_JS_Event_t event){
+	if(acc_gyro == NULL){
+		return 3;
+	}
+
+	int result;
+
+	switch(event){
+		case LSM6DSL_JS_FREE_FALL:
+			result = acc_gyro->disable_free_fall_detection();
+			break;
+		case LSM6DSL_JS_SINGLE_TAP:
+			result = acc_gyro->disable_single_tap_detection();
+			break;
+		case LSM6DSL_JS_DOUBLE_TAP:
+			result = acc_gyro->disable_double_tap_detection();
+			break;
+		case LSM6DSL_JS_WAKE_UP:
+			result = acc_gyro->disable_wake_up_detection();
+			break;
+		case LSM6DSL_JS_STEP:
+			result = acc_gyro->disable_pedometer();
+			break;
+		case LSM6DSL_JS_TILT:
+			result = acc_gyro->disable_tilt_detection();
+			break;
+		case LSM6DSL_JS_6D:
+			result = acc_gyro->disable_6d_orientation();
+			break;
+		default:
+			return 2;
+	}
+
+	return result ? 1 : 0;
+}
+
+/**
+ * @brief  Set the threshold of an embedded motion engine
+ * @param  Engine: free fall, single or double tap (one threshold for both),
+ *         wake up or step
+ * @param  Threshold code: 0 to 7 for free fall, 156 to 500 mg; 0 to 63 for
+ *         wake up, in 1/64 of the full scale; 0 to 31 for taps, in 1/32 of
+ *         the full scale; 0 to 31 for steps, in 32 mg
+ * @retval 0 on success, 1 on a sensor error, 2 on an invalid argument,
+ *         3 if the sensor is not initialized
+ */
+int LSM6DSL_JS::set_event_threshold(LSM6DSL_JS_Event_t event, uint8_t threshold){
+	if(acc_gyro == NULL){
+		return 3;
+	}
+
+	int result;
+
+	switch(event){
+		case LSM6DSL_JS_FREE_FALL:
+			if(threshold > 7){
+				return 2;
+			}
+			result = acc_gyro->set_free_fall_threshold(threshold);
+			break;
+		case LSM6DSL_JS_SINGLE_TAP:
+		case LSM6DSL_JS_DOUBLE_TAP:
+			if(threshold > LSM6DSL_TAP_THRESHOLD_HIGH){
+				return 2;
+			}
+			result = acc_gyro->set_tap_threshold(threshold);
+			break;
+		case LSM6DSL_JS_WAKE_UP:
+			if(threshold > LSM6DSL_WAKE_UP_THRESHOLD_HIGH){
+				return 2;
+			}
+			result = acc_gyro->set_wake_up_threshold(threshold);
+			break;
+		case LSM6DSL_JS_STEP:
+			if(threshold > LSM6DSL_PEDOMETER_THRESHOLD_HIGH){
+				return 2;
+			}
+			result = acc_gyro->set_pedometer_threshold(threshold);
+			break;
+		default:
+			return 2;
+	}
+
+	return result ? 1 : 0;
+}
+
+/**
+ * @brief  Get the number of steps counted by the pedometer
+ * @param  Step count
+ * @retval 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+int LSM6DSL_JS::get_step_counter(uint16_t *steps){
+	if(acc_gyro == NULL){
+		return 3;
+	}
+	return acc_gyro->get_step_counter(steps) ? 1 : 0;
+}
+
+/**
+ * @brief  Reset the step counter of the pedometer
+ * @retval 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+int LSM6DSL_JS::reset_step_counter(){
+	if(acc_gyro == NULL){
+		return 3;
+	}
+	return acc_gyro->reset_step_counter() ? 1 : 0;
+}
+
+/**
+ * @brief  Get the latest 6D orientation
+ * @param  Array of 6 flags: x low, x high, y low, y high, z low, z high,
+ *         1 for the axis over the threshold in that direction
+ * @retval 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+int LSM6DSL_JS::get_6d_orientation(uint8_t *orientation){
+	if(acc_gyro == NULL){
+		return 3;
+	}
+	if(acc_gyro->get_6d_orientation_xl(&orientation[0]) ||
+	   acc_gyro->get_6d_orientation_xh(&orientation[1]) ||
+	   acc_gyro->get_6d_orientation_yl(&orientation[2]) ||
+	   acc_gyro->get_6d_orientation_yh(&orientation[3]) ||
+	   acc_gyro->get_6d_orientation_zl(&orientation[4]) ||
+	   acc_gyro->get_6d_orientation_zh(&orientation[5])){
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * @brief  Read and clear the status of the enabled motion engines
+ * @param  Status
+ * @retval 0 on success, 1 on a sensor error, 3 if the sensor is not initialized
+ */
+int LSM6DSL_JS::get_event_status(LSM6DSL_Event_Status_t *status){
+	if(acc_gyro == NULL){
+		return 3;
+	}
+	return acc_gyro->get_event_status(status) ? 1 : 0;
+}
+
+/**
+ * @brief  Call a JavaScript function each time an enabled motion engine
+ *         raises INT1 or INT2
+ * @param  JavaScript object kept alive while events are enabled
+ * @param  JavaScript callback, called with an object of the detected events
+ *         and the number of interrupts since the previous call
+ * @retval 0 on success, 1 on a sensor error, 2 if no INT1 or INT2 pin was
+ *         given, 3 if the sensor is not initialized
+ * @note   Replaces FIFO streaming and data-ready events, which use INT1
+ */
+int LSM6DSL_JS::on_event(jerry_value_t this_obj, jerry_value_t cb){
+	if(acc_gyro == NULL){
+		return 3;
+	}
+	if(int1 == NC && int2 == NC){
+		return 2;
+	}
+
+	stop_fifo();
+	stop_data_ready();
+	stop_event();
+
+	// Latch the sources until they are read, so that events are not lost
+	// while JavaScript is busy, then clear the ones already latched
+	LSM6DSL_Event_Status_t status;
+	if(acc_gyro->set_interrupt_latch(1) || acc_gyro->get_event_status(&status)){
+		acc_gyro->set_interrupt_latch(0);
+		return 1;
+	}
+
+	if(int1 != NC){
+		acc_gyro->attach_int1_irq(callback(this, &LSM6DSL_JS::event_interrupt));
+	}
+	if(int2 != NC){
+		acc_gyro->attach_int2_irq(callback(this, &LSM6DSL_JS::event_interrupt));
+	}
+
+	// Keep the object and the callback while events may arrive
+	event_delivery.start(this_obj, cb);
+
+	if(int1 != NC){
+		acc_gyro->enable_int1_irq();
+	}
+	if(int2 != NC){
+		acc_gyro->enable_int2_irq();
+	}
+
+	// A source latched before the interrupts were enabled holds its pin high
+	// without an edge; read the status once so that it is released
+	event_interrupt();
+
+	return 0;
+}
+
+/**
+ * @brief  Stop motion events; the engines stay enabled
+ * @retval 0 on success, 1 on a sensor error
+ */
+int LSM6DSL_JS::stop_event(){
+	int result = 0;
+
+	if(event_delivery.is_started()){
+		if(int1 != NC){
+			acc_gyro->disable_int1_irq();
+		}
+		if(int2 != NC){
+			acc_gyro->disable_int2_irq();
+		}
+		result = acc_gyro->set_interrupt_latch(0);
+	}
+
+	// This may release the last reference to this object, so it comes last
+	event_delivery.stop();
+
+	return result;
+}
+
+/**
+ * @brief  INT1 and INT2 handler, runs in interrupt context
+ */
+void LSM6DSL_JS::event_interrupt(){
+	// Later interrupts are coalesced into a delivery already waiting
+	event_delivery.post(mbed::Callback<void()>(this, &LSM6DSL_JS::deliver_event));
+}
+
+/**
+ * @brief  Pass the detected events to JavaScript, on the event loop
+ */
+void LSM6DSL_JS::deliver_event(){
+	// Stopped since this delivery was posted, this object may be freed
+	uint32_t count;
+	if(!event_delivery.begin(&count)){
+		return;
+	}
+
+	// Reading the status releases the latched sources and their pins
+	LSM6DSL_Event_Status_t status;
+	if(acc_gyro->get_event_status(&status)){
+		return;
+	}
+
+	if(!(status.FreeFallStatus || status.TapStatus || status.DoubleTapStatus || status.WakeUpStatus ||
+	     status.StepStatus || status.TiltStatus || status.D6DOrientationStatus)){
+		return;
+	}
+
+	jerry_value_t out_object = make_event_object(&status);
+
+	jerry_value_t args[2] = {
+		out_object,
+		jerry_create_number(count)
+	};
+
+	// The callback may stop the events and free this object
+	event_delivery.call(args, 2);
+
+	jerry_release_value(args[0]);
+	jerry_release_value(args[1]);
+}
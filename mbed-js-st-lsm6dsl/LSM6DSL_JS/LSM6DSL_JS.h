@@ -47,6 +47,23 @@
 #include <stdint.h>
 #include "mbed.h"
 #include "LSM6DSLSensor.h"
+#include "LSM6DSLStream.h"
+#include "JsDelivery.h"
+
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
+
+/* Types ---------------------------------------------------------------------*/
+
+/** Embedded motion engines of the LSM6DSL. */
+typedef enum {
+    LSM6DSL_JS_FREE_FALL = 0,
+    LSM6DSL_JS_SINGLE_TAP,
+    LSM6DSL_JS_DOUBLE_TAP,
+    LSM6DSL_JS_WAKE_UP,
+    LSM6DSL_JS_STEP,
+    LSM6DSL_JS_TILT,
+    LSM6DSL_JS_6D
+} LSM6DSL_JS_Event_t;
 
 /* Class Declaration ---------------------------------------------------------*/
 
@@ -57,6 +74,30 @@ class LSM6DSL_JS {
 private:
     /* Helper classes. */
     LSM6DSLSensor *acc_gyro = NULL;
+    LSM6DSLStream *stream = NULL;
+    
+    /* FIFO streaming. */
+    PinName int1 = NC;
+    JsDelivery fifo_delivery;
+    uint16_t fifo_block = 0;
+    uint32_t fifo_lost = 0;
+    uint32_t fifo_overruns = 0;
+    
+    void fifo_ready();
+    void deliver_fifo();
+    
+    /* Data-ready events. */
+    JsDelivery drdy_delivery;
+    
+    void drdy_interrupt();
+    void deliver_drdy();
+    
+    /* Motion events. */
+    PinName int2 = NC;
+    JsDelivery event_delivery;
+    
+    void event_interrupt();
+    void deliver_event();
 
 public:
     /* Constructors */
@@ -79,11 +120,26 @@ public:
     
     /* Declarations */
     char *make_json(char* str, int32_t *data, char *axes, int data_count);
+    jerry_value_t make_event_object(LSM6DSL_Event_Status_t *status);
     uint8_t readID();
     int32_t *get_accelerometer_axes(int32_t *);
     char *get_accelerometer_axes_json(char *);
     int32_t *get_gyroscope_axes(int32_t *);
     char *get_gyroscope_axes_json(char *);
+    int get_axes(int32_t *);
+    int start_fifo(float odr, uint8_t decimation, uint16_t block, jerry_value_t this_obj, jerry_value_t cb);
+    int stop_fifo();
+    int on_data_ready(jerry_value_t this_obj, jerry_value_t cb);
+    int stop_data_ready();
+    int enable_event(LSM6DSL_JS_Event_t event, uint8_t pin);
+    int disable_event(LSM6DSL_JS_Event_t event);
+    int set_event_threshold(LSM6DSL_JS_Event_t event, uint8_t threshold);
+    int get_step_counter(uint16_t *steps);
+    int reset_step_counter();
+    int get_6d_orientation(uint8_t *orientation);
+    int get_event_status(LSM6DSL_Event_Status_t *status);
+    int on_event(jerry_value_t this_obj, jerry_value_t cb);
+    int stop_event();
     
 };
 
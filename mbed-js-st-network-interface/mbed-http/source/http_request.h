@@ -213,6 +213,16 @@ public:
         return error;
     }
 
+    /**
+     * Get the response being received.
+     *
+     * Set once send() has sent the request. The status line and the headers
+     * are parsed before the body, so a body callback can check them.
+     */
+    HttpResponse* get_response() {
+        return response;
+    }
+
 private:
     NetworkInterface* network;
     TCPSocket* socket;
@@ -1,187 +1,502 @@
-/**
- ******************************************************************************
- * @file    DevI2C.h
- * @author  AST / EST / AMG-CL
- * @version V0.0.2
- * @date    25-July-2016
- * @brief   Header file for a special I2C class DevI2C which provides some
- *          helper function for on-board communication
- ******************************************************************************
- * @attention
- *
- * <h2><center>&copy; COPYRIGHT(c) 2014 STMicroelectronics</center></h2>
- *
- * Redistribution and use in source and binary forms, with or without modification,
- * are permitted provided that the following conditions are met:
- *   1. Redistributions of source code must retain the above copyright notice,
- *      this list of conditions and the following disclaimer.
- *   2. Redistributions in binary form must reproduce the above copyright notice,
- *      this list of conditions and the following disclaimer in the documentation
- *      and/or other materials provided with the distribution.
- *   3. Neither the name of STMicroelectronics nor the names of its contributors
- *      may be used to endorse or promote products derived from this software
- *      without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
- * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
- * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
- * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
- * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
- * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
- * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
- * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
- *
- ******************************************************************************
- */
-
-/* Define to prevent from recursive inclusion --------------------------------*/
-#ifndef __DEV_I2C_H
-#define __DEV_I2C_H
-
-/* Includes ------------------------------------------------------------------*/
-#include "mbed.h"
-
-/* Classes -------------------------------------------------------------------*/
-/** Helper class DevI2C providing functions for multi-register I2C communication
- *  common for a series of I2C devices
- */
-class DevI2C : public I2C
-{
- public:
-   
-   /** Create a DevI2C Master interface, connected to the specified pins
-   *
-   *  @param sda I2C data line pin
-   *  @param scl I2C clock line pin
-   */
-   DevI2C(PinName sda, PinName scl) : I2C(sda, scl) {}
-
-   /**
-   * @brief  Writes a buffer towards the I2C peripheral device.
-   * @param  pBuffer pointer to the byte-array data to send
-   * @param  DeviceAddr specifies the peripheral device slave address.
-   * @param  RegisterAddr specifies the internal address register 
-   *         where to start writing to (must be correctly masked).
-   * @param  NumByteToWrite number of bytes to be written.
-   * @retval 0 if ok, 
-   * @retval -1 if an I2C error has occured, or
-   * @retval -2 on temporary buffer overflow (i.e. NumByteToWrite was too high)
-   * @note   On some devices if NumByteToWrite is greater
-   *         than one, the RegisterAddr must be masked correctly!
-   */
-   int i2c_write(uint8_t* pBuffer, uint8_t DeviceAddr, uint8_t RegisterAddr, 
-                 uint16_t NumByteToWrite)
-   {
-     int ret;
-     uint8_t tmp[TEMP_BUF_SIZE];
-     
-     if(NumByteToWrite >= TEMP_BUF_SIZE) return -2;
-     
-     /* First, send device address. Then, send data and STOP condition */
-     tmp[0] = RegisterAddr;
-     memcpy(tmp+1, pBuffer, NumByteToWrite);
-     
-     ret = write(DeviceAddr, (const char*)tmp, NumByteToWrite+1, false);
-     
-     if(ret) return -1;
-     return 0;
-   }
-        
-   /**
-   * @brief  Writes a buffer towards the I2C peripheral device.
-   * @param  pBuffer pointer to the byte-array data to send
-   * @param  DeviceAddr specifies the peripheral device slave address.
-   * @param  RegisterAddr specifies the internal address register 
-   *         where to start writing to (must be correctly masked).
-   * @param  NumByteToWrite number of bytes to be written.
-   * @retval 0 if ok, 
-   * @retval -1 if an I2C error has occured, or
-   * @retval -2 on temporary buffer overflow (i.e. NumByteToWrite was too high)
-   * @note   On some devices if NumByteToWrite is greater
-   *         than one, the RegisterAddr must be masked correctly!
-   */
-   int i2c_write(uint8_t* pBuffer, uint8_t DeviceAddr, uint16_t RegisterAddr, 
-                 uint16_t NumByteToWrite)
-   {
-     int ret;
-     uint8_t tmp[TEMP_BUF_SIZE];
-     
-     if(NumByteToWrite >= TEMP_BUF_SIZE) return -2;
-     
-     /* First, send device address. Then, send data and STOP condition */
-     tmp[0] = (RegisterAddr >> 8) & 0xFF;
-     tmp[1] = (RegisterAddr) & 0xFF;
-     memcpy(tmp+2, pBuffer, NumByteToWrite);
-     
-     ret = write(DeviceAddr, (const char*)tmp, NumByteToWrite+2, false);
-     
-     if(ret) return -1;
-     return 0;
-   }
-   /**
-   * @brief  Reads a buffer from the I2C peripheral device.
-   * @param  pBuffer pointer to the byte-array to read data in to
-   * @param  DaviceAddr specifies the peripheral device slave address.
-   * @param  RegisterAddr specifies the internal address register 
-   *         where to start reading from (must be correctly masked).
-   * @param  NumByteToRead number of bytes to be read.
-   * @retval 0 if ok, 
-   * @retval -1 if an I2C error has occured
-   * @note   On some devices if NumByteToWrite is greater
-   *         than one, the RegisterAddr must be masked correctly!
-   */
-   int i2c_read(uint8_t* pBuffer, uint8_t DeviceAddr, uint16_t RegisterAddr, 
-                uint16_t NumByteToRead)
-   {
-     int ret;
-     uint8_t reg_addr[2];
-     reg_addr[0] = (RegisterAddr >> 8) & 0xFF;
-     reg_addr[1] = (RegisterAddr) & 0xFF;
-     /* Send device address, with no STOP condition */
-     ret = write(DeviceAddr, (const char*)reg_addr, 2, true);
-     if(!ret) {
-       /* Read data, with STOP condition  */
-       ret = read(DeviceAddr, (char*)pBuffer, NumByteToRead, false);
-     }
-     
-     if(ret) 
-       return -1;
-     else
-       return 0;
-   }
-   
-   /**
-   * @brief  Reads a buffer from the I2C peripheral device.
-   * @param  pBuffer pointer to the byte-array to read data in to
-   * @param  DaviceAddr specifies the peripheral device slave address.
-   * @param  RegisterAddr specifies the internal address register 
-   *         where to start reading from (must be correctly masked).
-   * @param  NumByteToRead number of bytes to be read.
-   * @retval 0 if ok, 
-   * @retval -1 if an I2C error has occured
-   * @note   On some devices if NumByteToWrite is greater
-   *         than one, the RegisterAddr must be masked correctly!
-   */
-   int i2c_read(uint8_t* pBuffer, uint8_t DeviceAddr, uint8_t RegisterAddr, 
-                uint16_t NumByteToRead)
-   {
-     int ret;
-     
-     /* Send device address, with no STOP condition */
-     ret = write(DeviceAddr, (const char*)&RegisterAddr, 1, true);
-     if(!ret) {
-       /* Read data, with STOP condition  */
-       ret = read(DeviceAddr, (char*)pBuffer, NumByteToRead, false);
-     }
-     
-     if(ret) return -1;
-     return 0;
-   }
-   
-private:
-  static const unsigned int TEMP_BUF_SIZE = 32;
-};
-
-#endif /* __DEV_I2C_H */
+/**
+ ******************************************************************************
+ * @file    DevI2C.h
+ * @author  AST / EST
+ * @version V1.1.0
+ * @date    21-January-2016
+ * @brief   Header file for a special I2C class DevI2C which provides some
+ *          helper function for on-board communication
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2016 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent from recursive inclusion --------------------------------*/
+#ifndef __DEV_I2C_H
+#define __DEV_I2C_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "mbed.h"
+#include "pinmap.h"
+
+/* Defines -------------------------------------------------------------------*/
+/** Stack size of the thread running the queued transactions */
+#ifndef DEVI2C_DISPATCH_STACK_SIZE
+#define DEVI2C_DISPATCH_STACK_SIZE  1024
+#endif
+
+/* Types ---------------------------------------------------------------------*/
+/** Prebuilt transaction for DevI2C::submit()
+ *
+ *  The bytes in tx are written first; if rx_len is not zero the transaction
+ *  continues with a repeated start and reads rx_len bytes into rx. For a
+ *  register write, tx holds the register address followed by the data, so
+ *  the data is sent from the caller's buffer as is. The descriptor and its
+ *  buffers must stay valid until done has been called.
+ */
+typedef struct DevI2CTransaction {
+    uint8_t address;                    /*!< 8-bit device address */
+    const uint8_t *tx;                  /*!< Bytes to write, starting with the register address */
+    uint16_t tx_len;                    /*!< Number of bytes to write */
+    uint8_t *rx;                        /*!< Buffer to read into, NULL for a write */
+    uint16_t rx_len;                    /*!< Number of bytes to read, 0 for a write */
+    Callback<void(int)> done;           /*!< Called with 0 if ok or -1 on an I2C error, on the DevI2C thread */
+    struct DevI2CTransaction *next;     /*!< Queue link, used by DevI2C */
+} DevI2CTransaction;
+
+/** Bus usage of i2c_read(), i2c_write(), i2c_transfer() and submit() */
+typedef struct {
+    uint32_t transactions;              /*!< Transactions run, a register read counting as one */
+    uint32_t bytes;                     /*!< Bytes on the wire, device address bytes included */
+    uint32_t errors;                    /*!< Transactions that failed */
+    uint64_t bus_time;                  /*!< Time the bus was clocked, from the bytes and the frequency, in ns */
+} DevI2CStats;
+
+/* Classes -------------------------------------------------------------------*/
+/** Helper class DevI2C providing functions for multi-register I2C communication
+ *  common for a series of I2C devices
+ */
+class DevI2C : public I2C
+{
+public:
+    /** Create a DevI2C Master interface, connected to the specified pins
+     *
+     *  @param sda I2C data line pin
+     *  @param scl I2C clock line pin
+     */
+    DevI2C(PinName sda, PinName scl) : I2C(sda, scl),
+        dispatcher(NULL), queue(NULL), head(NULL), tail(NULL), current(NULL),
+        busy(false), bit_time(NS_PER_SECOND / DEFAULT_FREQUENCY) {
+        reset_stats();
+    }
+
+    /** Stop the thread running the queued transactions
+     *
+     *  @note  All submitted transactions must have completed.
+     */
+    ~DevI2C() {
+        if(queue) {
+            queue->break_dispatch();
+            dispatcher->join();
+            delete dispatcher;
+            delete queue;
+        }
+    }
+    
+    /**
+     * @brief  Writes a buffer towards the I2C peripheral device.
+     * @param  pBuffer pointer to the byte-array data to send
+     * @param  DeviceAddr specifies the peripheral device slave address.
+     * @param  RegisterAddr specifies the internal address register
+     *         where to start writing to (must be correctly masked).
+     * @param  NumByteToWrite number of bytes to be written.
+     * @retval 0 if ok,
+     * @retval -1 if an I2C error has occured
+     * @note   On some devices if NumByteToWrite is greater
+     *         than one, the RegisterAddr must be masked correctly!
+     */
+    int i2c_write(uint8_t* pBuffer, uint8_t DeviceAddr, uint8_t RegisterAddr,
+                  uint16_t NumByteToWrite) {
+        int ret;
+        uint8_t tmp[TEMP_BUF_SIZE];
+
+        lock();
+
+        if(NumByteToWrite < TEMP_BUF_SIZE) {
+            /* First, send device address. Then, send data and STOP condition */
+            tmp[0] = RegisterAddr;
+            memcpy(tmp+1, pBuffer, NumByteToWrite);
+
+            ret = write(DeviceAddr, (const char*)tmp, NumByteToWrite+1, false);
+            if(ret) ret = -1;
+        } else {
+            /* Longer writes are sent byte by byte from pBuffer, in one transaction */
+            start();
+            ret = (write((int)DeviceAddr) == 1 && write((int)RegisterAddr) == 1) ? 0 : -1;
+            for(uint16_t i = 0; !ret && i < NumByteToWrite; i++) {
+                if(write((int)pBuffer[i]) != 1) ret = -1;
+            }
+            stop();
+        }
+
+        count(NumByteToWrite + 2, 1, ret);
+
+        unlock();
+
+        return ret;
+    }
+
+    /**
+     * @brief  Reads a buffer from the I2C peripheral device.
+     * @param  pBuffer pointer to the byte-array to read data in to
+     * @param  DeviceAddr specifies the peripheral device slave address.
+     * @param  RegisterAddr specifies the internal address register
+     *         where to start reading from (must be correctly masked).
+     * @param  NumByteToRead number of bytes to be read.
+     * @retval 0 if ok,
+     * @retval -1 if an I2C error has occured
+     * @note   On some devices if NumByteToWrite is greater
+     *         than one, the RegisterAddr must be masked correctly!
+     */
+    int i2c_read(uint8_t* pBuffer, uint8_t DeviceAddr, uint8_t RegisterAddr,
+                 uint16_t NumByteToRead) {
+        int ret;
+
+        /* Hold the bus across the repeated start, other threads may share it */
+        lock();
+
+        /* Send device address, with no STOP condition */
+        ret = write(DeviceAddr, (const char*)&RegisterAddr, 1, true);
+        if(!ret) {
+            /* Read data, with STOP condition  */
+            ret = read(DeviceAddr, (char*)pBuffer, NumByteToRead, false);
+        }
+
+        count(NumByteToRead + 3, 2, ret);
+
+        unlock();
+
+        if(ret) return -1;
+        return 0;
+    }
+
+    /**
+     * @brief  Writes a buffer towards a device with 16-bit register addresses,
+     *         such as the M24LR EEPROM.
+     * @param  pBuffer pointer to the byte-array data to send
+     * @param  DeviceAddr specifies the peripheral device slave address.
+     * @param  RegisterAddr specifies the internal address register
+     *         where to start writing to, sent MSB first.
+     * @param  NumByteToWrite number of bytes to be written.
+     * @retval 0 if ok,
+     * @retval -1 if an I2C error has occured
+     */
+    int i2c_write(uint8_t* pBuffer, uint8_t DeviceAddr, uint16_t RegisterAddr,
+                  uint16_t NumByteToWrite) {
+        int ret;
+        uint8_t tmp[TEMP_BUF_SIZE];
+
+        lock();
+
+        if(NumByteToWrite < TEMP_BUF_SIZE - 1) {
+            /* First, send device address. Then, send data and STOP condition */
+            tmp[0] = (RegisterAddr >> 8) & 0xFF;
+            tmp[1] = RegisterAddr & 0xFF;
+            memcpy(tmp+2, pBuffer, NumByteToWrite);
+
+            ret = write(DeviceAddr, (const char*)tmp, NumByteToWrite+2, false);
+            if(ret) ret = -1;
+        } else {
+            /* Longer writes are sent byte by byte from pBuffer, in one transaction */
+            start();
+            ret = (write((int)DeviceAddr) == 1 && write((int)(RegisterAddr >> 8)) == 1 &&
+                   write((int)(RegisterAddr & 0xFF)) == 1) ? 0 : -1;
+            for(uint16_t i = 0; !ret && i < NumByteToWrite; i++) {
+                if(write((int)pBuffer[i]) != 1) ret = -1;
+            }
+            stop();
+        }
+
+        count(NumByteToWrite + 3, 1, ret);
+
+        unlock();
+
+        return ret;
+    }
+
+    /**
+     * @brief  Reads a buffer from a device with 16-bit register addresses,
+     *         such as the M24LR EEPROM.
+     * @param  pBuffer pointer to the byte-array to read data in to
+     * @param  DeviceAddr specifies the peripheral device slave address.
+     * @param  RegisterAddr specifies the internal address register
+     *         where to start reading from, sent MSB first.
+     * @param  NumByteToRead number of bytes to be read.
+     * @retval 0 if ok,
+     * @retval -1 if an I2C error has occured
+     */
+    int i2c_read(uint8_t* pBuffer, uint8_t DeviceAddr, uint16_t RegisterAddr,
+                 uint16_t NumByteToRead) {
+        int ret;
+        uint8_t reg_addr[2];
+
+        reg_addr[0] = (RegisterAddr >> 8) & 0xFF;
+        reg_addr[1] = RegisterAddr & 0xFF;
+
+        lock();
+
+        /* Send device address, with no STOP condition */
+        ret = write(DeviceAddr, (const char*)reg_addr, 2, true);
+        if(!ret) {
+            /* Read data, with STOP condition  */
+            ret = read(DeviceAddr, (char*)pBuffer, NumByteToRead, false);
+        }
+
+        count(NumByteToRead + 4, 2, ret);
+
+        unlock();
+
+        if(ret) return -1;
+        return 0;
+    }
+
+    /**
+     * @brief  Writes then reads in one transaction, with a repeated start.
+     * @param  DeviceAddr specifies the peripheral device slave address.
+     * @param  tx bytes to write, the register address first for a register
+     *         access; may be NULL if tx_len is 0.
+     * @param  tx_len number of bytes to write, 0 to only read.
+     * @param  rx buffer to read data in to; may be NULL if rx_len is 0.
+     * @param  rx_len number of bytes to read, 0 to only write.
+     * @retval 0 if ok,
+     * @retval -1 if an I2C error has occured
+     * @note   Counted in the bus usage like i2c_read() and i2c_write().
+     */
+    int i2c_transfer(uint8_t DeviceAddr, const uint8_t *tx, uint16_t tx_len,
+                     uint8_t *rx, uint16_t rx_len) {
+        int ret = 0;
+
+        lock();
+
+        if(tx_len) {
+            /* No STOP condition if a read follows */
+            ret = write(DeviceAddr, (const char*)tx, tx_len, rx_len != 0);
+        }
+        if(!ret && rx_len) {
+            ret = read(DeviceAddr, (char*)rx, rx_len, false);
+        }
+        if(ret) ret = -1;
+
+        if(tx_len || rx_len) count_transfer(tx_len, rx_len, ret);
+
+        unlock();
+
+        return ret;
+    }
+
+    /**
+     * @brief  Queues a transaction, to run without blocking the caller.
+     * @param  t prebuilt transaction, see DevI2CTransaction.
+     * @retval 0 if ok,
+     * @retval -1 if the DevI2C thread could not be started
+     * @note   Transactions run in the order they are submitted, on a thread
+     *         started by the first call. The bus is locked from the start to
+     *         the end of each one, so i2c_read() and i2c_write() from other
+     *         threads wait in between. Where the target supports asynchronous
+     *         I2C (DEVICE_I2C_ASYNCH) the bytes are moved by I2C::transfer()
+     *         under interrupt or DMA; otherwise the DevI2C thread runs the
+     *         transaction blocking. Not to be called from interrupt context.
+     */
+    int submit(DevI2CTransaction *t) {
+        bool idle;
+
+        if(!queue && start_dispatcher()) return -1;
+
+        t->next = NULL;
+
+        core_util_critical_section_enter();
+        if(tail) {
+            tail->next = t;
+        } else {
+            head = t;
+        }
+        tail = t;
+        idle = !busy;
+        busy = true;
+        core_util_critical_section_exit();
+
+        if(idle) queue->call(this, &DevI2C::run_next);
+
+        return 0;
+    }
+
+    /**
+     * @brief  Sets the bus frequency, also used to estimate the bus time.
+     * @param  hz SCL frequency in Hz.
+     */
+    void frequency(int hz) {
+        I2C::frequency(hz);
+        bit_time = NS_PER_SECOND / hz;
+    }
+
+    /**
+     * @brief  Reads the bus usage since construction or reset_stats().
+     * @param  stats filled with the counters, see DevI2CStats.
+     * @note   Counts the transactions of i2c_read(), i2c_write(),
+     *         i2c_transfer() and submit(), which is what the sensor drivers
+     *         and the JavaScript bindings use; divide by the number of
+     *         samples read to get the bus cost of a sample.
+     */
+    void get_stats(DevI2CStats *stats) {
+        lock();
+        *stats = usage;
+        unlock();
+    }
+
+    /**
+     * @brief  Clears the bus usage counters.
+     */
+    void reset_stats() {
+        lock();
+        memset(&usage, 0, sizeof(usage));
+        unlock();
+    }
+
+private:
+    /* Adds a transaction to the bus usage, with the bus locked; each byte is
+       9 clocks and each start or stop condition about one more */
+    void count(uint32_t bytes, uint32_t starts, int ret) {
+        usage.transactions++;
+        usage.bytes += bytes;
+        if(ret) usage.errors++;
+        usage.bus_time += (uint64_t)(bytes * 9 + starts + 1) * bit_time;
+    }
+
+    /* Adds a write then read transaction to the bus usage, with the bus locked */
+    void count_transfer(uint32_t tx_len, uint32_t rx_len, int ret) {
+        if(tx_len && rx_len) {
+            count(tx_len + rx_len + 2, 2, ret);
+        } else {
+            count(tx_len + rx_len + 1, 1, ret);
+        }
+    }
+
+    /* Adds a queued transaction to the bus usage, with the bus locked */
+    void count(DevI2CTransaction *t, int ret) {
+        count_transfer(t->tx_len, t->rx_len, ret);
+    }
+
+    /* Starts the thread running the queued transactions */
+    int start_dispatcher() {
+        /* At most one run_next() and one finish() wait in the queue */
+        queue = new EventQueue(4 * EVENTS_EVENT_SIZE);
+        dispatcher = new Thread(osPriorityAboveNormal, DEVI2C_DISPATCH_STACK_SIZE);
+
+        if(dispatcher->start(callback(queue, &EventQueue::dispatch_forever)) != osOK) {
+            delete dispatcher;
+            delete queue;
+            dispatcher = NULL;
+            queue = NULL;
+            return -1;
+        }
+
+        return 0;
+    }
+
+    /* Pops the next transaction, NULL when the queue is empty */
+    DevI2CTransaction *pop() {
+        DevI2CTransaction *t;
+
+        core_util_critical_section_enter();
+        t = head;
+        if(t) {
+            head = t->next;
+            if(!head) tail = NULL;
+        } else {
+            busy = false;
+        }
+        core_util_critical_section_exit();
+
+        return t;
+    }
+
+    /* Starts the queued transactions in turn, on the DevI2C thread */
+    void run_next() {
+        DevI2CTransaction *t;
+        int ret;
+
+        while((t = pop()) != NULL) {
+            lock();
+
+#if DEVICE_I2C_ASYNCH
+            current = t;
+            if(transfer(t->address, (const char*)t->tx, t->tx_len, (char*)t->rx, t->rx_len,
+                        callback(this, &DevI2C::transfer_done), I2C_EVENT_ALL, false) == 0) {
+                /* finish() carries on when the transfer completes */
+                return;
+            }
+            current = NULL;
+            ret = -1;
+            count(t, ret);
+#else
+            ret = write(t->address, (const char*)t->tx, t->tx_len, t->rx_len != 0);
+            if(!ret && t->rx_len) {
+                ret = read(t->address, (char*)t->rx, t->rx_len, false);
+            }
+            if(ret) ret = -1;
+            count(t, ret);
+#endif
+
+            unlock();
+
+            if(t->done) t->done(ret);
+        }
+    }
+
+#if DEVICE_I2C_ASYNCH
+    /* I2C::transfer() event handler, runs in interrupt context */
+    void transfer_done(int event) {
+        int ret = (event & I2C_EVENT_TRANSFER_COMPLETE) &&
+                  !(event & (I2C_EVENT_ERROR | I2C_EVENT_ERROR_NO_SLAVE | I2C_EVENT_TRANSFER_EARLY_NACK)) ? 0 : -1;
+
+        queue->call(this, &DevI2C::finish, ret);
+    }
+
+    /* Completes the current transaction and starts the next, on the DevI2C thread */
+    void finish(int ret) {
+        DevI2CTransaction *t = current;
+
+        current = NULL;
+        count(t, ret);
+        unlock();
+
+        if(t->done) t->done(ret);
+
+        run_next();
+    }
+#endif
+
+    static const unsigned int TEMP_BUF_SIZE = 32;
+    static const uint32_t NS_PER_SECOND = 1000000000;
+    static const uint32_t DEFAULT_FREQUENCY = 100000;
+
+    Thread *dispatcher;
+    EventQueue *queue;
+
+    /* Transaction queue, shared with submit() callers */
+    DevI2CTransaction *head;
+    DevI2CTransaction *tail;
+    DevI2CTransaction *current;
+    volatile bool busy;
+
+    /* Bus usage, updated with the bus locked */
+    DevI2CStats usage;
+    uint32_t bit_time;
+};
+
+#endif /* __DEV_I2C_H */
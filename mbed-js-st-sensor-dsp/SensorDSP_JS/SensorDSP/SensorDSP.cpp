@@ -0,0 +1,314 @@
+/**
+ ******************************************************************************
+ * @file    SensorDSP.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Streaming decimators, biquad filters and window features
+ *          for sensor samples.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SensorDSP.h"
+
+#include <math.h>
+#include <string.h>
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** Constructor
+ * @brief	Creates an unconfigured chain.
+ */
+SensorDSP::SensorDSP() :
+        num_stages(0), num_channels(0), in_rate(0.0f), out_rate(0.0f),
+        window(1), filled(0) {
+}
+
+/** configure
+ * @brief	Selects the input values and clears the stages.
+ * @param	Input rate in Hz
+ * @param	Number of values of an input sample
+ * @param	Indexes of the values to process, one per channel
+ * @param	Number of channels
+ * @return	0 on success, 1 if an argument is invalid
+ */
+int SensorDSP::configure(float rate, uint8_t count, const uint8_t *channels, uint8_t num_channels) {
+    if (!(rate > 0.0f) || num_channels == 0 || num_channels > SENSOR_DSP_MAX_CHANNELS) {
+        return 1;
+    }
+
+    for (uint8_t i = 0; i < num_channels; i++) {
+        if (channels[i] >= count) {
+            return 1;
+        }
+    }
+
+    memcpy(this->channels, channels, num_channels);
+    this->num_channels = num_channels;
+    in_rate = rate;
+    clear();
+    return 0;
+}
+
+/** add_decimator
+ * @brief	Appends a stage averaging factor samples into one.
+ * @param	Factor, 2 or more
+ * @return	0 on success, 1 if the chain is full or the factor is invalid
+ */
+int SensorDSP::add_decimator(uint16_t factor) {
+    if (num_stages == SENSOR_DSP_MAX_STAGES || num_channels == 0 || factor < 2) {
+        return 1;
+    }
+
+    Stage *stage = &stages[num_stages++];
+    stage->type = STAGE_DECIMATOR;
+    stage->factor = factor;
+    out_rate /= factor;
+
+    reset();
+    return 0;
+}
+
+/** add_biquad
+ * @brief	Appends a biquad filter.
+ * @param	b0, b1, b2, a1, a2, normalized so that a0 is 1
+ * @return	0 on success, 1 if the chain is full
+ */
+int SensorDSP::add_biquad(const float *coeffs) {
+    if (num_stages == SENSOR_DSP_MAX_STAGES || num_channels == 0) {
+        return 1;
+    }
+
+    Stage *stage = &stages[num_stages++];
+    stage->type = STAGE_BIQUAD;
+    memcpy(stage->coeffs, coeffs, sizeof(stage->coeffs));
+
+    reset();
+    return 0;
+}
+
+/** add_lowpass
+ * @brief	Appends a second order low-pass filter.
+ * @param	Cutoff frequency in Hz, below half the rate at this stage
+ * @param	Quality factor, 0.707 for Butterworth
+ * @return	0 on success, 1 if the chain is full or an argument is invalid
+ */
+int SensorDSP::add_lowpass(float cutoff, float q) {
+    return add_design(DESIGN_LOWPASS, cutoff, q);
+}
+
+/** add_highpass
+ * @brief	Appends a second order high-pass filter.
+ * @param	Cutoff frequency in Hz, below half the rate at this stage
+ * @param	Quality factor, 0.707 for Butterworth
+ * @return	0 on success, 1 if the chain is full or an argument is invalid
+ */
+int SensorDSP::add_highpass(float cutoff, float q) {
+    return add_design(DESIGN_HIGHPASS, cutoff, q);
+}
+
+/** add_bandpass
+ * @brief	Appends a second order band-pass filter with unity gain at its center.
+ * @param	Center frequency in Hz, below half the rate at this stage
+ * @param	Quality factor, the center frequency over the bandwidth
+ * @return	0 on success, 1 if the chain is full or an argument is invalid
+ */
+int SensorDSP::add_bandpass(float center, float q) {
+    return add_design(DESIGN_BANDPASS, center, q);
+}
+
+/** clear
+ * @brief	Removes every stage.
+ */
+void SensorDSP::clear() {
+    num_stages = 0;
+    out_rate = in_rate;
+    reset();
+}
+
+/** set_window
+ * @brief	Sets the number of samples, after the stages, per window.
+ * @param	Window length
+ * @return	0 on success, 1 if the length is zero
+ */
+int SensorDSP::set_window(uint32_t length) {
+    if (length == 0) {
+        return 1;
+    }
+
+    window = length;
+    reset();
+    return 0;
+}
+
+/** reset
+ * @brief	Clears the filter states and the current window.
+ */
+void SensorDSP::reset() {
+    for (uint8_t i = 0; i < num_stages; i++) {
+        stages[i].phase = 0;
+        memset(stages[i].s1, 0, sizeof(stages[i].s1));
+        memset(stages[i].s2, 0, sizeof(stages[i].s2));
+    }
+
+    filled = 0;
+    memset(sum, 0, sizeof(sum));
+    memset(sum_sq, 0, sizeof(sum_sq));
+    memset(peak, 0, sizeof(peak));
+}
+
+/** get_num_channels
+ * @brief	Returns the number of channels.
+ * @return	Number of channels, 0 before configure()
+ */
+uint8_t SensorDSP::get_num_channels() {
+    return num_channels;
+}
+
+/** get_rate
+ * @brief	Returns the rate after the stages, at which windows fill.
+ * @return	Rate in Hz
+ */
+float SensorDSP::get_rate() {
+    return out_rate;
+}
+
+/** process
+ * @brief	Runs one input sample through the chain.
+ * @param	Input sample, with the number of values given to configure()
+ * @param	Destination for the mean, rms and peak of each channel
+ * @return	true when a window completed and features were written
+ */
+bool SensorDSP::process(const float *values, float *features) {
+    float x[SENSOR_DSP_MAX_CHANNELS];
+
+    for (uint8_t c = 0; c < num_channels; c++) {
+        x[c] = values[channels[c]];
+    }
+
+    for (uint8_t i = 0; i < num_stages; i++) {
+        Stage *stage = &stages[i];
+
+        if (stage->type == STAGE_DECIMATOR) {
+            for (uint8_t c = 0; c < num_channels; c++) {
+                stage->s1[c] += x[c];
+            }
+            if (++stage->phase < stage->factor) {
+                return false;
+            }
+            stage->phase = 0;
+            for (uint8_t c = 0; c < num_channels; c++) {
+                x[c] = stage->s1[c] / stage->factor;
+                stage->s1[c] = 0.0f;
+            }
+        } else {
+            const float *k = stage->coeffs;
+            for (uint8_t c = 0; c < num_channels; c++) {
+                float y = k[0] * x[c] + stage->s1[c];
+                stage->s1[c] = k[1] * x[c] - k[3] * y + stage->s2[c];
+                stage->s2[c] = k[2] * x[c] - k[4] * y;
+                x[c] = y;
+            }
+        }
+    }
+
+    for (uint8_t c = 0; c < num_channels; c++) {
+        float magnitude = fabsf(x[c]);
+        sum[c] += x[c];
+        sum_sq[c] += x[c] * x[c];
+        if (magnitude > peak[c]) {
+            peak[c] = magnitude;
+        }
+    }
+
+    if (++filled < window) {
+        return false;
+    }
+
+    for (uint8_t c = 0; c < num_channels; c++) {
+        features[c * SENSOR_DSP_FEATURES] = sum[c] / window;
+        features[c * SENSOR_DSP_FEATURES + 1] = sqrtf(sum_sq[c] / window);
+        features[c * SENSOR_DSP_FEATURES + 2] = peak[c];
+        sum[c] = 0.0f;
+        sum_sq[c] = 0.0f;
+        peak[c] = 0.0f;
+    }
+    filled = 0;
+
+    return true;
+}
+
+/** add_design
+ * @brief	Appends a biquad designed for the rate at the end of the chain,
+ *          from the Audio EQ Cookbook formulas.
+ * @param	Filter type
+ * @param	Cutoff or center frequency in Hz
+ * @param	Quality factor
+ * @return	0 on success, 1 if the chain is full or an argument is invalid
+ */
+int SensorDSP::add_design(Design design, float freq, float q) {
+    if (!(freq > 0.0f) || !(freq < out_rate / 2.0f) || !(q > 0.0f)) {
+        return 1;
+    }
+
+    float w0 = 2.0f * 3.14159265f * freq / out_rate;
+    float cos_w0 = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    float a0 = 1.0f + alpha;
+    float coeffs[5];
+
+    switch (design) {
+        case DESIGN_LOWPASS:
+            coeffs[0] = (1.0f - cos_w0) / 2.0f;
+            coeffs[1] = 1.0f - cos_w0;
+            coeffs[2] = (1.0f - cos_w0) / 2.0f;
+            break;
+        case DESIGN_HIGHPASS:
+            coeffs[0] = (1.0f + cos_w0) / 2.0f;
+            coeffs[1] = -(1.0f + cos_w0);
+            coeffs[2] = (1.0f + cos_w0) / 2.0f;
+            break;
+        default:
+            coeffs[0] = alpha;
+            coeffs[1] = 0.0f;
+            coeffs[2] = -alpha;
+            break;
+    }
+    coeffs[3] = -2.0f * cos_w0;
+    coeffs[4] = 1.0f - alpha;
+
+    for (int i = 0; i < 5; i++) {
+        coeffs[i] /= a0;
+    }
+
+    return add_biquad(coeffs);
+}
@@ -0,0 +1,138 @@
+/**
+ ******************************************************************************
+ * @file    SensorDSP.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Streaming decimators, biquad filters and window features
+ *          for sensor samples.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SENSOR_DSP_H__
+#define __SENSOR_DSP_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Largest number of channels processed, one per selected sensor value. */
+#ifndef SENSOR_DSP_MAX_CHANNELS
+#define SENSOR_DSP_MAX_CHANNELS     6
+#endif
+
+/** Largest number of decimator and biquad stages. */
+#ifndef SENSOR_DSP_MAX_STAGES
+#define SENSOR_DSP_MAX_STAGES       6
+#endif
+
+/** Features of a window for each channel: mean, rms and peak. */
+#define SENSOR_DSP_FEATURES         3
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Streaming signal chain for sensor samples.
+ *
+ * Selected values of each sample go through a chain of decimators and
+ * biquad filters, then into a window; when the window is full its mean,
+ * rms and peak (largest magnitude) are returned for each channel. A
+ * decimator averages factor samples into one, which also filters out what
+ * would alias. Biquads use the transposed direct form II and can be
+ * designed for the rate at their place in the chain.
+ */
+class SensorDSP {
+public:
+    /* Constructor. */
+    SensorDSP();
+
+    /* Configuration. */
+    int configure(float rate, uint8_t count, const uint8_t *channels, uint8_t num_channels);
+    int add_decimator(uint16_t factor);
+    int add_biquad(const float *coeffs);
+    int add_lowpass(float cutoff, float q);
+    int add_highpass(float cutoff, float q);
+    int add_bandpass(float center, float q);
+    void clear();
+    int set_window(uint32_t length);
+    void reset();
+
+    uint8_t get_num_channels();
+    float get_rate();
+
+    /* Processing. */
+    bool process(const float *values, float *features);
+
+private:
+    typedef enum {
+        STAGE_DECIMATOR,
+        STAGE_BIQUAD
+    } StageType;
+
+    typedef enum {
+        DESIGN_LOWPASS,
+        DESIGN_HIGHPASS,
+        DESIGN_BANDPASS
+    } Design;
+
+    typedef struct {
+        StageType type;
+        uint16_t factor;                    /*!< Decimator factor */
+        uint16_t phase;                     /*!< Samples summed by the decimator */
+        float coeffs[5];                    /*!< Biquad b0, b1, b2, a1, a2 */
+        float s1[SENSOR_DSP_MAX_CHANNELS];  /*!< Decimator sums, biquad first state */
+        float s2[SENSOR_DSP_MAX_CHANNELS];  /*!< Biquad second state */
+    } Stage;
+
+    int add_design(Design design, float freq, float q);
+
+    Stage stages[SENSOR_DSP_MAX_STAGES];
+    uint8_t num_stages;
+
+    uint8_t channels[SENSOR_DSP_MAX_CHANNELS];
+    uint8_t num_channels;
+
+    /* Input rate and rate after the stages, in Hz. */
+    float in_rate;
+    float out_rate;
+
+    /* Window. */
+    uint32_t window;
+    uint32_t filled;
+    float sum[SENSOR_DSP_MAX_CHANNELS];
+    float sum_sq[SENSOR_DSP_MAX_CHANNELS];
+    float peak[SENSOR_DSP_MAX_CHANNELS];
+};
+
+#endif // __SENSOR_DSP_H__
@@ -0,0 +1,460 @@
+/**
+ ******************************************************************************
+ * @file    SensorDSP_JS-js.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Native signal chain on hub samples, for use with Javascript.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "jerryscript-mbed-util/logging.h"
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
+
+// Load the library that we'll wrap
+#include "SensorDSP_JS.h"
+
+#include "mbed.h"
+
+/* Class Implementation ------------------------------------------------------*/
+
+/**
+ * SensorDSP_JS#destructor
+ * Called if/when the SensorDSP_JS is GC'ed.
+ */
+void NAME_FOR_CLASS_NATIVE_DESTRUCTOR(SensorDSP_JS)(void *void_ptr) {
+    delete static_cast<SensorDSP_JS*>(void_ptr);
+}
+
+
+/**
+ * Type infomation of the native SensorDSP_JS pointer
+ * Set SensorDSP_JS#destructor as the free callback.
+ */
+static const jerry_object_native_info_t native_obj_type_info = {
+    .free_cb = NAME_FOR_CLASS_NATIVE_DESTRUCTOR(SensorDSP_JS)
+};
+
+
+/**
+ * SensorDSP_JS#init (native JavaScript method)
+ * @brief   Runs the chain on the samples of a sensor of a stopped hub, which
+ *          then no longer appear in the hub batches; clears the stages
+ * @param   SensorHub_JS object
+ * @param   Id of the sensor in the hub
+ * @param   Array of the indexes of the sample values to process, one per
+ *          channel (optional, all values by default)
+ * @returns 0 on success, 1 if the hub is running or the id is invalid, 2 if
+ *          the channels are invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorDSP_JS, init) {
+    CHECK_ARGUMENT_COUNT(SensorDSP_JS, init, (args_count == 2 || args_count == 3));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, init, 0, object);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, init, 1, number);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(SensorDSP_JS, init, 2, object, (args_count == 3));
+
+    // Unwrap native SensorDSP_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorDSP_JS pointer");
+    }
+
+    SensorDSP_JS *native_ptr = static_cast<SensorDSP_JS*>(void_ptr);
+
+    // Unwrap arguments
+    void *hub_ptr;
+    const jerry_object_native_info_t *hub_type_ptr;
+    bool hub_has_ptr = jerry_get_object_native_pointer(args[0], &hub_ptr, &hub_type_ptr);
+
+    if (!hub_has_ptr) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorHub_JS pointer");
+    }
+
+    // Cast the argument to C++
+    SensorHub_JS *hub = reinterpret_cast<SensorHub_JS*>(hub_ptr);
+
+    int id = jerry_get_number_value(args[1]);
+
+    uint8_t channels[SENSOR_DSP_MAX_CHANNELS];
+    uint8_t num_channels = 0;
+
+    if (args_count == 3) {
+        jerry_value_t name = jerry_create_string((const jerry_char_t *) "length");
+        jerry_value_t length_val = jerry_get_property(args[2], name);
+        uint32_t length = jerry_value_is_number(length_val) ? (uint32_t) jerry_get_number_value(length_val) : 0;
+
+        jerry_release_value(length_val);
+        jerry_release_value(name);
+
+        if (length == 0 || length > SENSOR_DSP_MAX_CHANNELS) {
+            return jerry_create_number(2);
+        }
+
+        for (uint32_t i = 0; i < length; i++) {
+            jerry_value_t val = jerry_get_property_by_index(args[2], i);
+            double index = jerry_value_is_number(val) ? jerry_get_number_value(val) : -1;
+            jerry_release_value(val);
+
+            if (index < 0 || index > 255) {
+                return jerry_create_number(2);
+            }
+            channels[num_channels++] = (uint8_t)index;
+        }
+    }
+
+    // Call the native function
+    int result = native_ptr->init(hub, id, num_channels ? channels : NULL, num_channels, this_obj);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorDSP_JS#add_decimator (native JavaScript method)
+ * @brief   Appends a stage averaging factor samples into one
+ * @param   Factor, 2 or more
+ * @returns 0 on success, 1 if the chain is full or the factor is invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorDSP_JS, add_decimator) {
+    CHECK_ARGUMENT_COUNT(SensorDSP_JS, add_decimator, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, add_decimator, 0, number);
+
+    // Unwrap native SensorDSP_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorDSP_JS pointer");
+    }
+
+    SensorDSP_JS *native_ptr = static_cast<SensorDSP_JS*>(void_ptr);
+
+    double factor = jerry_get_number_value(args[0]);
+
+    // Call the native function
+    int result = (factor >= 2 && factor <= 65535) ? native_ptr->add_decimator((uint16_t)factor) : 1;
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorDSP_JS#add_biquad (native JavaScript method)
+ * @brief   Appends a biquad filter with the given coefficients
+ * @param   Array of [b0, b1, b2, a1, a2], normalized so that a0 is 1
+ * @returns 0 on success, 1 if the chain is full or the coefficients are invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorDSP_JS, add_biquad) {
+    CHECK_ARGUMENT_COUNT(SensorDSP_JS, add_biquad, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, add_biquad, 0, object);
+
+    // Unwrap native SensorDSP_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorDSP_JS pointer");
+    }
+
+    SensorDSP_JS *native_ptr = static_cast<SensorDSP_JS*>(void_ptr);
+
+    // Unwrap arguments
+    float coeffs[5];
+    for (int i = 0; i < 5; i++) {
+        jerry_value_t val = jerry_get_property_by_index(args[0], i);
+        bool valid = jerry_value_is_number(val);
+        coeffs[i] = valid ? jerry_get_number_value(val) : 0.0f;
+        jerry_release_value(val);
+
+        if (!valid) {
+            return jerry_create_number(1);
+        }
+    }
+
+    // Call the native function
+    int result = native_ptr->add_biquad(coeffs);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorDSP_JS#add_lowpass (native JavaScript method)
+ * @brief   Appends a second order low-pass filter, designed for the rate at
+ *          the end of the chain
+ * @param   Cutoff frequency in Hz, below half that rate
+ * @param   Quality factor, 0.707 for Butterworth
+ * @returns 0 on success, 1 if the chain is full or an argument is invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorDSP_JS, add_lowpass) {
+    CHECK_ARGUMENT_COUNT(SensorDSP_JS, add_lowpass, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, add_lowpass, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, add_lowpass, 1, number);
+
+    // Unwrap native SensorDSP_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorDSP_JS pointer");
+    }
+
+    SensorDSP_JS *native_ptr = static_cast<SensorDSP_JS*>(void_ptr);
+
+    float freq = jerry_get_number_value(args[0]);
+    float q = jerry_get_number_value(args[1]);
+
+    // Call the native function
+    int result = native_ptr->add_lowpass(freq, q);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorDSP_JS#add_highpass (native JavaScript method)
+ * @brief   Appends a second order high-pass filter, designed for the rate at
+ *          the end of the chain
+ * @param   Cutoff frequency in Hz, below half that rate
+ * @param   Quality factor, 0.707 for Butterworth
+ * @returns 0 on success, 1 if the chain is full or an argument is invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorDSP_JS, add_highpass) {
+    CHECK_ARGUMENT_COUNT(SensorDSP_JS, add_highpass, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, add_highpass, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, add_highpass, 1, number);
+
+    // Unwrap native SensorDSP_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorDSP_JS pointer");
+    }
+
+    SensorDSP_JS *native_ptr = static_cast<SensorDSP_JS*>(void_ptr);
+
+    float freq = jerry_get_number_value(args[0]);
+    float q = jerry_get_number_value(args[1]);
+
+    // Call the native function
+    int result = native_ptr->add_highpass(freq, q);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorDSP_JS#add_bandpass (native JavaScript method)
+ * @brief   Appends a second order band-pass, unity gain at its center, filter, designed for the rate at
+ *          the end of the chain
+ * @param   Center frequency in Hz, below half that rate
+ * @param   Quality factor, the center frequency over the bandwidth
+ * @returns 0 on success, 1 if the chain is full or an argument is invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorDSP_JS, add_bandpass) {
+    CHECK_ARGUMENT_COUNT(SensorDSP_JS, add_bandpass, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, add_bandpass, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, add_bandpass, 1, number);
+
+    // Unwrap native SensorDSP_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorDSP_JS pointer");
+    }
+
+    SensorDSP_JS *native_ptr = static_cast<SensorDSP_JS*>(void_ptr);
+
+    float freq = jerry_get_number_value(args[0]);
+    float q = jerry_get_number_value(args[1]);
+
+    // Call the native function
+    int result = native_ptr->add_bandpass(freq, q);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorDSP_JS#clear (native JavaScript method)
+ * @brief   Removes every stage
+ * @returns 0
+ */
+DECLARE_CLASS_FUNCTION(SensorDSP_JS, clear) {
+    CHECK_ARGUMENT_COUNT(SensorDSP_JS, clear, (args_count == 0));
+
+    // Unwrap native SensorDSP_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorDSP_JS pointer");
+    }
+
+    SensorDSP_JS *native_ptr = static_cast<SensorDSP_JS*>(void_ptr);
+
+    // Call the native function
+    native_ptr->clear();
+
+    return jerry_create_number(0);
+}
+
+/**
+ * SensorDSP_JS#get_rate (native JavaScript method)
+ * @brief   Gets the rate at the end of the chain, at which windows fill
+ * @returns Rate in Hz, 0 before init
+ */
+DECLARE_CLASS_FUNCTION(SensorDSP_JS, get_rate) {
+    CHECK_ARGUMENT_COUNT(SensorDSP_JS, get_rate, (args_count == 0));
+
+    // Unwrap native SensorDSP_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorDSP_JS pointer");
+    }
+
+    SensorDSP_JS *native_ptr = static_cast<SensorDSP_JS*>(void_ptr);
+
+    // Get the result from the C++ API
+    float rate = native_ptr->get_rate();
+
+    return jerry_create_number(rate);
+}
+
+/**
+ * SensorDSP_JS#start (native JavaScript method)
+ * @brief   Starts processing and passing the window features to JavaScript
+ * @param   Window length, in samples at the end of the chain
+ * @param   Callback, called with a batch of windows and the number of
+ *          windows dropped since the previous batch. The batch is a flat
+ *          array of [time, mean, rms, peak of the first channel, mean, rms,
+ *          peak of the second channel, ..., time, ...] with the time of the
+ *          last sample of the window in us from the hub timer
+ * @returns 0 on success, 1 if the window is invalid, 3 if not initialized
+ */
+DECLARE_CLASS_FUNCTION(SensorDSP_JS, start) {
+    CHECK_ARGUMENT_COUNT(SensorDSP_JS, start, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, start, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorDSP_JS, start, 1, function);
+
+    // Unwrap native SensorDSP_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorDSP_JS pointer");
+    }
+
+    SensorDSP_JS *native_ptr = static_cast<SensorDSP_JS*>(void_ptr);
+
+    double window = jerry_get_number_value(args[0]);
+
+    // Call the native function
+    int result = (window >= 1 && window <= 0xFFFFFFFF) ? native_ptr->start((uint32_t)window, this_obj, args[1]) : 1;
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorDSP_JS#stop (native JavaScript method)
+ * @brief   Stops processing and passing the window features
+ * @returns 0
+ */
+DECLARE_CLASS_FUNCTION(SensorDSP_JS, stop) {
+    CHECK_ARGUMENT_COUNT(SensorDSP_JS, stop, (args_count == 0));
+
+    // Unwrap native SensorDSP_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorDSP_JS pointer");
+    }
+
+    SensorDSP_JS *native_ptr = static_cast<SensorDSP_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->stop();
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorDSP_JS (native JavaScript constructor)
+ * @brief   Constructor for Javascript wrapper
+ * @returns a JavaScript object representing SensorDSP_JS.
+ */
+DECLARE_CLASS_CONSTRUCTOR(SensorDSP_JS) {
+    CHECK_ARGUMENT_COUNT(SensorDSP_JS, __constructor, args_count == 0);
+    
+    // Extract native SensorDSP_JS pointer (from this object) 
+    SensorDSP_JS *native_ptr = new SensorDSP_JS();
+
+    jerry_value_t js_object = jerry_create_object();
+    jerry_set_object_native_pointer(js_object, native_ptr, &native_obj_type_info);
+
+    // attach methods
+    ATTACH_CLASS_FUNCTION(js_object, SensorDSP_JS, init);
+    ATTACH_CLASS_FUNCTION(js_object, SensorDSP_JS, add_decimator);
+    ATTACH_CLASS_FUNCTION(js_object, SensorDSP_JS, add_biquad);
+    ATTACH_CLASS_FUNCTION(js_object, SensorDSP_JS, add_lowpass);
+    ATTACH_CLASS_FUNCTION(js_object, SensorDSP_JS, add_highpass);
+    ATTACH_CLASS_FUNCTION(js_object, SensorDSP_JS, add_bandpass);
+    ATTACH_CLASS_FUNCTION(js_object, SensorDSP_JS, clear);
+    ATTACH_CLASS_FUNCTION(js_object, SensorDSP_JS, get_rate);
+    ATTACH_CLASS_FUNCTION(js_object, SensorDSP_JS, start);
+    ATTACH_CLASS_FUNCTION(js_object, SensorDSP_JS, stop);
+    
+    return js_object;
+}
@@ -0,0 +1,313 @@
+/**
+ ******************************************************************************
+ * @file    SensorDSP_JS.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Native signal chain on hub samples, for use with Javascript.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SensorDSP_JS.h"
+
+#include "mbed.h"
+
+#if (SENSOR_DSP_JS_RING_SIZE & (SENSOR_DSP_JS_RING_SIZE - 1)) != 0
+#error "SENSOR_DSP_JS_RING_SIZE must be a power of two"
+#endif
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** init
+ * @brief	Runs the chain on the samples of a sensor of a hub, which then
+ *		no longer appear in its batches; clears the stages.
+ * @param	Hub the sensor was added to, stopped
+ * @param	Id of the sensor in the hub
+ * @param	Indexes of the sample values to process, or NULL for all
+ * @param	Number of indexes
+ * @param	JavaScript object, kept alive by the hub
+ * @retval	0 on success, 1 if the hub is running or the id is invalid,
+ *		2 if the channels are invalid
+ */
+int SensorDSP_JS::init(SensorHub_JS *hub, int id, const uint8_t *channels, uint8_t num_channels, jerry_value_t this_obj){
+	uint8_t count;
+	float rate;
+
+	if(id < 0 || id > 255 || hub->get_source(id, &count, &rate) != 0){
+		return 1;
+	}
+
+	uint8_t all[SENSOR_DSP_MAX_CHANNELS];
+	if(channels == NULL){
+		num_channels = count < SENSOR_DSP_MAX_CHANNELS ? count : SENSOR_DSP_MAX_CHANNELS;
+		for(uint8_t i = 0; i < num_channels; i++){
+			all[i] = i;
+		}
+		channels = all;
+	}
+
+	mutex.lock();
+	int result = dsp.configure(rate, count, channels, num_channels);
+	mutex.unlock();
+
+	if(result != 0){
+		return 2;
+	}
+
+	if(hub->attach(id, callback(this, &SensorDSP_JS::sample), this_obj) != 0){
+		return 1;
+	}
+
+	return 0;
+}
+
+/** Destructor
+ * @brief	Stops the delivery.
+ */
+SensorDSP_JS::~SensorDSP_JS(){
+	stop();
+}
+
+/** add_decimator
+ * @brief	Appends a stage averaging factor samples into one.
+ * @param	Factor, 2 or more
+ * @retval	0 on success, 1 if the chain is full or the factor is invalid
+ */
+int SensorDSP_JS::add_decimator(uint16_t factor){
+	mutex.lock();
+	int result = dsp.add_decimator(factor);
+	mutex.unlock();
+	return result;
+}
+
+/** add_biquad
+ * @brief	Appends a biquad filter.
+ * @param	b0, b1, b2, a1, a2, normalized so that a0 is 1
+ * @retval	0 on success, 1 if the chain is full
+ */
+int SensorDSP_JS::add_biquad(const float *coeffs){
+	mutex.lock();
+	int result = dsp.add_biquad(coeffs);
+	mutex.unlock();
+	return result;
+}
+
+/** add_lowpass
+ * @brief	Appends a second order low-pass filter.
+ * @param	Cutoff frequency in Hz
+ * @param	Quality factor
+ * @retval	0 on success, 1 if the chain is full or an argument is invalid
+ */
+int SensorDSP_JS::add_lowpass(float cutoff, float q){
+	mutex.lock();
+	int result = dsp.add_lowpass(cutoff, q);
+	mutex.unlock();
+	return result;
+}
+
+/** add_highpass
+ * @brief	Appends a second order high-pass filter.
+ * @param	Cutoff frequency in Hz
+ * @param	Quality factor
+ * @retval	0 on success, 1 if the chain is full or an argument is invalid
+ */
+int SensorDSP_JS::add_highpass(float cutoff, float q){
+	mutex.lock();
+	int result = dsp.add_highpass(cutoff, q);
+	mutex.unlock();
+	return result;
+}
+
+/** add_bandpass
+ * @brief	Appends a second order band-pass filter.
+ * @param	Center frequency in Hz
+ * @param	Quality factor
+ * @retval	0 on success, 1 if the chain is full or an argument is invalid
+ */
+int SensorDSP_JS::add_bandpass(float center, float q){
+	mutex.lock();
+	int result = dsp.add_bandpass(center, q);
+	mutex.unlock();
+	return result;
+}
+
+/** clear
+ * @brief	Removes every stage.
+ */
+void SensorDSP_JS::clear(){
+	mutex.lock();
+	dsp.clear();
+	mutex.unlock();
+}
+
+/** get_rate
+ * @brief	Returns the rate after the stages, at which windows fill.
+ * @retval	Rate in Hz, 0 before init()
+ */
+float SensorDSP_JS::get_rate(){
+	mutex.lock();
+	float rate = dsp.get_rate();
+	mutex.unlock();
+	return rate;
+}
+
+/** start
+ * @brief	Starts passing the window features to JavaScript.
+ * @param	Window length, in samples after the stages
+ * @param	JavaScript object kept alive while delivering
+ * @param	JavaScript callback
+ * @retval	0 on success, 1 if the window is invalid, 3 before init()
+ */
+int SensorDSP_JS::start(uint32_t window, jerry_value_t this_obj, jerry_value_t cb){
+	stop();
+
+	// Keep the object and the callback while windows may arrive, from
+	// before the hub thread can post a delivery
+	dsp_delivery.start(this_obj, cb);
+
+	mutex.lock();
+	int result = dsp.get_num_channels() == 0 ? 3 : dsp.set_window(window);
+	if(result == 0){
+		tail = head;
+		lost = 0;
+		enabled = true;
+	}
+	mutex.unlock();
+
+	if(result != 0){
+		stop();
+		return result;
+	}
+
+	return 0;
+}
+
+/** stop
+ * @brief	Stops processing and passing the window features.
+ * @retval	0
+ */
+int SensorDSP_JS::stop(){
+	mutex.lock();
+	enabled = false;
+	mutex.unlock();
+
+	// This may release the last reference to this object, so it comes last
+	dsp_delivery.stop();
+
+	return 0;
+}
+
+/** sample
+ * @brief	Runs a sample through the chain, on the hub thread.
+ * @param	Sample of the sensor
+ */
+void SensorDSP_JS::sample(const SensorHubSample *sample){
+	bool done = false;
+
+	mutex.lock();
+	if(enabled){
+		Window *window = &ring[head & (SENSOR_DSP_JS_RING_SIZE - 1)];
+		bool full = (head - tail == SENSOR_DSP_JS_RING_SIZE);
+		float discard[SENSOR_DSP_MAX_CHANNELS * SENSOR_DSP_FEATURES];
+
+		// A full ring still runs the chain so that the filter states stay continuous
+		if(dsp.process(sample->values, full ? discard : window->features)){
+			if(full){
+				lost++;
+			} else {
+				window->time = sample->time;
+				head++;
+				done = true;
+			}
+		}
+	}
+	mutex.unlock();
+
+	// A delivery already waiting takes every window completed meanwhile
+	if(done){
+		dsp_delivery.post(mbed::Callback<void()>(this, &SensorDSP_JS::deliver));
+	}
+}
+
+/** deliver
+ * @brief	Passes the waiting windows to JavaScript as one batch, on the
+ *		event loop.
+ */
+void SensorDSP_JS::deliver(){
+	// Stopped since this delivery was posted, this object may be freed
+	if(!dsp_delivery.begin()){
+		return;
+	}
+
+	jerry_value_t out_array = jerry_create_array(0);
+	uint32_t index = 0;
+	uint32_t dropped;
+
+	mutex.lock();
+	uint8_t num_features = dsp.get_num_channels() * SENSOR_DSP_FEATURES;
+	uint32_t waiting = head - tail;
+	dropped = lost;
+	lost = 0;
+	mutex.unlock();
+
+	// Only the windows already waiting, copied out one at a time to keep the hub thread going
+	for(uint32_t i = 0; i < waiting; i++){
+		Window window;
+
+		mutex.lock();
+		window = ring[tail & (SENSOR_DSP_JS_RING_SIZE - 1)];
+		tail++;
+		mutex.unlock();
+
+		jerry_value_t time = jerry_create_number((double)window.time);
+		jerry_release_value(jerry_set_property_by_index(out_array, index++, time));
+		jerry_release_value(time);
+
+		for(uint8_t k = 0; k < num_features; k++){
+			jerry_value_t val = jerry_create_number(window.features[k]);
+			jerry_release_value(jerry_set_property_by_index(out_array, index++, val));
+			jerry_release_value(val);
+		}
+	}
+
+	jerry_value_t args[2] = {
+		out_array,
+		jerry_create_number(dropped)
+	};
+
+	// The callback may stop the delivery and free this object
+	dsp_delivery.call(args, 2);
+
+	jerry_release_value(args[0]);
+	jerry_release_value(args[1]);
+}
@@ -0,0 +1,114 @@
+/**
+ ******************************************************************************
+ * @file    SensorDSP_JS.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Native signal chain on hub samples, for use with Javascript.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SENSOR_DSP_JS_H__
+#define __SENSOR_DSP_JS_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "mbed.h"
+#include "SensorDSP.h"
+#include "JsDelivery.h"
+#include "SensorHub_JS.h"
+
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Number of windows held for Javascript, must be a power of two. */
+#ifndef SENSOR_DSP_JS_RING_SIZE
+#define SENSOR_DSP_JS_RING_SIZE     8
+#endif
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Signal chain run natively on the samples of a sensor hub, passing only
+ * the window features to Javascript.
+ */
+class SensorDSP_JS {
+private:
+    /* Helper classes. */
+    SensorDSP dsp;
+    
+    /* Guards the chain and the windows, shared with the hub thread. */
+    Mutex mutex;
+    
+    /* Completed windows. */
+    typedef struct {
+        uint64_t time;
+        float features[SENSOR_DSP_MAX_CHANNELS * SENSOR_DSP_FEATURES];
+    } Window;
+    
+    Window ring[SENSOR_DSP_JS_RING_SIZE];
+    uint32_t head = 0;
+    uint32_t tail = 0;
+    uint32_t lost = 0;
+    
+    /* Delivery. */
+    bool enabled = false;
+    JsDelivery dsp_delivery;
+    
+    void sample(const SensorHubSample *sample);
+    void deliver();
+
+public:
+    /* Constructors */
+    SensorDSP_JS(){}
+    
+    int init(SensorHub_JS *hub, int id, const uint8_t *channels, uint8_t num_channels, jerry_value_t this_obj);
+    
+    /* Destructor */
+    ~SensorDSP_JS();
+    
+    /* Declarations */
+    int add_decimator(uint16_t factor);
+    int add_biquad(const float *coeffs);
+    int add_lowpass(float cutoff, float q);
+    int add_highpass(float cutoff, float q);
+    int add_bandpass(float center, float q);
+    void clear();
+    float get_rate();
+    int start(uint32_t window, jerry_value_t this_obj, jerry_value_t cb);
+    int stop();
+};
+
+#endif
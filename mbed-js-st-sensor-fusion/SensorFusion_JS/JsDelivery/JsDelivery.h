@@ -0,0 +1,214 @@
+/**
+ ******************************************************************************
+ * @file    JsDelivery.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Delivery of interrupt and thread events to a JavaScript callback.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __JS_DELIVERY_H__
+#define __JS_DELIVERY_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "mbed.h"
+#include "jerryscript-mbed-event-loop/EventLoop.h"
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Posts events from an interrupt or a thread to the event loop and passes
+ * them to a JavaScript callback, keeping the JavaScript object that owns the
+ * native one alive meanwhile.
+ *
+ * The object is held from start() until stop(), and longer while a delivery
+ * is posted, since that delivery runs on the native object. Only one delivery
+ * waits in the event loop; events posted meanwhile are counted into it.
+ */
+class JsDelivery {
+private:
+    jerry_value_t held_this;
+    jerry_value_t held_cb;
+    volatile uint32_t count;
+    volatile bool posted;
+
+    JsDelivery(const JsDelivery &);
+    JsDelivery &operator=(const JsDelivery &);
+
+public:
+    JsDelivery() : held_this(0), held_cb(0), count(0), posted(false) {}
+
+    ~JsDelivery() {
+        if (held_cb != 0) {
+            jerry_release_value(held_cb);
+        }
+    }
+
+    /**
+     * Keeps the object and the callback, on the event loop; call it before
+     * the interrupt or thread that posts events is started
+     */
+    void start(jerry_value_t this_obj, jerry_value_t cb) {
+        // Still held when a delivery was posted before the last stop
+        jerry_value_t held = held_this == 0 ? jerry_acquire_value(this_obj) : held_this;
+        core_util_critical_section_enter();
+        held_this = held;
+        count = 0;
+        core_util_critical_section_exit();
+
+        if (held_cb != 0) {
+            jerry_release_value(held_cb);
+        }
+        held_cb = jerry_acquire_value(cb);
+    }
+
+    /**
+     * Drops the callback and the object, on the event loop; call it once
+     * the interrupt or thread no longer posts events. This may release the
+     * last reference to the native object
+     */
+    void stop() {
+        if (held_cb != 0) {
+            jerry_release_value(held_cb);
+            held_cb = 0;
+        }
+
+        // A delivery still posted uses the object and releases it itself.
+        // An event may be posting one right now, hence the critical section
+        jerry_value_t this_obj = 0;
+        core_util_critical_section_enter();
+        if (!posted) {
+            this_obj = held_this;
+            held_this = 0;
+        }
+        core_util_critical_section_exit();
+
+        if (this_obj != 0) {
+            jerry_release_value(this_obj);
+        }
+    }
+
+    /**
+     * Returns whether a callback is set, on the event loop
+     */
+    bool is_started() const {
+        return held_cb != 0;
+    }
+
+    /**
+     * Counts an event and posts a delivery unless one is waiting; does
+     * nothing once stopped. Safe in interrupt context and on other threads
+     */
+    void post(mbed::Callback<void()> deliver) {
+        core_util_critical_section_enter();
+        bool post_now = false;
+        if (held_this != 0) {
+            count++;
+            post_now = !posted;
+            posted = true;
+        }
+        core_util_critical_section_exit();
+
+        if (post_now) {
+            mbed::js::EventLoop::getInstance().nativeCallback(deliver);
+        }
+    }
+
+    /**
+     * Starts a delivery, first thing on the event loop; allows the next one
+     * so that newer events are not missed
+     * @param events Set to the number of events since the previous delivery
+     * @returns false if stopped since the delivery was posted: the object
+     *          kept for it is then released, which may free the native one,
+     *          so the caller returns without touching it
+     */
+    bool begin(uint32_t *events = NULL) {
+        bool stopped = held_cb == 0;
+        jerry_value_t kept = 0;
+
+        // Once stopped, take back the object together with the flag so that
+        // no further delivery is posted
+        core_util_critical_section_enter();
+        if (events != NULL) {
+            *events = count;
+        }
+        count = 0;
+        posted = false;
+        if (stopped) {
+            kept = held_this;
+            held_this = 0;
+        }
+        core_util_critical_section_exit();
+
+        if (stopped) {
+            if (kept != 0) {
+                jerry_release_value(kept);
+            }
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Acquires the object, for a delivery that calls back more than once;
+     * the callback may stop the delivery, release it when done
+     */
+    jerry_value_t keep() {
+        return jerry_acquire_value(held_this);
+    }
+
+    /**
+     * Calls the callback with the object as this, unless stopped. The callback
+     * may stop the delivery, so the native object may be freed on return
+     * unless kept
+     */
+    void call(const jerry_value_t *args, jerry_size_t args_count) {
+        if (held_cb == 0) {
+            return;
+        }
+
+        jerry_value_t this_obj = jerry_acquire_value(held_this);
+        jerry_value_t cb = jerry_acquire_value(held_cb);
+        jerry_value_t ret_val = jerry_call_function(cb, this_obj, args, args_count);
+
+        jerry_release_value(ret_val);
+        jerry_release_value(cb);
+        jerry_release_value(this_obj);
+    }
+};
+
+#endif // __JS_DELIVERY_H__
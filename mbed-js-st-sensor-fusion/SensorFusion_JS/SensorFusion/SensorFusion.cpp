@@ -0,0 +1,346 @@
+/**
+ ******************************************************************************
+ * @file    SensorFusion.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Fixed-point orientation filter for accelerometer, gyroscope
+ *          and magnetometer samples.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SensorFusion.h"
+
+#include <math.h>
+
+/* Defines -------------------------------------------------------------------*/
+
+#define Q30_HALF                    (SENSOR_FUSION_Q30_ONE / 2)
+
+/** mdps to Q30 rad/s after a 16 bit shift: pi / 180000 * 2^46. */
+#define GYRO_MDPS_TO_RAD            1228166276LL
+
+/** us to half a step in Q30 s after a 16 bit shift: 2^30 / 2000000 * 2^16. */
+#define US_TO_HALF_STEP             35184372LL
+
+#define RAD_TO_DEG                  57.2957795f
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** Constructor
+ * @brief	Creates a filter at rest with kp = 0.5, ki = 0 and the
+ *          magnetometer axes equal to the gyroscope axes.
+ */
+SensorFusion::SensorFusion() : mag_valid(false) {
+    mag_axes[0] = 1;
+    mag_axes[1] = 2;
+    mag_axes[2] = 3;
+    set_gains(0.5f, 0.0f);
+    reset();
+}
+
+/** set_gains
+ * @brief	Sets the feedback gains of the filter.
+ * @param	Proportional gain, how fast the accelerometer and magnetometer
+ *          pull the orientation, 0 to 8
+ * @param	Integral gain, how fast the gyroscope bias is learnt, 0 to 8
+ * @return	0 on success, 1 if a gain is out of range
+ */
+int SensorFusion::set_gains(float kp, float ki) {
+    if (!(kp >= 0.0f && kp <= 8.0f && ki >= 0.0f && ki <= 8.0f)) {
+        return 1;
+    }
+
+    two_kp = (int32_t)(2.0f * kp * 65536.0f + 0.5f);
+    two_ki = (int32_t)(2.0f * ki * 65536.0f + 0.5f);
+    return 0;
+}
+
+/** set_mag_axes
+ * @brief	Maps the magnetometer axes onto the gyroscope axes.
+ * @param	For the gyroscope x, y and z axes, the magnetometer axis along
+ *          them: 1, 2 or 3 for x, y or z, negative when opposite
+ * @return	0 on success, 1 if the axes are not a signed permutation
+ */
+int SensorFusion::set_mag_axes(const int8_t *axes) {
+    uint8_t used = 0;
+
+    for (int i = 0; i < 3; i++) {
+        int8_t axis = axes[i] < 0 ? -axes[i] : axes[i];
+        if (axis < 1 || axis > 3 || (used & (1 << axis))) {
+            return 1;
+        }
+        used |= 1 << axis;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        mag_axes[i] = axes[i];
+    }
+    mag_valid = false;
+    return 0;
+}
+
+/** reset
+ * @brief	Returns to the identity orientation and clears the learnt bias;
+ *          the next update only takes its time.
+ */
+void SensorFusion::reset() {
+    q[0] = SENSOR_FUSION_Q30_ONE;
+    q[1] = 0;
+    q[2] = 0;
+    q[3] = 0;
+    integral[0] = 0;
+    integral[1] = 0;
+    integral[2] = 0;
+    last_time = 0;
+    started = false;
+}
+
+/** set_mag
+ * @brief	Sets the magnetic field used by the next updates.
+ * @param	Magnetometer x, y, z, in mgauss
+ */
+void SensorFusion::set_mag(const int32_t *mag) {
+    int32_t aligned[3];
+
+    for (int i = 0; i < 3; i++) {
+        int8_t axis = mag_axes[i];
+        aligned[i] = axis < 0 ? -mag[-axis - 1] : mag[axis - 1];
+    }
+
+    mag_valid = normalize(aligned, this->mag);
+}
+
+/** update
+ * @brief	Integrates one gyroscope sample, corrected towards the gravity
+ *          measured by the accelerometer and the latest magnetic field.
+ * @param	Sample time, in us
+ * @param	Accelerometer x, y, z, in mg
+ * @param	Gyroscope x, y, z, in mdps
+ */
+void SensorFusion::update(uint64_t time, const int32_t *acc, const int32_t *gyro) {
+    if (!started || time <= last_time) {
+        started = true;
+        last_time = time;
+        return;
+    }
+
+    uint64_t step = time - last_time;
+    last_time = time;
+    if (step > SENSOR_FUSION_MAX_STEP_US) {
+        step = SENSOR_FUSION_MAX_STEP_US;
+    }
+    int64_t half_dt = ((int64_t)step * US_TO_HALF_STEP) >> 16;
+
+    int64_t q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+
+    // Rotation rate, Q30 rad/s
+    int64_t g[3];
+    for (int i = 0; i < 3; i++) {
+        g[i] = ((int64_t)gyro[i] * GYRO_MDPS_TO_RAD) >> 16;
+    }
+
+    // The feedback needs a measured direction; free fall leaves the gyroscope alone
+    int32_t a[3];
+    if (normalize(acc, a)) {
+        int64_t q0q0 = (q0 * q0) >> 30;
+        int64_t q0q1 = (q0 * q1) >> 30;
+        int64_t q0q2 = (q0 * q2) >> 30;
+        int64_t q0q3 = (q0 * q3) >> 30;
+        int64_t q1q1 = (q1 * q1) >> 30;
+        int64_t q1q2 = (q1 * q2) >> 30;
+        int64_t q1q3 = (q1 * q3) >> 30;
+        int64_t q2q2 = (q2 * q2) >> 30;
+        int64_t q2q3 = (q2 * q3) >> 30;
+        int64_t q3q3 = (q3 * q3) >> 30;
+
+        // Half the gravity direction estimated from the quaternion
+        int64_t halfvx = q1q3 - q0q2;
+        int64_t halfvy = q0q1 + q2q3;
+        int64_t halfvz = q0q0 - Q30_HALF + q3q3;
+
+        // Error between the measured and the estimated directions
+        int64_t e[3];
+        e[0] = ((int64_t)a[1] * halfvz - (int64_t)a[2] * halfvy) >> 30;
+        e[1] = ((int64_t)a[2] * halfvx - (int64_t)a[0] * halfvz) >> 30;
+        e[2] = ((int64_t)a[0] * halfvy - (int64_t)a[1] * halfvx) >> 30;
+
+        if (mag_valid) {
+            int64_t mx = mag[0], my = mag[1], mz = mag[2];
+
+            // Field in the earth frame, flattened onto north and down
+            int64_t hx = 2 * ((mx * (Q30_HALF - q2q2 - q3q3) + my * (q1q2 - q0q3) + mz * (q1q3 + q0q2)) >> 30);
+            int64_t hy = 2 * ((mx * (q1q2 + q0q3) + my * (Q30_HALF - q1q1 - q3q3) + mz * (q2q3 - q0q1)) >> 30);
+            int64_t bx = sqrt64((uint64_t)(hx * hx + hy * hy));
+            int64_t bz = 2 * ((mx * (q1q3 - q0q2) + my * (q2q3 + q0q1) + mz * (Q30_HALF - q1q1 - q2q2)) >> 30);
+
+            // Half the field direction estimated from the quaternion
+            int64_t halfwx = (bx * (Q30_HALF - q2q2 - q3q3) + bz * (q1q3 - q0q2)) >> 30;
+            int64_t halfwy = (bx * (q1q2 - q0q3) + bz * (q0q1 + q2q3)) >> 30;
+            int64_t halfwz = (bx * (q0q2 + q1q3) + bz * (Q30_HALF - q1q1 - q2q2)) >> 30;
+
+            e[0] += (my * halfwz - mz * halfwy) >> 30;
+            e[1] += (mz * halfwx - mx * halfwz) >> 30;
+            e[2] += (mx * halfwy - my * halfwx) >> 30;
+        }
+
+        for (int i = 0; i < 3; i++) {
+            if (two_ki > 0) {
+                // Rounded, a truncation would add up to a drift of the bias
+                integral[i] += ((((int64_t)two_ki * e[i] + (1 << 15)) >> 16) * (2 * half_dt) + (1LL << 29)) >> 30;
+                g[i] += integral[i];
+            } else {
+                integral[i] = 0;
+            }
+            g[i] += ((int64_t)two_kp * e[i]) >> 16;
+        }
+    }
+
+    // Half the rotation of this step, Q30 rad
+    for (int i = 0; i < 3; i++) {
+        g[i] = (g[i] * half_dt) >> 30;
+    }
+
+    int64_t n[4];
+    n[0] = q0 + ((-q1 * g[0] - q2 * g[1] - q3 * g[2]) >> 30);
+    n[1] = q1 + ((q0 * g[0] + q2 * g[2] - q3 * g[1]) >> 30);
+    n[2] = q2 + ((q0 * g[1] - q1 * g[2] + q3 * g[0]) >> 30);
+    n[3] = q3 + ((q0 * g[2] + q1 * g[1] - q2 * g[0]) >> 30);
+
+    // Renormalize; halved first so that a long step cannot overflow the sum
+    uint64_t n2 = 0;
+    for (int i = 0; i < 4; i++) {
+        int64_t h = n[i] >> 1;
+        n2 += (uint64_t)(h * h);
+    }
+
+    uint32_t norm = sqrt64(n2);
+    if (norm == 0) {
+        reset();
+        return;
+    }
+
+    for (int i = 0; i < 4; i++) {
+        q[i] = (int32_t)(n[i] * (1LL << 29) / norm);
+    }
+}
+
+/** get_quaternion
+ * @brief	Reads the orientation.
+ * @param	Destination for w, x, y, z, Q30
+ */
+void SensorFusion::get_quaternion(int32_t *q) {
+    for (int i = 0; i < 4; i++) {
+        q[i] = this->q[i];
+    }
+}
+
+/** to_euler
+ * @brief	Converts an orientation to angles.
+ * @param	Quaternion w, x, y, z, Q30
+ * @param	Destination for roll, pitch, yaw, in degrees
+ */
+void SensorFusion::to_euler(const int32_t *q, float *euler) {
+    float w = q[0] / (float)SENSOR_FUSION_Q30_ONE;
+    float x = q[1] / (float)SENSOR_FUSION_Q30_ONE;
+    float y = q[2] / (float)SENSOR_FUSION_Q30_ONE;
+    float z = q[3] / (float)SENSOR_FUSION_Q30_ONE;
+
+    float sin_pitch = 2.0f * (w * y - z * x);
+    if (sin_pitch > 1.0f) {
+        sin_pitch = 1.0f;
+    } else if (sin_pitch < -1.0f) {
+        sin_pitch = -1.0f;
+    }
+
+    euler[0] = atan2f(2.0f * (w * x + y * z), 1.0f - 2.0f * (x * x + y * y)) * RAD_TO_DEG;
+    euler[1] = asinf(sin_pitch) * RAD_TO_DEG;
+    euler[2] = atan2f(2.0f * (w * z + x * y), 1.0f - 2.0f * (y * y + z * z)) * RAD_TO_DEG;
+}
+
+/** sqrt64
+ * @brief	Integer square root, rounded down.
+ * @param	Value
+ * @return	Square root
+ */
+uint32_t SensorFusion::sqrt64(uint64_t x) {
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+
+    while (bit != 0) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
+
+/** normalize
+ * @brief	Scales a vector to unit length.
+ * @param	x, y, z, each below 2^20 in magnitude
+ * @param	Destination for the unit vector, Q30
+ * @return	false if the vector is zero
+ */
+bool SensorFusion::normalize(const int32_t *in, int32_t *out) {
+    int64_t n2 = 0;
+    for (int i = 0; i < 3; i++) {
+        n2 += (int64_t)in[i] * in[i];
+    }
+
+    if (n2 == 0) {
+        return false;
+    }
+
+    // Scaled up by 4^half so that the length has 31 significant bits; a field
+    // of a few hundred mgauss would otherwise only get a few parts in 1e5
+    uint64_t scaled = (uint64_t)n2;
+    int half = 0;
+    while (scaled < (1ULL << 60)) {
+        scaled <<= 2;
+        half++;
+    }
+    uint32_t norm = sqrt64(scaled);
+
+    for (int i = 0; i < 3; i++) {
+        out[i] = (int32_t)(in[i] * (1LL << (30 + half)) / norm);
+    }
+    return true;
+}
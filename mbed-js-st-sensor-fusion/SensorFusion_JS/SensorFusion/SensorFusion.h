@@ -0,0 +1,118 @@
+/**
+ ******************************************************************************
+ * @file    SensorFusion.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Fixed-point orientation filter for accelerometer, gyroscope
+ *          and magnetometer samples.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SENSOR_FUSION_H__
+#define __SENSOR_FUSION_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+/* Defines -------------------------------------------------------------------*/
+
+/** One in the Q30 format of the quaternion and the unit vectors. */
+#define SENSOR_FUSION_Q30_ONE       (1L << 30)
+
+/** Longest step integrated at once, in us; longer gaps are clamped. */
+#ifndef SENSOR_FUSION_MAX_STEP_US
+#define SENSOR_FUSION_MAX_STEP_US   100000
+#endif
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Mahony orientation filter in fixed point.
+ *
+ * The quaternion and the unit vectors are Q30, the rotation rates Q30 rad/s,
+ * and the inputs stay in the sensor units: mg, mdps and mgauss. An update
+ * costs a few dozen 32x32->64 bit multiplies, two integer square roots and
+ * no floating point, so it can run at the full output data rate of the
+ * gyroscope. The step is taken from the sample times, so a late or skipped
+ * sample does not bend the integration.
+ *
+ * The accelerometer corrects roll and pitch and, when set, the magnetometer
+ * corrects yaw; its axes must be aligned with the gyroscope first, see
+ * set_mag_axes().
+ */
+class SensorFusion {
+public:
+    /* Constructor. */
+    SensorFusion();
+
+    /* Configuration. */
+    int set_gains(float kp, float ki);
+    int set_mag_axes(const int8_t *axes);
+    void reset();
+
+    /* Filter. */
+    void update(uint64_t time, const int32_t *acc, const int32_t *gyro);
+    void set_mag(const int32_t *mag);
+    void get_quaternion(int32_t *q);
+
+    /* Conversion of a Q30 quaternion, for the consumer. */
+    static void to_euler(const int32_t *q, float *euler);
+
+private:
+    static uint32_t sqrt64(uint64_t x);
+    static bool normalize(const int32_t *in, int32_t *out);
+
+    /* Quaternion w, x, y, z, Q30. */
+    int32_t q[4];
+
+    /* Integral feedback, Q30 rad/s. */
+    int64_t integral[3];
+
+    /* Twice the proportional and integral gains, Q16. */
+    int32_t two_kp;
+    int32_t two_ki;
+
+    /* Magnetometer to gyroscope axes, +-1 to +-3. */
+    int8_t mag_axes[3];
+
+    /* Latest magnetometer direction, Q30. */
+    int32_t mag[3];
+    bool mag_valid;
+
+    /* Time of the previous update, in us. */
+    uint64_t last_time;
+    bool started;
+};
+
+#endif // __SENSOR_FUSION_H__
@@ -0,0 +1,376 @@
+/**
+ ******************************************************************************
+ * @file    SensorFusion_JS-js.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Native orientation fusion of hub samples, for use with
+ *          Javascript.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "jerryscript-mbed-util/logging.h"
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
+
+// Load the library that we'll wrap
+#include "SensorFusion_JS.h"
+
+#include "mbed.h"
+
+/* Class Implementation ------------------------------------------------------*/
+
+/**
+ * SensorFusion_JS#destructor
+ * Called if/when the SensorFusion_JS is GC'ed.
+ */
+void NAME_FOR_CLASS_NATIVE_DESTRUCTOR(SensorFusion_JS)(void *void_ptr) {
+    delete static_cast<SensorFusion_JS*>(void_ptr);
+}
+
+
+/**
+ * Type infomation of the native SensorFusion_JS pointer
+ * Set SensorFusion_JS#destructor as the free callback.
+ */
+static const jerry_object_native_info_t native_obj_type_info = {
+    .free_cb = NAME_FOR_CLASS_NATIVE_DESTRUCTOR(SensorFusion_JS)
+};
+
+
+/**
+ * SensorFusion_JS#init (native JavaScript method)
+ * @brief   Feeds the filter from the samples of a stopped sensor hub; the
+ *          sensors used no longer appear in the hub batches
+ * @param   SensorHub_JS object
+ * @param   Id of an LSM6DSL in the hub
+ * @param   Id of an LSM303AGR in the hub for the magnetometer (optional)
+ * @returns 0 on success, 1 if the hub is running or an id is invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorFusion_JS, init) {
+    CHECK_ARGUMENT_COUNT(SensorFusion_JS, init, (args_count == 2 || args_count == 3));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorFusion_JS, init, 0, object);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorFusion_JS, init, 1, number);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(SensorFusion_JS, init, 2, number, (args_count == 3));
+
+    // Unwrap native SensorFusion_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorFusion_JS pointer");
+    }
+
+    SensorFusion_JS *native_ptr = static_cast<SensorFusion_JS*>(void_ptr);
+
+    // Unwrap arguments
+    void *hub_ptr;
+    const jerry_object_native_info_t *hub_type_ptr;
+    bool hub_has_ptr = jerry_get_object_native_pointer(args[0], &hub_ptr, &hub_type_ptr);
+
+    if (!hub_has_ptr) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorHub_JS pointer");
+    }
+
+    // Cast the argument to C++
+    SensorHub_JS *hub = reinterpret_cast<SensorHub_JS*>(hub_ptr);
+
+    int imu_id = jerry_get_number_value(args[1]);
+    int mag_id = args_count == 3 ? (int)jerry_get_number_value(args[2]) : -1;
+
+    // Call the native function
+    int result = native_ptr->init(hub, imu_id, mag_id, this_obj);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorFusion_JS#set_gains (native JavaScript method)
+ * @brief   Sets the feedback gains, 0.5 and 0 by default
+ * @param   Proportional gain, how fast the accelerometer and magnetometer
+ *          correct the orientation, 0 to 8
+ * @param   Integral gain, how fast the gyroscope bias is learnt, 0 to 8
+ * @returns 0 on success, 1 if a gain is out of range
+ */
+DECLARE_CLASS_FUNCTION(SensorFusion_JS, set_gains) {
+    CHECK_ARGUMENT_COUNT(SensorFusion_JS, set_gains, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorFusion_JS, set_gains, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorFusion_JS, set_gains, 1, number);
+
+    // Unwrap native SensorFusion_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorFusion_JS pointer");
+    }
+
+    SensorFusion_JS *native_ptr = static_cast<SensorFusion_JS*>(void_ptr);
+
+    float kp = jerry_get_number_value(args[0]);
+    float ki = jerry_get_number_value(args[1]);
+
+    // Call the native function
+    int result = native_ptr->set_gains(kp, ki);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorFusion_JS#set_mag_axes (native JavaScript method)
+ * @brief   Maps the magnetometer axes onto the LSM6DSL axes
+ * @param   Array of the magnetometer axis along the LSM6DSL x, y and z axes:
+ *          1, 2 or 3 for x, y or z, negative when opposite; [1, 2, 3] by default
+ * @returns 0 on success, 1 if the axes are not a signed permutation
+ */
+DECLARE_CLASS_FUNCTION(SensorFusion_JS, set_mag_axes) {
+    CHECK_ARGUMENT_COUNT(SensorFusion_JS, set_mag_axes, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorFusion_JS, set_mag_axes, 0, object);
+
+    // Unwrap native SensorFusion_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorFusion_JS pointer");
+    }
+
+    SensorFusion_JS *native_ptr = static_cast<SensorFusion_JS*>(void_ptr);
+
+    // Unwrap arguments
+    int8_t axes[3];
+    for (int i = 0; i < 3; i++) {
+        jerry_value_t val = jerry_get_property_by_index(args[0], i);
+        axes[i] = jerry_value_is_number(val) ? (int8_t)jerry_get_number_value(val) : 0;
+        jerry_release_value(val);
+    }
+
+    // Call the native function
+    int result = native_ptr->set_mag_axes(axes);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorFusion_JS#reset (native JavaScript method)
+ * @brief   Returns to the identity orientation and clears the learnt bias
+ * @returns 0
+ */
+DECLARE_CLASS_FUNCTION(SensorFusion_JS, reset) {
+    CHECK_ARGUMENT_COUNT(SensorFusion_JS, reset, (args_count == 0));
+
+    // Unwrap native SensorFusion_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorFusion_JS pointer");
+    }
+
+    SensorFusion_JS *native_ptr = static_cast<SensorFusion_JS*>(void_ptr);
+
+    // Call the native function
+    native_ptr->reset();
+
+    return jerry_create_number(0);
+}
+
+/**
+ * SensorFusion_JS#start (native JavaScript method)
+ * @brief   Starts passing the orientation to JavaScript at a decimated rate;
+ *          the filter itself runs at the LSM6DSL rate of the hub
+ * @param   Output rate in Hz
+ * @param   Callback, called with the quaternion [w, x, y, z], the angles
+ *          [roll, pitch, yaw] in degrees and the time of the latest sample in
+ *          us from the hub timer
+ * @returns 0 on success, 1 if the rate is invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorFusion_JS, start) {
+    CHECK_ARGUMENT_COUNT(SensorFusion_JS, start, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorFusion_JS, start, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorFusion_JS, start, 1, function);
+
+    // Unwrap native SensorFusion_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorFusion_JS pointer");
+    }
+
+    SensorFusion_JS *native_ptr = static_cast<SensorFusion_JS*>(void_ptr);
+
+    float rate = jerry_get_number_value(args[0]);
+
+    // Call the native function
+    int result = native_ptr->start(rate, this_obj, args[1]);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorFusion_JS#stop (native JavaScript method)
+ * @brief   Stops passing the orientation to JavaScript
+ * @returns 0
+ */
+DECLARE_CLASS_FUNCTION(SensorFusion_JS, stop) {
+    CHECK_ARGUMENT_COUNT(SensorFusion_JS, stop, (args_count == 0));
+
+    // Unwrap native SensorFusion_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorFusion_JS pointer");
+    }
+
+    SensorFusion_JS *native_ptr = static_cast<SensorFusion_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->stop();
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorFusion_JS#get_quaternion (native JavaScript method)
+ * @brief   Gets the latest orientation
+ * @returns Array of [w, x, y, z]
+ */
+DECLARE_CLASS_FUNCTION(SensorFusion_JS, get_quaternion) {
+    CHECK_ARGUMENT_COUNT(SensorFusion_JS, get_quaternion, (args_count == 0));
+
+    // Unwrap native SensorFusion_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorFusion_JS pointer");
+    }
+
+    SensorFusion_JS *native_ptr = static_cast<SensorFusion_JS*>(void_ptr);
+
+    // Get the result from the C++ API
+    float q[4];
+    native_ptr->get_quaternion(q);
+
+    // Cast it back to JavaScript
+    jerry_value_t out = jerry_create_array(4);
+
+    for (int i = 0; i < 4; i++) {
+        jerry_value_t val = jerry_create_number(q[i]);
+        jerry_release_value(jerry_set_property_by_index(out, i, val));
+        jerry_release_value(val);
+    }
+
+    // Return the output
+    return out;
+}
+
+/**
+ * SensorFusion_JS#get_euler (native JavaScript method)
+ * @brief   Gets the latest orientation as angles
+ * @returns Array of [roll, pitch, yaw] in degrees
+ */
+DECLARE_CLASS_FUNCTION(SensorFusion_JS, get_euler) {
+    CHECK_ARGUMENT_COUNT(SensorFusion_JS, get_euler, (args_count == 0));
+
+    // Unwrap native SensorFusion_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorFusion_JS pointer");
+    }
+
+    SensorFusion_JS *native_ptr = static_cast<SensorFusion_JS*>(void_ptr);
+
+    // Get the result from the C++ API
+    float euler[3];
+    native_ptr->get_euler(euler);
+
+    // Cast it back to JavaScript
+    jerry_value_t out = jerry_create_array(3);
+
+    for (int i = 0; i < 3; i++) {
+        jerry_value_t val = jerry_create_number(euler[i]);
+        jerry_release_value(jerry_set_property_by_index(out, i, val));
+        jerry_release_value(val);
+    }
+
+    // Return the output
+    return out;
+}
+
+/**
+ * SensorFusion_JS (native JavaScript constructor)
+ * @brief   Constructor for Javascript wrapper
+ * @returns a JavaScript object representing SensorFusion_JS.
+ */
+DECLARE_CLASS_CONSTRUCTOR(SensorFusion_JS) {
+    CHECK_ARGUMENT_COUNT(SensorFusion_JS, __constructor, args_count == 0);
+    
+    // Extract native SensorFusion_JS pointer (from this object) 
+    SensorFusion_JS *native_ptr = new SensorFusion_JS();
+
+    jerry_value_t js_object = jerry_create_object();
+    jerry_set_object_native_pointer(js_object, native_ptr, &native_obj_type_info);
+
+    // attach methods
+    ATTACH_CLASS_FUNCTION(js_object, SensorFusion_JS, init);
+    ATTACH_CLASS_FUNCTION(js_object, SensorFusion_JS, set_gains);
+    ATTACH_CLASS_FUNCTION(js_object, SensorFusion_JS, set_mag_axes);
+    ATTACH_CLASS_FUNCTION(js_object, SensorFusion_JS, reset);
+    ATTACH_CLASS_FUNCTION(js_object, SensorFusion_JS, start);
+    ATTACH_CLASS_FUNCTION(js_object, SensorFusion_JS, stop);
+    ATTACH_CLASS_FUNCTION(js_object, SensorFusion_JS, get_quaternion);
+    ATTACH_CLASS_FUNCTION(js_object, SensorFusion_JS, get_euler);
+    
+    return js_object;
+}
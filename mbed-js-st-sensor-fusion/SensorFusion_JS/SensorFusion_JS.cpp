@@ -0,0 +1,296 @@
+/**
+ ******************************************************************************
+ * @file    SensorFusion_JS.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Native orientation fusion of hub samples, for use with
+ *          Javascript.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SensorFusion_JS.h"
+
+#include "mbed.h"
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** init
+ * @brief	Feeds the filter from the samples of a sensor hub, which then
+ *		no longer appear in its batches.
+ * @param	Hub the sensors were added to, stopped
+ * @param	Id of an LSM6DSL in the hub
+ * @param	Id of an LSM303AGR in the hub, or -1 without magnetometer
+ * @param	JavaScript object, kept alive by the hub
+ * @retval	0 on success, 1 if the hub is running or an id is invalid
+ */
+int SensorFusion_JS::init(SensorHub_JS *hub, int imu_id, int mag_id, jerry_value_t this_obj){
+	if(imu_id < 0 || imu_id > 255 || mag_id > 255 || mag_id == imu_id){
+		return 1;
+	}
+
+	if(hub->attach(imu_id, callback(this, &SensorFusion_JS::imu_sample), this_obj) != 0){
+		return 1;
+	}
+
+	if(mag_id >= 0 && hub->attach(mag_id, callback(this, &SensorFusion_JS::mag_sample), this_obj) != 0){
+		hub->attach(imu_id, SensorHubSink(), this_obj);
+		return 1;
+	}
+
+	return 0;
+}
+
+/** Destructor
+ * @brief	Stops the delivery.
+ */
+SensorFusion_JS::~SensorFusion_JS(){
+	stop();
+}
+
+/** set_gains
+ * @brief	Sets the feedback gains of the filter.
+ * @param	Proportional gain, 0 to 8
+ * @param	Integral gain, 0 to 8
+ * @retval	0 on success, 1 if a gain is out of range
+ */
+int SensorFusion_JS::set_gains(float kp, float ki){
+	mutex.lock();
+	int result = fusion.set_gains(kp, ki);
+	mutex.unlock();
+	return result;
+}
+
+/** set_mag_axes
+ * @brief	Maps the magnetometer axes onto the gyroscope axes.
+ * @param	Magnetometer axis along the gyroscope x, y and z axes, 1 to 3,
+ *		negative when opposite
+ * @retval	0 on success, 1 if the axes are not a signed permutation
+ */
+int SensorFusion_JS::set_mag_axes(const int8_t *axes){
+	mutex.lock();
+	int result = fusion.set_mag_axes(axes);
+	mutex.unlock();
+	return result;
+}
+
+/** reset
+ * @brief	Returns to the identity orientation.
+ */
+void SensorFusion_JS::reset(){
+	mutex.lock();
+	fusion.reset();
+	mutex.unlock();
+}
+
+/** start
+ * @brief	Starts passing the orientation to JavaScript.
+ * @param	Output rate in Hz, normally a fraction of the LSM6DSL rate
+ * @param	JavaScript object kept alive while delivering
+ * @param	JavaScript callback
+ * @retval	0 on success, 1 if the rate is invalid
+ */
+int SensorFusion_JS::start(float rate, jerry_value_t this_obj, jerry_value_t cb){
+	if(!(rate > 0.0f) || rate > 1000.0f){
+		return 1;
+	}
+
+	stop();
+
+	// Keep the object and the callback while the orientation may arrive,
+	// from before the hub thread can post a delivery
+	fusion_delivery.start(this_obj, cb);
+
+	mutex.lock();
+	out_period = (uint32_t)(1000000.0f / rate + 0.5f);
+	out_due = 0;
+	mutex.unlock();
+
+	return 0;
+}
+
+/** stop
+ * @brief	Stops passing the orientation to JavaScript; the filter keeps
+ *		running with the hub.
+ * @retval	0
+ */
+int SensorFusion_JS::stop(){
+	mutex.lock();
+	out_period = 0;
+	mutex.unlock();
+
+	// This may release the last reference to this object, so it comes last
+	fusion_delivery.stop();
+
+	return 0;
+}
+
+/** get_quaternion
+ * @brief	Reads the latest orientation.
+ * @param	Destination for w, x, y, z
+ */
+void SensorFusion_JS::get_quaternion(float *q){
+	int32_t fixed[4];
+
+	mutex.lock();
+	fusion.get_quaternion(fixed);
+	mutex.unlock();
+
+	for(int i = 0; i < 4; i++){
+		q[i] = fixed[i] / (float)SENSOR_FUSION_Q30_ONE;
+	}
+}
+
+/** get_euler
+ * @brief	Reads the latest orientation as angles.
+ * @param	Destination for roll, pitch, yaw, in degrees
+ */
+void SensorFusion_JS::get_euler(float *euler){
+	int32_t fixed[4];
+
+	mutex.lock();
+	fusion.get_quaternion(fixed);
+	mutex.unlock();
+
+	SensorFusion::to_euler(fixed, euler);
+}
+
+/** imu_sample
+ * @brief	Updates the filter with an LSM6DSL sample, on the hub thread.
+ * @param	[ax, ay, az, gx, gy, gz] in mg and mdps
+ */
+void SensorFusion_JS::imu_sample(const SensorHubSample *sample){
+	if(sample->count < 6){
+		return;
+	}
+
+	int32_t acc[3], gyro[3];
+	for(int i = 0; i < 3; i++){
+		acc[i] = (int32_t)sample->values[i];
+		gyro[i] = (int32_t)sample->values[3 + i];
+	}
+
+	bool due = false;
+
+	mutex.lock();
+
+	// The hub timer restarts with the hub
+	if(sample->time < fusion_time){
+		out_due = 0;
+	}
+
+	fusion.update(sample->time, acc, gyro);
+	fusion_time = sample->time;
+
+	// Output deadlines stay on the grid of the first sample after start()
+	if(out_period != 0 && sample->time >= out_due){
+		out_due = out_due == 0 ? sample->time + out_period : out_due + out_period;
+		if(out_due <= sample->time){
+			out_due = sample->time + out_period;
+		}
+		due = true;
+	}
+	mutex.unlock();
+
+	// A busy interpreter gets the latest orientation
+	if(due){
+		fusion_delivery.post(mbed::Callback<void()>(this, &SensorFusion_JS::deliver));
+	}
+}
+
+/** mag_sample
+ * @brief	Sets the magnetic field from an LSM303AGR sample, on the hub thread.
+ * @param	[ax, ay, az, mx, my, mz] in mg and mgauss
+ */
+void SensorFusion_JS::mag_sample(const SensorHubSample *sample){
+	if(sample->count < 6){
+		return;
+	}
+
+	int32_t mag[3];
+	for(int i = 0; i < 3; i++){
+		mag[i] = (int32_t)sample->values[3 + i];
+	}
+
+	mutex.lock();
+	fusion.set_mag(mag);
+	mutex.unlock();
+}
+
+/** deliver
+ * @brief	Passes the latest orientation to JavaScript, on the event loop.
+ */
+void SensorFusion_JS::deliver(){
+	// Stopped since this delivery was posted, this object may be freed
+	if(!fusion_delivery.begin()){
+		return;
+	}
+
+	int32_t fixed[4];
+	uint64_t time;
+
+	mutex.lock();
+	fusion.get_quaternion(fixed);
+	time = fusion_time;
+	mutex.unlock();
+
+	float euler[3];
+	SensorFusion::to_euler(fixed, euler);
+
+	jerry_value_t q_array = jerry_create_array(4);
+	for(int i = 0; i < 4; i++){
+		jerry_value_t val = jerry_create_number(fixed[i] / (double)SENSOR_FUSION_Q30_ONE);
+		jerry_release_value(jerry_set_property_by_index(q_array, i, val));
+		jerry_release_value(val);
+	}
+
+	jerry_value_t euler_array = jerry_create_array(3);
+	for(int i = 0; i < 3; i++){
+		jerry_value_t val = jerry_create_number(euler[i]);
+		jerry_release_value(jerry_set_property_by_index(euler_array, i, val));
+		jerry_release_value(val);
+	}
+
+	jerry_value_t args[3] = {
+		q_array,
+		euler_array,
+		jerry_create_number((double)time)
+	};
+
+	// The callback may stop the delivery and free this object
+	fusion_delivery.call(args, 3);
+
+	for(int i = 0; i < 3; i++){
+		jerry_release_value(args[i]);
+	}
+}
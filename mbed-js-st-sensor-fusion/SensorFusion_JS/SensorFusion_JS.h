@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file    SensorFusion_JS.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Native orientation fusion of hub samples, for use with
+ *          Javascript.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SENSOR_FUSION_JS_H__
+#define __SENSOR_FUSION_JS_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "mbed.h"
+#include "SensorFusion.h"
+#include "JsDelivery.h"
+#include "SensorHub_JS.h"
+
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Orientation of an LSM6DSL, and optionally an LSM303AGR, fused natively
+ * from the samples of a sensor hub for Javascript.
+ */
+class SensorFusion_JS {
+private:
+    /* Helper classes. */
+    SensorFusion fusion;
+    
+    /* Guards the filter and the output, shared with the hub thread. */
+    Mutex mutex;
+    
+    /* Time of the latest update, in us from the hub timer. */
+    uint64_t fusion_time = 0;
+    
+    /* Decimated delivery. */
+    uint32_t out_period = 0;
+    uint64_t out_due = 0;
+    JsDelivery fusion_delivery;
+    
+    void imu_sample(const SensorHubSample *sample);
+    void mag_sample(const SensorHubSample *sample);
+    void deliver();
+
+public:
+    /* Constructors */
+    SensorFusion_JS(){}
+    
+    int init(SensorHub_JS *hub, int imu_id, int mag_id, jerry_value_t this_obj);
+    
+    /* Destructor */
+    ~SensorFusion_JS();
+    
+    /* Declarations */
+    int set_gains(float kp, float ki);
+    int set_mag_axes(const int8_t *axes);
+    void reset();
+    int start(float rate, jerry_value_t this_obj, jerry_value_t cb);
+    int stop();
+    void get_quaternion(float *q);
+    void get_euler(float *euler);
+};
+
+#endif
@@ -0,0 +1,438 @@
+/**
+ ******************************************************************************
+ * @file    SensorHub.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Native scheduler sampling several sensors on a shared bus.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SensorHub.h"
+
+#if (SENSOR_HUB_RING_SIZE & (SENSOR_HUB_RING_SIZE - 1)) != 0
+#error "SENSOR_HUB_RING_SIZE must be a power of two"
+#endif
+
+/** Deadlines closer than this to the current tick are served by it, in us. */
+#ifndef SENSOR_HUB_MERGE_US
+#define SENSOR_HUB_MERGE_US         200
+#endif
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** Constructor
+ * @brief	Creates a hub with no sensors.
+ */
+SensorHub::SensorHub() :
+        num_sources(0), i2c(NULL), spi(NULL),
+        thread(osPriorityAboveNormal, SENSOR_HUB_STACK_SIZE),
+        queue(4 * EVENTS_EVENT_SIZE), thread_started(false),
+        running(false), tick_pending(false), ready_pending(false), next_due(0),
+        ticks(0), late_max(0), late_sum(0), busy_max(0), skipped(0), lost(0), errors(0),
+        head(0), tail(0) {
+}
+
+/** Destructor
+ * @brief	Stops sampling and the hub thread.
+ */
+SensorHub::~SensorHub() {
+    shutdown();
+}
+
+/** set_bus
+ * @brief	Sets the I2C bus shared by the sensors, locked during each tick.
+ * @param	I2C bus, or NULL
+ */
+void SensorHub::set_bus(I2C *i2c) {
+    this->i2c = i2c;
+    spi = NULL;
+}
+
+/** set_bus
+ * @brief	Sets the SPI bus shared by the sensors, locked during each tick.
+ * @param	SPI bus, or NULL
+ */
+void SensorHub::set_bus(SPI *spi) {
+    this->spi = spi;
+    i2c = NULL;
+}
+
+/** add
+ * @brief	Adds a sensor, sampled in the order the sensors were added.
+ * @param	Function reading one sample
+ * @param	Number of values it reads, up to SENSOR_HUB_MAX_VALUES
+ * @param	Sampling rate in Hz
+ * @return	Sensor id on success, -1 if the hub is running, full, or an
+ *          argument is invalid
+ */
+int SensorHub::add(SensorHubRead read, uint8_t count, float rate) {
+    if (running || num_sources == SENSOR_HUB_MAX_SOURCES ||
+        count == 0 || count > SENSOR_HUB_MAX_VALUES || !(rate > 0.0f) || rate > 1000000.0f) {
+        return -1;
+    }
+
+    Source *source = &sources[num_sources];
+    source->read = read;
+    source->sink = SensorHubSink();
+    source->count = count;
+    source->period = (uint32_t)(1000000.0f / rate + 0.5f);
+    source->due = 0;
+
+    return num_sources++;
+}
+
+/** attach
+ * @brief	Hands the samples of a sensor to a native sink instead of the ring.
+ * @param	Sensor id, as returned by add()
+ * @param	Sink, or an empty SensorHubSink to use the ring again
+ * @return	0 on success, -1 if the hub is running or the id is invalid
+ */
+int SensorHub::attach(uint8_t id, SensorHubSink sink) {
+    if (running || id >= num_sources) {
+        return -1;
+    }
+
+    sources[id].sink = sink;
+    return 0;
+}
+
+/** get_source
+ * @brief	Reads how a sensor is sampled.
+ * @param	Sensor id, as returned by add()
+ * @param	Destination for the number of values of a sample
+ * @param	Destination for the sampling rate in Hz
+ * @return	0 on success, -1 if the id is invalid
+ */
+int SensorHub::get_source(uint8_t id, uint8_t *count, float *rate) {
+    if (id >= num_sources) {
+        return -1;
+    }
+
+    *count = sources[id].count;
+    *rate = 1000000.0f / sources[id].period;
+    return 0;
+}
+
+/** start
+ * @brief	Starts sampling; every sensor is read at the first tick.
+ * @param	Called from the hub thread when samples are waiting
+ * @return	0 on success, 1 if the hub thread could not start, 2 if no
+ *          sensor was added
+ */
+int SensorHub::start(Callback<void()> ready) {
+    if (num_sources == 0) {
+        return 2;
+    }
+
+    stop();
+
+    if (!thread_started) {
+        if (thread.start(callback(&queue, &EventQueue::dispatch_forever)) != osOK) {
+            return 1;
+        }
+        thread_started = true;
+    }
+
+    this->ready = ready;
+    ready_pending = false;
+    tail = head;
+
+    ticks = 0;
+    late_max = 0;
+    late_sum = 0;
+    busy_max = 0;
+    skipped = 0;
+    lost = 0;
+    errors = 0;
+
+    for (uint8_t i = 0; i < num_sources; i++) {
+        sources[i].due = 0;
+    }
+    next_due = 0;
+
+    timer.reset();
+    timer.start();
+    running = true;
+
+    interrupt();
+
+    return 0;
+}
+
+/** stop
+ * @brief	Stops sampling; waiting samples can still be read. A tick
+ *          already running on the hub thread is waited for, so the sensor
+ *          reads and sinks are no longer called once this returns.
+ * @return	0
+ */
+int SensorHub::stop() {
+    if (!running) {
+        return 0;
+    }
+
+    running = false;
+    timeout.detach();
+
+    // Ticks run in order on the hub thread: once an empty event queued now
+    // has run, no tick is running and a tick queued meanwhile has returned
+    if (thread_started && Thread::gettid() != thread.get_id()) {
+        Semaphore done(0);
+        if (queue.call(&done, &Semaphore::release)) {
+            done.wait();
+        }
+    }
+
+    // Disarm the deadline a tick running until then may have set
+    timeout.detach();
+    timer.stop();
+
+    return 0;
+}
+
+/** shutdown
+ * @brief	Stops sampling and ends the hub thread for good, so nothing runs
+ *          on it any more; called before releasing what the sensor reads
+ *          and sinks use.
+ */
+void SensorHub::shutdown() {
+    stop();
+    if (thread_started) {
+        queue.break_dispatch();
+        thread.join();
+        thread_started = false;
+    }
+}
+
+/** is_running
+ * @brief	Checks whether the hub is started.
+ * @return	true while sampling
+ */
+bool SensorHub::is_running() {
+    return running;
+}
+
+/** acknowledge
+ * @brief	Allows the next ready callback, called by the consumer before
+ *          it reads the waiting samples.
+ */
+void SensorHub::acknowledge() {
+    ready_pending = false;
+}
+
+/** count
+ * @brief	Returns the number of samples waiting.
+ * @return	Number of samples
+ */
+size_t SensorHub::count() {
+    return head - tail;
+}
+
+/** read
+ * @brief	Removes the oldest samples, called by the consumer.
+ * @param	Destination
+ * @param	Largest number of samples to read
+ * @return	Number of samples read
+ */
+size_t SensorHub::read(SensorHubSample *samples, size_t n) {
+    uint32_t t = tail;
+    size_t waiting = head - t;
+
+    if (n > waiting) {
+        n = waiting;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        samples[i] = ring[(t + i) & (SENSOR_HUB_RING_SIZE - 1)];
+    }
+
+    // The samples must be copied before the hub thread can reuse their slots
+    __DMB();
+    tail = t + n;
+    return n;
+}
+
+/** get_stats
+ * @brief	Reads the scheduling statistics.
+ * @param	Destination
+ */
+void SensorHub::get_stats(SensorHubStats *stats) {
+    stats->ticks = ticks;
+    stats->late_max = late_max;
+    stats->late_avg = ticks ? (uint32_t)(late_sum / ticks) : 0;
+    stats->busy_max = busy_max;
+    stats->skipped = skipped;
+    stats->lost = lost;
+    stats->errors = errors;
+}
+
+/** interrupt
+ * @brief	Deadline reached, schedules a tick on the hub thread.
+ */
+void SensorHub::interrupt() {
+    if (!tick_pending) {
+        tick_pending = true;
+        queue.call(this, &SensorHub::tick);
+    }
+}
+
+/** lock_bus
+ * @brief	Takes the shared bus for the whole tick.
+ */
+void SensorHub::lock_bus() {
+    if (i2c != NULL) {
+        i2c->lock();
+    } else if (spi != NULL) {
+        spi->lock();
+    }
+}
+
+/** unlock_bus
+ * @brief	Releases the shared bus.
+ */
+void SensorHub::unlock_bus() {
+    if (i2c != NULL) {
+        i2c->unlock();
+    } else if (spi != NULL) {
+        spi->unlock();
+    }
+}
+
+/** tick
+ * @brief	Reads the sensors that are due and arms the next deadline, on
+ *          the hub thread.
+ */
+void SensorHub::tick() {
+    tick_pending = false;
+
+    if (!running) {
+        return;
+    }
+
+    uint64_t now = timer.read_high_resolution_us();
+    uint32_t late = now > next_due ? (uint32_t)(now - next_due) : 0;
+
+    ticks++;
+    late_sum += late;
+    if (late > late_max) {
+        late_max = late;
+    }
+
+    uint64_t first = 0;
+    bool sampled = false;
+    uint8_t num_sunk = 0;
+
+    lock_bus();
+
+    for (uint8_t i = 0; i < num_sources; i++) {
+        Source *source = &sources[i];
+
+        if (source->due > now + SENSOR_HUB_MERGE_US) {
+            continue;
+        }
+
+        uint32_t h = head;
+        SensorHubSample *sample = &ring[h & (SENSOR_HUB_RING_SIZE - 1)];
+        bool full = (h - tail == SENSOR_HUB_RING_SIZE);
+        float values[SENSOR_HUB_MAX_VALUES];
+
+        uint64_t time = timer.read_high_resolution_us();
+        if (!sampled) {
+            first = time;
+            sampled = true;
+        }
+
+        // Read even when the ring is full so that level interrupts are cleared
+        if (source->read(values)) {
+            errors++;
+        } else if (source->sink) {
+            SensorHubSample *out = &sunk[num_sunk++];
+            out->time = time;
+            out->id = i;
+            out->count = source->count;
+            memcpy(out->values, values, source->count * sizeof(float));
+        } else if (full) {
+            lost++;
+        } else {
+            sample->time = time;
+            sample->id = i;
+            sample->count = source->count;
+            memcpy(sample->values, values, source->count * sizeof(float));
+
+            // The sample must be stored before the consumer can see the new head
+            __DMB();
+            head = h + 1;
+        }
+
+        // Deadlines stay on the grid; periods missed during a stall are skipped
+        source->due += source->period;
+        if (source->due <= now) {
+            uint32_t missed = (uint32_t)((now - source->due) / source->period) + 1;
+            source->due += (uint64_t)missed * source->period;
+            skipped += missed;
+        }
+    }
+
+    if (sampled) {
+        uint32_t busy = (uint32_t)(timer.read_high_resolution_us() - first);
+        if (busy > busy_max) {
+            busy_max = busy;
+        }
+    }
+
+    unlock_bus();
+
+    // Sinks run off the bus so that they do not stretch the tick
+    for (uint8_t i = 0; i < num_sunk; i++) {
+        sources[sunk[i].id].sink(&sunk[i]);
+    }
+
+    if (count() > 0 && !ready_pending) {
+        ready_pending = true;
+        ready();
+    }
+
+    // Arm the earliest deadline
+    next_due = sources[0].due;
+    for (uint8_t i = 1; i < num_sources; i++) {
+        if (sources[i].due < next_due) {
+            next_due = sources[i].due;
+        }
+    }
+
+    if (!running) {
+        return;
+    }
+
+    now = timer.read_high_resolution_us();
+    timeout.attach_us(callback(this, &SensorHub::interrupt), next_due > now ? next_due - now : 1);
+}
@@ -0,0 +1,198 @@
+/**
+ ******************************************************************************
+ * @file    SensorHub.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Native scheduler sampling several sensors on a shared bus.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SENSOR_HUB_H__
+#define __SENSOR_HUB_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "mbed.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Number of sensors the hub can sample. */
+#ifndef SENSOR_HUB_MAX_SOURCES
+#define SENSOR_HUB_MAX_SOURCES      8
+#endif
+
+/** Largest number of values returned by one sensor read. */
+#ifndef SENSOR_HUB_MAX_VALUES
+#define SENSOR_HUB_MAX_VALUES       6
+#endif
+
+/** Number of samples held between the hub thread and the consumer, must be a power of two. */
+#ifndef SENSOR_HUB_RING_SIZE
+#define SENSOR_HUB_RING_SIZE        64
+#endif
+
+/** Stack size of the sampling thread. */
+#ifndef SENSOR_HUB_STACK_SIZE
+#define SENSOR_HUB_STACK_SIZE       1024
+#endif
+
+/* Types ---------------------------------------------------------------------*/
+
+/**
+ * Reads one sample of a sensor into values, returns 0 on success.
+ * Called on the hub thread with the shared bus locked.
+ */
+typedef Callback<int(float *values)> SensorHubRead;
+
+/** One timestamped sample of one sensor. */
+typedef struct {
+    uint64_t time;                          /*!< Hub timer when the read started, in us */
+    uint8_t id;                             /*!< Sensor, as returned by SensorHub::add() */
+    uint8_t count;                          /*!< Number of values */
+    float values[SENSOR_HUB_MAX_VALUES];
+} SensorHubSample;
+
+/**
+ * Consumes the samples of one sensor natively instead of the ring.
+ * Called on the hub thread after the bus is released, keep it short.
+ */
+typedef Callback<void(const SensorHubSample *sample)> SensorHubSink;
+
+/** Scheduling statistics since the hub was started. */
+typedef struct {
+    uint32_t ticks;                         /*!< Number of ticks run */
+    uint32_t late_max;                      /*!< Largest delay of a tick after its deadline, in us */
+    uint32_t late_avg;                      /*!< Average delay of a tick after its deadline, in us */
+    uint32_t busy_max;                      /*!< Longest tick from the first to the last transaction, in us */
+    uint32_t skipped;                       /*!< Periods skipped because a tick ran later than a period */
+    uint32_t lost;                          /*!< Samples dropped because the ring was full */
+    uint32_t errors;                        /*!< Failed sensor reads */
+} SensorHubStats;
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Samples several sensors at their own rates from one thread.
+ *
+ * A Timeout wakes the hub thread at the next deadline. The sensors due are
+ * read back to back, in the order they were added, while the shared bus is
+ * locked, so no other transaction gets in between and the bus does not idle
+ * between them. Each sample is timestamped from a hardware timer and stored
+ * in a ring; the ready callback is called from the hub thread when samples
+ * are waiting, and the consumer calls acknowledge() and read() from its own
+ * thread. Deadlines are absolute, so timing errors do not accumulate.
+ *
+ * A sensor with a sink attached skips the ring: its samples are handed to
+ * the sink on the hub thread at the sensor rate, so native consumers such
+ * as filters see every sample without waking the consumer thread.
+ */
+class SensorHub {
+public:
+    /* Constructor and destructor. */
+    SensorHub();
+    ~SensorHub();
+
+    /* Configuration, while stopped. */
+    void set_bus(I2C *i2c);
+    void set_bus(SPI *spi);
+    int add(SensorHubRead read, uint8_t count, float rate);
+    int attach(uint8_t id, SensorHubSink sink);
+    int get_source(uint8_t id, uint8_t *count, float *rate);
+
+    /* Control. */
+    int start(Callback<void()> ready);
+    int stop();
+    void shutdown();
+    bool is_running();
+
+    /* Consumer side. */
+    void acknowledge();
+    size_t count();
+    size_t read(SensorHubSample *samples, size_t n);
+    void get_stats(SensorHubStats *stats);
+
+private:
+    void interrupt();
+    void tick();
+    void lock_bus();
+    void unlock_bus();
+
+    typedef struct {
+        SensorHubRead read;
+        SensorHubSink sink;
+        uint8_t count;
+        uint32_t period;
+        uint64_t due;
+    } Source;
+
+    Source sources[SENSOR_HUB_MAX_SOURCES];
+    uint8_t num_sources;
+
+    I2C *i2c;
+    SPI *spi;
+
+    Thread thread;
+    EventQueue queue;
+    Timeout timeout;
+    Timer timer;
+    bool thread_started;
+
+    Callback<void()> ready;
+
+    volatile bool running;
+    volatile bool tick_pending;
+    volatile bool ready_pending;
+
+    /* Next deadline of the hub, written by the hub thread only. */
+    uint64_t next_due;
+
+    /* Statistics, written by the hub thread only. */
+    volatile uint32_t ticks;
+    volatile uint32_t late_max;
+    uint64_t late_sum;
+    volatile uint32_t busy_max;
+    volatile uint32_t skipped;
+    volatile uint32_t lost;
+    volatile uint32_t errors;
+
+    /* Samples of the tick waiting for their sinks, hub thread only. */
+    SensorHubSample sunk[SENSOR_HUB_MAX_SOURCES];
+
+    /* Sample ring; head is written by the hub thread, tail by the consumer. */
+    SensorHubSample ring[SENSOR_HUB_RING_SIZE];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+};
+
+#endif // __SENSOR_HUB_H__
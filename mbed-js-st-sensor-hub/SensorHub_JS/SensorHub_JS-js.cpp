@@ -0,0 +1,470 @@
+/**
+ ******************************************************************************
+ * @file    SensorHub_JS-js.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Native sampling scheduler for several sensors on a shared bus,
+ *          for use with Javascript.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "jerryscript-mbed-util/logging.h"
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
+
+// Load the library that we'll wrap
+#include "SensorHub_JS.h"
+
+#include "mbed.h"
+
+/* Class Implementation ------------------------------------------------------*/
+
+/**
+ * SensorHub_JS#destructor
+ * Called if/when the SensorHub_JS is GC'ed.
+ */
+void NAME_FOR_CLASS_NATIVE_DESTRUCTOR(SensorHub_JS)(void *void_ptr) {
+    delete static_cast<SensorHub_JS*>(void_ptr);
+}
+
+
+/**
+ * Type infomation of the native SensorHub_JS pointer
+ * Set SensorHub_JS#destructor as the free callback.
+ */
+static const jerry_object_native_info_t native_obj_type_info = {
+    .free_cb = NAME_FOR_CLASS_NATIVE_DESTRUCTOR(SensorHub_JS)
+};
+
+
+/**
+ * SensorHub_JS#init_i2c (native JavaScript method)
+ * @brief Sets the DevI2C bus shared by the sensors, held during each tick
+ * @param DevI2C object
+ */
+DECLARE_CLASS_FUNCTION(SensorHub_JS, init_i2c) {
+    CHECK_ARGUMENT_COUNT(SensorHub_JS, init_i2c, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorHub_JS, init_i2c, 0, object);
+
+    // Unwrap native SensorHub_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorHub_JS pointer");
+    }
+
+    SensorHub_JS *native_ptr = static_cast<SensorHub_JS*>(void_ptr);
+ 
+    // Unwrap arguments
+    void *i2c_ptr;
+    const jerry_object_native_info_t *i2c_type_ptr;
+    bool i2c_has_ptr = jerry_get_object_native_pointer(args[0], &i2c_ptr, &i2c_type_ptr);
+
+    // Check if we have the i2c pointer
+    if (!i2c_has_ptr) {
+        printf("Not a I2C input!");
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native DevI2C pointer");
+    }
+
+    // Cast the argument to C++
+    DevI2C* i2c = reinterpret_cast<DevI2C*>(i2c_ptr);
+
+    // Call the native function
+    native_ptr->init(*i2c);
+
+    return jerry_create_number(0);
+}
+
+/**
+ * SensorHub_JS#init_spi (native JavaScript method)
+ * @brief Sets the SPI bus shared by the sensors, held during each tick
+ * @param SPI object
+ */
+DECLARE_CLASS_FUNCTION(SensorHub_JS, init_spi) {
+    CHECK_ARGUMENT_COUNT(SensorHub_JS, init_spi, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorHub_JS, init_spi, 0, object);
+
+    // Unwrap native SensorHub_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorHub_JS pointer");
+    }
+
+    SensorHub_JS *native_ptr = static_cast<SensorHub_JS*>(void_ptr);
+ 
+    // Unwrap arguments
+    void *spi_ptr;
+    const jerry_object_native_info_t *spi_type_ptr;
+    bool spi_has_ptr = jerry_get_object_native_pointer(args[0], &spi_ptr, &spi_type_ptr);
+
+    // Check if we have the spi pointer
+    if (!spi_has_ptr) {
+        printf("Not a SPI input!");
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SPI pointer");
+    }
+
+    // Cast the argument to C++
+    SPI* spi = reinterpret_cast<SPI*>(spi_ptr);
+
+    // Call the native function
+    native_ptr->init(*spi);
+
+    return jerry_create_number(0);
+}
+
+/**
+ * SensorHub_JS#add_lsm6dsl (native JavaScript method)
+ * @brief   Adds an LSM6DSL sampled at its own rate, each sample holds
+ *          [ax, ay, az, gx, gy, gz] in mg and mdps
+ * @param   Initialized LSM6DSL_JS object
+ * @param   Sampling rate in Hz
+ * @returns Sensor id used in the batches, or -1 if the hub is running, full,
+ *          or the rate is invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorHub_JS, add_lsm6dsl) {
+    CHECK_ARGUMENT_COUNT(SensorHub_JS, add_lsm6dsl, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorHub_JS, add_lsm6dsl, 0, object);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorHub_JS, add_lsm6dsl, 1, number);
+
+    // Unwrap native SensorHub_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorHub_JS pointer");
+    }
+
+    SensorHub_JS *native_ptr = static_cast<SensorHub_JS*>(void_ptr);
+
+    // Unwrap arguments
+    void *sensor_ptr;
+    const jerry_object_native_info_t *sensor_type_ptr;
+    bool sensor_has_ptr = jerry_get_object_native_pointer(args[0], &sensor_ptr, &sensor_type_ptr);
+
+    if (!sensor_has_ptr) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM6DSL_JS pointer");
+    }
+
+    // Cast the argument to C++
+    LSM6DSL_JS *sensor = reinterpret_cast<LSM6DSL_JS*>(sensor_ptr);
+
+    float rate = jerry_get_number_value(args[1]);
+
+    // Call the native function
+    int result = native_ptr->add_lsm6dsl(sensor, rate, args[0]);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorHub_JS#add_lsm303agr (native JavaScript method)
+ * @brief   Adds an LSM303AGR sampled at its own rate, each sample holds
+ *          [ax, ay, az, mx, my, mz] in mg and mgauss
+ * @param   Initialized LSM303AGR_JS object
+ * @param   Sampling rate in Hz
+ * @returns Sensor id used in the batches, or -1 if the hub is running, full,
+ *          or the rate is invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorHub_JS, add_lsm303agr) {
+    CHECK_ARGUMENT_COUNT(SensorHub_JS, add_lsm303agr, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorHub_JS, add_lsm303agr, 0, object);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorHub_JS, add_lsm303agr, 1, number);
+
+    // Unwrap native SensorHub_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorHub_JS pointer");
+    }
+
+    SensorHub_JS *native_ptr = static_cast<SensorHub_JS*>(void_ptr);
+
+    // Unwrap arguments
+    void *sensor_ptr;
+    const jerry_object_native_info_t *sensor_type_ptr;
+    bool sensor_has_ptr = jerry_get_object_native_pointer(args[0], &sensor_ptr, &sensor_type_ptr);
+
+    if (!sensor_has_ptr) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LSM303AGR_JS pointer");
+    }
+
+    // Cast the argument to C++
+    LSM303AGR_JS *sensor = reinterpret_cast<LSM303AGR_JS*>(sensor_ptr);
+
+    float rate = jerry_get_number_value(args[1]);
+
+    // Call the native function
+    int result = native_ptr->add_lsm303agr(sensor, rate, args[0]);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorHub_JS#add_hts221 (native JavaScript method)
+ * @brief   Adds an HTS221 sampled at its own rate, each sample holds
+ *          [humidity, temperature] in % and degC
+ * @param   Initialized HTS221_JS object
+ * @param   Sampling rate in Hz
+ * @returns Sensor id used in the batches, or -1 if the hub is running, full,
+ *          or the rate is invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorHub_JS, add_hts221) {
+    CHECK_ARGUMENT_COUNT(SensorHub_JS, add_hts221, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorHub_JS, add_hts221, 0, object);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorHub_JS, add_hts221, 1, number);
+
+    // Unwrap native SensorHub_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorHub_JS pointer");
+    }
+
+    SensorHub_JS *native_ptr = static_cast<SensorHub_JS*>(void_ptr);
+
+    // Unwrap arguments
+    void *sensor_ptr;
+    const jerry_object_native_info_t *sensor_type_ptr;
+    bool sensor_has_ptr = jerry_get_object_native_pointer(args[0], &sensor_ptr, &sensor_type_ptr);
+
+    if (!sensor_has_ptr) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native HTS221_JS pointer");
+    }
+
+    // Cast the argument to C++
+    HTS221_JS *sensor = reinterpret_cast<HTS221_JS*>(sensor_ptr);
+
+    float rate = jerry_get_number_value(args[1]);
+
+    // Call the native function
+    int result = native_ptr->add_hts221(sensor, rate, args[0]);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorHub_JS#add_lps22hb (native JavaScript method)
+ * @brief   Adds an LPS22HB sampled at its own rate, each sample holds
+ *          [pressure, temperature] in hPa and degC
+ * @param   Initialized LPS22HB_JS object
+ * @param   Sampling rate in Hz
+ * @returns Sensor id used in the batches, or -1 if the hub is running, full,
+ *          or the rate is invalid
+ */
+DECLARE_CLASS_FUNCTION(SensorHub_JS, add_lps22hb) {
+    CHECK_ARGUMENT_COUNT(SensorHub_JS, add_lps22hb, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorHub_JS, add_lps22hb, 0, object);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorHub_JS, add_lps22hb, 1, number);
+
+    // Unwrap native SensorHub_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorHub_JS pointer");
+    }
+
+    SensorHub_JS *native_ptr = static_cast<SensorHub_JS*>(void_ptr);
+
+    // Unwrap arguments
+    void *sensor_ptr;
+    const jerry_object_native_info_t *sensor_type_ptr;
+    bool sensor_has_ptr = jerry_get_object_native_pointer(args[0], &sensor_ptr, &sensor_type_ptr);
+
+    if (!sensor_has_ptr) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native LPS22HB_JS pointer");
+    }
+
+    // Cast the argument to C++
+    LPS22HB_JS *sensor = reinterpret_cast<LPS22HB_JS*>(sensor_ptr);
+
+    float rate = jerry_get_number_value(args[1]);
+
+    // Call the native function
+    int result = native_ptr->add_lps22hb(sensor, rate, args[0]);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorHub_JS#start (native JavaScript method)
+ * @brief   Starts sampling the sensors that were added
+ * @param   Callback, called with a batch of samples and the number of samples
+ *          dropped since the previous batch. The batch is a flat array of
+ *          [time, id, count, value 1, ... value count, time, id, ...] with
+ *          the time in us from the hub timer
+ * @returns 0 on success, 1 if the hub thread could not start, 2 if no sensor
+ *          was added
+ */
+DECLARE_CLASS_FUNCTION(SensorHub_JS, start) {
+    CHECK_ARGUMENT_COUNT(SensorHub_JS, start, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SensorHub_JS, start, 0, function);
+
+    // Unwrap native SensorHub_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorHub_JS pointer");
+    }
+
+    SensorHub_JS *native_ptr = static_cast<SensorHub_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->start(this_obj, args[0]);
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorHub_JS#stop (native JavaScript method)
+ * @brief   Stops sampling
+ * @returns 0
+ */
+DECLARE_CLASS_FUNCTION(SensorHub_JS, stop) {
+    CHECK_ARGUMENT_COUNT(SensorHub_JS, stop, (args_count == 0));
+
+    // Unwrap native SensorHub_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorHub_JS pointer");
+    }
+
+    SensorHub_JS *native_ptr = static_cast<SensorHub_JS*>(void_ptr);
+
+    // Call the native function
+    int result = native_ptr->stop();
+
+    return jerry_create_number(result);
+}
+
+/**
+ * SensorHub_JS#get_stats (native JavaScript method)
+ * @brief   Gets the scheduling statistics since the hub was started
+ * @returns Array of [ticks, largest delay of a tick in us, average delay of a
+ *          tick in us, longest tick on the bus in us, skipped periods, lost
+ *          samples, failed reads]
+ */
+DECLARE_CLASS_FUNCTION(SensorHub_JS, get_stats) {
+    CHECK_ARGUMENT_COUNT(SensorHub_JS, get_stats, (args_count == 0));
+
+    // Unwrap native SensorHub_JS object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SensorHub_JS pointer");
+    }
+
+    SensorHub_JS *native_ptr = static_cast<SensorHub_JS*>(void_ptr);
+
+    // Get the result from the C++ API
+    SensorHubStats stats;
+    native_ptr->get_stats(&stats);
+
+    uint32_t values[7] = {
+        stats.ticks, stats.late_max, stats.late_avg, stats.busy_max,
+        stats.skipped, stats.lost, stats.errors
+    };
+
+    // Cast it back to JavaScript
+    jerry_value_t out = jerry_create_array(7);
+
+    for (int i = 0; i < 7; i++) {
+        jerry_value_t val = jerry_create_number(values[i]);
+        jerry_release_value(jerry_set_property_by_index(out, i, val));
+        jerry_release_value(val);
+    }
+
+    // Return the output
+    return out;
+}
+
+/**
+ * SensorHub_JS (native JavaScript constructor)
+ * @brief   Constructor for Javascript wrapper
+ * @returns a JavaScript object representing SensorHub_JS.
+ */
+DECLARE_CLASS_CONSTRUCTOR(SensorHub_JS) {
+    CHECK_ARGUMENT_COUNT(SensorHub_JS, __constructor, args_count == 0);
+    
+    // Extract native SensorHub_JS pointer (from this object) 
+    SensorHub_JS *native_ptr = new SensorHub_JS();
+
+    jerry_value_t js_object = jerry_create_object();
+    jerry_set_object_native_pointer(js_object, native_ptr, &native_obj_type_info);
+
+    // attach methods
+    ATTACH_CLASS_FUNCTION(js_object, SensorHub_JS, init_i2c);
+    ATTACH_CLASS_FUNCTION(js_object, SensorHub_JS, init_spi);
+    ATTACH_CLASS_FUNCTION(js_object, SensorHub_JS, add_lsm6dsl);
+    ATTACH_CLASS_FUNCTION(js_object, SensorHub_JS, add_lsm303agr);
+    ATTACH_CLASS_FUNCTION(js_object, SensorHub_JS, add_hts221);
+    ATTACH_CLASS_FUNCTION(js_object, SensorHub_JS, add_lps22hb);
+    ATTACH_CLASS_FUNCTION(js_object, SensorHub_JS, start);
+    ATTACH_CLASS_FUNCTION(js_object, SensorHub_JS, stop);
+    ATTACH_CLASS_FUNCTION(js_object, SensorHub_JS, get_stats);
+    
+    return js_object;
+}
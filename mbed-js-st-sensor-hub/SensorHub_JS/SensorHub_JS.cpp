@@ -0,0 +1,330 @@
+/**
+ ******************************************************************************
+ * @file    SensorHub_JS.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Native sampling scheduler for several sensors on a shared bus,
+ *          for use with Javascript.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "SensorHub_JS.h"
+
+#include "mbed.h"
+
+/* Samples copied out of the hub per step when delivering a batch */
+#define SENSOR_HUB_JS_DELIVER_STEP 8
+
+/* Sensor reads, called on the hub thread ------------------------------------*/
+
+/* Accelerometer x, y, z in mg then gyroscope x, y, z in mdps */
+static int read_lsm6dsl(LSM6DSL_JS *sensor, float *values)
+{
+	int32_t axes[6];
+	if(sensor->get_axes(axes)){
+		return 1;
+	}
+	for(int i = 0; i < 6; i++){
+		values[i] = axes[i];
+	}
+	return 0;
+}
+
+/* Accelerometer x, y, z in mg then magnetometer x, y, z in mgauss */
+static int read_lsm303agr(LSM303AGR_JS *sensor, float *values)
+{
+	int32_t axes[6];
+	if(sensor->get_axes(axes)){
+		return 1;
+	}
+	for(int i = 0; i < 6; i++){
+		values[i] = axes[i];
+	}
+	return 0;
+}
+
+/* Humidity in % then temperature in degC */
+static int read_hts221(HTS221_JS *sensor, float *values)
+{
+	return sensor->get_humidity_temperature(&values[0], &values[1]);
+}
+
+/* Pressure in hPa then temperature in degC */
+static int read_lps22hb(LPS22HB_JS *sensor, float *values)
+{
+	return sensor->get_pressure_temperature(&values[0], &values[1]);
+}
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** init
+ * @brief	Sets the DevI2C bus shared by the sensors, held during each tick.
+ * @param	DevI2c object of helper class which handles the DevI2C peripheral
+ */
+void SensorHub_JS::init(DevI2C &devI2c){
+	hub.set_bus(&devI2c);
+}
+
+/** init
+ * @brief	Sets the SPI bus shared by the sensors, held during each tick.
+ * @param	SPI object of helper class which handles the SPI peripheral
+ */
+void SensorHub_JS::init(SPI &spi){
+	hub.set_bus(&spi);
+}
+
+/** Destructor
+ * @brief	Stops sampling and releases the sensor objects, once the hub
+ *		thread, which reads them and calls the consumers, has ended.
+ */
+SensorHub_JS::~SensorHub_JS(){
+	hub.shutdown();
+	for(uint8_t i = 0; i < num_sensors; i++){
+		jerry_release_value(sensors[i]);
+		if(consumers[i] != 0){
+			jerry_release_value(consumers[i]);
+		}
+	}
+}
+
+/** add
+ * @brief	Adds a sensor read to the hub.
+ * @param	Function reading one sample
+ * @param	Number of values per sample
+ * @param	Sampling rate in Hz
+ * @param	JavaScript sensor object, kept alive by the hub
+ * @retval	Sensor id, or -1 if the hub is running, full, or the rate is invalid
+ */
+int SensorHub_JS::add(SensorHubRead read, uint8_t count, float rate, jerry_value_t sensor_obj){
+	int id = hub.add(read, count, rate);
+	if(id < 0){
+		return -1;
+	}
+	sensors[num_sensors++] = jerry_acquire_value(sensor_obj);
+	return id;
+}
+
+/** add_lsm6dsl
+ * @brief	Samples accelerometer and gyroscope of an LSM6DSL in one transaction.
+ * @param	Initialized LSM6DSL_JS
+ * @param	Sampling rate in Hz
+ * @param	JavaScript sensor object
+ * @retval	Sensor id, or -1 on error
+ */
+int SensorHub_JS::add_lsm6dsl(LSM6DSL_JS *sensor, float rate, jerry_value_t sensor_obj){
+	return add(callback(read_lsm6dsl, sensor), 6, rate, sensor_obj);
+}
+
+/** add_lsm303agr
+ * @brief	Samples accelerometer and magnetometer of an LSM303AGR.
+ * @param	LSM303AGR_JS with both sensors initialized
+ * @param	Sampling rate in Hz
+ * @param	JavaScript sensor object
+ * @retval	Sensor id, or -1 on error
+ */
+int SensorHub_JS::add_lsm303agr(LSM303AGR_JS *sensor, float rate, jerry_value_t sensor_obj){
+	return add(callback(read_lsm303agr, sensor), 6, rate, sensor_obj);
+}
+
+/** add_hts221
+ * @brief	Samples humidity and temperature of an HTS221.
+ * @param	Initialized HTS221_JS
+ * @param	Sampling rate in Hz
+ * @param	JavaScript sensor object
+ * @retval	Sensor id, or -1 on error
+ */
+int SensorHub_JS::add_hts221(HTS221_JS *sensor, float rate, jerry_value_t sensor_obj){
+	return add(callback(read_hts221, sensor), 2, rate, sensor_obj);
+}
+
+/** add_lps22hb
+ * @brief	Samples pressure and temperature of an LPS22HB.
+ * @param	Initialized LPS22HB_JS
+ * @param	Sampling rate in Hz
+ * @param	JavaScript sensor object
+ * @retval	Sensor id, or -1 on error
+ */
+int SensorHub_JS::add_lps22hb(LPS22HB_JS *sensor, float rate, jerry_value_t sensor_obj){
+	return add(callback(read_lps22hb, sensor), 2, rate, sensor_obj);
+}
+
+/** attach
+ * @brief	Hands the samples of a sensor to a native consumer instead of
+ *		the batches, on the hub thread.
+ * @param	Sensor id
+ * @param	Sink of the consumer, or an empty sink to detach it
+ * @param	JavaScript object of the consumer, kept alive by the hub
+ *		while attached
+ * @retval	0 on success, -1 if the hub is running or the id is invalid
+ */
+int SensorHub_JS::attach(uint8_t id, SensorHubSink sink, jerry_value_t consumer_obj){
+	if(hub.attach(id, sink) != 0){
+		return -1;
+	}
+	if(consumers[id] != 0){
+		jerry_release_value(consumers[id]);
+		consumers[id] = 0;
+	}
+	if(sink){
+		consumers[id] = jerry_acquire_value(consumer_obj);
+	}
+	return 0;
+}
+
+/** get_source
+ * @brief	Reads how a sensor is sampled, for native consumers.
+ * @param	Sensor id
+ * @param	Destination for the number of values of a sample
+ * @param	Destination for the sampling rate in Hz
+ * @retval	0 on success, -1 if the id is invalid
+ */
+int SensorHub_JS::get_source(uint8_t id, uint8_t *count, float *rate){
+	return hub.get_source(id, count, rate);
+}
+
+/** start
+ * @brief	Starts sampling.
+ * @param	JavaScript object kept alive while sampling
+ * @param	JavaScript callback, called with a batch of samples and the
+ *		number of samples dropped since the previous batch
+ * @retval	0 on success, 1 if the hub thread could not start, 2 if no
+ *		sensor was added
+ */
+int SensorHub_JS::start(jerry_value_t this_obj, jerry_value_t cb){
+	stop();
+
+	hub_lost = 0;
+
+	// Keep the object and the callback while samples may arrive, from before
+	// the hub can post a delivery
+	hub_delivery.start(this_obj, cb);
+
+	int result = hub.start(callback(this, &SensorHub_JS::ready));
+	if(result != 0){
+		stop();
+		return result;
+	}
+
+	return 0;
+}
+
+/** stop
+ * @brief	Stops sampling.
+ * @retval	0
+ */
+int SensorHub_JS::stop(){
+	int result = hub.stop();
+
+	// This may release the last reference to this object, so it comes last
+	hub_delivery.stop();
+
+	return result;
+}
+
+/** get_stats
+ * @brief	Reads the scheduling statistics since the hub was started.
+ * @param	Destination
+ */
+void SensorHub_JS::get_stats(SensorHubStats *stats){
+	hub.get_stats(stats);
+}
+
+/** ready
+ * @brief	Called from the hub thread when samples are waiting.
+ */
+void SensorHub_JS::ready(){
+	// Later samples are read by a delivery already waiting
+	hub_delivery.post(mbed::Callback<void()>(this, &SensorHub_JS::deliver));
+}
+
+/** deliver
+ * @brief	Passes the waiting samples to JavaScript as one batch, on the
+ *		event loop.
+ */
+void SensorHub_JS::deliver(){
+	// Stopped since this delivery was posted, this object may be freed
+	if(!hub_delivery.begin()){
+		return;
+	}
+
+	// Allow the next notification first so that samples pushed meanwhile are not missed
+	hub.acknowledge();
+
+	// Only the samples already waiting, a fast hub must not keep us here
+	size_t waiting = hub.count();
+
+	jerry_value_t out_array = jerry_create_array(0);
+	uint32_t index = 0;
+
+	SensorHubSample samples[SENSOR_HUB_JS_DELIVER_STEP];
+	while(waiting > 0){
+		size_t n = hub.read(samples, waiting < SENSOR_HUB_JS_DELIVER_STEP ? waiting : SENSOR_HUB_JS_DELIVER_STEP);
+		if(n == 0){
+			break;
+		}
+		waiting -= n;
+
+		for(size_t i = 0; i < n; i++){
+			jerry_value_t header[3] = {
+				jerry_create_number((double)samples[i].time),
+				jerry_create_number(samples[i].id),
+				jerry_create_number(samples[i].count)
+			};
+			for(int k = 0; k < 3; k++){
+				jerry_release_value(jerry_set_property_by_index(out_array, index++, header[k]));
+				jerry_release_value(header[k]);
+			}
+			for(uint8_t k = 0; k < samples[i].count; k++){
+				jerry_value_t val = jerry_create_number(samples[i].values[k]);
+				jerry_release_value(jerry_set_property_by_index(out_array, index++, val));
+				jerry_release_value(val);
+			}
+		}
+	}
+
+	SensorHubStats stats;
+	hub.get_stats(&stats);
+
+	jerry_value_t args[2] = {
+		out_array,
+		jerry_create_number(stats.lost - hub_lost)
+	};
+	hub_lost = stats.lost;
+
+	// The callback may stop the hub and free this object
+	hub_delivery.call(args, 2);
+
+	jerry_release_value(args[0]);
+	jerry_release_value(args[1]);
+}
@@ -0,0 +1,105 @@
+/**
+ ******************************************************************************
+ * @file    SensorHub_JS.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Native sampling scheduler for several sensors on a shared bus,
+ *          for use with Javascript.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __SENSOR_HUB_JS_H__
+#define __SENSOR_HUB_JS_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "mbed.h"
+#include "SensorHub.h"
+#include "JsDelivery.h"
+#include "LSM6DSL_JS.h"
+#include "LSM303AGR_JS.h"
+#include "HTS221_JS.h"
+#include "LPS22HB_JS.h"
+
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Samples several sensor objects at their own rates for Javascript.
+ */
+class SensorHub_JS {
+private:
+    /* Helper classes. */
+    SensorHub hub;
+    
+    /* Sensor objects kept alive while the hub may read them. */
+    jerry_value_t sensors[SENSOR_HUB_MAX_SOURCES];
+    uint8_t num_sensors = 0;
+    
+    /* Native consumers kept alive while the hub may call their sinks. */
+    jerry_value_t consumers[SENSOR_HUB_MAX_SOURCES] = {0};
+    
+    /* Delivery. */
+    JsDelivery hub_delivery;
+    uint32_t hub_lost = 0;
+    
+    int add(SensorHubRead read, uint8_t count, float rate, jerry_value_t sensor_obj);
+    void ready();
+    void deliver();
+
+public:
+    /* Constructors */
+    SensorHub_JS(){}
+    
+    void init(DevI2C &devI2c);
+    void init(SPI &spi);
+    
+    /* Destructor */
+    ~SensorHub_JS();
+    
+    /* Declarations */
+    int add_lsm6dsl(LSM6DSL_JS *sensor, float rate, jerry_value_t sensor_obj);
+    int add_lsm303agr(LSM303AGR_JS *sensor, float rate, jerry_value_t sensor_obj);
+    int add_hts221(HTS221_JS *sensor, float rate, jerry_value_t sensor_obj);
+    int add_lps22hb(LPS22HB_JS *sensor, float rate, jerry_value_t sensor_obj);
+    int attach(uint8_t id, SensorHubSink sink, jerry_value_t consumer_obj);
+    int get_source(uint8_t id, uint8_t *count, float *rate);
+    int start(jerry_value_t this_obj, jerry_value_t cb);
+    int stop();
+    void get_stats(SensorHubStats *stats);
+};
+
+#endif
@@ -42,33 +42,44 @@
  * @brief	Constructor.
  */
 SerialBuffer::SerialBuffer() {
-    position = 0;
+    capacity = SERIAL_BUFFER_INITIAL_SIZE;
+    buffer = new char[capacity];
+    gap_start = 0;
+    gap_end = capacity;
 }
 
 /** destructor
  * @brief	Destructor.
  */
 SerialBuffer::~SerialBuffer() {
-    position = 0;
+    delete[] buffer;
 }
 
 /** clear
  * @brief	Clears the buffer.
  */
 void SerialBuffer::clear() {
-    buffer.clear();
-    position = 0;
+    gap_start = 0;
+    gap_end = capacity;
 }
 
 /** add
  * @brief	Adds string to buffer.
  * @param	string data
  */
-void SerialBuffer::add(string s) {
-    for(string::iterator it = s.begin(); it != s.end(); ++it) {
-        buffer.insert(buffer.begin() + position, *it);
-        position++;
-    }
+void SerialBuffer::add(const string &s) {
+    add(s.data(), s.length());
+}
+
+/** add
+ * @brief	Adds characters to buffer at the current position.
+ * @param	Characters
+ * @param	Number of characters
+ */
+void SerialBuffer::add(const char *data, size_t length) {
+    reserve(length);
+    memcpy(buffer + gap_start, data, length);
+    gap_start += length;
 }
 
 /** add
@@ -76,24 +87,29 @@ void SerialBuffer::add(string s) {
  * @param	Character
  */
 void SerialBuffer::add(char c) {
-    buffer.insert(buffer.begin() + position, c);
-    position++;
+    reserve(1);
+    buffer[gap_start++] = c;
 }
 
-/** begin
- * @brief	Returns the beginning of buffer.
- * @return  buffer begin iterator
+/** remove
+ * @brief	Removes the character before the current position.
+ * @return  false if at the beginning of the buffer
  */
-vector<char>::iterator SerialBuffer::begin() {
-    return buffer.begin();
+bool SerialBuffer::remove() {
+    if (gap_start == 0) {
+        return false;
+    }
+    gap_start--;
+    return true;
 }
 
-/** end
- * @brief	Returns the end of buffer.
- * @return  buffer end iterator
+/** truncate
+ * @brief	Keeps only the first characters, the position moves to the end.
+ * @param	Number of characters kept
  */
-vector<char>::iterator SerialBuffer::end() {
-    return buffer.end();
+void SerialBuffer::truncate(size_t length) {
+    setPosition(length);
+    gap_end = capacity;
 }
 
 /** getPosition
@@ -101,7 +117,7 @@ vector<char>::iterator SerialBuffer::end() {
  * @return  Position
  */
 size_t SerialBuffer::getPosition() {
-    return position;
+    return gap_start;
 }
 
 /** setPosition
@@ -109,7 +125,24 @@ size_t SerialBuffer::getPosition() {
  * @param	Position
  */
 void SerialBuffer::setPosition(size_t pos) {
-    position = pos;
+    if (pos > size()) {
+        pos = size();
+    }
+
+    if (pos < gap_start) {
+        // Move the characters between pos and the cursor after the gap
+        size_t count = gap_start - pos;
+        memmove(buffer + gap_end - count, buffer + pos, count);
+        gap_start -= count;
+        gap_end -= count;
+    }
+    else if (pos > gap_start) {
+        // Move the characters between the cursor and pos before the gap
+        size_t count = pos - gap_start;
+        memmove(buffer + gap_start, buffer + gap_end, count);
+        gap_start += count;
+        gap_end += count;
+    }
 }
 
 /** size
@@ -117,7 +150,18 @@ void SerialBuffer::setPosition(size_t pos) {
  * @return  Buffer size
  */
 size_t SerialBuffer::size() {
-    return buffer.size();
+    return capacity - (gap_end - gap_start);
+}
+
+/** getTail
+ * @brief	Returns the characters after the current position, e.g. to
+ *          redraw the end of the line after an edit.
+ * @param	Set to the number of characters
+ * @return  Characters, not null terminated
+ */
+const char *SerialBuffer::getTail(size_t *length) {
+    *length = capacity - gap_end;
+    return buffer + gap_end;
 }
 
 /** get_string
@@ -125,17 +169,47 @@ size_t SerialBuffer::size() {
  * @return  Buffer string
  */
 string SerialBuffer::get_string(){
-    string s(buffer.begin(), buffer.end());
+    string s;
+    s.reserve(size());
+    s.append(buffer, gap_start);
+    s.append(buffer + gap_end, capacity - gap_end);
     return s;
 }
 
 /** get_char_array
- * @brief	Returns the buffer as char array.
+ * @brief	Returns the buffer as null terminated char array, without copying.
+ *          The cursor is moved to the end of the buffer and the pointer stays
+ *          valid until the buffer is modified.
  * @return  Buffer character array
  */
 char *SerialBuffer::get_char_array(){
-    string s(buffer.begin(), buffer.end());
-    char *data = (char *)s.c_str();
-    data[buffer.size()] = '\0';
-    return data;
+    setPosition(size());
+    reserve(1);
+    buffer[gap_start] = '\0';
+    return buffer;
+}
+
+/** reserve
+ * @brief	Makes the gap at least length characters long.
+ * @param	Number of characters
+ */
+void SerialBuffer::reserve(size_t length) {
+    if (gap_end - gap_start >= length) {
+        return;
+    }
+
+    size_t tail = capacity - gap_end;
+    size_t new_capacity = capacity * 2;
+    while (new_capacity - size() < length) {
+        new_capacity *= 2;
+    }
+
+    char *new_buffer = new char[new_capacity];
+    memcpy(new_buffer, buffer, gap_start);
+    memcpy(new_buffer + new_capacity - tail, buffer + gap_end, tail);
+    delete[] buffer;
+
+    buffer = new_buffer;
+    gap_end = new_capacity - tail;
+    capacity = new_capacity;
 }
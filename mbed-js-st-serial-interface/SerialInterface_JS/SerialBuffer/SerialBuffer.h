@@ -44,10 +44,22 @@
 using namespace std;
 #include <string>
 #include "mbed.h"
-#include <vector>
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Initial capacity of the buffer, it doubles when full. */
+#ifndef SERIAL_BUFFER_INITIAL_SIZE
+#define SERIAL_BUFFER_INITIAL_SIZE  64
+#endif
 
 /* Class Declaration ---------------------------------------------------------*/
 
+/**
+ * Line buffer of the REPL, stored as a gap buffer: the text before the cursor
+ * sits at the start of the array, the text after it at the end, and the free
+ * space (the gap) is at the cursor. Inserting or deleting at the cursor is
+ * O(1); moving the cursor moves only the bytes it crosses.
+ */
 class SerialBuffer {
 public:
     
@@ -59,22 +71,28 @@ public:
 
     /* Functions. */
     void clear();
-    void add(string s);
+    void add(const string &s);
+    void add(const char *data, size_t length);
     void add(char c);
-    vector<char>::iterator begin();
-    vector<char>::iterator end();
+    bool remove();
+    void truncate(size_t length);
     size_t getPosition();
     void setPosition(size_t pos);
     size_t size();
+    const char *getTail(size_t *length);
     string get_string();
     char *get_char_array();
 
 private:
+    void reserve(size_t length);
+
     /* Buffer. */
-    vector<char> buffer;
-    
-    /* Buffer position/index. */
-    size_t position;
+    char *buffer;
+    size_t capacity;
+
+    /* Gap, the cursor position is gap_start. */
+    size_t gap_start;
+    size_t gap_end;
 };
 
 
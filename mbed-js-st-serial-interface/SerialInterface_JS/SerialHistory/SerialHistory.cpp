@@ -0,0 +1,153 @@
+/**
+ ******************************************************************************
+ * @file    SerialHistory.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Bounded command history for SerialInterface.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "SerialHistory.h"
+
+#if SERIAL_HISTORY_SIZE > 65535
+#error "SERIAL_HISTORY_SIZE must be at most 65535"
+#endif
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** constructor
+ * @brief	Constructor.
+ */
+SerialHistory::SerialHistory() : first(0), used(0) {
+}
+
+/** add
+ * @brief	Adds a command, dropping the oldest ones if needed. Empty
+ *          commands, commands longer than the arena and repeats of the
+ *          newest command are not stored.
+ * @param	Command text
+ * @param	Command length
+ */
+void SerialHistory::add(const char *data, size_t length) {
+    if (length == 0 || length > SERIAL_HISTORY_SIZE) {
+        return;
+    }
+
+    size_t offset = 0;
+    if (used > 0) {
+        size_t last_length;
+        const char *last = get(used - 1, &last_length);
+        if (last_length == length && memcmp(last, data, length) == 0) {
+            return; // Same as the previous command
+        }
+
+        // After the newest command, or at the start if it does not fit
+        offset = (last - arena) + last_length;
+        if (offset + length > SERIAL_HISTORY_SIZE) {
+            offset = 0;
+        }
+    }
+
+    while (used == SERIAL_HISTORY_ENTRIES || overlaps(offset, length)) {
+        removeOldest();
+    }
+
+    memcpy(arena + offset, data, length);
+
+    entry_t *entry = &entries[(first + used) % SERIAL_HISTORY_ENTRIES];
+    entry->offset = offset;
+    entry->length = length;
+    used++;
+}
+
+/** count
+ * @brief	Returns the number of commands stored.
+ * @return  Number of commands
+ */
+size_t SerialHistory::count() {
+    return used;
+}
+
+/** get
+ * @brief	Returns a command, in place.
+ * @param	Index, 0 is the oldest command
+ * @param	Set to the command length
+ * @return  Command text, not null terminated
+ */
+const char *SerialHistory::get(size_t index, size_t *length) {
+    const entry_t *entry = &entries[(first + index) % SERIAL_HISTORY_ENTRIES];
+    *length = entry->length;
+    return arena + entry->offset;
+}
+
+/** find
+ * @brief	Finds the next command starting with a prefix.
+ * @param	Prefix
+ * @param	Prefix length, 0 matches any command
+ * @param	Index to start from
+ * @param	-1 to search towards older commands, 1 towards newer ones
+ * @return  Index of the command, or -1 if none matches
+ */
+int SerialHistory::find(const char *prefix, size_t length, int from, int step) {
+    for (int index = from; index >= 0 && index < (int)used; index += step) {
+        size_t entry_length;
+        const char *entry = get(index, &entry_length);
+        if (entry_length >= length && memcmp(entry, prefix, length) == 0) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+/** removeOldest
+ * @brief	Drops the oldest command.
+ */
+void SerialHistory::removeOldest() {
+    first = (first + 1) % SERIAL_HISTORY_ENTRIES;
+    used--;
+}
+
+/** overlaps
+ * @brief	Checks if an arena range is used by a stored command.
+ * @param	Offset in the arena
+ * @param	Length
+ * @return  true if a command uses part of the range
+ */
+bool SerialHistory::overlaps(size_t offset, size_t length) {
+    for (size_t index = 0; index < used; index++) {
+        const entry_t *entry = &entries[(first + index) % SERIAL_HISTORY_ENTRIES];
+        if (entry->offset < offset + length && offset < (size_t)entry->offset + entry->length) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,97 @@
+/**
+ ******************************************************************************
+ * @file    SerialHistory.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Bounded command history for SerialInterface.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+#ifndef _SERIAL_HISTORY_H
+#define _SERIAL_HISTORY_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "mbed.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Bytes of command text kept, at most 65535. */
+#ifndef SERIAL_HISTORY_SIZE
+#define SERIAL_HISTORY_SIZE     1024
+#endif
+
+/** Number of commands kept. */
+#ifndef SERIAL_HISTORY_ENTRIES
+#define SERIAL_HISTORY_ENTRIES  16
+#endif
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Command history of fixed size: the text of the commands is stored in one
+ * arena of SERIAL_HISTORY_SIZE bytes and their position in a ring of
+ * SERIAL_HISTORY_ENTRIES entries. The oldest commands are dropped to make
+ * room; a command is stored contiguously, so it can be read in place.
+ * A command equal to the previous one is not stored again.
+ *
+ * Index 0 is the oldest command, count() - 1 the newest.
+ */
+class SerialHistory {
+public:
+
+    /* Constructor. */
+    SerialHistory();
+
+    /* Functions. */
+    void add(const char *data, size_t length);
+    size_t count();
+    const char *get(size_t index, size_t *length);
+    int find(const char *prefix, size_t length, int from, int step);
+
+private:
+    typedef struct {
+        uint16_t offset;
+        uint16_t length;
+    } entry_t;
+
+    void removeOldest();
+    bool overlaps(size_t offset, size_t length);
+
+    char arena[SERIAL_HISTORY_SIZE];
+    entry_t entries[SERIAL_HISTORY_ENTRIES];
+
+    /* Ring index of the oldest entry and number of entries. */
+    size_t first;
+    size_t used;
+};
+
+#endif // _SERIAL_HISTORY_H
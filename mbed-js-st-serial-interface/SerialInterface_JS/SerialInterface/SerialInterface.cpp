@@ -47,7 +47,7 @@ ISerialInterface* SerialInterface::serialInterface = NULL;
 /** Constructor
  * @brief	constructor.
  */
-SerialInterface::SerialInterface() : historyPosition(0) {
+SerialInterface::SerialInterface() : upload(pc), processPending(false), isrMaxTime(0), rxOverruns(0), rxHighWater(0), historyPosition(0), historyPrefix(0) {
     
     //pc.printf("\r\nJavaScript REPL running...\r\n> ");
     
@@ -62,183 +62,231 @@ SerialInterface::SerialInterface() : historyPosition(0) {
  * @brief	Prints the character entered.
  */
 void SerialInterface::printJustHappened() {
-    string s(buffer.begin(), buffer.end());
-    pc.printf("> %s", s.c_str());
+    pc.printf("> %s", buffer.get_char_array());
 }
 
 /** callback
- * @brief	Callback when a key is entered in terminal.
+ * @brief	Called in the UART interrupt when bytes are received. The bytes
+ *          are only queued here, they are handled by processInput() on the
+ *          event loop thread.
  */
 void SerialInterface::callback() {
+    uint32_t start = us_ticker_read();
+
     while (pc.readable()) {
-        char c = pc.getc();
+        if (!ring.push(pc.getc())) {
+            rxOverruns++;
+        }
+    }
 
-        // control characters start with 0x1b and end with a-zA-Z
-        if (inControlChar) {
+    size_t count = ring.count();
+    if (count > rxHighWater) {
+        rxHighWater = count;
+    }
 
-            controlSequence.push_back(c);
+    if (!processPending) {
+        processPending = true;
+        js::EventLoop::getInstance().nativeCallback(Callback<void()>(this, &SerialInterface::processInput));
+    }
 
-            // if a-zA-Z then it's the last one in the control char...
-            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
-                inControlChar = false;
+    uint32_t elapsed = us_ticker_read() - start;
+    if (elapsed > isrMaxTime) {
+        isrMaxTime = elapsed;
+    }
+}
 
-                // up
-                if (controlSequence.size() == 2 && controlSequence.at(0) == 0x5b && controlSequence.at(1) == 0x41) {
-                    pc.printf("\033[u"); // restore current position
+/** processInput
+ * @brief	Handles the bytes queued by the interrupt.
+ */
+void SerialInterface::processInput() {
+    // Cleared first, bytes received from now on schedule a new call
+    processPending = false;
+
+    char c;
+    while (ring.pop(&c)) {
+        if (upload.isActive()) {
+            upload.feed(c);
+        }
+        else {
+            handleCharacter(c);
+        }
+    }
+}
 
-                    if (historyPosition == 0) {
-                        // cannot do...
-                    }
-                    else {
-                        historyPosition--;
-                        // reset cursor to 0, do \r, then write the new command...
-                        pc.printf("\33[2K\r> %s", history[historyPosition].c_str());
+/** handleCharacter
+ * @brief	Handles a key entered in terminal.
+ * @param	Character
+ */
+void SerialInterface::handleCharacter(char c) {
+    // control characters start with 0x1b and end with a-zA-Z
+    if (inControlChar) {
+
+        controlSequence.push_back(c);
+
+        // if a-zA-Z then it's the last one in the control char...
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+            inControlChar = false;
+
+            // up
+            if (controlSequence.size() == 2 && controlSequence.at(0) == 0x5b && controlSequence.at(1) == 0x41) {
+                pc.printf("\033[u"); // restore current position
+
+                if (historyPosition == history.count()) {
+#ifdef SERIAL_HISTORY_PREFIX_SEARCH
+                    // only go through the commands starting with what was typed
+                    historyPrefix = buffer.size();
+#else
+                    historyPrefix = 0;
+#endif
+                }
 
-                        buffer.clear();
-                        buffer.add(history[historyPosition]);
-                    }
+                int index = history.find(buffer.get_char_array(), historyPrefix, (int)historyPosition - 1, -1);
+                if (index < 0) {
+                    // cannot do...
                 }
-                // down
-                else if (controlSequence.size() == 2 && controlSequence.at(0) == 0x5b && controlSequence.at(1) == 0x42) {
-                    pc.printf("\033[u"); // restore current position
+                else {
+                    showHistory(index);
+                }
+            }
+            // down
+            else if (controlSequence.size() == 2 && controlSequence.at(0) == 0x5b && controlSequence.at(1) == 0x42) {
+                pc.printf("\033[u"); // restore current position
 
-                    if (historyPosition == history.size()) {
-                        // no-op
-                    }
-                    else if (historyPosition == history.size() - 1) {
-                        historyPosition++;
+                int index = history.find(buffer.get_char_array(), historyPrefix, (int)historyPosition + 1, 1);
 
-                        // put empty
-                        // reset cursor to 0, do \r, then write the new command...
-                        pc.printf("\33[2K\r> ");
+                if (historyPosition == history.count()) {
+                    // no-op
+                }
+                else if (index < 0) {
+                    historyPosition = history.count();
 
-                        buffer.clear();
-                    }
-                    else {
-                        historyPosition++;
-                        // reset cursor to 0, do \r, then write the new command...
-                        pc.printf("\33[2K\r> %s", history[historyPosition].c_str());
+                    // put back what was typed before going through the history
+                    buffer.truncate(historyPrefix);
+                    pc.printf("\33[2K\r> %s", buffer.get_char_array());
+                }
+                else {
+                    showHistory(index);
+                }
+            }
+            // left
+            else if (controlSequence.size() == 2 && controlSequence.at(0) == 0x5b && controlSequence.at(1) == 0x44) {
+                size_t curr = buffer.getPosition();
 
-                        buffer.clear();
-                        buffer.add(history[historyPosition]);
-                    }
+                // at pos0? prevent moving to the left
+                if (curr == 0) {
+                    pc.printf("\033[u"); // restore current position
                 }
-                // left
-                else if (controlSequence.size() == 2 && controlSequence.at(0) == 0x5b && controlSequence.at(1) == 0x44) {
-                    size_t curr = buffer.getPosition();
+                // otherwise it's OK, move the cursor back
+                else {
+                    buffer.setPosition(curr - 1);
 
-                    // at pos0? prevent moving to the left
-                    if (curr == 0) {
-                        pc.printf("\033[u"); // restore current position
-                    }
-                    // otherwise it's OK, move the cursor back
-                    else {
-                        buffer.setPosition(curr - 1);
-
-                        pc.putc('\033');
-                        for (size_t ix = 0; ix < controlSequence.size(); ix++) {
-                            pc.putc(controlSequence[ix]);
-                        }
+                    pc.putc('\033');
+                    for (size_t ix = 0; ix < controlSequence.size(); ix++) {
+                        pc.putc(controlSequence[ix]);
                     }
                 }
-                // right
-                else if (controlSequence.size() == 2 && controlSequence.at(0) == 0x5b && controlSequence.at(1) == 0x43) {
-                    size_t curr = buffer.getPosition();
-                    size_t size = buffer.size();
-
-                    // already at the end?
-                    if (curr == size) {
-                        pc.printf("\033[u"); // restore current position
-                    }
-                    else {
-                        buffer.setPosition(curr + 1);
+            }
+            // right
+            else if (controlSequence.size() == 2 && controlSequence.at(0) == 0x5b && controlSequence.at(1) == 0x43) {
+                size_t curr = buffer.getPosition();
+                size_t size = buffer.size();
 
-                        pc.putc('\033');
-                        for (size_t ix = 0; ix < controlSequence.size(); ix++) {
-                            pc.putc(controlSequence[ix]);
-                        }
-                    }
+                // already at the end?
+                if (curr == size) {
+                    pc.printf("\033[u"); // restore current position
                 }
                 else {
-                    // not up/down? Execute original control sequence
+                    buffer.setPosition(curr + 1);
+
                     pc.putc('\033');
                     for (size_t ix = 0; ix < controlSequence.size(); ix++) {
                         pc.putc(controlSequence[ix]);
                     }
                 }
-
-                controlSequence.clear();
+            }
+            else {
+                // not up/down? Execute original control sequence
+                pc.putc('\033');
+                for (size_t ix = 0; ix < controlSequence.size(); ix++) {
+                    pc.putc(controlSequence[ix]);
+                }
             }
 
-            continue;
+            controlSequence.clear();
         }
 
-        switch (c) {
-            case 0x06: // '^F': /* Flash the program */
-                pc.printf("\r\n");
-                addCharacter('\0');
-                js::EventLoop::getInstance().nativeCallback(Callback<void()>(this, &SerialInterface::flashBuffer));
-                break;
-            
-            case 0x12: // '\r': /* want to run the buffer */
-                pc.printf("\r\n");
-                js::EventLoop::getInstance().nativeCallback(Callback<void()>(this, &SerialInterface::runBuffer));
-                break;
-            case '\r': /* want to run the buffer */
-                addSpecialCharacter('\n');
-                pc.printf("\r\n");
-                break;
-            case 0x09: /* Horizontal Tab */
-                //pc.printf("\t");
-                addCharacter('\t');
-                break;
-            case 0x08: /* backspace */
-            case 0x7f: /* also backspace on some terminals */
-                js::EventLoop::getInstance().nativeCallback(Callback<void()>(this, &SerialInterface::handleBackspace));
-                break;
-            // Not using ESC key at the moment
-            case 0x1b: // control character 
-                // wait until next a-zA-Z
-                inControlChar = true;
-
-                pc.printf("\033[s"); // save current position
-
-                break; // break out of the callback (ignore all other characters)
-            
-            default:
-                if( c < 0x20){
-                    //pc.printf("Skipping character: %c ASCII: ", c, (int)c);
-                    break;
-                }
-                addCharacter(c);
+        return;
+    }
+
+    switch (c) {
+        case 0x06: // '^F': /* Flash the program */
+            pc.printf("\r\n");
+            flashBuffer();
+            break;
+        
+        case 0x12: // '\r': /* want to run the buffer */
+            pc.printf("\r\n");
+            runBuffer();
+            break;
+        case '\r': /* want to run the buffer */
+            addSpecialCharacter('\n');
+            pc.printf("\r\n");
+            break;
+        case SERIAL_UPLOAD_START: // '^B': /* Binary upload, no echo */
+            upload.start();
+            break;
+#ifdef JSMANAGER_PROFILE
+        case 0x10: // '^P': /* Print the native bindings profile */
+            Profiler::print();
+            pc.printf("> ");
+            break;
+#endif
+        case 0x14: // '^T': /* Print receive statistics */
+            printStats();
+            break;
+        case 0x09: /* Horizontal Tab */
+            //pc.printf("\t");
+            addCharacter('\t');
+            break;
+        case 0x08: /* backspace */
+        case 0x7f: /* also backspace on some terminals */
+            handleBackspace();
+            break;
+        // Not using ESC key at the moment
+        case 0x1b: // control character 
+            // wait until next a-zA-Z
+            inControlChar = true;
+
+            pc.printf("\033[s"); // save current position
+
+            break; // break out of the callback (ignore all other characters)
+        
+        default:
+            if( c < 0x20){
+                //pc.printf("Skipping character: %c ASCII: ", c, (int)c);
                 break;
-        }
+            }
+            addCharacter(c);
+            break;
     }
 }
 
+/** printStats
+ * @brief	Prints the receive statistics: the longest time spent in the
+ *          interrupt, the bytes dropped because the ring was full and the
+ *          highest ring fill level.
+ */
+void SerialInterface::printStats() {
+    pc.printf("\r\nRX interrupt max %lu us, %lu bytes dropped, ring peak %u of %u bytes\r\n> ",
+              (unsigned long)isrMaxTime, (unsigned long)rxOverruns, (unsigned)rxHighWater, (unsigned)SERIAL_RING_SIZE);
+}
+
 /** addToBuffer
  * @brief	Add character to Buffer.
  * @param	Character
  */
 void SerialInterface::addToBuffer(char c){
-    size_t curr_pos = buffer.getPosition();
-    size_t buffer_size = buffer.size();
-
-    if (curr_pos == buffer_size) {
-        buffer.add(c);
-    }
-    else {
-        // super inefficient...
-        string v(buffer.begin(), buffer.end());
-        v.insert(curr_pos, 1, c);
-
-        buffer.clear();
-        buffer.add(v);
-
-        buffer.setPosition(curr_pos + 1);
-
-        pc.printf("\r> %s\033[%dG", v.c_str(), int(curr_pos) + 4);
-    }           
+    buffer.add(c);
 }
 
 /** addCharacter
@@ -247,7 +295,14 @@ void SerialInterface::addToBuffer(char c){
  */
 void SerialInterface::addCharacter(char c){
     addToBuffer(c);
-    pc.putc(c);          
+    pc.putc(c);
+
+    // Mid-line: redraw the rest of the line and put the cursor back
+    size_t tail_length;
+    const char *tail = buffer.getTail(&tail_length);
+    if (tail_length > 0) {
+        pc.printf("%.*s\033[%dD", (int)tail_length, tail, (int)tail_length);
+    }
 }
 
 /** addSpecialCharacter
@@ -262,40 +317,48 @@ void SerialInterface::addSpecialCharacter(char c){
  * @brief	Handle the Backspace key.
  */
 void SerialInterface::handleBackspace() {
-    size_t curr_pos = buffer.getPosition();
+    if (!buffer.remove()) return;
 
-    string v(buffer.begin(), buffer.end());
-
-    if (v.size() == 0 || curr_pos == 0) return;
-
-    bool endOfLine = curr_pos == v.size();
-
-    v.erase(curr_pos - 1, 1);
-
-    buffer.clear();
-    buffer.add(v);
+    size_t tail_length;
+    const char *tail = buffer.getTail(&tail_length);
 
-    buffer.setPosition(curr_pos - 1);
-
-    if (endOfLine) {
+    if (tail_length == 0) {
         pc.printf("\b \b");
     }
     else {
-        // carriage return, new text, set cursor, empty until end of line
-        pc.printf("\r\033[K> %s\033[%dG", v.c_str(), curr_pos + 2);
+        // back one, redraw the rest of the line, clear the last character, set cursor
+        pc.printf("\b%.*s \033[%dD", (int)tail_length, tail, (int)tail_length + 1);
     }
 }
 
+/** showHistory
+ * @brief	Replaces the buffer with a command from the history.
+ * @param	History index
+ */
+void SerialInterface::showHistory(int index) {
+    size_t length;
+    const char *command = history.get(index, &length);
+
+    historyPosition = index;
+
+    // reset cursor to 0, do \r, then write the new command...
+    pc.printf("\33[2K\r> %.*s", (int)length, command);
+
+    buffer.clear();
+    buffer.add(command, length);
+}
+
 /** runBuffer
  * @brief	Runs the JS code from buffer.
  */
 void SerialInterface::runBuffer() {
-    string rawCode(buffer.begin(), buffer.end());
+    const size_t length = buffer.size();
+    const char *rawCode = buffer.get_char_array();
 
-    // pc.printf("Running: %s\r\n", rawCode.c_str());
+    // pc.printf("Running: %s\r\n", rawCode);
 
-    history.push_back(rawCode);
-    historyPosition = history.size();
+    history.add(rawCode, length);
+    historyPosition = history.count();
 
     // pc.printf("Executing (%s): ", rawCode.c_str());
     // for (size_t ix = 0; ix < rawCode.size(); ix++) {
@@ -303,15 +366,14 @@ void SerialInterface::runBuffer() {
     // }
     // pc.printf("\r\n");
 
-    const jerry_char_t* code = reinterpret_cast<const jerry_char_t*>(rawCode.c_str());
-    const size_t length = rawCode.length();
+    const jerry_char_t* code = reinterpret_cast<const jerry_char_t*>(rawCode);
 
     jerry_value_t parsed_code = jerry_parse(code, length, false);
 
     // @todo, how do we get the error message? :-o
 
     if (jerry_value_has_error_flag(parsed_code)) {
-        LOG_PRINT_ALWAYS("Syntax error while parsing code... (%s)\r\n", rawCode.c_str());
+        LOG_PRINT_ALWAYS("Syntax error while parsing code... (%s)\r\n", rawCode);
     }
     else {
         jerry_value_t returned_value = jerry_run(parsed_code);
@@ -365,14 +427,14 @@ void SerialInterface::runBuffer() {
  * @brief	Write the data in buffer to flash.
  */
 void SerialInterface::flashBuffer() {
-    addCharacter('\0');
-    string rawCode(buffer.begin(), buffer.end());
+    const size_t length = buffer.size();
+    const char *rawCode = buffer.get_char_array();
 
-    char *data = (char *)rawCode.c_str();
-    //data[buffer.size()] = '\0';
-    
-    pc.printf("Requesting to flash: %s\r\nwith length: %i\r\n", data, strlen(data));
-    Flasher::write_to_flash(data);
+    pc.printf("Requesting to flash: %s\r\nwith length: %i\r\n", rawCode, (int)length);
+    if(ScriptLoader::store(rawCode, length) != 0){
+        pc.printf("Flashing failed, program not stored\r\n");
+        return;
+    }
     
     //buffer.clear();
 
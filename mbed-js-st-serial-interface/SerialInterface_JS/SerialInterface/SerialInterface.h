@@ -43,6 +43,7 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include <string>
+#include <vector>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <sys/time.h>
@@ -52,8 +53,12 @@
 
 #include "us_ticker_api.h"
 
-#include "Flasher.h"
+#include "ScriptLoader.h"
+#include "Profiler.h"
 #include "SerialBuffer.h"
+#include "SerialHistory.h"
+#include "SerialRing.h"
+#include "SerialUpload.h"
 #include "ISerialInterface.h"
 
 #include "jerryscript-mbed-event-loop/EventLoop.h"
@@ -80,6 +85,7 @@ public:
     
     /* Public functions. */
     void printJustHappened();
+    void printStats();
 
 private:
     /* SerialInterface interface. */
@@ -87,21 +93,34 @@ private:
     
     /* Functions. */
     void callback();
+    void processInput();
+    void handleCharacter(char c);
     void addToBuffer(char c);
     void addCharacter(char c);
     void addSpecialCharacter(char c);
     void handleBackspace();
+    void showHistory(int index);
     void runBuffer() ;
     void flashBuffer();
     bool jerry_port_console_printing;
     void jerry_port_console (const char *format, ...);
     
 private:
+    SerialRing ring;
+    SerialUpload upload;
+    volatile bool processPending;
+
+    /* Receive statistics, updated in the interrupt. */
+    volatile uint32_t isrMaxTime;
+    volatile uint32_t rxOverruns;
+    volatile size_t rxHighWater;
+
     SerialBuffer buffer;
     bool inControlChar = false;
     vector<char> controlSequence;
-    vector<string> history;
+    SerialHistory history;
     size_t historyPosition;
+    size_t historyPrefix;
 };
 
 #endif // _SERIALINTERFACE_H
\ No newline at end of file
@@ -0,0 +1,97 @@
+/**
+ ******************************************************************************
+ * @file    SerialRing.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Interrupt safe receive ring for SerialInterface.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "SerialRing.h"
+
+#if (SERIAL_RING_SIZE & (SERIAL_RING_SIZE - 1)) != 0
+#error "SERIAL_RING_SIZE must be a power of two"
+#endif
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** constructor
+ * @brief	Constructor.
+ */
+SerialRing::SerialRing() : head(0), tail(0) {
+}
+
+/** push
+ * @brief	Adds a byte, called by the producer.
+ * @param	Byte
+ * @return  false if the ring is full and the byte was dropped
+ */
+bool SerialRing::push(char c) {
+    uint32_t h = head;
+    if (h - tail == SERIAL_RING_SIZE) {
+        return false;
+    }
+
+    buffer[h & (SERIAL_RING_SIZE - 1)] = c;
+
+    // The byte must be stored before the consumer can see the new head
+    __DMB();
+    head = h + 1;
+    return true;
+}
+
+/** pop
+ * @brief	Removes the oldest byte, called by the consumer.
+ * @param	Set to the byte
+ * @return  false if the ring is empty
+ */
+bool SerialRing::pop(char *c) {
+    uint32_t t = tail;
+    if (t == head) {
+        return false;
+    }
+
+    *c = buffer[t & (SERIAL_RING_SIZE - 1)];
+
+    // The byte must be read before the producer can reuse its slot
+    __DMB();
+    tail = t + 1;
+    return true;
+}
+
+/** count
+ * @brief	Returns the number of bytes waiting.
+ * @return  Number of bytes
+ */
+size_t SerialRing::count() {
+    return head - tail;
+}
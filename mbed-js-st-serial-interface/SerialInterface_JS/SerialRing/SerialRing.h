@@ -0,0 +1,80 @@
+/**
+ ******************************************************************************
+ * @file    SerialRing.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Interrupt safe receive ring for SerialInterface.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+#ifndef _SERIAL_RING_H
+#define _SERIAL_RING_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "mbed.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Size of the receive ring in bytes, must be a power of two. */
+#ifndef SERIAL_RING_SIZE
+#define SERIAL_RING_SIZE    2048
+#endif
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Fixed size single producer, single consumer byte ring. push() is called
+ * from the UART interrupt and pop() from the event loop thread; each side
+ * only writes its own index, so no lock is needed.
+ */
+class SerialRing {
+public:
+
+    /* Constructor. */
+    SerialRing();
+
+    /* Functions. */
+    bool push(char c);
+    bool pop(char *c);
+    size_t count();
+
+private:
+    char buffer[SERIAL_RING_SIZE];
+
+    /* Written by the producer only. */
+    volatile uint32_t head;
+
+    /* Written by the consumer only. */
+    volatile uint32_t tail;
+};
+
+#endif // _SERIAL_RING_H
@@ -0,0 +1,241 @@
+/**
+ ******************************************************************************
+ * @file    SerialUpload.cpp
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Binary framed script upload for SerialInterface.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "SerialUpload.h"
+
+#include "jerryscript-mbed-event-loop/EventLoop.h"
+
+/* Class Implementation ------------------------------------------------------*/
+
+/** constructor
+ * @brief	Constructor.
+ * @param	Serial port the replies are sent to
+ */
+SerialUpload::SerialUpload(RawSerial &serial) : serial(serial), state(STATE_IDLE), fill(0), length(0),
+                                                expected(0), nakSent(false), started(false) {
+}
+
+/** start
+ * @brief	Enters upload mode, the next bytes received are frames.
+ */
+void SerialUpload::start() {
+    state = STATE_SYNC;
+    expected = 0;
+    nakSent = false;
+    started = false;
+    timeout.attach(Callback<void()>(this, &SerialUpload::onTimeout), SERIAL_UPLOAD_TIMEOUT);
+}
+
+/** isActive
+ * @brief	Returns whether upload mode is on.
+ * @return  true in upload mode
+ */
+bool SerialUpload::isActive() {
+    return state != STATE_IDLE;
+}
+
+/** feed
+ * @brief	Handles a received byte.
+ * @param	Byte
+ */
+void SerialUpload::feed(char c) {
+    uint8_t byte = (uint8_t)c;
+
+    switch (state) {
+        case STATE_SYNC:
+            // Anything before the sync byte is noise or the rest of a bad frame
+            if (byte == SERIAL_UPLOAD_SYNC) {
+                state = STATE_HEADER;
+                fill = 0;
+            }
+            break;
+
+        case STATE_HEADER:
+            header[fill++] = byte;
+            if (fill == sizeof(header)) {
+                length = header[2] | (header[3] << 8);
+                fill = 0;
+                if (length > SERIAL_UPLOAD_CHUNK_SIZE) {
+                    // Corrupted length, wait for the next frame
+                    if (!nakSent) {
+                        reply(SERIAL_UPLOAD_NAK, expected);
+                        nakSent = true;
+                    }
+                    state = STATE_SYNC;
+                }
+                else {
+                    state = length > 0 ? STATE_PAYLOAD : STATE_CRC;
+                }
+            }
+            break;
+
+        case STATE_PAYLOAD:
+            payload[fill++] = byte;
+            if (fill == length) {
+                fill = 0;
+                state = STATE_CRC;
+            }
+            break;
+
+        case STATE_CRC:
+            crc[fill++] = byte;
+            if (fill == sizeof(crc)) {
+                state = STATE_SYNC;
+                handleFrame();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/** handleFrame
+ * @brief	Handles a complete frame.
+ */
+void SerialUpload::handleFrame() {
+    uint32_t received = crc[0] | (crc[1] << 8) | (crc[2] << 16) | ((uint32_t)crc[3] << 24);
+    uint32_t computed = Flasher::crc32(payload, length, Flasher::crc32(header, sizeof(header)));
+
+    uint8_t type = header[0];
+    uint8_t seq = header[1];
+
+    if (received == computed && type == SERIAL_UPLOAD_FRAME_ABORT) {
+        // Accepted whatever its sequence number, the host may be lost
+        Flasher::abort_write();
+        reply(SERIAL_UPLOAD_ACK, seq);
+        stop();
+        return;
+    }
+
+    if (received != computed || seq != expected) {
+        uint8_t behind = expected - seq;
+        if (received == computed && behind >= 1 && behind <= SERIAL_UPLOAD_WINDOW) {
+            // Sent again because an acknowledge was lost
+            reply(SERIAL_UPLOAD_ACK, seq);
+        }
+        else if (!nakSent) {
+            reply(SERIAL_UPLOAD_NAK, expected);
+            nakSent = true;
+        }
+        return;
+    }
+
+    nakSent = false;
+    expected++;
+    timeout.attach(Callback<void()>(this, &SerialUpload::onTimeout), SERIAL_UPLOAD_TIMEOUT);
+
+    int ret = 0;
+    switch (type) {
+        case SERIAL_UPLOAD_FRAME_START:
+            update.reset();
+            started = true;
+            break;
+
+        case SERIAL_UPLOAD_FRAME_DATA:
+            ret = started ? update.write((const char *)payload, length) : 5;
+            break;
+
+        case SERIAL_UPLOAD_FRAME_END:
+            ret = started ? update.finish() : 5;
+            if (ret == 0) {
+                ret = ScriptLoader::commit();
+            }
+            if (ret == 0) {
+                reply(SERIAL_UPLOAD_ACK, seq);
+                stop();
+
+                // Let the acknowledge go out before the reset
+                wait_ms(10);
+                NVIC_SystemReset();
+            }
+            break;
+
+        default:
+            ret = 5;
+            break;
+    }
+
+    if (ret != 0) {
+        Flasher::abort_write();
+        reply(SERIAL_UPLOAD_FAIL, ret);
+        stop();
+        return;
+    }
+
+    reply(SERIAL_UPLOAD_ACK, seq);
+}
+
+/** reply
+ * @brief	Sends a reply to the host.
+ * @param	Reply code
+ * @param	Sequence number or error code
+ */
+void SerialUpload::reply(uint8_t code, uint8_t value) {
+    serial.putc(code);
+    serial.putc(value);
+}
+
+/** stop
+ * @brief	Leaves upload mode.
+ */
+void SerialUpload::stop() {
+    timeout.detach();
+    state = STATE_IDLE;
+    started = false;
+}
+
+/** onTimeout
+ * @brief	Called in interrupt context when the host went quiet.
+ */
+void SerialUpload::onTimeout() {
+    js::EventLoop::getInstance().nativeCallback(Callback<void()>(this, &SerialUpload::timedOut));
+}
+
+/** timedOut
+ * @brief	Drops the upload after a timeout.
+ */
+void SerialUpload::timedOut() {
+    if (state == STATE_IDLE) {
+        return;
+    }
+
+    Flasher::abort_write();
+    stop();
+    serial.printf("\r\nUpload timed out\r\n> ");
+}
@@ -0,0 +1,152 @@
+/**
+ ******************************************************************************
+ * @file    SerialUpload.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Binary framed script upload for SerialInterface.
+******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+#ifndef _SERIAL_UPLOAD_H
+#define _SERIAL_UPLOAD_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "mbed.h"
+
+#include "ScriptLoader.h"
+#include "ScriptUpdate.h"
+#include "SerialRing.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Key that switches the terminal to upload mode (Ctrl+B). */
+#define SERIAL_UPLOAD_START         0x02
+
+/** Maximum payload of a frame in bytes. */
+#ifndef SERIAL_UPLOAD_CHUNK_SIZE
+#define SERIAL_UPLOAD_CHUNK_SIZE    256
+#endif
+
+/** Frames the host may send before waiting for an acknowledge. */
+#ifndef SERIAL_UPLOAD_WINDOW
+#define SERIAL_UPLOAD_WINDOW        4
+#endif
+
+/** Upload mode is left after this many seconds without a frame. */
+#ifndef SERIAL_UPLOAD_TIMEOUT
+#define SERIAL_UPLOAD_TIMEOUT       5.0f
+#endif
+
+/** Frame sync byte, frame types and replies. */
+#define SERIAL_UPLOAD_SYNC          0x7E
+#define SERIAL_UPLOAD_FRAME_START   'S'
+#define SERIAL_UPLOAD_FRAME_DATA    'D'
+#define SERIAL_UPLOAD_FRAME_END     'E'
+#define SERIAL_UPLOAD_FRAME_ABORT   'A'
+#define SERIAL_UPLOAD_ACK           0x06
+#define SERIAL_UPLOAD_NAK           0x15
+#define SERIAL_UPLOAD_FAIL          0x18
+
+/** Frame overhead: sync, type, sequence, length and CRC32. */
+#define SERIAL_UPLOAD_FRAME_OVERHEAD 9
+
+#if SERIAL_UPLOAD_WINDOW * (SERIAL_UPLOAD_CHUNK_SIZE + SERIAL_UPLOAD_FRAME_OVERHEAD) > SERIAL_RING_SIZE
+#error "A full upload window must fit SERIAL_RING_SIZE"
+#endif
+
+/* Class Declaration ---------------------------------------------------------*/
+
+/**
+ * Receives a script in binary frames and streams it into flash, without
+ * echo and without going through the line editor.
+ *
+ * A frame is the sync byte, a type, a sequence number, a little endian 16
+ * bit payload length, the payload and the CRC32 of type to payload:
+ *
+ *   SERIAL_UPLOAD_FRAME_START  starts an upload, no payload
+ *   SERIAL_UPLOAD_FRAME_DATA   next part of the script, or of a compressed
+ *                              or delta update (see ScriptUpdate.h)
+ *   SERIAL_UPLOAD_FRAME_END    checks the script, makes it active and reboots
+ *   SERIAL_UPLOAD_FRAME_ABORT  drops the upload and leaves upload mode, with
+ *                              any sequence number
+ *
+ * Every frame received in order is acknowledged with SERIAL_UPLOAD_ACK and
+ * its sequence number. A corrupted or out of order frame is answered once
+ * with SERIAL_UPLOAD_NAK and the expected sequence number, and frames are
+ * dropped until that one is sent again (go-back-N). The host may have up to
+ * SERIAL_UPLOAD_WINDOW frames unacknowledged. If the script cannot be
+ * stored, SERIAL_UPLOAD_FAIL and the ScriptLoader return code are sent and
+ * upload mode is left.
+ */
+class SerialUpload {
+public:
+
+    /* Constructor. */
+    SerialUpload(RawSerial &serial);
+
+    /* Functions. */
+    void start();
+    bool isActive();
+    void feed(char c);
+
+private:
+    void handleFrame();
+    void reply(uint8_t code, uint8_t value);
+    void stop();
+    void onTimeout();
+    void timedOut();
+
+    enum State {
+        STATE_IDLE,
+        STATE_SYNC,
+        STATE_HEADER,
+        STATE_PAYLOAD,
+        STATE_CRC
+    };
+
+    RawSerial &serial;
+    UpdateDecoder update;
+    Timeout timeout;
+
+    State state;
+    uint8_t header[4];
+    uint8_t payload[SERIAL_UPLOAD_CHUNK_SIZE];
+    uint8_t crc[4];
+    uint32_t fill;
+    uint32_t length;
+
+    uint8_t expected;
+    bool nakSent;
+    bool started;
+};
+
+#endif // _SERIAL_UPLOAD_H
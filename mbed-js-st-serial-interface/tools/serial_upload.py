@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""
+Uploads a script, or an update built with the JS manager make_update.py, to
+a device running SerialInterface, using the binary framed upload mode.
+
+    serial_upload.py /dev/ttyACM0 main.js
+    serial_upload.py --baud 921600 /dev/ttyACM0 update.bin
+
+Needs pyserial. See SerialInterface_JS/SerialUpload/SerialUpload.h for the
+protocol.
+"""
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+import serial
+
+START_KEY = b'\x02'
+SYNC = 0x7E
+ACK = 0x06
+NAK = 0x15
+FAIL = 0x18
+CHUNK_SIZE = 256
+WINDOW = 4
+
+
+def frame(kind, seq, payload=b''):
+    body = struct.pack('<cBH', kind, seq & 0xFF, len(payload)) + payload
+    return bytes([SYNC]) + body + struct.pack('<I', zlib.crc32(body) & 0xFFFFFFFF)
+
+
+def upload(port, data, timeout):
+    frames = [frame(b'S', 0)]
+    for offset in range(0, len(data), CHUNK_SIZE):
+        frames.append(frame(b'D', len(frames), data[offset:offset + CHUNK_SIZE]))
+    frames.append(frame(b'E', len(frames)))
+
+    port.reset_input_buffer()
+    port.write(START_KEY)
+
+    base = 0      # oldest frame not acknowledged
+    sent = 0      # next frame to send
+    start = time.time()
+    deadline = time.time() + timeout
+    while base < len(frames):
+        while sent < len(frames) and sent - base < WINDOW:
+            port.write(frames[sent])
+            sent += 1
+
+        reply = port.read(2)
+        if len(reply) < 2:
+            if time.time() > deadline:
+                raise IOError('no reply from the device')
+            sent = base  # resend the window
+            continue
+        deadline = time.time() + timeout
+
+        code, value = reply[0], reply[1]
+        if code == ACK:
+            # Sequence numbers are 8 bit, map back to the frame index
+            index = base + ((value - base) & 0xFF)
+            if index < sent:
+                base = max(base, index + 1)
+        elif code == NAK:
+            index = base + ((value - base) & 0xFF)
+            base = sent = index
+        elif code == FAIL:
+            raise IOError('device could not store the script (code %d)' % value)
+
+    elapsed = time.time() - start
+    print('%d bytes in %.2f s (%.0f bytes/s)' % (len(data), elapsed, len(data) / elapsed))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Upload a script over serial')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--timeout', type=float, default=3.0, help='seconds to wait for a reply')
+    parser.add_argument('port')
+    parser.add_argument('script')
+    args = parser.parse_args()
+
+    with open(args.script, 'rb') as f:
+        data = f.read()
+
+    with serial.Serial(args.port, args.baud, timeout=0.5) as port:
+        try:
+            upload(port, data, args.timeout)
+        except IOError as error:
+            port.write(frame(b'A', 0))
+            sys.exit(str(error))
+
+
+if __name__ == '__main__':
+    main()
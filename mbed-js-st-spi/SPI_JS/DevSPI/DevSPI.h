@@ -50,6 +50,13 @@
 #define __DEV_SPI_BIG_ENDIAN
 #endif
 
+/* Types ---------------------------------------------------------------------*/
+/** Bus usage of the DevSPI register helpers, all SPI buses together */
+typedef struct {
+    uint32_t transactions;      /*!< Register reads and writes */
+    uint32_t bytes;             /*!< Bytes clocked, register address bytes included */
+} DevSPIStats;
+
 /* Classes -------------------------------------------------------------------*/
 /** Helper class DevSPI providing functions for synchronous SPI communication
  *  common for a series of SPI devices.
@@ -116,10 +123,8 @@ class DevSPI : public SPI
         /* Select the chip. */
         ssel = 0;
         
-        /* Write data. */
-	for (int i = 0; i < NumBytesToWrite; i++) {
-            write(pBuffer[i]);
-	}
+        /* Write data, in one block transfer. */
+        write((const char *)pBuffer, (int)NumBytesToWrite, NULL, 0);
 
         /* Unselect the chip. */
         ssel = 1;
@@ -177,17 +182,139 @@ class DevSPI : public SPI
         /* Select the chip. */
         ssel = 0;
         
-        /* Read and write data at the same time. */
-	for (int i = 0; i < NumBytes; i++) {
-            pBufferToRead[i] = write(pBufferToWrite[i]);
-	}
+        /* Read and write data at the same time, in one block transfer. */
+        write((const char *)pBufferToWrite, (int)NumBytes, (char *)pBufferToRead, (int)NumBytes);
+
+        /* Unselect the chip. */
+        ssel = 1;
+
+        return 0;
+    }
+
+    /**
+     * @brief      Reads consecutive registers of an SPI device in 8-bit data mode.
+     *             The register address and the data each go in one block
+     *             transfer, with the bus locked and the chip selected across both.
+     * @param[in]  spi SPI bus the device is on, a DevSPI or a plain SPI.
+     * @param[in]  ssel GPIO of the SSEL pin of the SPI device to be used for communication.
+     * @param[in]  RegisterAddr register address, with the read bit and any
+     *             auto-increment bit the device needs already set.
+     * @param[out] pBuffer pointer to the buffer to read data into.
+     * @param[in]  NumBytesToRead number of bytes to read.
+     * @retval     0 if ok.
+     * @note       Used by the sensor classes for their io_read() in 4-wire mode.
+     */
+    static int spi_read_reg(SPI *spi, DigitalOut &ssel, uint8_t RegisterAddr, uint8_t* pBuffer, uint16_t NumBytesToRead)
+    {
+        spi->lock();
+
+        /* Select the chip. */
+        ssel = 0;
+
+        /* Write the register address, then clock the data in. */
+        spi->write((const char *)&RegisterAddr, 1, NULL, 0);
+        spi->write(NULL, 0, (char *)pBuffer, (int)NumBytesToRead);
 
         /* Unselect the chip. */
         ssel = 1;
 
+        spi->unlock();
+
+        count(NumBytesToRead + 1);
+
         return 0;
     }
 
+    /**
+     * @brief      Reads consecutive registers of an SPI device wired in 3-wire mode,
+     *             in one block transfer with the bus locked.
+     * @param[in]  spi SPI bus the device is on, a DevSPI or a plain SPI.
+     * @param[in]  ssel GPIO of the SSEL pin of the SPI device to be used for communication.
+     * @param[in]  RegisterAddr register address, with the read bit and any
+     *             auto-increment bit the device needs already set.
+     * @param[out] pBuffer pointer to the buffer to read data into.
+     * @param[in]  NumBytesToRead number of bytes to read.
+     * @retval     0 if ok.
+     * @note       Used by the sensor classes for their io_read() in 3-wire mode.
+     */
+    static int spi_read_reg_3w(SPI *spi, DigitalOut &ssel, uint8_t RegisterAddr, uint8_t* pBuffer, uint16_t NumBytesToRead)
+    {
+        spi->lock();
+
+        /* Select the chip. */
+        ssel = 0;
+
+        /* Write the register address and read the data on the same line. */
+        spi->write((const char *)&RegisterAddr, 1, (char *)pBuffer, (int)NumBytesToRead);
+
+        /* Unselect the chip. */
+        ssel = 1;
+
+        spi->unlock();
+
+        count(NumBytesToRead + 1);
+
+        return 0;
+    }
+
+    /**
+     * @brief      Writes consecutive registers of an SPI device in 8-bit data mode.
+     *             The register address and the data each go in one block
+     *             transfer, with the bus locked and the chip selected across both.
+     * @param[in]  spi SPI bus the device is on, a DevSPI or a plain SPI.
+     * @param[in]  ssel GPIO of the SSEL pin of the SPI device to be used for communication.
+     * @param[in]  RegisterAddr register address, with any auto-increment bit
+     *             the device needs already set.
+     * @param[in]  pBuffer pointer to the buffer of data to send.
+     * @param[in]  NumBytesToWrite number of bytes to write.
+     * @retval     0 if ok.
+     * @note       Used by the sensor classes for their io_write().
+     */
+    static int spi_write_reg(SPI *spi, DigitalOut &ssel, uint8_t RegisterAddr, uint8_t* pBuffer, uint16_t NumBytesToWrite)
+    {
+        spi->lock();
+
+        /* Select the chip. */
+        ssel = 0;
+
+        /* Write the register address, then the data. */
+        spi->write((const char *)&RegisterAddr, 1, NULL, 0);
+        spi->write((const char *)pBuffer, (int)NumBytesToWrite, NULL, 0);
+
+        /* Unselect the chip. */
+        ssel = 1;
+
+        spi->unlock();
+
+        count(NumBytesToWrite + 1);
+
+        return 0;
+    }
+
+    /**
+     * @brief      Reads the bus usage of spi_read_reg(), spi_read_reg_3w() and
+     *             spi_write_reg(), which is what the sensor drivers use, since
+     *             start up or reset_stats(). Divide by the number of samples read
+     *             to get the bus cost of a sample.
+     * @param[out] stats filled with the counters, see DevSPIStats.
+     */
+    static void get_stats(DevSPIStats *stats)
+    {
+        core_util_critical_section_enter();
+        *stats = usage();
+        core_util_critical_section_exit();
+    }
+
+    /**
+     * @brief      Clears the bus usage counters.
+     */
+    static void reset_stats()
+    {
+        core_util_critical_section_enter();
+        memset(&usage(), 0, sizeof(DevSPIStats));
+        core_util_critical_section_exit();
+    }
+
     /**
      * @brief      Writes a buffer to the SPI peripheral device in 16-bit data mode 
      *             using synchronous SPI communication.
@@ -286,6 +413,20 @@ class DevSPI : public SPI
     }
 
 protected:
+    /* Bus usage, shared by all the copies of this header linked in */
+    static DevSPIStats &usage() {
+        static DevSPIStats stats;
+        return stats;
+    }
+
+    /* Adds a register access to the bus usage */
+    static void count(uint32_t bytes) {
+        core_util_critical_section_enter();
+        usage().transactions++;
+        usage().bytes += bytes;
+        core_util_critical_section_exit();
+    }
+
     inline uint16_t htons(uint16_t x) {
 #ifndef __DEV_SPI_BIG_ENDIAN
 	return (((x)<<8)|((x)>>8));
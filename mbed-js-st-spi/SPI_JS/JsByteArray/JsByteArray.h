@@ -0,0 +1,304 @@
+/**
+ ******************************************************************************
+ * @file    JsByteArray.h
+ * @author  ST
+ * @version V1.0.0
+ * @date    17 October 2026
+ * @brief   Byte arrays and transaction lists shared by the bus bindings.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright notice,
+ *      this list of conditions and the following disclaimer in the documentation
+ *      and/or other materials provided with the distribution.
+ *   3. Neither the name of STMicroelectronics nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************
+ */
+
+/* Prevent recursive inclusion -----------------------------------------------*/
+
+#ifndef __JS_BYTE_ARRAY_H__
+#define __JS_BYTE_ARRAY_H__
+
+/* Includes ------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <math.h>
+#include "jerryscript-mbed-library-registry/wrap_tools.h"
+
+/* Defines -------------------------------------------------------------------*/
+
+/** Largest number of bytes copied out of or into one byte array */
+#define JS_BYTE_ARRAY_MAX_LENGTH    0xFFFF
+
+/** Largest number of transactions copied out of one transfer() list */
+#define JS_TRANSFER_LIST_MAX_ITEMS  256
+
+/* Numbers -------------------------------------------------------------------*/
+
+/**
+ * Converts a length or an index passed by the script
+ * @param value Number
+ * @param max Largest value accepted
+ * @param index Set to the value
+ * @returns false if the value is not an integer in [0, max]
+ */
+static inline bool js_byte_array_get_index(jerry_value_t value, uint32_t max, uint32_t *index) {
+    double number = jerry_get_number_value(value);
+
+    // NaN fails every comparison
+    if (!(number >= 0 && number <= (double) max) || floor(number) != number) {
+        return false;
+    }
+
+    *index = (uint32_t) number;
+    return true;
+}
+
+/* Byte arrays ---------------------------------------------------------------*/
+
+/**
+ * Returns the length of an Array or TypedArray. The length of an object
+ * posing as a TypedArray is not trusted: anything that is not a valid
+ * length reads as 0, and callers check it against JS_BYTE_ARRAY_MAX_LENGTH
+ * before allocating.
+ */
+static inline uint32_t js_byte_array_length(jerry_value_t array) {
+    if (jerry_value_is_array(array)) {
+        return jerry_get_array_length(array);
+    }
+
+    jerry_value_t name = jerry_create_string((const jerry_char_t *) "length");
+    jerry_value_t length = jerry_get_property(array, name);
+    uint32_t result = 0;
+    if (jerry_value_is_number(length) && !js_byte_array_get_index(length, 0xFFFFFFFF, &result)) {
+        result = 0;
+    }
+
+    jerry_release_value(length);
+    jerry_release_value(name);
+
+    return result;
+}
+
+/**
+ * Returns whether a value is an Array or a TypedArray; ArrayBuffers and
+ * other objects have no indexed elements and are not byte arrays
+ */
+static inline bool js_byte_array_is_valid(jerry_value_t value) {
+    if (jerry_value_is_array(value)) {
+        return true;
+    }
+    if (!jerry_value_is_object(value)) {
+        return false;
+    }
+
+    jerry_value_t name = jerry_create_string((const jerry_char_t *) "BYTES_PER_ELEMENT");
+    jerry_value_t size = jerry_get_property(value, name);
+    bool result = jerry_value_is_number(size);
+
+    jerry_release_value(size);
+    jerry_release_value(name);
+
+    return result;
+}
+
+/**
+ * Copies bytes out of an Array or TypedArray
+ * @param source Array, or TypedArray view over an ArrayBuffer
+ */
+static inline void js_byte_array_read(jerry_value_t source, uint8_t *bytes, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        jerry_value_t val = jerry_get_property_by_index(source, i);
+        bytes[i] = jerry_value_is_number(val) ? (uint8_t) jerry_get_number_value(val) : 0;
+        jerry_release_value(val);
+    }
+}
+
+/**
+ * Copies bytes into a caller-provided Array or TypedArray
+ * @param target Array, or TypedArray view over an ArrayBuffer
+ * @param offset Index of the first byte
+ * @returns the index following the last byte written, or -1 if the bytes
+ *          do not fit in a TypedArray or could not be stored
+ */
+static inline int32_t js_byte_array_write(jerry_value_t target, uint32_t offset, const uint8_t *bytes, uint32_t count) {
+    // TypedArrays silently drop elements past their end
+    if (!jerry_value_is_array(target) && (double) offset + count > js_byte_array_length(target)) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        jerry_value_t val = jerry_create_number(bytes[i]);
+        jerry_value_t ret_val = jerry_set_property_by_index(target, offset + i, val);
+        bool failed = jerry_value_has_error_flag(ret_val);
+
+        jerry_release_value(ret_val);
+        jerry_release_value(val);
+
+        if (failed) {
+            return -1;
+        }
+    }
+
+    return offset + count;
+}
+
+/**
+ * Returns whether an optional byte array argument was left out
+ */
+static inline bool js_byte_array_is_absent(jerry_value_t value) {
+    return jerry_value_is_undefined(value) || jerry_value_is_null(value);
+}
+
+/* Transaction lists ---------------------------------------------------------*/
+
+/**
+ * The [target, tx, rx] transactions of a transfer() call, copied out of
+ * JavaScript. Reading the caller's arrays may run script code, such as
+ * property getters, which must not run while the bus is locked: gather the
+ * list first, run it natively with the bus held, then write the bytes read
+ * back once the bus is released.
+ */
+class JsTransferList {
+public:
+    /** One transaction */
+    typedef struct {
+        int target;                     /*!< Device address or chip select pin */
+        uint8_t *tx;                    /*!< Bytes to send */
+        uint32_t tx_len;
+        uint8_t *rx;                    /*!< Buffer for the bytes received */
+        uint32_t rx_len;
+    } Item;
+
+    /**
+     * Copies the transactions of list, an Array of [target, tx, rx] with a
+     * number target and Array or TypedArray tx and rx, both optional. The
+     * copy stops at the first malformed transaction, after
+     * JS_TRANSFER_LIST_MAX_ITEMS transactions, or at the transaction taking
+     * the bytes of the list past JS_BYTE_ARRAY_MAX_LENGTH.
+     */
+    JsTransferList(jerry_value_t list) : items(NULL), rx_arrays(NULL), buffer(NULL), num_items(0) {
+        uint32_t length = jerry_get_array_length(list);
+        if (length > JS_TRANSFER_LIST_MAX_ITEMS) {
+            length = JS_TRANSFER_LIST_MAX_ITEMS;
+        }
+        jerry_value_t *tx_arrays = new jerry_value_t[length];
+        uint32_t size = 0;
+
+        items = new Item[length];
+        rx_arrays = new jerry_value_t[length];
+
+        for (; num_items < length; num_items++) {
+            jerry_value_t op = jerry_get_property_by_index(list, num_items);
+            jerry_value_t target = jerry_get_property_by_index(op, 0);
+            jerry_value_t tx = jerry_get_property_by_index(op, 1);
+            jerry_value_t rx = jerry_get_property_by_index(op, 2);
+
+            bool valid = jerry_value_is_array(op) && jerry_value_is_number(target) &&
+                         (js_byte_array_is_absent(tx) || js_byte_array_is_valid(tx)) &&
+                         (js_byte_array_is_absent(rx) || js_byte_array_is_valid(rx));
+
+            if (valid) {
+                Item *item = &items[num_items];
+                item->target = jerry_get_number_value(target);
+                item->tx_len = js_byte_array_is_absent(tx) ? 0 : js_byte_array_length(tx);
+                item->rx_len = js_byte_array_is_absent(rx) ? 0 : js_byte_array_length(rx);
+
+                // Checked one by one, so that the sum cannot wrap
+                valid = item->tx_len <= JS_BYTE_ARRAY_MAX_LENGTH - size &&
+                        item->rx_len <= JS_BYTE_ARRAY_MAX_LENGTH - size - item->tx_len;
+            }
+
+            if (valid) {
+                size += items[num_items].tx_len + items[num_items].rx_len;
+
+                tx_arrays[num_items] = tx;
+                rx_arrays[num_items] = rx;
+            } else {
+                jerry_release_value(rx);
+                jerry_release_value(tx);
+            }
+
+            jerry_release_value(target);
+            jerry_release_value(op);
+
+            if (!valid) {
+                break;
+            }
+        }
+
+        // One buffer holds the bytes of all the transactions
+        buffer = new uint8_t[size ? size : 1];
+
+        uint8_t *next = buffer;
+        for (uint32_t i = 0; i < num_items; i++) {
+            items[i].tx = next;
+            js_byte_array_read(tx_arrays[i], next, items[i].tx_len);
+            next += items[i].tx_len;
+            items[i].rx = next;
+            next += items[i].rx_len;
+
+            jerry_release_value(tx_arrays[i]);
+        }
+
+        delete[] tx_arrays;
+    }
+
+    ~JsTransferList() {
+        for (uint32_t i = 0; i < num_items; i++) {
+            jerry_release_value(rx_arrays[i]);
+        }
+
+        delete[] buffer;
+        delete[] rx_arrays;
+        delete[] items;
+    }
+
+    /** Number of well-formed transactions, from the start of the list */
+    uint32_t count() {
+        return num_items;
+    }
+
+    /** Transaction i, i below count() */
+    Item *get(uint32_t i) {
+        return &items[i];
+    }
+
+    /** Copies the bytes received by the first done transactions into their rx arrays */
+    void write_back(uint32_t done) {
+        for (uint32_t i = 0; i < done && i < num_items; i++) {
+            if (items[i].rx_len) {
+                js_byte_array_write(rx_arrays[i], 0, items[i].rx, items[i].rx_len);
+            }
+        }
+    }
+
+private:
+    Item *items;
+    jerry_value_t *rx_arrays;
+    uint8_t *buffer;
+    uint32_t num_items;
+};
+
+#endif // __JS_BYTE_ARRAY_H__
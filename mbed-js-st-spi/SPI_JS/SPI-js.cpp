@@ -43,6 +43,8 @@
 
 // Load the library that we'll wrap
 #include "SPI.h"
+#include "DevSPI.h"
+#include "JsByteArray.h"
     
 #include "mbed.h"
 
@@ -66,6 +68,263 @@ static const jerry_object_native_info_t native_obj_type_info = {
     .free_cb = NAME_FOR_CLASS_NATIVE_DESTRUCTOR(SPI)
 };
 
+/**
+ * SPI#frequency (native JavaScript method)
+ *
+ * @param frequency New SPI clock frequency in Hz
+ */
+DECLARE_CLASS_FUNCTION(SPI, frequency) {
+    CHECK_ARGUMENT_COUNT(SPI, frequency, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SPI, frequency, 0, number);
+
+    // Unwrap native SPI object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SPI pointer");
+    }
+
+    SPI *native_ptr = static_cast<SPI*>(void_ptr);
+
+    int hz = jerry_get_number_value(args[0]);
+    native_ptr->frequency(hz);
+
+    return jerry_create_undefined();
+}
+
+/**
+ * SPI#format (native JavaScript method)
+ *
+ * @param bits Number of bits per SPI frame (4 - 16)
+ * @param mode Clock polarity and phase mode (0 - 3)
+ */
+DECLARE_CLASS_FUNCTION(SPI, format) {
+    CHECK_ARGUMENT_COUNT(SPI, format, (args_count == 2));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SPI, format, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SPI, format, 1, number);
+
+    // Unwrap native SPI object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SPI pointer");
+    }
+
+    SPI *native_ptr = static_cast<SPI*>(void_ptr);
+
+    int bits = jerry_get_number_value(args[0]);
+    int mode = jerry_get_number_value(args[1]);
+    native_ptr->format(bits, mode);
+
+    return jerry_create_undefined();
+}
+
+/**
+ * SPI#write (native JavaScript method)
+ *
+ * @param data Frame to send on the SPI bus
+ * @returns the frame received at the same time
+ */
+DECLARE_CLASS_FUNCTION(SPI, write) {
+    CHECK_ARGUMENT_COUNT(SPI, write, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SPI, write, 0, number);
+
+    // Unwrap native SPI object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SPI pointer");
+    }
+
+    SPI *native_ptr = static_cast<SPI*>(void_ptr);
+
+    int data = jerry_get_number_value(args[0]);
+
+    return jerry_create_number(native_ptr->write(data));
+}
+
+/**
+ * SPI#read_registers (native JavaScript method)
+ *
+ * Reads consecutive registers in one transaction: the chip select goes low,
+ * the register is sent with the read bit (0x80) set and the data is clocked in.
+ *
+ * @param cs Chip select pin, NC if the device is selected otherwise
+ * @param register Register to start reading from (must be correctly masked)
+ * @param length Number of bytes to read
+ * @param target (optional) Array or TypedArray the bytes are written to
+ * @param offset (optional) Index of the first byte in target, 0 by default
+ * @returns a new array of the bytes read, or with a target the index
+ *          following the last byte written
+ */
+DECLARE_CLASS_FUNCTION(SPI, read_registers) {
+    CHECK_ARGUMENT_COUNT(SPI, read_registers, (args_count >= 3 && args_count <= 5));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SPI, read_registers, 0, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SPI, read_registers, 1, number);
+    CHECK_ARGUMENT_TYPE_ALWAYS(SPI, read_registers, 2, number);
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(SPI, read_registers, 3, object, (args_count >= 4));
+    CHECK_ARGUMENT_TYPE_ON_CONDITION(SPI, read_registers, 4, number, (args_count == 5));
+
+    // Unwrap native SPI object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SPI pointer");
+    }
+
+    SPI *native_ptr = static_cast<SPI*>(void_ptr);
+
+    // Unwrap arguments
+    PinName cs_pin = (PinName) jerry_get_number_value(args[0]);
+    char reg = (char) jerry_get_number_value(args[1]) | 0x80;
+    uint32_t length;
+    uint32_t offset = 0;
+
+    if (!js_byte_array_get_index(args[2], JS_BYTE_ARRAY_MAX_LENGTH, &length) || length == 0) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Invalid SPI read length");
+    }
+    if (args_count == 5 && !js_byte_array_get_index(args[4], 0x7FFFFFFF - length, &offset)) {
+        return jerry_create_error(JERRY_ERROR_RANGE,
+                                  (const jerry_char_t *) "Offset must be a non-negative integer index");
+    }
+
+    uint8_t *data = new uint8_t[length];
+
+    native_ptr->lock();
+    if (cs_pin != NC) {
+        DigitalOut cs(cs_pin, 0);
+        native_ptr->write(&reg, 1, NULL, 0);
+        native_ptr->write(NULL, 0, (char *) data, length);
+        cs = 1;
+    } else {
+        native_ptr->write(&reg, 1, NULL, 0);
+        native_ptr->write(NULL, 0, (char *) data, length);
+    }
+    native_ptr->unlock();
+
+    jerry_value_t out;
+    if (args_count >= 4) {
+        out = jerry_create_number(js_byte_array_write(args[3], offset, data, length));
+    } else {
+        out = jerry_create_array(length);
+        js_byte_array_write(out, 0, data, length);
+    }
+
+    delete[] data;
+
+    return out;
+}
+
+/**
+ * SPI#transfer (native JavaScript method)
+ *
+ * Runs a list of transactions back to back, holding the SPI bus.
+ *
+ * @param transactions Array of [cs, tx, rx] transactions: the chip select pin
+ *        cs (NC for none) goes low, the bytes of the Array or TypedArray tx are
+ *        sent, then if the optional rx is given rx.length bytes are clocked
+ *        in to it, and cs goes high again
+ * @returns the number of transactions completed, less than the number of
+ *          transactions if one was malformed
+ */
+DECLARE_CLASS_FUNCTION(SPI, transfer) {
+    CHECK_ARGUMENT_COUNT(SPI, transfer, (args_count == 1));
+    CHECK_ARGUMENT_TYPE_ALWAYS(SPI, transfer, 0, array);
+
+    // Unwrap native SPI object
+    void *void_ptr;
+    const jerry_object_native_info_t *type_ptr;
+    bool has_ptr = jerry_get_object_native_pointer(this_obj, &void_ptr, &type_ptr);
+
+    if (!has_ptr || type_ptr != &native_obj_type_info) {
+        return jerry_create_error(JERRY_ERROR_TYPE,
+                                  (const jerry_char_t *) "Failed to get native SPI pointer");
+    }
+
+    SPI *native_ptr = static_cast<SPI*>(void_ptr);
+
+    // Copy the transactions out of JavaScript before holding the bus
+    JsTransferList list(args[0]);
+    uint32_t done;
+
+    native_ptr->lock();
+
+    for (done = 0; done < list.count(); done++) {
+        JsTransferList::Item *t = list.get(done);
+        PinName cs_pin = (PinName) t->target;
+
+        if (cs_pin != NC) {
+            DigitalOut cs(cs_pin, 0);
+            native_ptr->write((const char *) t->tx, t->tx_len, NULL, 0);
+            native_ptr->write(NULL, 0, (char *) t->rx, t->rx_len);
+            cs = 1;
+        } else {
+            native_ptr->write((const char *) t->tx, t->tx_len, NULL, 0);
+            native_ptr->write(NULL, 0, (char *) t->rx, t->rx_len);
+        }
+    }
+
+    native_ptr->unlock();
+
+    list.write_back(done);
+
+    return jerry_create_number(done);
+}
+
+/**
+ * SPI#get_stats (native JavaScript method)
+ *
+ * Returns the bus usage of the sensor drivers, on all SPI buses together.
+ *
+ * @returns array: [register reads and writes, bytes clocked] since start up
+ *          or reset_stats()
+ */
+DECLARE_CLASS_FUNCTION(SPI, get_stats) {
+    CHECK_ARGUMENT_COUNT(SPI, get_stats, (args_count == 0));
+
+    DevSPIStats stats;
+    DevSPI::get_stats(&stats);
+
+    double values[2] = {
+        (double) stats.transactions,
+        (double) stats.bytes
+    };
+
+    jerry_value_t out_array = jerry_create_array(2);
+    for (uint32_t i = 0; i < 2; i++) {
+        jerry_value_t val = jerry_create_number(values[i]);
+        jerry_release_value(jerry_set_property_by_index(out_array, i, val));
+        jerry_release_value(val);
+    }
+
+    return out_array;
+}
+
+/**
+ * SPI#reset_stats (native JavaScript method)
+ *
+ * Clears the bus usage counters.
+ */
+DECLARE_CLASS_FUNCTION(SPI, reset_stats) {
+    CHECK_ARGUMENT_COUNT(SPI, reset_stats, (args_count == 0));
+
+    DevSPI::reset_stats();
+    return jerry_create_undefined();
+}
+
 /**
  * SPI (native JavaScript constructor)
  *
@@ -88,14 +347,13 @@ DECLARE_CLASS_CONSTRUCTOR(SPI) {
     jerry_value_t js_object = jerry_create_object();
     jerry_set_object_native_pointer(js_object, native_ptr, &native_obj_type_info);
     
-    /*
-    //Future upgrades
     ATTACH_CLASS_FUNCTION(js_object, SPI, frequency);
-    ATTACH_CLASS_FUNCTION(js_object, SPI, read);
+    ATTACH_CLASS_FUNCTION(js_object, SPI, format);
     ATTACH_CLASS_FUNCTION(js_object, SPI, write);
-    ATTACH_CLASS_FUNCTION(js_object, SPI, start);
-    ATTACH_CLASS_FUNCTION(js_object, SPI, stop);
-    */
+    ATTACH_CLASS_FUNCTION(js_object, SPI, read_registers);
+    ATTACH_CLASS_FUNCTION(js_object, SPI, transfer);
+    ATTACH_CLASS_FUNCTION(js_object, SPI, get_stats);
+    ATTACH_CLASS_FUNCTION(js_object, SPI, reset_stats);
     
     return js_object;
 